@@ -23,154 +23,236 @@
 namespace juce
 {
 
-void AudioDataConverters::convertFloatToInt16LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+namespace AudioDataConverterHelpers
 {
-    auto maxVal = (double) 0x7fff;
-    auto intData = static_cast<char*> (dest);
+    enum { blockSize = 256 };
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
+    static double getMaxValue (AudioDataConverters::DataFormat format) noexcept
     {
-        for (int i = 0; i < numSamples; ++i)
+        switch (format)
         {
-            *reinterpret_cast<uint16*> (intData) = ByteOrder::swapIfBigEndian ((uint16) (short) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-            intData += destBytesPerSample;
+            case AudioDataConverters::int16LE:
+            case AudioDataConverters::int16BE:  return (double) 0x7fff;
+            case AudioDataConverters::int24LE:
+            case AudioDataConverters::int24BE:  return (double) 0x7fffff;
+            default:                            return (double) 0x7fffffff;
         }
     }
-    else
+
+    // Gives exactly the same results as roundToInt (jlimit (-maxValue, maxValue, maxValue * source[i] + noise[i]))
+    static void scaleAndRound (const float* source, int* dest, int num, double maxValue, const float* noise) noexcept
     {
-        intData += destBytesPerSample * numSamples;
+        int i = 0;
 
-        for (int i = numSamples; --i >= 0;)
+       #if JUCE_USE_SSE_INTRINSICS
+        auto scale = _mm_set1_pd (maxValue);
+        auto lower = _mm_set1_pd (-maxValue);
+
+        for (; i + 4 <= num; i += 4)
         {
-            intData -= destBytesPerSample;
-            *reinterpret_cast<uint16*> (intData) = ByteOrder::swapIfBigEndian ((uint16) (short) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-        }
-    }
-}
+            auto s = _mm_loadu_ps (source + i);
+            auto lo = _mm_mul_pd (_mm_cvtps_pd (s), scale);
+            auto hi = _mm_mul_pd (_mm_cvtps_pd (_mm_movehl_ps (s, s)), scale);
 
-void AudioDataConverters::convertFloatToInt16BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
-{
-    auto maxVal = (double) 0x7fff;
-    auto intData = static_cast<char*> (dest);
+            if (noise != nullptr)
+            {
+                auto n = _mm_loadu_ps (noise + i);
+                lo = _mm_add_pd (lo, _mm_cvtps_pd (n));
+                hi = _mm_add_pd (hi, _mm_cvtps_pd (_mm_movehl_ps (n, n)));
+            }
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            *reinterpret_cast<uint16*> (intData) = ByteOrder::swapIfLittleEndian ((uint16) (short) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-            intData += destBytesPerSample;
+            lo = _mm_min_pd (_mm_max_pd (lo, lower), scale);
+            hi = _mm_min_pd (_mm_max_pd (hi, lower), scale);
+
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i),
+                              _mm_unpacklo_epi64 (_mm_cvtpd_epi32 (lo), _mm_cvtpd_epi32 (hi)));
         }
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] = roundToInt (jlimit (-maxValue, maxValue, maxValue * source[i] + (noise != nullptr ? (double) noise[i] : 0.0)));
     }
-    else
+
+    static void writeInts (AudioDataConverters::DataFormat format, const int* source, char* dest, int num, int destBytesPerSample) noexcept
     {
-        intData += destBytesPerSample * numSamples;
+        int i = 0;
 
-        for (int i = numSamples; --i >= 0;)
+        switch (format)
         {
-            intData -= destBytesPerSample;
-            *reinterpret_cast<uint16*> (intData) = ByteOrder::swapIfLittleEndian ((uint16) (short) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-        }
-    }
-}
+            case AudioDataConverters::int16LE:
+            case AudioDataConverters::int16BE:
+            {
+                auto bigEndian = (format == AudioDataConverters::int16BE);
 
-void AudioDataConverters::convertFloatToInt24LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
-{
-    auto maxVal = (double) 0x7fffff;
-    auto intData = static_cast<char*> (dest);
+               #if JUCE_USE_SSE_INTRINSICS && JUCE_LITTLE_ENDIAN
+                if (destBytesPerSample == 2)
+                {
+                    for (; i + 8 <= num; i += 8)
+                    {
+                        auto packed = _mm_packs_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i)),
+                                                       _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i + 4)));
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            ByteOrder::littleEndian24BitToChars (roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])), intData);
-            intData += destBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += destBytesPerSample * numSamples;
+                        if (bigEndian)
+                            packed = _mm_or_si128 (_mm_slli_epi16 (packed, 8), _mm_srli_epi16 (packed, 8));
 
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= destBytesPerSample;
-            ByteOrder::littleEndian24BitToChars (roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])), intData);
-        }
-    }
-}
+                        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + 2 * i), packed);
+                    }
+                }
+               #endif
 
-void AudioDataConverters::convertFloatToInt24BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
-{
-    auto maxVal = (double) 0x7fffff;
-    auto intData = static_cast<char*> (dest);
+                for (; i < num; ++i)
+                {
+                    auto value = (uint16) (short) source[i];
+                    *reinterpret_cast<uint16*> (dest + i * destBytesPerSample) = bigEndian ? ByteOrder::swapIfLittleEndian (value)
+                                                                                           : ByteOrder::swapIfBigEndian (value);
+                }
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            ByteOrder::bigEndian24BitToChars (roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])), intData);
-            intData += destBytesPerSample;
+                break;
+            }
+
+            case AudioDataConverters::int24LE:
+                for (; i < num; ++i)
+                    ByteOrder::littleEndian24BitToChars (source[i], dest + i * destBytesPerSample);
+
+                break;
+
+            case AudioDataConverters::int24BE:
+                for (; i < num; ++i)
+                    ByteOrder::bigEndian24BitToChars (source[i], dest + i * destBytesPerSample);
+
+                break;
+
+            case AudioDataConverters::int32LE:
+            case AudioDataConverters::int32BE:
+            {
+                auto bigEndian = (format == AudioDataConverters::int32BE);
+
+                if (destBytesPerSample == 4 && bigEndian == (ByteOrder::isBigEndian() != 0))
+                {
+                    memmove (dest, source, (size_t) num * sizeof (int));
+                    break;
+                }
+
+                for (; i < num; ++i)
+                {
+                    auto value = (uint32) source[i];
+                    *reinterpret_cast<uint32*> (dest + i * destBytesPerSample) = bigEndian ? ByteOrder::swapIfLittleEndian (value)
+                                                                                           : ByteOrder::swapIfBigEndian (value);
+                }
+
+                break;
+            }
+
+            case AudioDataConverters::float32LE:
+            case AudioDataConverters::float32BE:
+            default:
+                jassertfalse;
+                break;
         }
     }
-    else
+
+    static void readInts (AudioDataConverters::DataFormat format, const char* source, int* dest, int num, int srcBytesPerSample) noexcept
     {
-        intData += destBytesPerSample * numSamples;
+        int i = 0;
 
-        for (int i = numSamples; --i >= 0;)
+        switch (format)
         {
-            intData -= destBytesPerSample;
-            ByteOrder::bigEndian24BitToChars (roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])), intData);
+            case AudioDataConverters::int16LE:
+            case AudioDataConverters::int16BE:
+            {
+                auto bigEndian = (format == AudioDataConverters::int16BE);
+
+               #if JUCE_USE_SSE_INTRINSICS && JUCE_LITTLE_ENDIAN
+                if (srcBytesPerSample == 2)
+                {
+                    for (; i + 8 <= num; i += 8)
+                    {
+                        auto values = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + 2 * i));
+
+                        if (bigEndian)
+                            values = _mm_or_si128 (_mm_slli_epi16 (values, 8), _mm_srli_epi16 (values, 8));
+
+                        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i),     _mm_srai_epi32 (_mm_unpacklo_epi16 (values, values), 16));
+                        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i + 4), _mm_srai_epi32 (_mm_unpackhi_epi16 (values, values), 16));
+                    }
+                }
+               #endif
+
+                for (; i < num; ++i)
+                {
+                    auto value = *reinterpret_cast<const uint16*> (source + i * srcBytesPerSample);
+                    dest[i] = (short) (bigEndian ? ByteOrder::swapIfLittleEndian (value)
+                                                 : ByteOrder::swapIfBigEndian (value));
+                }
+
+                break;
+            }
+
+            case AudioDataConverters::int24LE:
+                for (; i < num; ++i)
+                    dest[i] = ByteOrder::littleEndian24Bit (source + i * srcBytesPerSample);
+
+                break;
+
+            case AudioDataConverters::int24BE:
+                for (; i < num; ++i)
+                    dest[i] = ByteOrder::bigEndian24Bit (source + i * srcBytesPerSample);
+
+                break;
+
+            case AudioDataConverters::int32LE:
+            case AudioDataConverters::int32BE:
+            {
+                auto bigEndian = (format == AudioDataConverters::int32BE);
+
+                for (; i < num; ++i)
+                {
+                    auto value = *reinterpret_cast<const uint32*> (source + i * srcBytesPerSample);
+                    dest[i] = (int) (bigEndian ? ByteOrder::swapIfLittleEndian (value)
+                                               : ByteOrder::swapIfBigEndian (value));
+                }
+
+                break;
+            }
+
+            case AudioDataConverters::float32LE:
+            case AudioDataConverters::float32BE:
+            default:
+                jassertfalse;
+                break;
         }
     }
 }
 
-void AudioDataConverters::convertFloatToInt32LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+//==============================================================================
+void AudioDataConverters::convertFloatToInt16LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
 {
-    auto maxVal = (double) 0x7fffffff;
-    auto intData = static_cast<char*> (dest);
+    convertFloatToFormat (int16LE, source, dest, numSamples, destBytesPerSample, nullptr);
+}
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            *reinterpret_cast<uint32*> (intData) = ByteOrder::swapIfBigEndian ((uint32) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-            intData += destBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += destBytesPerSample * numSamples;
+void AudioDataConverters::convertFloatToInt16BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+{
+    convertFloatToFormat (int16BE, source, dest, numSamples, destBytesPerSample, nullptr);
+}
 
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= destBytesPerSample;
-            *reinterpret_cast<uint32*> (intData) = ByteOrder::swapIfBigEndian ((uint32) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-        }
-    }
+void AudioDataConverters::convertFloatToInt24LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+{
+    convertFloatToFormat (int24LE, source, dest, numSamples, destBytesPerSample, nullptr);
 }
 
-void AudioDataConverters::convertFloatToInt32BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+void AudioDataConverters::convertFloatToInt24BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
 {
-    auto maxVal = (double) 0x7fffffff;
-    auto intData = static_cast<char*> (dest);
+    convertFloatToFormat (int24BE, source, dest, numSamples, destBytesPerSample, nullptr);
+}
 
-    if (dest != (void*) source || destBytesPerSample <= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            *reinterpret_cast<uint32*> (intData) = ByteOrder::swapIfLittleEndian ((uint32) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-            intData += destBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += destBytesPerSample * numSamples;
+void AudioDataConverters::convertFloatToInt32LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+{
+    convertFloatToFormat (int32LE, source, dest, numSamples, destBytesPerSample, nullptr);
+}
 
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= destBytesPerSample;
-            *reinterpret_cast<uint32*> (intData) = ByteOrder::swapIfLittleEndian ((uint32) roundToInt (jlimit (-maxVal, maxVal, maxVal * source[i])));
-        }
-    }
+void AudioDataConverters::convertFloatToInt32BE (const float* source, void* dest, int numSamples, int destBytesPerSample)
+{
+    convertFloatToFormat (int32BE, source, dest, numSamples, destBytesPerSample, nullptr);
 }
 
 void AudioDataConverters::convertFloatToFloat32LE (const float* source, void* dest, int numSamples, int destBytesPerSample)
@@ -212,152 +294,32 @@ void AudioDataConverters::convertFloatToFloat32BE (const float* source, void* de
 //==============================================================================
 void AudioDataConverters::convertInt16LEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / 0x7fff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (short) ByteOrder::swapIfBigEndian (*reinterpret_cast<const uint16*> (intData));
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (short) ByteOrder::swapIfBigEndian (*reinterpret_cast<const uint16*> (intData));
-        }
-    }
+    convertFormatToFloat (int16LE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertInt16BEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / 0x7fff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (short) ByteOrder::swapIfLittleEndian (*reinterpret_cast<const uint16*> (intData));
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (short) ByteOrder::swapIfLittleEndian (*reinterpret_cast<const uint16*> (intData));
-        }
-    }
+    convertFormatToFloat (int16BE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertInt24LEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / 0x7fffff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (short) ByteOrder::littleEndian24Bit (intData);
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (short) ByteOrder::littleEndian24Bit (intData);
-        }
-    }
+    convertFormatToFloat (int24LE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertInt24BEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / 0x7fffff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (short) ByteOrder::bigEndian24Bit (intData);
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (short) ByteOrder::bigEndian24Bit (intData);
-        }
-    }
+    convertFormatToFloat (int24BE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertInt32LEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / (float) 0x7fffffff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (float) ByteOrder::swapIfBigEndian (*reinterpret_cast<const uint32*> (intData));
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (float) ByteOrder::swapIfBigEndian (*reinterpret_cast<const uint32*> (intData));
-        }
-    }
+    convertFormatToFloat (int32LE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertInt32BEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
 {
-    const float scale = 1.0f / (float) 0x7fffffff;
-    auto intData = static_cast<const char*> (source);
-
-    if (source != (void*) dest || srcBytesPerSample >= 4)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dest[i] = scale * (float) ByteOrder::swapIfLittleEndian (*reinterpret_cast<const uint32*> (intData));
-            intData += srcBytesPerSample;
-        }
-    }
-    else
-    {
-        intData += srcBytesPerSample * numSamples;
-
-        for (int i = numSamples; --i >= 0;)
-        {
-            intData -= srcBytesPerSample;
-            dest[i] = scale * (float) ByteOrder::swapIfLittleEndian (*reinterpret_cast<const uint32*> (intData));
-        }
-    }
+    convertFormatToFloat (int32BE, source, dest, numSamples, srcBytesPerSample);
 }
 
 void AudioDataConverters::convertFloat32LEToFloat (const void* source, float* dest, int numSamples, int srcBytesPerSample)
@@ -428,6 +390,102 @@ void AudioDataConverters::convertFormatToFloat (DataFormat sourceFormat, const v
     }
 }
 
+void AudioDataConverters::convertFloatToFormat (DataFormat destFormat, const float* source, void* dest,
+                                                int numSamples, int destBytesPerSample, Dither* dither)
+{
+    using namespace AudioDataConverterHelpers;
+
+    if (destFormat == float32LE)  { convertFloatToFloat32LE (source, dest, numSamples, destBytesPerSample); return; }
+    if (destFormat == float32BE)  { convertFloatToFloat32BE (source, dest, numSamples, destBytesPerSample); return; }
+
+    auto maxValue = getMaxValue (destFormat);
+    auto intData = static_cast<char*> (dest);
+    auto useDither = (dither != nullptr && dither->getType() != Dither::Type::none);
+
+    // When converting in-place to a wider stride, the blocks have to be done backwards
+    // so that each one is read before it gets overwritten
+    auto backwards = (dest == (void*) source && destBytesPerSample > 4);
+    auto numBlocks = (numSamples + blockSize - 1) / blockSize;
+
+    int ints[blockSize];
+    float noise[blockSize];
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        auto start = (backwards ? numBlocks - 1 - i : i) * (int) blockSize;
+        auto num = jmin ((int) blockSize, numSamples - start);
+
+        if (useDither)
+            dither->generate (noise, num);
+
+        scaleAndRound (source + start, ints, num, maxValue, useDither ? noise : nullptr);
+        writeInts (destFormat, ints, intData + start * destBytesPerSample, num, destBytesPerSample);
+    }
+}
+
+void AudioDataConverters::convertFormatToFloat (DataFormat sourceFormat, const void* source, float* dest,
+                                                int numSamples, int srcBytesPerSample)
+{
+    using namespace AudioDataConverterHelpers;
+
+    if (sourceFormat == float32LE)  { convertFloat32LEToFloat (source, dest, numSamples, srcBytesPerSample); return; }
+    if (sourceFormat == float32BE)  { convertFloat32BEToFloat (source, dest, numSamples, srcBytesPerSample); return; }
+
+    auto scale = 1.0f / (float) getMaxValue (sourceFormat);
+    auto intData = static_cast<const char*> (source);
+    auto backwards = (source == (void*) dest && srcBytesPerSample < 4);
+    auto numBlocks = (numSamples + blockSize - 1) / blockSize;
+
+    int ints[blockSize];
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        auto start = (backwards ? numBlocks - 1 - i : i) * (int) blockSize;
+        auto num = jmin ((int) blockSize, numSamples - start);
+
+        readInts (sourceFormat, intData + start * srcBytesPerSample, ints, num, srcBytesPerSample);
+        FloatVectorOperations::convertFixedToFloat (dest + start, ints, scale, num);
+    }
+}
+
+//==============================================================================
+AudioDataConverters::Dither::Dither (Type t, float amplitudeInLSBs, uint32 seed) noexcept
+    : type (t), amplitude (amplitudeInLSBs), state (seed != 0 ? seed : 1)
+{
+}
+
+float AudioDataConverters::Dither::getNextUniform() noexcept
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return (float) (state >> 8) * (1.0f / 16777216.0f);
+}
+
+void AudioDataConverters::Dither::generate (float* dest, int numValues) noexcept
+{
+    switch (type)
+    {
+        case Type::rectangular:
+            for (int i = 0; i < numValues; ++i)
+                dest[i] = amplitude * (getNextUniform() - 0.5f);
+
+            break;
+
+        case Type::triangular:
+            for (int i = 0; i < numValues; ++i)
+                dest[i] = amplitude * (getNextUniform() - getNextUniform());
+
+            break;
+
+        case Type::none:
+        default:
+            FloatVectorOperations::clear (dest, numValues);
+            break;
+    }
+}
+
 //==============================================================================
 void AudioDataConverters::interleaveSamples (const float** source, float* dest, int numSamples, int numChannels)
 {
@@ -586,6 +644,180 @@ public:
         Test1 <AudioData::Int32>::test (*this, r);
         beginTest ("Round-trip conversion: Float32");
         Test1 <AudioData::Float32>::test (*this, r);
+
+        beginTest ("Block conversion matches per-sample conversion");
+        {
+            const AudioDataConverters::DataFormat formats[] = { AudioDataConverters::int16LE, AudioDataConverters::int16BE,
+                                                                AudioDataConverters::int24LE, AudioDataConverters::int24BE,
+                                                                AudioDataConverters::int32LE, AudioDataConverters::int32BE };
+            const int numSamples = 1003;
+            HeapBlock<float> source (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                source[i] = r.nextFloat() * 2.4f - 1.2f;
+
+            source[0] = 1.0f;
+            source[1] = -1.0f;
+            source[2] = 0.0f;
+
+            for (auto format : formats)
+            {
+                for (int extraBytes : { 0, 1, 5 })
+                {
+                    auto bytesPerSample = getBytesPerSample (format);
+                    auto stride = bytesPerSample + extraBytes;
+
+                    HeapBlock<char> converted ((size_t) (numSamples * stride), true), expected ((size_t) (numSamples * stride), true);
+                    AudioDataConverters::convertFloatToFormat (format, source, converted, numSamples, stride, nullptr);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        writeReferenceSample (format, source[i], expected + i * stride);
+
+                    expect (memcmp (converted, expected, (size_t) (numSamples * stride)) == 0);
+
+                    HeapBlock<float> reversed (numSamples);
+                    AudioDataConverters::convertFormatToFloat (format, converted, reversed, numSamples, stride);
+
+                    bool allMatch = true;
+
+                    for (int i = 0; i < numSamples; ++i)
+                        allMatch = allMatch && reversed[i] == readReferenceSample (format, expected + i * stride);
+
+                    expect (allMatch);
+                }
+
+                // in-place, widening the stride
+                HeapBlock<char> inPlace ((size_t) numSamples * 8, true), expected ((size_t) numSamples * 8, true);
+                memcpy (inPlace, source, sizeof (float) * (size_t) numSamples);
+                AudioDataConverters::convertFloatToFormat (format, reinterpret_cast<float*> (inPlace.get()), inPlace, numSamples, 8, nullptr);
+                AudioDataConverters::convertFloatToFormat (format, source, expected, numSamples, 8, nullptr);
+                bool inPlaceMatches = true;
+
+                for (int i = 0; i < numSamples; ++i)
+                    inPlaceMatches = inPlaceMatches && memcmp (inPlace + i * 8, expected + i * 8, (size_t) getBytesPerSample (format)) == 0;
+
+                expect (inPlaceMatches);
+
+                // ..and back again, narrowing it
+                HeapBlock<float> reversed (numSamples);
+                AudioDataConverters::convertFormatToFloat (format, expected, reversed, numSamples, 8);
+                AudioDataConverters::convertFormatToFloat (format, inPlace, reinterpret_cast<float*> (inPlace.get()), numSamples, 8);
+                expect (memcmp (inPlace, reversed, sizeof (float) * (size_t) numSamples) == 0);
+
+                if (getBytesPerSample (format) < 4)
+                {
+                    // in-place, with a stride narrower than a float
+                    HeapBlock<char> narrow ((size_t) numSamples * 4, true);
+                    auto bytesPerSample = getBytesPerSample (format);
+                    AudioDataConverters::convertFloatToFormat (format, source, narrow, numSamples, bytesPerSample, nullptr);
+                    AudioDataConverters::convertFormatToFloat (format, narrow, reversed, numSamples, bytesPerSample);
+                    AudioDataConverters::convertFormatToFloat (format, narrow, reinterpret_cast<float*> (narrow.get()), numSamples, bytesPerSample);
+                    expect (memcmp (narrow, reversed, sizeof (float) * (size_t) numSamples) == 0);
+                }
+            }
+        }
+
+        beginTest ("24-bit samples keep their full resolution");
+        {
+            const uint8 data[] = { 0x00, 0x00, 0x40,   0x01, 0x00, 0x00,   0x00, 0x00, 0xc0 };
+            float result[3];
+            AudioDataConverters::convertInt24LEToFloat (data, result, 3);
+            expectWithinAbsoluteError (result[0], 0.5f, 1.0e-6f);
+            expectWithinAbsoluteError (result[1], 1.0f / (float) 0x7fffff, 1.0e-9f);
+            expectWithinAbsoluteError (result[2], -0.5f, 1.0e-6f);
+
+            const uint8 data32[] = { 0x00, 0x00, 0x00, 0xc0 };
+            AudioDataConverters::convertInt32LEToFloat (data32, result, 1);
+            expectWithinAbsoluteError (result[0], -0.5f, 1.0e-6f);
+        }
+
+        beginTest ("Dither");
+        {
+            const int numSamples = 8192;
+            HeapBlock<float> silence (numSamples, true), constant (numSamples);
+            HeapBlock<int16> output (numSamples);
+
+            AudioDataConverters::Dither triangular (AudioDataConverters::Dither::Type::triangular);
+            AudioDataConverters::convertFloatToFormat (AudioDataConverters::int16LE, silence, output, numSamples, 2, &triangular);
+
+            int numNonZero = 0;
+            bool allWithinOneLSB = true;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto value = (int) ByteOrder::swapIfBigEndian ((uint16) output[i]);
+                allWithinOneLSB = allWithinOneLSB && std::abs ((int16) value) <= 1;
+                numNonZero += (value != 0 ? 1 : 0);
+            }
+
+            expect (allWithinOneLSB);
+            expect (numNonZero > numSamples / 16 && numNonZero < numSamples / 2);
+
+            // A level that falls between two steps should be reproduced on average
+            auto level = 1000.3f / (float) 0x7fff;
+            FloatVectorOperations::fill (constant, level, numSamples);
+
+            for (auto type : { AudioDataConverters::Dither::Type::rectangular, AudioDataConverters::Dither::Type::triangular })
+            {
+                AudioDataConverters::Dither dither (type, 1.0f, (uint32) r.nextInt());
+                AudioDataConverters::convertFloatToFormat (AudioDataConverters::int16LE, constant, output, numSamples, 2, &dither);
+
+                double total = 0;
+                bool allNearby = true;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto value = (int16) ByteOrder::swapIfBigEndian ((uint16) output[i]);
+                    allNearby = allNearby && value >= 999 && value <= 1002;
+                    total += value;
+                }
+
+                expect (allNearby);
+                expectWithinAbsoluteError (total / numSamples, 1000.3, 0.05);
+            }
+
+            AudioDataConverters::Dither none (AudioDataConverters::Dither::Type::none);
+            AudioDataConverters::convertFloatToFormat (AudioDataConverters::int16LE, constant, output, numSamples, 2, &none);
+            expectEquals ((int) (int16) ByteOrder::swapIfBigEndian ((uint16) output[numSamples - 1]), 1000);
+        }
+    }
+
+    static int getBytesPerSample (AudioDataConverters::DataFormat format)
+    {
+        return format == AudioDataConverters::int16LE || format == AudioDataConverters::int16BE ? 2
+             : format == AudioDataConverters::int24LE || format == AudioDataConverters::int24BE ? 3 : 4;
+    }
+
+    static double getMaxValue (AudioDataConverters::DataFormat format)
+    {
+        auto bytes = getBytesPerSample (format);
+        return bytes == 2 ? (double) 0x7fff : (bytes == 3 ? (double) 0x7fffff : (double) 0x7fffffff);
+    }
+
+    static bool isBigEndianFormat (AudioDataConverters::DataFormat format)
+    {
+        return format == AudioDataConverters::int16BE || format == AudioDataConverters::int24BE || format == AudioDataConverters::int32BE;
+    }
+
+    static void writeReferenceSample (AudioDataConverters::DataFormat format, float sample, char* dest)
+    {
+        auto maxValue = getMaxValue (format);
+        auto value = roundToInt (jlimit (-maxValue, maxValue, maxValue * sample));
+        auto bytes = getBytesPerSample (format);
+
+        for (int i = 0; i < bytes; ++i)
+            dest[isBigEndianFormat (format) ? bytes - 1 - i : i] = (char) (value >> (8 * i));
+    }
+
+    static float readReferenceSample (AudioDataConverters::DataFormat format, const char* source)
+    {
+        auto bytes = getBytesPerSample (format);
+        uint32 value = 0;
+
+        for (int i = 0; i < bytes; ++i)
+            value |= ((uint32) (uint8) source[isBigEndianFormat (format) ? bytes - 1 - i : i]) << (8 * (i + 4 - bytes));
+
+        return (float) ((int) value >> (8 * (4 - bytes))) * (1.0f / (float) getMaxValue (format));
     }
 };
 
@@ -701,6 +701,78 @@ public:
     static void convertFormatToFloat (DataFormat sourceFormat,
                                       const void* source, float* dest, int numSamples);
 
+    //==============================================================================
+    /**
+        Generates the noise that can be added to samples when they're converted to
+        a lower bit-depth, to decorrelate the quantisation error from the signal.
+
+        The noise is measured in units of the destination format's least significant
+        bit, and a Dither object keeps its own random state, so you should use one
+        object per channel (or per stream) and keep it alive between blocks.
+
+        @see convertFloatToFormat
+    */
+    class JUCE_API  Dither
+    {
+    public:
+        enum class Type
+        {
+            none,           /**< No noise is added. */
+            rectangular,    /**< Uniform noise with a peak amplitude of half an LSB. */
+            triangular      /**< Triangular-PDF noise with a peak amplitude of one LSB. */
+        };
+
+        /** Creates a Dither of the given type.
+            The amplitude lets you scale the noise, e.g. when dithering a 16-bit signal that's
+            being written as full-range 32-bit integers, use an amplitude of 65536.
+        */
+        explicit Dither (Type type = Type::triangular, float amplitudeInLSBs = 1.0f, uint32 seed = 0x9e3779b9) noexcept;
+
+        /** Returns the type of noise that this object generates. */
+        Type getType() const noexcept                   { return type; }
+
+        /** Fills the given buffer with the next set of noise values. */
+        void generate (float* dest, int numValues) noexcept;
+
+    private:
+        Type type;
+        float amplitude;
+        uint32 state;
+
+        float getNextUniform() noexcept;
+    };
+
+    /** Converts floats to one of the DataFormat types, optionally adding dither.
+
+        This does the same clipping and rounding as the format-specific functions, but
+        processes the samples in blocks using SIMD instructions where they're available.
+        The dest data may overlap the source data in the same way as for the other functions.
+
+        @param destFormat           the format to write
+        @param source               the float samples, which should be in the range -1 to 1
+        @param dest                 the destination buffer
+        @param numSamples           the number of samples to convert
+        @param destBytesPerSample   the distance between the start of each dest sample, which
+                                    lets you write interleaved data
+        @param dither               if this isn't nullptr, noise from it will be added before
+                                    the samples are rounded. It's ignored for float formats.
+    */
+    static void convertFloatToFormat (DataFormat destFormat,
+                                      const float* source, void* dest, int numSamples,
+                                      int destBytesPerSample, Dither* dither);
+
+    /** Converts samples in one of the DataFormat types to floats.
+
+        @param sourceFormat         the format of the source data
+        @param source               the source buffer
+        @param dest                 the floats to write
+        @param numSamples           the number of samples to convert
+        @param srcBytesPerSample    the distance between the start of each source sample
+    */
+    static void convertFormatToFloat (DataFormat sourceFormat,
+                                      const void* source, float* dest, int numSamples,
+                                      int srcBytesPerSample);
+
     //==============================================================================
     static void interleaveSamples (const float** source, float* dest,
                                    int numSamples, int numChannels);
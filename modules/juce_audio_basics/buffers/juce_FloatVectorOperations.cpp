@@ -485,6 +485,167 @@ namespace FloatVectorHelpers
         }
     };
    #endif
+
+   #if JUCE_USE_AVX_INTRINSICS
+    //==============================================================================
+    // These are only compiled for AVX/AVX-512 on a per-function basis, and will only
+    // be called after checking that the CPU supports them.
+   #if JUCE_MSVC
+    #define JUCE_AVX_TARGET
+    #define JUCE_AVX512_TARGET
+   #else
+    #define JUCE_AVX_TARGET       __attribute__ ((target ("avx")))
+    #define JUCE_AVX512_TARGET    __attribute__ ((target ("avx512f")))
+   #endif
+
+    struct AVXOps32
+    {
+        using Type = float;
+        using ParallelType = __m256;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadIntsU (const int* v) noexcept              { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType abs (ParallelType a) noexcept                  { return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a); }
+
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMinimum (v, (int) numParallel); }
+    };
+
+    struct AVXOps64
+    {
+        using Type = double;
+        using ParallelType = __m256d;
+        enum { numParallel = 4 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType abs (ParallelType a) noexcept                  { return _mm256_andnot_pd (_mm256_set1_pd (-0.0), a); }
+
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+    };
+
+    // The unmasked AVX-512 intrinsics pass an undefined register as the merge source, which
+    // GCC reports as "may be used uninitialized" once inlined, so these use the masked
+    // forms with every lane enabled and an explicit source instead.
+    struct AVX512Ops32
+    {
+        using Type = float;
+        using ParallelType = __m512;
+        enum { numParallel = 16 };
+        static constexpr __mmask16 allLanes = 0xffff;
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadIntsU (const int* v) noexcept              { return _mm512_mask_cvtepi32_ps (_mm512_setzero_ps(), allLanes, _mm512_loadu_si512 (v)); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_mask_max_ps (a, allLanes, a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_mask_min_ps (a, allLanes, a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType abs (ParallelType a) noexcept
+        {
+            return _mm512_castsi512_ps (_mm512_and_si512 (_mm512_castps_si512 (a), _mm512_set1_epi32 (0x7fffffff)));
+        }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMinimum (v, (int) numParallel); }
+    };
+
+    struct AVX512Ops64
+    {
+        using Type = double;
+        using ParallelType = __m512d;
+        enum { numParallel = 8 };
+        static constexpr __mmask8 allLanes = 0xff;
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_mask_max_pd (a, allLanes, a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_mask_min_pd (a, allLanes, a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType abs (ParallelType a) noexcept
+        {
+            return _mm512_castsi512_pd (_mm512_and_si512 (_mm512_castpd_si512 (a), _mm512_set1_epi64 (0x7fffffffffffffffLL)));
+        }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return findMinimum (v, (int) numParallel); }
+    };
+
+    namespace AVX
+    {
+        using Ops32 = AVXOps32;
+        using Ops64 = AVXOps64;
+
+        #define JUCE_WIDE_VEC_TARGET JUCE_AVX_TARGET
+        #include "juce_FloatVectorOperations_WideKernels.h"
+        #undef JUCE_WIDE_VEC_TARGET
+    }
+
+    namespace AVX512
+    {
+        using Ops32 = AVX512Ops32;
+        using Ops64 = AVX512Ops64;
+
+        #define JUCE_WIDE_VEC_TARGET JUCE_AVX512_TARGET
+        #include "juce_FloatVectorOperations_WideKernels.h"
+        #undef JUCE_WIDE_VEC_TARGET
+    }
+
+    //==============================================================================
+    enum class WideVectorSupport
+    {
+        none,
+        avx,
+        avx512
+    };
+
+    static WideVectorSupport findWideVectorSupport() noexcept
+    {
+        if (SystemStats::hasAVX512F())  return WideVectorSupport::avx512;
+        if (SystemStats::hasAVX())      return WideVectorSupport::avx;
+
+        return WideVectorSupport::none;
+    }
+
+    // This is checked once at startup, so any calls made during static initialisation
+    // before it gets set will just use the SSE versions.
+    static const WideVectorSupport wideVectorSupport = findWideVectorSupport();
+
+    #define JUCE_DISPATCH_WIDE_VEC_OP(name, ...) \
+        if (FloatVectorHelpers::wideVectorSupport == FloatVectorHelpers::WideVectorSupport::avx512) \
+            return FloatVectorHelpers::AVX512::name (__VA_ARGS__); \
+        \
+        if (FloatVectorHelpers::wideVectorSupport == FloatVectorHelpers::WideVectorSupport::avx) \
+            return FloatVectorHelpers::AVX::name (__VA_ARGS__);
+   #else
+    #define JUCE_DISPATCH_WIDE_VEC_OP(name, ...)
+   #endif
 }
 
 //==============================================================================
@@ -522,6 +683,7 @@ void JUCE_CALLTYPE FloatVectorOperations::fill (float* dest, float valueToFill,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfill (&valueToFill, dest, 1, (size_t) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (fill, dest, valueToFill, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill, val, JUCE_LOAD_NONE,
                               const Mode::ParallelType val = Mode::load1 (valueToFill);)
    #endif
@@ -532,6 +694,7 @@ void JUCE_CALLTYPE FloatVectorOperations::fill (double* dest, double valueToFill
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfillD (&valueToFill, dest, 1, (size_t) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (fill, dest, valueToFill, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] = valueToFill, val, JUCE_LOAD_NONE,
                               const Mode::ParallelType val = Mode::load1 (valueToFill);)
    #endif
@@ -552,6 +715,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -563,6 +727,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -574,6 +739,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, amount, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
    #endif
@@ -581,6 +747,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, amount, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
 }
@@ -590,6 +757,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src, amount, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -601,6 +769,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsaddD (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src, amount, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -612,6 +781,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -621,6 +791,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -630,6 +801,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -639,6 +811,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (add, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -648,6 +821,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (subtract, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -657,6 +831,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (subtract, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -666,6 +841,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (subtract, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -675,6 +851,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (subtract, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -684,6 +861,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -695,6 +873,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -706,6 +885,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -717,6 +897,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (addWithMultiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -725,6 +906,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (subtractWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -732,6 +914,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (subtractWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -739,6 +922,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, co
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (subtractWithMultiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -746,6 +930,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (subtractWithMultiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -756,6 +941,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -765,6 +951,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, src, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -774,6 +961,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -783,6 +971,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -792,6 +981,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, multiplier, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -802,6 +992,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (multiply, dest, multiplier, num)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -809,6 +1000,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -816,6 +1008,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (copyWithMultiply, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -844,6 +1037,7 @@ void FloatVectorOperations::abs (float* dest, const float* src, int num) noexcep
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (abs, dest, src, num)
     FloatVectorHelpers::signMask32 signMask;
     signMask.i = 0x7fffffffUL;
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = std::abs (src[i]), Mode::bit_and (s, mask),
@@ -859,6 +1053,7 @@ void FloatVectorOperations::abs (double* dest, const double* src, int num) noexc
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (abs, dest, src, num)
     FloatVectorHelpers::signMask64 signMask;
     signMask.i = 0x7fffffffffffffffULL;
 
@@ -877,6 +1072,7 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
                                   vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, )
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (convertFixedToFloat, dest, src, multiplier, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
                                   Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)))),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
@@ -886,6 +1082,7 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
 
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (min, dest, src, comp, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -893,6 +1090,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (min, dest, src, comp, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -903,6 +1101,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (min, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -912,12 +1111,14 @@ void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (min, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (max, dest, src, comp, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -925,6 +1126,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_DISPATCH_WIDE_VEC_OP (max, dest, src, comp, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -935,6 +1137,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (max, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -944,6 +1147,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (max, dest, src1, src2, num)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -955,6 +1159,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (float* dest, const float* src, f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (clip, dest, src, low, high, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
@@ -968,6 +1173,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_DISPATCH_WIDE_VEC_OP (clip, dest, src, low, high, num)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType lo = Mode::load1 (low); const Mode::ParallelType hi = Mode::load1 (high);)
@@ -977,6 +1183,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinAndMax, src, num)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
    #else
     return Range<float>::findMinAndMax (src, num);
@@ -986,6 +1193,7 @@ Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* sr
 Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinAndMax, src, num)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
    #else
     return Range<double>::findMinAndMax (src, num);
@@ -995,6 +1203,7 @@ Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double*
 float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinOrMax, src, num, true)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
    #else
     return juce::findMinimum (src, num);
@@ -1004,6 +1213,7 @@ float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int nu
 double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinOrMax, src, num, true)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
    #else
     return juce::findMinimum (src, num);
@@ -1013,6 +1223,7 @@ double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int
 float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinOrMax, src, num, false)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
    #else
     return juce::findMaximum (src, num);
@@ -1022,6 +1233,7 @@ float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int nu
 double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_DISPATCH_WIDE_VEC_OP (findMinOrMax, src, num, false)
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
    #else
     return juce::findMaximum (src, num);
@@ -1160,7 +1372,7 @@ public:
             const int num = random.nextInt (range) + 1;
 
             HeapBlock<ValueType> buffer1 (num + 16), buffer2 (num + 16);
-            HeapBlock<int> buffer3 (num + 16);
+            HeapBlock<int> buffer3 (num + 16, true);
 
            #if JUCE_ARM
             ValueType* const data1 = buffer1;
@@ -1233,6 +1445,15 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            FloatVectorOperations::clip (data2, data1, (ValueType) 1, (ValueType) 5, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 5));
+
+            FloatVectorOperations::min (data2, data1, (ValueType) 3, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 3));
+
+            FloatVectorOperations::max (data2, data1, (ValueType) 9, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 9));
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1284,8 +1505,159 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        // Compares the vectorised operations on random data against plain loops, using
+        // odd lengths and offsets so that every path also has to handle its remainders.
+        template <typename Kernels>
+        static void runReferenceTest (UnitTest& u, Random random)
+        {
+            const int num = random.nextInt (600) + 1;
+            const int offset = random.nextInt (16);
+
+            HeapBlock<ValueType> src1 ((size_t) (num + offset), true), src2 ((size_t) (num + offset), true),
+                                 dest ((size_t) (num + offset), true), expected ((size_t) num, true);
+            HeapBlock<int> ints ((size_t) (num + offset), true);
+
+            auto* s1 = src1 + offset;
+            auto* s2 = src2 + offset;
+            auto* d = dest + offset;
+
+            for (int i = 0; i < num; ++i)
+            {
+                s1[i] = (ValueType) (random.nextDouble() * 2000.0 - 1000.0);
+                s2[i] = (ValueType) (random.nextDouble() * 2000.0 - 1000.0);
+                ints[offset + i] = random.nextInt();
+            }
+
+            const auto k = (ValueType) (random.nextDouble() * 4.0 - 2.0);
+
+            auto check = [&] (const ValueType* actual)
+            {
+                for (int i = 0; i < num; ++i)
+                {
+                    if (std::abs (actual[i] - expected[i]) > std::abs (expected[i]) * std::numeric_limits<ValueType>::epsilon() * 4)
+                    {
+                        u.expect (false, "Result differs from the scalar reference at index " + String (i));
+                        return;
+                    }
+                }
+
+                u.expect (true);
+            };
+
+            Kernels::add (d, s1, s2, num);
+            for (int i = 0; i < num; ++i) expected[i] = s1[i] + s2[i];
+            check (d);
+
+            Kernels::subtract (d, s1, s2, num);
+            for (int i = 0; i < num; ++i) expected[i] = s1[i] - s2[i];
+            check (d);
+
+            Kernels::multiply (d, s1, s2, num);
+            for (int i = 0; i < num; ++i) expected[i] = s1[i] * s2[i];
+            check (d);
+
+            Kernels::copyWithMultiply (d, s1, k, num);
+            for (int i = 0; i < num; ++i) expected[i] = s1[i] * k;
+            check (d);
+
+            std::copy (s2, s2 + num, d);
+            Kernels::addWithMultiply (d, s1, k, num);
+            for (int i = 0; i < num; ++i) expected[i] = s2[i] + s1[i] * k;
+            check (d);
+
+            Kernels::abs (d, s1, num);
+            for (int i = 0; i < num; ++i) expected[i] = std::abs (s1[i]);
+            check (d);
+
+            Kernels::copyWithMultiply (d, s1, (ValueType) -1, num);
+            for (int i = 0; i < num; ++i) expected[i] = -s1[i];
+            check (d);
+
+            Kernels::min (d, s1, s2, num);
+            for (int i = 0; i < num; ++i) expected[i] = jmin (s1[i], s2[i]);
+            check (d);
+
+            Kernels::max (d, s1, s2, num);
+            for (int i = 0; i < num; ++i) expected[i] = jmax (s1[i], s2[i]);
+            check (d);
+
+            Kernels::clip (d, s1, (ValueType) -100, (ValueType) 100, num);
+            for (int i = 0; i < num; ++i) expected[i] = jlimit ((ValueType) -100, (ValueType) 100, s1[i]);
+            check (d);
+
+            u.expect (Kernels::findMinimum (s1, num) == juce::findMinimum (s1, num));
+            u.expect (Kernels::findMaximum (s1, num) == juce::findMaximum (s1, num));
+            u.expect (Kernels::findMinAndMax (s1, num) == Range<ValueType>::findMinAndMax (s1, num));
+
+            runConversionReferenceTest<Kernels> (u, d, expected, ints + offset, num);
+        }
+
+        template <typename Kernels>
+        static void runConversionReferenceTest (UnitTest& u, float* d, float* expected, const int* ints, int num)
+        {
+            Kernels::convertFixedToFloat (d, ints, 1.0f / 65536.0f, num);
+            convertFixed (expected, ints, 1.0f / 65536.0f, num);
+            u.expect (buffersMatch (d, expected, num));
+        }
+
+        template <typename Kernels>
+        static void runConversionReferenceTest (UnitTest&, double*, double*, const int*, int) {}
     };
 
+    // Each of these gives the reference test one set of kernels to call, so that the wide
+    // versions can be checked directly rather than only the one that the dispatcher picks.
+    #define JUCE_FORWARD_VEC_OPS(target) \
+        template <typename... Args> static void add (Args... args) noexcept               { target::add (args...); } \
+        template <typename... Args> static void subtract (Args... args) noexcept          { target::subtract (args...); } \
+        template <typename... Args> static void multiply (Args... args) noexcept          { target::multiply (args...); } \
+        template <typename... Args> static void copyWithMultiply (Args... args) noexcept  { target::copyWithMultiply (args...); } \
+        template <typename... Args> static void addWithMultiply (Args... args) noexcept   { target::addWithMultiply (args...); } \
+        template <typename... Args> static void abs (Args... args) noexcept               { target::abs (args...); } \
+        template <typename... Args> static void min (Args... args) noexcept               { target::min (args...); } \
+        template <typename... Args> static void max (Args... args) noexcept               { target::max (args...); } \
+        template <typename... Args> static void clip (Args... args) noexcept              { target::clip (args...); } \
+        template <typename... Args> static void convertFixedToFloat (Args... args) noexcept { target::convertFixedToFloat (args...); } \
+        template <typename Type> static Range<Type> findMinAndMax (const Type* src, int num) noexcept { return target::findMinAndMax (src, num); }
+
+    struct DispatchedKernels
+    {
+        JUCE_FORWARD_VEC_OPS (FloatVectorOperations)
+
+        template <typename Type> static Type findMinimum (const Type* src, int num) noexcept  { return FloatVectorOperations::findMinimum (src, num); }
+        template <typename Type> static Type findMaximum (const Type* src, int num) noexcept  { return FloatVectorOperations::findMaximum (src, num); }
+    };
+
+   #if JUCE_USE_AVX_INTRINSICS
+    struct AVXKernels
+    {
+        JUCE_FORWARD_VEC_OPS (FloatVectorHelpers::AVX)
+
+        template <typename Type> static Type findMinimum (const Type* src, int num) noexcept  { return FloatVectorHelpers::AVX::findMinOrMax (src, num, true); }
+        template <typename Type> static Type findMaximum (const Type* src, int num) noexcept  { return FloatVectorHelpers::AVX::findMinOrMax (src, num, false); }
+    };
+
+    struct AVX512Kernels
+    {
+        JUCE_FORWARD_VEC_OPS (FloatVectorHelpers::AVX512)
+
+        template <typename Type> static Type findMinimum (const Type* src, int num) noexcept  { return FloatVectorHelpers::AVX512::findMinOrMax (src, num, true); }
+        template <typename Type> static Type findMaximum (const Type* src, int num) noexcept  { return FloatVectorHelpers::AVX512::findMinOrMax (src, num, false); }
+    };
+   #endif
+
+    #undef JUCE_FORWARD_VEC_OPS
+
+    template <typename Kernels>
+    void runReferenceTests()
+    {
+        for (int i = 100; --i >= 0;)
+        {
+            TestRunner<float>::runReferenceTest<Kernels> (*this, getRandom());
+            TestRunner<double>::runReferenceTest<Kernels> (*this, getRandom());
+        }
+    }
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1295,6 +1667,31 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("Default dispatch path matches scalar reference");
+        runReferenceTests<DispatchedKernels>();
+
+       #if JUCE_USE_AVX_INTRINSICS
+        if (SystemStats::hasAVX())
+        {
+            beginTest ("AVX kernels match scalar reference");
+            runReferenceTests<AVXKernels>();
+        }
+        else
+        {
+            logMessage ("AVX isn't supported on this machine, skipping");
+        }
+
+        if (SystemStats::hasAVX512F())
+        {
+            beginTest ("AVX-512 kernels match scalar reference");
+            runReferenceTests<AVX512Kernels>();
+        }
+        else
+        {
+            logMessage ("AVX-512 isn't supported on this machine, skipping");
+        }
+       #endif
     }
 };
 
@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file contains the kernels used for the wide (AVX and AVX-512) versions of the
+    FloatVectorOperations functions.
+
+    It gets included once for each instruction set, inside a namespace which has already
+    declared Ops32, Ops64 and JUCE_WIDE_VEC_TARGET, so that each copy can be compiled for
+    its own target while the rest of the library stays runnable on any x86 CPU. Don't
+    include it anywhere else!
+*/
+
+template <typename Type> struct WideModeType;
+template <> struct WideModeType<float>   { using Mode = Ops32; };
+template <> struct WideModeType<double>  { using Mode = Ops64; };
+
+#define JUCE_WIDE_INCREMENT_DEST             dest += Mode::numParallel;
+#define JUCE_WIDE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+#define JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+
+#define JUCE_WIDE_LOAD_NONE
+#define JUCE_WIDE_LOAD_DEST                  const auto d = Mode::loadU (dest);
+#define JUCE_WIDE_LOAD_SRC                   const auto s = Mode::loadU (src);
+#define JUCE_WIDE_LOAD_SRC_DEST              const auto d = Mode::loadU (dest), s = Mode::loadU (src);
+#define JUCE_WIDE_LOAD_SRC1_SRC2             const auto s1 = Mode::loadU (src1), s2 = Mode::loadU (src2);
+#define JUCE_WIDE_LOAD_SRC1_SRC2_DEST        const auto d = Mode::loadU (dest), s1 = Mode::loadU (src1), s2 = Mode::loadU (src2);
+
+// Unlike SSE, unaligned loads and stores cost the same as aligned ones on every CPU that
+// supports AVX when the data happens to be aligned, so there's only one version of each loop.
+#define JUCE_WIDE_VEC_OP(normalOp, vecOp, locals, increment, setupOp) \
+    using Mode = typename WideModeType<Type>::Mode; \
+    setupOp \
+    for (int numLongOps = num / Mode::numParallel; --numLongOps >= 0;) \
+    { \
+        locals \
+        Mode::storeU (dest, vecOp); \
+        increment \
+    } \
+    num &= (Mode::numParallel - 1); \
+    for (int i = 0; i < num; ++i) normalOp;
+
+//==============================================================================
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void fill (Type* dest, Type valueToFill, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = valueToFill, val, JUCE_WIDE_LOAD_NONE, JUCE_WIDE_INCREMENT_DEST,
+                      const auto val = Mode::load1 (valueToFill);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void copyWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = src[i] * multiplier, Mode::mul (mult, s), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto mult = Mode::load1 (multiplier);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void add (Type* dest, Type amount, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_WIDE_LOAD_DEST, JUCE_WIDE_INCREMENT_DEST,
+                      const auto amountToAdd = Mode::load1 (amount);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void add (Type* dest, const Type* src, Type amount, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = src[i] + amount, Mode::add (am, s), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto am = Mode::load1 (amount);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void add (Type* dest, const Type* src, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] += src[i], Mode::add (d, s), JUCE_WIDE_LOAD_SRC_DEST, JUCE_WIDE_INCREMENT_SRC_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void add (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_WIDE_LOAD_SRC1_SRC2, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void subtract (Type* dest, const Type* src, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] -= src[i], Mode::sub (d, s), JUCE_WIDE_LOAD_SRC_DEST, JUCE_WIDE_INCREMENT_SRC_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void subtract (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_WIDE_LOAD_SRC1_SRC2, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void addWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)), JUCE_WIDE_LOAD_SRC_DEST, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto mult = Mode::load1 (multiplier);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void addWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)), JUCE_WIDE_LOAD_SRC1_SRC2_DEST, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void subtractWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)), JUCE_WIDE_LOAD_SRC_DEST, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto mult = Mode::load1 (multiplier);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void subtractWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)), JUCE_WIDE_LOAD_SRC1_SRC2_DEST, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void multiply (Type* dest, const Type* src, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] *= src[i], Mode::mul (d, s), JUCE_WIDE_LOAD_SRC_DEST, JUCE_WIDE_INCREMENT_SRC_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void multiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_WIDE_LOAD_SRC1_SRC2, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void multiply (Type* dest, Type multiplier, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_WIDE_LOAD_DEST, JUCE_WIDE_INCREMENT_DEST,
+                      const auto mult = Mode::load1 (multiplier);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void abs (Type* dest, const Type* src, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = std::abs (src[i]), Mode::abs (s), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST, )
+}
+
+JUCE_WIDE_VEC_TARGET inline void convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
+{
+    using Type = float;
+    JUCE_WIDE_VEC_OP (dest[i] = (float) src[i] * multiplier, Mode::mul (mult, Mode::loadIntsU (src)), JUCE_WIDE_LOAD_NONE, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto mult = Mode::load1 (multiplier);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void min (Type* dest, const Type* src, Type comp, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = jmin (src[i], comp), Mode::min (s, cmp), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto cmp = Mode::load1 (comp);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void min (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_WIDE_LOAD_SRC1_SRC2, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void max (Type* dest, const Type* src, Type comp, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = jmax (src[i], comp), Mode::max (s, cmp), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto cmp = Mode::load1 (comp);)
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void max (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_WIDE_LOAD_SRC1_SRC2, JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST, )
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET void clip (Type* dest, const Type* src, Type low, Type high, int num) noexcept
+{
+    JUCE_WIDE_VEC_OP (dest[i] = jmax (jmin (src[i], high), low), Mode::max (Mode::min (s, hi), lo), JUCE_WIDE_LOAD_SRC, JUCE_WIDE_INCREMENT_SRC_DEST,
+                      const auto lo = Mode::load1 (low); const auto hi = Mode::load1 (high);)
+}
+
+//==============================================================================
+template <typename Type>
+JUCE_WIDE_VEC_TARGET Type findMinOrMax (const Type* src, int num, bool isMinimum) noexcept
+{
+    using Mode = typename WideModeType<Type>::Mode;
+    auto numLongOps = num / Mode::numParallel;
+
+    if (numLongOps <= 1)
+        return isMinimum ? juce::findMinimum (src, num)
+                         : juce::findMaximum (src, num);
+
+    auto val = Mode::loadU (src);
+
+    if (isMinimum)
+    {
+        while (--numLongOps > 0)
+        {
+            src += Mode::numParallel;
+            val = Mode::min (val, Mode::loadU (src));
+        }
+    }
+    else
+    {
+        while (--numLongOps > 0)
+        {
+            src += Mode::numParallel;
+            val = Mode::max (val, Mode::loadU (src));
+        }
+    }
+
+    auto result = isMinimum ? Mode::min (val)
+                            : Mode::max (val);
+
+    num &= (Mode::numParallel - 1);
+    src += Mode::numParallel;
+
+    for (int i = 0; i < num; ++i)
+        result = isMinimum ? jmin (result, src[i])
+                           : jmax (result, src[i]);
+
+    return result;
+}
+
+template <typename Type>
+JUCE_WIDE_VEC_TARGET Range<Type> findMinAndMax (const Type* src, int num) noexcept
+{
+    using Mode = typename WideModeType<Type>::Mode;
+    auto numLongOps = num / Mode::numParallel;
+
+    if (numLongOps <= 1)
+        return Range<Type>::findMinAndMax (src, num);
+
+    auto mn = Mode::loadU (src);
+    auto mx = mn;
+
+    while (--numLongOps > 0)
+    {
+        src += Mode::numParallel;
+        const auto v = Mode::loadU (src);
+        mn = Mode::min (mn, v);
+        mx = Mode::max (mx, v);
+    }
+
+    Range<Type> result (Mode::min (mn),
+                        Mode::max (mx));
+
+    num &= (Mode::numParallel - 1);
+    src += Mode::numParallel;
+
+    for (int i = 0; i < num; ++i)
+        result = result.getUnionWith (src[i]);
+
+    return result;
+}
+
+#undef JUCE_WIDE_VEC_OP
+#undef JUCE_WIDE_LOAD_NONE
+#undef JUCE_WIDE_LOAD_DEST
+#undef JUCE_WIDE_LOAD_SRC
+#undef JUCE_WIDE_LOAD_SRC_DEST
+#undef JUCE_WIDE_LOAD_SRC1_SRC2
+#undef JUCE_WIDE_LOAD_SRC1_SRC2_DEST
+#undef JUCE_WIDE_INCREMENT_DEST
+#undef JUCE_WIDE_INCREMENT_SRC_DEST
+#undef JUCE_WIDE_INCREMENT_SRC1_SRC2_DEST
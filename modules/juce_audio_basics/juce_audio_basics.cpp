@@ -37,6 +37,16 @@
 
 #if JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
+
+ // The AVX versions of the FloatVectorOperations are compiled using per-function target
+ // attributes and chosen at runtime, so they need a compiler that supports that.
+ #if ! defined (JUCE_USE_AVX_INTRINSICS) && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && (__GNUC__ * 100 + __GNUC_MINOR__) >= 409))
+  #define JUCE_USE_AVX_INTRINSICS 1
+ #endif
+
+ #if JUCE_USE_AVX_INTRINSICS
+  #include <immintrin.h>
+ #endif
 #endif
 
 #ifndef JUCE_USE_VDSP_FRAMEWORK
@@ -61,6 +71,7 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
@@ -85,4 +96,6 @@
 #include "sources/juce_ResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
+#include "synthesisers/juce_ParallelVoiceRenderer.cpp"
+#include "synthesisers/juce_VoiceNoteTable.cpp"
 #include "synthesisers/juce_Synthesiser.cpp"
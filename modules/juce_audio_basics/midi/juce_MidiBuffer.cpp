@@ -71,7 +71,8 @@ namespace MidiBufferHelpers
         return 0;
     }
 
-    static uint8* findEventAfter (uint8* d, uint8* endData, int samplePosition) noexcept
+    template <typename DataPointer>
+    static DataPointer findEventAfter (DataPointer d, DataPointer endData, int samplePosition) noexcept
     {
         while (d < endData && getEventTime (d) <= samplePosition)
             d += getEventTotalSize (d);
@@ -102,14 +103,81 @@ MidiBufferIterator::reference MidiBufferIterator::operator*() const noexcept
 }
 
 //==============================================================================
+// A run of events from another buffer that's being merged into this one
+struct MidiBuffer::EventRange
+{
+    const uint8* next;
+    const uint8* end;
+    int sampleDelta;
+};
+
 MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
 {
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
-void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
-void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
+MidiBuffer::MidiBuffer (const MidiBuffer& other)
+    : data (other.data),
+      lastEventOffset (other.lastEventOffset),
+      fixedCapacity (other.fixedCapacity)
+{
+    data.ensureStorageAllocated (fixedCapacity);
+}
+
+MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other)
+{
+    if (this != &other)
+    {
+        data.clearQuick();
+        lastEventOffset = -1;
+
+        if (hasSpaceFor (other.data.size()))
+        {
+            data.addArray (other.data.begin(), other.data.size());
+            lastEventOffset = other.lastEventOffset;
+        }
+        else
+        {
+            EventRange range { other.data.begin(), other.data.end(), 0 };
+            mergeEvents (&range, 1);
+        }
+    }
+
+    return *this;
+}
+
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    std::swap (lastEventOffset, other.lastEventOffset);
+    std::swap (fixedCapacity, other.fixedCapacity);
+    std::swap (numDroppedEvents, other.numDroppedEvents);
+}
+
+void MidiBuffer::clear() noexcept
+{
+    data.clearQuick();
+    lastEventOffset = -1;
+    numDroppedEvents = 0;
+}
+
+void MidiBuffer::ensureSize (size_t minimumNumBytes)
+{
+    data.ensureStorageAllocated ((int) minimumNumBytes);
+
+    if (fixedCapacity > 0)
+        fixedCapacity = jmax (fixedCapacity, (int) minimumNumBytes);
+}
+
+void MidiBuffer::setFixedCapacity (size_t numBytes)
+{
+    // The buffer already holds more than this!
+    jassert ((int) numBytes == 0 || data.size() <= (int) numBytes);
+
+    fixedCapacity = (int) numBytes;
+    data.ensureStorageAllocated (fixedCapacity);
+}
+
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
 void MidiBuffer::clear (int startSample, int numSamples)
@@ -117,46 +185,230 @@ void MidiBuffer::clear (int startSample, int numSamples)
     auto start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     auto end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - data.begin()));
+    if (fixedCapacity > 0)
+    {
+        // Array releases storage after a removal, so a fixed-capacity buffer moves its later
+        // events down itself, and then shortens the array without touching its storage.
+        if (end > start)
+        {
+            auto newSize = data.size() - (int) (end - start);
+            memmove (start, end, (size_t) (data.end() - end));
+
+            data.clearQuick();
+            data.addArray (reinterpret_cast<const char*> (data.begin()), newSize);
+        }
+    }
+    else
+    {
+        data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    }
+
+    lastEventOffset = -1;
+}
+
+bool MidiBuffer::canAppend (int sampleNumber) const noexcept
+{
+    auto size = data.size();
+
+    if (size == 0)
+        return true;
+
+    // The position of the last event is only a hint, as the data may have been
+    // changed directly, so check that it really does lead to the end of the buffer
+    if (lastEventOffset < 0 || lastEventOffset + (int) (sizeof (int32) + sizeof (uint16)) > size)
+        return false;
+
+    auto* lastEvent = data.begin() + lastEventOffset;
+
+    return lastEventOffset + MidiBufferHelpers::getEventTotalSize (lastEvent) == size
+            && MidiBufferHelpers::getEventTime (lastEvent) <= sampleNumber;
+}
+
+bool MidiBuffer::hasSpaceFor (int numBytes) const noexcept
+{
+    return fixedCapacity == 0 || data.size() + numBytes <= fixedCapacity;
 }
 
-void MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
+bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
 {
-    addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+    return addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
 }
 
-void MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
+bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
 {
     auto numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
 
-    if (numBytes > 0)
-    {
-        auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
-        auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
+    if (numBytes <= 0)
+        return false;
 
-        data.insertMultiple (offset, 0, (int) newItemSize);
+    auto newItemSize = numBytes + (int) (sizeof (int32) + sizeof (uint16));
 
-        auto* d = data.begin() + offset;
-        writeUnaligned<int32>  (d, sampleNumber);
-        d += sizeof (int32);
-        writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
-        d += sizeof (uint16);
-        memcpy (d, newData, (size_t) numBytes);
+    if (! hasSpaceFor (newItemSize))
+    {
+        ++numDroppedEvents;
+        return false;
     }
+
+    auto offset = canAppend (sampleNumber) ? data.size()
+                                           : (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
+
+    if (offset == data.size())
+        lastEventOffset = offset;
+    else if (lastEventOffset >= offset)
+        lastEventOffset += newItemSize;
+
+    data.insertMultiple (offset, 0, newItemSize);
+
+    auto* d = data.begin() + offset;
+    writeUnaligned<int32>  (d, sampleNumber);
+    d += sizeof (int32);
+    writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+    d += sizeof (uint16);
+    memcpy (d, newData, (size_t) numBytes);
+
+    return true;
 }
 
 void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             int startSample, int numSamples, int sampleDeltaToAdd)
 {
-    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    jassert (&otherBuffer != this);
+
+    auto* otherEnd = otherBuffer.data.end();
+    auto* first = MidiBufferHelpers::findEventAfter (otherBuffer.data.begin(), otherEnd, startSample - 1);
+    auto* last  = numSamples < 0 ? otherEnd
+                                 : MidiBufferHelpers::findEventAfter (first, otherEnd, startSample + numSamples - 1);
+
+    EventRange range { first, last, sampleDeltaToAdd };
+    mergeEvents (&range, 1);
+}
+
+void MidiBuffer::addEvents (const MidiBuffer* const* otherBuffers, int numOtherBuffers,
+                            int startSample, int numSamples)
+{
+    // Buffers are merged in batches, so that the ranges can live on the stack
+    constexpr int maxRangesPerMerge = 16;
+    EventRange ranges[maxRangesPerMerge];
+    int numRanges = 0;
+
+    for (int i = 0; i < numOtherBuffers; ++i)
     {
-        const auto metadata = *i;
+        if (auto* other = otherBuffers[i])
+        {
+            jassert (other != this);
+
+            auto* otherEnd = other->data.end();
+            auto* first = MidiBufferHelpers::findEventAfter (other->data.begin(), otherEnd, startSample - 1);
+            auto* last  = numSamples < 0 ? otherEnd
+                                         : MidiBufferHelpers::findEventAfter (first, otherEnd, startSample + numSamples - 1);
+
+            if (first < last)
+                ranges[numRanges++] = { first, last, 0 };
+        }
+
+        if (numRanges == maxRangesPerMerge)
+        {
+            mergeEvents (ranges, numRanges);
+            numRanges = 0;
+        }
+    }
 
-        if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
+    if (numRanges > 0)
+        mergeEvents (ranges, numRanges);
+}
+
+void MidiBuffer::mergeEvents (EventRange* ranges, int numRanges)
+{
+    using namespace MidiBufferHelpers;
+
+    int numBytesToAdd = 0;
+    auto earliestTime = std::numeric_limits<int>::max();
+
+    for (int i = 0; i < numRanges; ++i)
+    {
+        auto& range = ranges[i];
+
+        if (range.next < range.end)
+        {
+            numBytesToAdd += (int) (range.end - range.next);
+            earliestTime = jmin (earliestTime, getEventTime (range.next) + range.sampleDelta);
+        }
+    }
+
+    if (numBytesToAdd == 0)
+        return;
+
+    if (! hasSpaceFor (numBytesToAdd))
+    {
+        // Not everything will fit, so add the events one at a time to keep as many as possible
+        for (int i = 0; i < numRanges; ++i)
+            for (auto* e = ranges[i].next; e < ranges[i].end; e += getEventTotalSize (e))
+                addEvent (e + sizeof (int32) + sizeof (uint16), getEventDataSize (e), getEventTime (e) + ranges[i].sampleDelta);
+
+        return;
+    }
+
+    // Any events up to the earliest new one can stay where they are. The rest get moved
+    // up to make room, and are then merged back down along with the new events, which
+    // can never overwrite an event that hasn't been read yet.
+    auto oldSize = data.size();
+    auto splitOffset = canAppend (earliestTime) ? oldSize
+                                                : (int) (findEventAfter (data.begin(), data.end(), earliestTime) - data.begin());
+
+    data.insertMultiple (splitOffset, 0, numBytesToAdd);
+
+    auto* dest = data.begin() + splitOffset;
+    auto* existing = dest + numBytesToAdd;
+    auto* existingEnd = data.end();
+    uint8* lastWritten = nullptr;
+
+    for (;;)
+    {
+        EventRange* nextRange = nullptr;
+        int nextTime = 0;
+
+        for (int i = 0; i < numRanges; ++i)
+        {
+            auto& range = ranges[i];
+
+            if (range.next < range.end)
+            {
+                auto time = getEventTime (range.next) + range.sampleDelta;
+
+                if (nextRange == nullptr || time < nextTime)
+                {
+                    nextRange = &range;
+                    nextTime = time;
+                }
+            }
+        }
+
+        if (nextRange == nullptr)
             break;
 
-        addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd);
+        while (existing < existingEnd && getEventTime (existing) <= nextTime)
+        {
+            auto size = getEventTotalSize (existing);
+            memmove (dest, existing, size);
+            lastWritten = dest;
+            dest += size;
+            existing += size;
+        }
+
+        auto size = getEventTotalSize (nextRange->next);
+        memcpy (dest, nextRange->next, size);
+        writeUnaligned<int32> (dest, nextTime);
+        lastWritten = dest;
+        dest += size;
+        nextRange->next += size;
     }
+
+    jassert (dest == existing);
+
+    if (existing < existingEnd)
+        lastEventOffset += numBytesToAdd;
+    else
+        lastEventOffset = (int) (lastWritten - data.begin());
 }
 
 int MidiBuffer::getNumEvents() const noexcept
@@ -180,6 +432,9 @@ int MidiBuffer::getLastEventTime() const noexcept
     if (data.size() == 0)
         return 0;
 
+    if (canAppend (std::numeric_limits<int>::max()))
+        return MidiBufferHelpers::getEventTime (data.begin() + lastEventOffset);
+
     auto endData = data.end();
 
     for (auto d = data.begin();;)
@@ -237,4 +492,323 @@ bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePositio
     return true;
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiBufferTests  : public UnitTest
+{
+    MidiBufferTests()
+        : UnitTest ("MidiBuffer", UnitTestCategories::midi)
+    {}
+
+    static Array<int> getTimes (const MidiBuffer& buffer)
+    {
+        Array<int> times;
+
+        for (const auto metadata : buffer)
+            times.add (metadata.samplePosition);
+
+        return times;
+    }
+
+    static Array<int> getNotes (const MidiBuffer& buffer)
+    {
+        Array<int> notes;
+
+        for (const auto metadata : buffer)
+            notes.add (metadata.getMessage().getNoteNumber());
+
+        return notes;
+    }
+
+    static MidiBuffer createRandomBuffer (Random& r, int numEvents, int firstNote)
+    {
+        MidiBuffer buffer;
+
+        for (int i = 0; i < numEvents; ++i)
+            buffer.addEvent (MidiMessage::noteOn (1, (firstNote + i) % 128, (uint8) 100), r.nextInt (64));
+
+        return buffer;
+    }
+
+    // The reference behaviour: adding every event one at a time, in source order
+    static MidiBuffer mergeSlowly (const MidiBuffer& existing, const Array<MidiBuffer>& sources)
+    {
+        auto result = existing;
+
+        for (auto& source : sources)
+            for (const auto metadata : source)
+                result.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+
+        return result;
+    }
+
+    void expectSameEvents (const MidiBuffer& a, const MidiBuffer& b)
+    {
+        expect (a.data == b.data);
+        expectEquals (a.getNumEvents(), b.getNumEvents());
+        expectEquals (a.getLastEventTime(), b.getLastEventTime());
+    }
+
+    void runTest() override
+    {
+        beginTest ("Events are kept in time order, with ties in the order they were added");
+        {
+            MidiBuffer buffer;
+
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 1, (uint8) 1), 10));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 2, (uint8) 1), 20));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 3, (uint8) 1), 5));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 4, (uint8) 1), 10));
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 5, (uint8) 1), 20));
+
+            expect (getTimes (buffer) == Array<int> (5, 10, 10, 20, 20));
+            expect (getNotes (buffer) == Array<int> (3, 1, 4, 2, 5));
+            expectEquals (buffer.getFirstEventTime(), 5);
+            expectEquals (buffer.getLastEventTime(), 20);
+
+            const uint8 invalidData[] = { 0x10, 0x20 };
+            expect (! buffer.addEvent (invalidData, 2, 0));
+            expectEquals (buffer.getNumEvents(), 5);
+        }
+
+        beginTest ("Last event time survives direct changes to the data");
+        {
+            MidiBuffer buffer;
+
+            for (int i = 0; i < 10; ++i)
+                buffer.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), i);
+
+            buffer.clear (5, 3);
+            expect (getTimes (buffer) == Array<int> (0, 1, 2, 3, 4, 8, 9));
+            buffer.clear (5, 10);
+            expectEquals (buffer.getLastEventTime(), 4);
+
+            buffer.data.removeRange (0, 9); // the first note-on
+            buffer.addEvent (MidiMessage::noteOn (1, 100, (uint8) 1), 2);
+            expect (getTimes (buffer) == Array<int> (1, 2, 2, 3, 4));
+            expectEquals (buffer.getLastEventTime(), 4);
+
+            buffer.data.clearQuick();
+            buffer.addEvent (MidiMessage::noteOn (1, 100, (uint8) 1), 7);
+            expect (getTimes (buffer) == Array<int> (7));
+        }
+
+        beginTest ("A fixed capacity drops events rather than allocating");
+        {
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (30);
+            expectEquals ((int) buffer.getFixedCapacity(), 30);
+
+            auto* storage = buffer.data.begin();
+            int numAdded = 0;
+
+            for (int i = 0; i < 10; ++i)
+                if (buffer.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), 10 - i))
+                    ++numAdded;
+
+            expectEquals (numAdded, 3);
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getNumDroppedEvents(), 7);
+            expect (buffer.data.begin() == storage);
+
+            MidiBuffer source;
+
+            for (int i = 0; i < 10; ++i)
+                source.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), i);
+
+            buffer = source;
+            expectEquals (buffer.getNumEvents(), 3);
+            expect (getTimes (buffer) == Array<int> (0, 1, 2));
+            expect (buffer.data.begin() == storage);
+
+            buffer.clear();
+            expectEquals (buffer.getNumDroppedEvents(), 0);
+            buffer.addEvents (source, 0, -1, 0);
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getNumDroppedEvents(), 7);
+
+            MidiBuffer copy (buffer);
+            expectEquals ((int) copy.getFixedCapacity(), 30);
+            expectSameEvents (copy, buffer);
+
+            buffer.ensureSize (100);
+            expectEquals ((int) buffer.getFixedCapacity(), 100);
+        }
+
+        beginTest ("Clearing a time range keeps a fixed capacity buffer's storage");
+        {
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (1000);
+            auto* storage = buffer.data.begin();
+
+            for (int i = 0; i < 100; ++i)
+                expect (buffer.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), i));
+
+            buffer.clear (0, 95);
+            expect (getTimes (buffer) == Array<int> (95, 96, 97, 98, 99));
+            expect (buffer.data.begin() == storage);
+
+            buffer.clear (96, 2);
+            expect (getTimes (buffer) == Array<int> (95, 98, 99));
+            expect (getNotes (buffer) == Array<int> (95, 98, 99));
+            expectEquals (buffer.getLastEventTime(), 99);
+
+            for (int i = 0; i < 100; ++i)
+                buffer.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), i);
+
+            expectEquals (buffer.getNumEvents(), 103);
+            expectEquals (buffer.getNumDroppedEvents(), 0);
+            expect (buffer.data.begin() == storage);
+        }
+
+        beginTest ("Adding a time range from another buffer");
+        {
+            MidiBuffer source, buffer;
+
+            for (int i = 0; i < 10; ++i)
+                source.addEvent (MidiMessage::noteOn (1, i, (uint8) 1), i * 10);
+
+            buffer.addEvent (MidiMessage::noteOn (1, 100, (uint8) 1), 25);
+            buffer.addEvents (source, 20, 30, 5);
+
+            expect (getTimes (buffer) == Array<int> (25, 25, 35, 45));
+            expect (getNotes (buffer) == Array<int> (100, 2, 3, 4));
+        }
+
+        beginTest ("Merging many buffers matches adding their events one at a time");
+        {
+            auto r = getRandom();
+
+            for (int trial = 0; trial < 50; ++trial)
+            {
+                auto existing = createRandomBuffer (r, r.nextInt (20), 0);
+                Array<MidiBuffer> sources;
+                Array<const MidiBuffer*> sourcePointers;
+
+                for (int i = r.nextInt (40); --i >= 0;)
+                    sources.add (createRandomBuffer (r, r.nextInt (10), i * 3));
+
+                for (auto& source : sources)
+                    sourcePointers.add (&source);
+
+                sourcePointers.add (nullptr);
+
+                auto merged = existing;
+                merged.addEvents (sourcePointers.getRawDataPointer(), sourcePointers.size(), 0, -1);
+
+                auto expected = mergeSlowly (existing, sources);
+                expectSameEvents (merged, expected);
+
+                merged.addEvent (MidiMessage::noteOn (1, 1, (uint8) 1), 1000);
+                expected.addEvent (MidiMessage::noteOn (1, 1, (uint8) 1), 1000);
+                expectSameEvents (merged, expected);
+            }
+        }
+
+        beginTest ("Merging a time range from many buffers matches adding it from each buffer in turn");
+        {
+            auto r = getRandom();
+
+            for (int trial = 0; trial < 50; ++trial)
+            {
+                auto existing = createRandomBuffer (r, r.nextInt (20), 0);
+                Array<MidiBuffer> sources;
+                Array<const MidiBuffer*> sourcePointers;
+
+                for (int i = r.nextInt (40); --i >= 0;)
+                    sources.add (createRandomBuffer (r, r.nextInt (10), i * 3));
+
+                for (auto& source : sources)
+                    sourcePointers.add (&source);
+
+                auto startSample = r.nextInt (32);
+                auto numSamples = r.nextInt (40) - 4;
+
+                auto merged = existing;
+                merged.addEvents (sourcePointers.getRawDataPointer(), sourcePointers.size(), startSample, numSamples);
+
+                auto expected = existing;
+
+                for (auto& source : sources)
+                    expected.addEvents (source, startSample, numSamples, 0);
+
+                expectSameEvents (merged, expected);
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            auto timeMilliseconds = [] (std::function<void()> function)
+            {
+                auto start = Time::getHighResolutionTicks();
+                function();
+                return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0;
+            };
+
+            const int numEvents = 8192;
+            MidiBuffer appended;
+
+            auto appendTime = timeMilliseconds ([&]
+            {
+                for (int i = 0; i < numEvents; ++i)
+                    appended.addEvent (MidiMessage::channelPressureChange (2 + i % 15, i & 127), i / 16);
+            });
+
+            logMessage ("Appending " + String (numEvents) + " events in order: " + String (appendTime, 2) + " ms");
+
+            // Eight MPE sources, each sending 768 per-note expression messages in a 512-sample block
+            Array<MidiBuffer> sources;
+            Array<const MidiBuffer*> sourcePointers;
+
+            for (int source = 0; source < 8; ++source)
+            {
+                MidiBuffer buffer;
+
+                for (int i = 0; i < 768; ++i)
+                    buffer.addEvent (MidiMessage::pitchWheel (2 + (source + i) % 15, (i * 37) & 16383), (i * 2 + source) / 3);
+
+                sources.add (buffer);
+            }
+
+            for (auto& source : sources)
+                sourcePointers.add (&source);
+
+            const int numBlocks = 100;
+            MidiBuffer oneAtATime, merged;
+
+            auto oneAtATimeTime = timeMilliseconds ([&]
+            {
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    oneAtATime.clear();
+
+                    for (auto& source : sources)
+                        oneAtATime.addEvents (source, 0, 512, 0);
+                }
+            });
+
+            auto mergedTime = timeMilliseconds ([&]
+            {
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    merged.clear();
+                    merged.addEvents (sourcePointers.getRawDataPointer(), sourcePointers.size(), 0, 512);
+                }
+            });
+
+            expectSameEvents (merged, oneAtATime);
+
+            logMessage ("Merging 8 MPE buffers of 768 events, " + String (numBlocks) + " blocks: one buffer at a time "
+                          + String (oneAtATimeTime, 2) + " ms, all at once " + String (mergedTime, 2) + " ms");
+        }
+    }
+};
+
+static MidiBufferTests midiBufferTests;
+
+#endif
+
 } // namespace juce
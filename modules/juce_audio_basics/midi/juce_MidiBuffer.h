@@ -137,6 +137,11 @@ private:
     appropriate container. MidiBuffer is designed for lower-level streams of raw
     midi data.
 
+    Adding events in time order is cheap, as each one just gets appended to the end
+    of the buffer, and other buffers can be merged in with a single pass using
+    addEvents(). To use a buffer on the audio thread without any risk of allocating,
+    give it a fixed capacity with setFixedCapacity().
+
     @see MidiMessage
 
     @tags{Audio}
@@ -151,14 +156,37 @@ public:
     /** Creates a MidiBuffer containing a single midi message. */
     explicit MidiBuffer (const MidiMessage& message) noexcept;
 
+    /** Creates a copy of another buffer, including its fixed capacity if it has one. */
+    MidiBuffer (const MidiBuffer&);
+
+    /** Replaces the events in this buffer with a copy of the ones in another buffer.
+
+        This reuses the buffer's existing storage, so it won't allocate if the buffer is
+        already big enough. If this buffer has a fixed capacity, any events that don't
+        fit are dropped.
+    */
+    MidiBuffer& operator= (const MidiBuffer&);
+
+    /** Move constructor. */
+    MidiBuffer (MidiBuffer&&) noexcept = default;
+
+    /** Move assignment operator. */
+    MidiBuffer& operator= (MidiBuffer&&) noexcept = default;
+
     //==============================================================================
-    /** Removes all events from the buffer. */
+    /** Removes all events from the buffer.
+
+        This also resets the count returned by getNumDroppedEvents().
+    */
     void clear() noexcept;
 
     /** Removes all events between two times from the buffer.
 
         All events for which (start <= event position < start + numSamples) will
-        be removed.
+        be removed. Note that this may release some of the buffer's storage, unless
+        the buffer has a fixed capacity.
+
+        @see setFixedCapacity
     */
     void clear (int start, int numSamples);
 
@@ -183,10 +211,14 @@ public:
 
         If an event is added whose sample position is the same as one or more events
         already in the buffer, the new event will be placed after the existing ones.
+        An event that's no earlier than the last one in the buffer is simply appended.
+
+        Returns false if the event couldn't be added because the buffer has a fixed
+        capacity and is full.
 
         To retrieve events, use a MidiBufferIterator object
     */
-    void addEvent (const MidiMessage& midiMessage, int sampleNumber);
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
     /** Adds an event to the buffer from raw midi data.
 
@@ -202,9 +234,12 @@ public:
         it'll actually only store 3 bytes. If the midi data is invalid, it might not
         add an event at all.
 
+        Returns false if no event was added, either because the data was invalid or
+        because the buffer has a fixed capacity and is full.
+
         To retrieve events, use a MidiBufferIterator object
     */
-    void addEvent (const void* rawMidiData,
+    bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
                    int sampleNumber);
 
@@ -221,12 +256,34 @@ public:
                                     startSample will be taken.
         @param sampleDeltaToAdd     a value which will be added to the source timestamps of the events
                                     that are added to this buffer
+
+        The events are merged in with a single pass over the two buffers. Source events
+        that have the same position as events already in this buffer are placed after them.
     */
     void addEvents (const MidiBuffer& otherBuffer,
                     int startSample,
                     int numSamples,
                     int sampleDeltaToAdd);
 
+    /** Merges the events in a time range from a set of other buffers into this one.
+
+        This does a single k-way merge of all the buffers, which is much quicker than
+        adding them one at a time. Events with the same position are ordered by the
+        buffer they came from - any that were already in this buffer come first,
+        followed by those from otherBuffers[0], otherBuffers[1], etc.
+
+        None of the other buffers can be this buffer, and any of them may be nullptr.
+
+        @param otherBuffers         the buffers containing the events to add
+        @param numOtherBuffers      the number of buffers in otherBuffers
+        @param startSample          the lowest sample number to copy from the other buffers
+        @param numSamples           the number of samples to copy from each buffer, starting
+                                    at startSample. If this is less than 0, all events after
+                                    startSample will be taken.
+    */
+    void addEvents (const MidiBuffer* const* otherBuffers, int numOtherBuffers,
+                    int startSample, int numSamples);
+
     /** Returns the sample number of the first event in the buffer.
         If the buffer's empty, this will just return 0.
     */
@@ -248,9 +305,33 @@ public:
     /** Preallocates some memory for the buffer to use.
         This helps to avoid needing to reallocate space when the buffer has messages
         added to it.
+
+        If the buffer has a fixed capacity that's smaller than this, the capacity is
+        increased to match.
     */
     void ensureSize (size_t minimumNumBytes);
 
+    /** Allocates a fixed amount of storage, after which the buffer will never allocate.
+
+        Once a buffer has a fixed capacity, adding, merging or copying events into it
+        is real-time safe: any event that doesn't fit is dropped rather than making the
+        buffer grow, and is counted by getNumDroppedEvents(). Each event takes up the
+        size of its midi data plus 6 bytes.
+
+        Passing 0 lets the buffer grow again whenever it needs to.
+    */
+    void setFixedCapacity (size_t numBytes);
+
+    /** Returns the capacity set with setFixedCapacity(), or 0 if the buffer can grow. */
+    size_t getFixedCapacity() const noexcept                    { return (size_t) fixedCapacity; }
+
+    /** Returns the number of events that have been dropped since the buffer was last
+        cleared because it was full.
+
+        @see setFixedCapacity
+    */
+    int getNumDroppedEvents() const noexcept                    { return numDroppedEvents; }
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -340,6 +421,14 @@ public:
     Array<uint8> data;
 
 private:
+    struct EventRange;
+
+    bool canAppend (int sampleNumber) const noexcept;
+    bool hasSpaceFor (int numBytes) const noexcept;
+    void mergeEvents (EventRange*, int numRanges);
+
+    int lastEventOffset = -1, fixedCapacity = 0, numDroppedEvents = 0;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
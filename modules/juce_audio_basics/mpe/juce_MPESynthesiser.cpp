@@ -45,6 +45,14 @@ void MPESynthesiser::startVoice (MPESynthesiserVoice* voice, MPENote noteToStart
 
     voice->currentlyPlayingNote = noteToStart;
     voice->noteOnTime = lastNoteOnCounter++;
+
+    // (a subclass may have changed the voice list directly, in which case the indexes need updating)
+    if (voices[voice->voiceIndex] != voice || voiceNoteTable.getNumVoices() != voices.size())
+        updateVoiceNoteTable();
+
+    if (voices[voice->voiceIndex] == voice)
+        voiceNoteTable.setVoiceNote (voice->voiceIndex, noteToStart.initialNote);
+
     voice->noteStarted();
 }
 
@@ -69,68 +77,70 @@ void MPESynthesiser::notePressureChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice& voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->notePressureChanged();
-        }
-    }
+        voice.currentlyPlayingNote = changedNote;
+        voice.notePressureChanged();
+    });
 }
 
 void MPESynthesiser::notePitchbendChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice& voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->notePitchbendChanged();
-        }
-    }
+        voice.currentlyPlayingNote = changedNote;
+        voice.notePitchbendChanged();
+    });
 }
 
 void MPESynthesiser::noteTimbreChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice& voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->noteTimbreChanged();
-        }
-    }
+        voice.currentlyPlayingNote = changedNote;
+        voice.noteTimbreChanged();
+    });
 }
 
 void MPESynthesiser::noteKeyStateChanged (MPENote changedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (changedNote, [&] (MPESynthesiserVoice& voice)
     {
-        if (voice->isCurrentlyPlayingNote (changedNote))
-        {
-            voice->currentlyPlayingNote = changedNote;
-            voice->noteKeyStateChanged();
-        }
-    }
+        voice.currentlyPlayingNote = changedNote;
+        voice.noteKeyStateChanged();
+    });
 }
 
 void MPESynthesiser::noteReleased (MPENote finishedNote)
 {
     const ScopedLock sl (voicesLock);
 
-    for (auto i = voices.size(); --i >= 0;)
+    forEachVoicePlayingNote (finishedNote, [&] (MPESynthesiserVoice& voice)
+    {
+        stopVoice (&voice, finishedNote, true);
+    });
+}
+
+template <typename Callback>
+void MPESynthesiser::forEachVoicePlayingNote (MPENote note, Callback&& callback)
+{
+    // (the voice list is protected, so this catches any subclasses that have changed it directly)
+    if (voiceNoteTable.getNumVoices() != voices.size())
+        updateVoiceNoteTable();
+
+    for (auto i = voiceNoteTable.getFirstVoiceForNote (note.initialNote); i >= 0;)
     {
         auto* voice = voices.getUnchecked (i);
+        i = voiceNoteTable.getNextVoiceForSameNote (i);
 
-        if (voice->isCurrentlyPlayingNote(finishedNote))
-            stopVoice (voice, finishedNote, true);
+        if (voice->isCurrentlyPlayingNote (note))
+            callback (*voice);
     }
 }
 
@@ -172,6 +182,11 @@ MPESynthesiserVoice* MPESynthesiser::findFreeVoice (MPENote noteToFindVoiceFor,
     return nullptr;
 }
 
+static bool isOlderVoice (const MPESynthesiserVoice* voice, const MPESynthesiserVoice* oldestSoFar) noexcept
+{
+    return oldestSoFar == nullptr || voice->noteOnTime < oldestSoFar->noteOnTime;
+}
+
 MPESynthesiserVoice* MPESynthesiser::findVoiceToSteal (MPENote noteToStealVoiceFor) const
 {
     // This voice-stealing algorithm applies the following heuristics:
@@ -186,25 +201,10 @@ MPESynthesiserVoice* MPESynthesiser::findVoiceToSteal (MPENote noteToStealVoiceF
     MPESynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     MPESynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // this is a list of voices we can steal, sorted by how long they've been running
-    Array<MPESynthesiserVoice*> usableVoices;
-    usableVoices.ensureStorageAllocated (voices.size());
-
     for (auto* voice : voices)
     {
         jassert (voice->isActive()); // We wouldn't be here otherwise
 
-        usableVoices.add (voice);
-
-        // NB: Using a functor rather than a lambda here due to scare-stories about
-        // compilers generating code containing heap allocations..
-        struct Sorter
-        {
-            bool operator() (const MPESynthesiserVoice* a, const MPESynthesiserVoice* b) const noexcept { return a->noteOnTime < b->noteOnTime; }
-        };
-
-        std::sort (usableVoices.begin(), usableVoices.end(), Sorter());
-
         if (! voice->isPlayingButReleased()) // Don't protect released notes
         {
             auto noteNumber = voice->getCurrentlyPlayingNote().initialNote;
@@ -221,28 +221,38 @@ MPESynthesiserVoice* MPESynthesiser::findVoiceToSteal (MPENote noteToStealVoiceF
     if (top == low)
         top = nullptr;
 
-    // If we want to re-use the voice to trigger a new note,
-    // then The oldest note that's playing the same note number is ideal.
-    if (noteToStealVoiceFor.isValid())
-        for (auto* voice : usableVoices)
-            if (voice->getCurrentlyPlayingNote().initialNote == noteToStealVoiceFor.initialNote)
-                return voice;
+    // Rather than sorting the voices by age, this finds the oldest one in each of
+    // these categories, in order of preference:
+    MPESynthesiserVoice* oldestWithSameNote = nullptr; // If we want to re-use the voice to trigger a new note, then the oldest note that's playing the same note number is ideal
+    MPESynthesiserVoice* oldestReleased = nullptr;     // Oldest voice that has been released (no finger on it and not held by sustain pedal)
+    MPESynthesiserVoice* oldestNotHeld = nullptr;      // Oldest voice that doesn't have a finger on it
+    MPESynthesiserVoice* oldestUnprotected = nullptr;  // Oldest voice that isn't protected
 
-    // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    for (auto* voice : voices)
+    {
+        if (noteToStealVoiceFor.isValid()
+             && voice->getCurrentlyPlayingNote().initialNote == noteToStealVoiceFor.initialNote
+             && isOlderVoice (voice, oldestWithSameNote))
+            oldestWithSameNote = voice;
 
-    // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top
-             && voice->getCurrentlyPlayingNote().keyState != MPENote::keyDown
-             && voice->getCurrentlyPlayingNote().keyState != MPENote::keyDownAndSustained)
-            return voice;
+        if (voice == low || voice == top)
+            continue;
+
+        if (voice->isPlayingButReleased() && isOlderVoice (voice, oldestReleased))
+            oldestReleased = voice;
+
+        auto keyState = voice->getCurrentlyPlayingNote().keyState;
 
-    // Oldest voice that isn't protected
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top)
+        if (keyState != MPENote::keyDown && keyState != MPENote::keyDownAndSustained
+             && isOlderVoice (voice, oldestNotHeld))
+            oldestNotHeld = voice;
+
+        if (isOlderVoice (voice, oldestUnprotected))
+            oldestUnprotected = voice;
+    }
+
+    for (auto* voice : { oldestWithSameNote, oldestReleased, oldestNotHeld, oldestUnprotected })
+        if (voice != nullptr)
             return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
@@ -260,13 +270,16 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (voicesLock);
     newVoice->setCurrentSampleRate (getSampleRate());
+    activeVoices.ensureStorageAllocated (voices.size() + 1);
     voices.add (newVoice);
+    updateVoiceNoteTable();
 }
 
 void MPESynthesiser::clearVoices()
 {
     const ScopedLock sl (voicesLock);
     voices.clear();
+    updateVoiceNoteTable();
 }
 
 MPESynthesiserVoice* MPESynthesiser::getVoice (const int index) const
@@ -279,6 +292,7 @@ void MPESynthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (voicesLock);
     voices.remove (index);
+    updateVoiceNoteTable();
 }
 
 void MPESynthesiser::reduceNumVoices (const int newNumVoices)
@@ -295,6 +309,23 @@ void MPESynthesiser::reduceNumVoices (const int newNumVoices)
         else
             voices.remove (0); // if there's no voice to steal, kill the oldest voice
     }
+
+    updateVoiceNoteTable();
+}
+
+// Rebuilds the table after the voice list has changed, as the voice indexes will have moved
+void MPESynthesiser::updateVoiceNoteTable()
+{
+    voiceNoteTable.setNumVoices (voices.size());
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->voiceIndex = i;
+
+        if (voice->isActive())
+            voiceNoteTable.setVoiceNote (i, voice->getCurrentlyPlayingNote().initialNote);
+    }
 }
 
 void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
@@ -315,19 +346,33 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 //==============================================================================
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    const ScopedLock sl (voicesLock);
-
-    for (auto* voice : voices)
-    {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
-    }
+    renderActiveVoices (buffer, startSample, numSamples);
 }
 
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+{
+    renderActiveVoices (buffer, startSample, numSamples);
+}
+
+template <typename floatType>
+void MPESynthesiser::renderActiveVoices (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
+    if (parallelRenderer.getNumWorkerThreads() > 0)
+    {
+        // (the storage for this is allocated when voices are added, so it won't allocate here)
+        activeVoices.clearQuick();
+
+        for (auto* voice : voices)
+            if (voice->isActive())
+                activeVoices.add (voice);
+
+        parallelRenderer.render (activeVoices.getRawDataPointer(), activeVoices.size(),
+                                 buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -335,4 +380,11 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
     }
 }
 
+void MPESynthesiser::setParallelVoiceRendering (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (voicesLock);
+    activeVoices.ensureStorageAllocated (voices.size());
+    parallelRenderer.prepare (numWorkerThreads, maximumNumChannels, maximumBlockSize);
+}
+
 } // namespace juce
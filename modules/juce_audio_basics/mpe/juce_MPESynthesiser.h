@@ -127,6 +127,28 @@ public:
     /** Returns true if note-stealing is enabled. */
     bool isVoiceStealingEnabled() const noexcept                { return shouldStealVoices; }
 
+    //==============================================================================
+    /** Makes the synthesiser render its active voices in parallel, using some worker threads.
+
+        The worker threads' buffers are allocated here, so maximumNumChannels and
+        maximumBlockSize must be large enough for the buffers that you'll be passing to
+        renderNextBlock(). Any blocks that don't fit will just be rendered without using
+        the worker threads. Because the voices will be rendered concurrently, they mustn't
+        modify any state that's shared between them.
+
+        The number of worker threads should be less than the number of CPU cores, and
+        passing 0 for numWorkerThreads turns this off again. This only affects the default
+        implementation of renderNextSubBlock().
+
+        @see Synthesiser::setParallelVoiceRendering, ParallelVoiceRenderer
+    */
+    void setParallelVoiceRendering (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads being used to render voices in parallel.
+        @see setParallelVoiceRendering
+    */
+    int getNumParallelRenderingThreads() const noexcept         { return parallelRenderer.getNumWorkerThreads(); }
+
     //==============================================================================
     /** Tells the synthesiser what the sample rate is for the audio it's being used to render.
 
@@ -306,6 +328,18 @@ private:
     bool shouldStealVoices = false;
     uint32 lastNoteOnCounter = 0;
 
+    ParallelVoiceRenderer parallelRenderer;
+    Array<MPESynthesiserVoice*> activeVoices;
+    VoiceNoteTable voiceNoteTable;
+
+    void updateVoiceNoteTable();
+
+    template <typename Callback>
+    void forEachVoicePlayingNote (MPENote, Callback&&);
+
+    template <typename floatType>
+    void renderActiveVoices (AudioBuffer<floatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
 
@@ -185,6 +185,8 @@ private:
     //==============================================================================
     friend class MPESynthesiser;
 
+    int voiceIndex = -1; // (this voice's position in the synth's voice list)
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserVoice)
 };
 
@@ -50,6 +50,12 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     auto scaledBlockSize = roundToInt (samplesPerBlockExpected * ratio);
     input->prepareToPlay (scaledBlockSize, sampleRate * ratio);
 
+    if (polyphaseResampler != nullptr)
+    {
+        createPolyphaseResampler();
+        scaledBlockSize += polyphaseResampler->getLatencyInSamples();
+    }
+
     buffer.setSize (numChannels, scaledBlockSize + 32);
 
     filterStates.calloc (numChannels);
@@ -69,6 +75,36 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    if (polyphaseResampler != nullptr)
+        polyphaseResampler->reset (true);
+}
+
+void ResamplingAudioSource::setPolyphaseResamplingEnabled (bool shouldUsePolyphaseResampler)
+{
+    const ScopedLock sl (callbackLock);
+
+    if (shouldUsePolyphaseResampler != isPolyphaseResamplingEnabled())
+    {
+        if (shouldUsePolyphaseResampler)
+        {
+            const SpinLock::ScopedLockType ratioSl (ratioLock);
+            createPolyphaseResampler();
+        }
+        else
+        {
+            polyphaseResampler.reset();
+        }
+
+        flushBuffers();
+    }
+}
+
+void ResamplingAudioSource::createPolyphaseResampler()
+{
+    // Allow some headroom above the current ratio, so that it can be changed
+    // without having to rebuild the resampler
+    polyphaseResampler.reset (new PolyphaseResampler (numChannels, 32, jmax (4.0, ratio)));
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -94,6 +130,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         lastRatio = localRatio;
     }
 
+    if (polyphaseResampler != nullptr)
+    {
+        getNextPolyphaseBlock (info, localRatio);
+        return;
+    }
+
     const int sampsNeeded = roundToInt (info.numSamples * localRatio) + 3;
 
     int bufferSize = buffer.getNumSamples();
@@ -195,6 +237,42 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextPolyphaseBlock (const AudioSourceChannelInfo& info, double localRatio)
+{
+    // In this mode the buffer isn't used circularly: it always holds the next
+    // sampsInBuffer input samples, starting at index 0.
+    auto sampsNeeded = polyphaseResampler->getNumInputSamplesNeeded (localRatio, info.numSamples);
+
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (buffer.getNumChannels(), sampsNeeded + 32, true, true);
+
+    if (sampsInBuffer < sampsNeeded)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, sampsInBuffer, sampsNeeded - sampsInBuffer);
+        input->getNextAudioBlock (readInfo);
+        sampsInBuffer = sampsNeeded;
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+    {
+        destBuffers[channel] = info.buffer->getWritePointer (channel, info.startSample);
+        srcBuffers[channel] = buffer.getReadPointer (channel);
+    }
+
+    auto numUsed = polyphaseResampler->process (localRatio, srcBuffers, destBuffers,
+                                                channelsToProcess, info.numSamples);
+
+    jassert (numUsed <= sampsInBuffer);
+    sampsInBuffer -= numUsed;
+
+    if (numUsed > 0 && sampsInBuffer > 0)
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            memmove (buffer.getWritePointer (channel), buffer.getReadPointer (channel, numUsed),
+                     (size_t) sampsInBuffer * sizeof (float));
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -27,7 +27,12 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    By default this uses linear interpolation with an IIR low-pass filter, which is
+    cheap but lets some aliasing through. Calling setPolyphaseResamplingEnabled()
+    switches it to a PolyphaseResampler, which is much cleaner, at the cost of some
+    extra CPU.
+
+    @see AudioSource, PolyphaseResampler, LagrangeInterpolator, CatmullRomInterpolator
 
     @tags{Audio}
 */
@@ -68,6 +73,21 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    /** Chooses whether to use a windowed-sinc PolyphaseResampler rather than the default
+        linear interpolation and IIR filter.
+
+        The polyphase resampler has much lower aliasing and a flat passband, but uses more
+        CPU and adds some latency, which is compensated for each time the buffers are
+        flushed. Changing this setting flushes the buffers, so it's best done before
+        playback starts.
+    */
+    void setPolyphaseResamplingEnabled (bool shouldUsePolyphaseResampler);
+
+    /** Returns true if the polyphase resampler is being used.
+        @see setPolyphaseResamplingEnabled
+    */
+    bool isPolyphaseResamplingEnabled() const noexcept          { return polyphaseResampler != nullptr; }
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -86,6 +106,7 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    std::unique_ptr<PolyphaseResampler> polyphaseResampler;
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -99,6 +120,8 @@ private:
     void resetFilters();
 
     void applyFilter (float* samples, int num, FilterState& fs);
+    void createPolyphaseResampler();
+    void getNextPolyphaseBlock (const AudioSourceChannelInfo&, double localRatio);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
@@ -0,0 +1,499 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ParallelVoiceRenderer::Worker  : public Thread
+{
+public:
+    Worker (ParallelVoiceRenderer& r, int index)
+        : Thread ("Voice renderer " + String (index + 1)), owner (r),
+          lastJob (r.jobCounter.load())
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        jobAvailable.signal();
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (waitForNextJob())
+        {
+            lastJob = owner.jobCounter.load (std::memory_order_acquire);
+            owner.joinCurrentJob (*this);
+        }
+    }
+
+    // Clears the part of the scratch buffer that the current job needs
+    void prepareScratchBuffer (const Job& job)
+    {
+        for (int chan = 0; chan < job.numChannels; ++chan)
+        {
+            if (job.isDouble)
+                doubleScratch.clear (chan, 0, job.numSamples);
+            else
+                floatScratch.clear (chan, 0, job.numSamples);
+        }
+    }
+
+    void* getScratchBuffer (const Job& job) noexcept
+    {
+        if (job.isDouble)
+            return &doubleScratch;
+
+        return &floatScratch;
+    }
+
+    // Returns true when there's a new job, or false if the thread should exit
+    bool waitForNextJob()
+    {
+        // spin for a little while first, as the next sub-block is probably about to arrive..
+        auto spinEndTime = Time::getHighResolutionTicks() + Time::secondsToHighResolutionTicks (spinTimeSeconds);
+
+        for (;;)
+        {
+            if (threadShouldExit())
+                return false;
+
+            if (owner.jobCounter.load (std::memory_order_acquire) != lastJob)
+                return true;
+
+            if (Time::getHighResolutionTicks() < spinEndTime)
+            {
+                // (yielding here stops the spinning from starving the audio thread if there aren't enough cores)
+                Thread::yield();
+                continue;
+            }
+
+            isSleeping = true;
+
+            // (the renderer checks isSleeping after bumping the job counter, so one of us will see the other)
+            if (owner.jobCounter.load() == lastJob && ! threadShouldExit())
+                jobAvailable.wait (100);
+
+            isSleeping = false;
+        }
+    }
+
+    static constexpr double spinTimeSeconds = 0.001;
+
+    ParallelVoiceRenderer& owner;
+    AudioBuffer<float> floatScratch;
+    AudioBuffer<double> doubleScratch;
+    WaitableEvent jobAvailable;
+    std::atomic<bool> isSleeping { false };
+    uint32 lastJob;
+    int numVoicesRendered = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+ParallelVoiceRenderer::ParallelVoiceRenderer() {}
+
+ParallelVoiceRenderer::~ParallelVoiceRenderer()
+{
+    workers.clear();
+}
+
+void ParallelVoiceRenderer::prepare (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    jassert (numWorkerThreads >= 0 && maximumNumChannels >= 0 && maximumBlockSize >= 0);
+
+    maxChannels = maximumNumChannels;
+    maxBlockSize = maximumBlockSize;
+
+    workers.removeRange (numWorkerThreads, workers.size());
+
+    while (workers.size() < numWorkerThreads)
+        workers.add (new Worker (*this, workers.size()));
+
+    for (auto* w : workers)
+    {
+        w->floatScratch.setSize (maxChannels, maxBlockSize);
+        w->doubleScratch.setSize (maxChannels, maxBlockSize);
+
+        if (! w->isThreadRunning())
+            w->startThread (Thread::realtimeAudioPriority);
+    }
+}
+
+bool ParallelVoiceRenderer::canRenderInParallel (int numVoices, int numChannels, int numSamples) const noexcept
+{
+    return numVoices > 1
+            && ! workers.isEmpty()
+            && numChannels <= maxChannels
+            && numSamples <= maxBlockSize;
+}
+
+void ParallelVoiceRenderer::runJob (const Job& job, void* outputBuffer, int startSample)
+{
+    currentJob = job;
+    nextVoiceIndex.store (0, std::memory_order_relaxed);
+
+    for (auto* w : workers)
+        w->numVoicesRendered = 0;
+
+    isJobOpen.store (true);
+    jobCounter.fetch_add (1);
+
+    for (auto* w : workers)
+        if (w->isSleeping.load())
+            w->jobAvailable.signal();
+
+    // the calling thread takes its share of the voices too, rendering them straight into the output
+    renderVoicesFromCurrentJob (outputBuffer, startSample, nullptr);
+
+    // Every voice has been claimed by now, so closing the job means that a worker which hasn't
+    // started yet will skip it, and only the workers that are busy rendering need waiting for.
+    // (A worker marks itself as busy before checking whether the job is open, and we close it
+    // before checking for busy workers, so one of us will always see the other.)
+    isJobOpen.store (false);
+
+    for (int spins = 0; numBusyWorkers.load() > 0; ++spins)
+        if (spins > 40)
+            Thread::yield();
+
+    for (auto* w : workers)
+    {
+        if (w->numVoicesRendered == 0)
+            continue;
+
+        for (int chan = 0; chan < job.numChannels; ++chan)
+        {
+            if (job.isDouble)
+                static_cast<AudioBuffer<double>*> (outputBuffer)->addFrom (chan, startSample, w->doubleScratch, chan, 0, job.numSamples);
+            else
+                static_cast<AudioBuffer<float>*> (outputBuffer)->addFrom (chan, startSample, w->floatScratch, chan, 0, job.numSamples);
+        }
+    }
+}
+
+void ParallelVoiceRenderer::joinCurrentJob (Worker& worker)
+{
+    numBusyWorkers.fetch_add (1);
+
+    if (isJobOpen.load())
+        renderVoicesFromCurrentJob (nullptr, 0, &worker);
+
+    numBusyWorkers.fetch_sub (1, std::memory_order_release);
+}
+
+void ParallelVoiceRenderer::renderVoicesFromCurrentJob (void* outputBuffer, int startSample, Worker* worker)
+{
+    for (;;)
+    {
+        auto index = nextVoiceIndex.fetch_add (1, std::memory_order_relaxed);
+
+        if (index >= currentJob.numVoices)
+            return;
+
+        if (worker != nullptr)
+        {
+            // workers render into their own scratch buffers, which only need clearing if they get some voices
+            if (worker->numVoicesRendered++ == 0)
+                worker->prepareScratchBuffer (currentJob);
+
+            outputBuffer = worker->getScratchBuffer (currentJob);
+        }
+
+        currentJob.renderVoice (currentJob.voices, index, outputBuffer, startSample, currentJob.numSamples);
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParallelVoiceRendererTests  : public UnitTest
+{
+public:
+    ParallelVoiceRendererTests()
+        : UnitTest ("ParallelVoiceRenderer", UnitTestCategories::audio)
+    {}
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override      { return true; }
+        bool appliesToChannel (int) override   { return true; }
+    };
+
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0;
+            level = velocity;
+            delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+        }
+
+        void stopNote (float, bool) override        { clearCurrentNote(); }
+        void pitchWheelMoved (int) override          {}
+        void controllerMoved (int, int) override     {}
+
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                auto sample = (FloatType) (level * std::sin (phase));
+                phase += delta;
+
+                for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+                    buffer.addSample (chan, i, sample);
+            }
+        }
+
+        void renderNextBlock (AudioBuffer<float>& b, int s, int n) override    { render (b, s, n); }
+        void renderNextBlock (AudioBuffer<double>& b, int s, int n) override   { render (b, s, n); }
+
+        double phase = 0, delta = 0, level = 0;
+    };
+
+    struct TestMPEVoice  : public MPESynthesiserVoice
+    {
+        void noteStarted() override
+        {
+            phase = 0;
+            delta = MathConstants<double>::twoPi * currentlyPlayingNote.getFrequencyInHertz() / currentSampleRate;
+        }
+
+        void noteStopped (bool) override         { clearCurrentNote(); }
+        void notePressureChanged() override      {}
+        void notePitchbendChanged() override     {}
+        void noteTimbreChanged() override        {}
+        void noteKeyStateChanged() override      {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                auto sample = (float) (0.1 * std::sin (phase));
+                phase += delta;
+
+                for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+                    buffer.addSample (chan, i, sample);
+            }
+        }
+
+        double phase = 0, delta = 0;
+    };
+
+    struct ConstantVoice
+    {
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+                buffer.addSample (0, i, 1.0f);
+        }
+    };
+
+    // Roughly the cost of a simple additive voice
+    struct PartialsVoice
+    {
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                float sample = 0;
+
+                for (int p = 1; p <= 16; ++p)
+                    sample += std::sin ((float) (phase * p)) / (float) p;
+
+                phase += 0.01;
+                buffer.addSample (0, i, sample * 0.01f);
+                buffer.addSample (1, i, sample * 0.01f);
+            }
+        }
+
+        double phase = 0;
+    };
+
+    static MidiBuffer createMidi (Random& r, int numSamples, int numEvents, bool isMPE)
+    {
+        MidiBuffer midi;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto note = 36 + r.nextInt (60);
+            auto channel = isMPE ? 2 + r.nextInt (15) : 1;
+            auto pos = r.nextInt (numSamples);
+
+            if (r.nextInt (4) == 0)
+                midi.addEvent (MidiMessage::noteOff (channel, note), pos);
+            else
+                midi.addEvent (MidiMessage::noteOn (channel, note, (uint8) (1 + r.nextInt (127))), pos);
+        }
+
+        return midi;
+    }
+
+    template <typename SynthType, typename FloatType>
+    void expectSameOutput (SynthType& serial, SynthType& parallel, int64 seed, bool isMPE)
+    {
+        Random r (seed);
+        AudioBuffer<FloatType> serialOutput (2, 512), parallelOutput (2, 512);
+
+        for (int block = 0; block < 50; ++block)
+        {
+            auto numSamples = 1 + r.nextInt (512);
+            auto midi = createMidi (r, numSamples, r.nextInt (20), isMPE);
+
+            serialOutput.clear();
+            parallelOutput.clear();
+            serial.renderNextBlock (serialOutput, midi, 0, numSamples);
+            parallel.renderNextBlock (parallelOutput, midi, 0, numSamples);
+
+            for (int chan = 0; chan < 2; ++chan)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (parallelOutput.getSample (chan, i), serialOutput.getSample (chan, i), (FloatType) 1.0e-4);
+        }
+    }
+
+    template <typename FloatType>
+    void testSynthesiser (int numWorkers)
+    {
+        Synthesiser serial, parallel;
+
+        for (auto* synth : { &serial, &parallel })
+        {
+            for (int i = 0; i < 48; ++i)
+                synth->addVoice (new TestVoice());
+
+            synth->addSound (new TestSound());
+            synth->setCurrentPlaybackSampleRate (44100.0);
+        }
+
+        parallel.setParallelVoiceRendering (numWorkers, 2, 512);
+        expectEquals (parallel.getNumParallelRenderingThreads(), numWorkers);
+
+        expectSameOutput<Synthesiser, FloatType> (serial, parallel, getRandom().nextInt64(), false);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Synthesiser output is the same when rendered in parallel");
+        {
+            for (int numWorkers : { 1, 3 })
+            {
+                testSynthesiser<float> (numWorkers);
+                testSynthesiser<double> (numWorkers);
+            }
+        }
+
+        beginTest ("MPESynthesiser output is the same when rendered in parallel");
+        {
+            MPESynthesiser serial, parallel;
+
+            for (auto* synth : { &serial, &parallel })
+            {
+                for (int i = 0; i < 32; ++i)
+                    synth->addVoice (new TestMPEVoice());
+
+                synth->setVoiceStealingEnabled (true);
+                synth->setCurrentPlaybackSampleRate (44100.0);
+            }
+
+            parallel.setParallelVoiceRendering (2, 2, 512);
+            expectSameOutput<MPESynthesiser, float> (serial, parallel, getRandom().nextInt64(), true);
+        }
+
+        beginTest ("Rendering blocks of different sizes");
+        {
+            ParallelVoiceRenderer renderer;
+            renderer.prepare (2, 1, 64);
+
+            ConstantVoice constantVoices[8];
+            ConstantVoice* voicePointers[8];
+
+            for (int i = 0; i < 8; ++i)
+                voicePointers[i] = constantVoices + i;
+
+            for (int numSamples : { 64, 256 })
+            {
+                AudioBuffer<float> output (1, numSamples);
+                output.clear();
+                renderer.render (voicePointers, 8, output, 0, numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (output.getSample (0, i), 8.0f);
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            constexpr int blockSize = 256, numBlocks = 20;
+            auto numWorkers = jmax (1, SystemStats::getNumCpus() - 1);
+
+            for (int numVoices : { 4, 16, 64 })
+            {
+                std::vector<PartialsVoice> voices ((size_t) numVoices);
+                std::vector<PartialsVoice*> voicePointers;
+
+                for (auto& v : voices)
+                    voicePointers.push_back (&v);
+
+                AudioBuffer<float> output (2, blockSize);
+
+                auto timeBlocks = [&] (int numWorkerThreads)
+                {
+                    ParallelVoiceRenderer renderer;
+                    renderer.prepare (numWorkerThreads, 2, blockSize);
+
+                    auto start = Time::getHighResolutionTicks();
+
+                    for (int block = 0; block < numBlocks; ++block)
+                    {
+                        output.clear();
+                        renderer.render (voicePointers.data(), numVoices, output, 0, blockSize);
+                    }
+
+                    return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0 / numBlocks;
+                };
+
+                auto serialTime = timeBlocks (0);
+                auto parallelTime = timeBlocks (numWorkers);
+
+                logMessage (String (numVoices) + " voices, " + String (blockSize) + " samples: serial " + String (serialTime, 3)
+                              + " ms, " + String (numWorkers) + " workers " + String (parallelTime, 3) + " ms ("
+                              + String (serialTime / parallelTime, 2) + "x, " + String (serialTime / (parallelTime * (numWorkers + 1)), 2)
+                              + " of ideal)");
+            }
+        }
+    }
+};
+
+static ParallelVoiceRendererTests parallelVoiceRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Spreads the rendering of a set of synthesiser voices across some worker threads.
+
+    This is used by Synthesiser and MPESynthesiser when they're asked to render their
+    voices in parallel, but you could also use it in your own synth classes.
+
+    Each call to render() hands out the voices one at a time to the calling thread and to
+    the worker threads. The calling thread renders its voices straight into the output
+    buffer, and each worker renders into its own scratch buffer, which gets added to the
+    output once all the voices are finished. When the calling thread runs out of voices
+    to take, it only waits for the workers that are still rendering some, so a worker
+    that's slow to wake up doesn't hold up the block.
+
+    None of this allocates or takes any locks on the calling thread, but the scratch
+    buffers have to be big enough for the blocks being rendered, so you need to tell
+    prepare() the largest number of channels and samples to expect. If a block turns
+    out to be bigger than that, it's just rendered on the calling thread instead.
+
+    Between jobs, the workers spin for a short while before going to sleep, so that
+    the sub-blocks that a synth renders in quick succession don't each have to pay
+    the cost of waking them up.
+
+    Note that the voices will be called concurrently, so they mustn't modify any
+    state that they share with each other.
+
+    @tags{Audio}
+*/
+class JUCE_API  ParallelVoiceRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a renderer with no worker threads. */
+    ParallelVoiceRenderer();
+
+    /** Destructor. */
+    ~ParallelVoiceRenderer();
+
+    //==============================================================================
+    /** Starts or stops worker threads so that there are the given number of them, and
+        allocates their scratch buffers.
+
+        A value of 0 for numWorkerThreads means that all the voices will be rendered on the
+        calling thread. Because the calling thread renders some of the voices too, there's
+        no point in using more than SystemStats::getNumCpus() - 1 workers, and using more
+        workers than there are spare cores will make things slower rather than faster.
+
+        This mustn't be called while render() is in progress.
+    */
+    void prepare (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads that are running. */
+    int getNumWorkerThreads() const noexcept            { return workers.size(); }
+
+    //==============================================================================
+    /** Renders some voices, adding their output to a buffer.
+
+        This calls renderNextBlock (AudioBuffer<FloatType>&, int, int) on each of the voices
+        in the array, which may be SynthesiserVoices, MPESynthesiserVoices, or anything else
+        with a method like that.
+    */
+    template <typename VoiceType, typename FloatType>
+    void render (VoiceType* const* voicesToRender, int numVoicesToRender,
+                 AudioBuffer<FloatType>& outputAudio, int startSample, int numSamples)
+    {
+        struct Callback
+        {
+            static void renderVoice (const void* voices, int index, void* buffer, int start, int num)
+            {
+                static_cast<VoiceType* const*> (voices)[index]->renderNextBlock (*static_cast<AudioBuffer<FloatType>*> (buffer), start, num);
+            }
+        };
+
+        if (! canRenderInParallel (numVoicesToRender, outputAudio.getNumChannels(), numSamples))
+        {
+            for (int i = 0; i < numVoicesToRender; ++i)
+                voicesToRender[i]->renderNextBlock (outputAudio, startSample, numSamples);
+
+            return;
+        }
+
+        Job job;
+        job.voices = voicesToRender;
+        job.numVoices = numVoicesToRender;
+        job.numChannels = outputAudio.getNumChannels();
+        job.numSamples = numSamples;
+        job.renderVoice = Callback::renderVoice;
+        job.isDouble = std::is_same<FloatType, double>::value;
+
+        runJob (job, &outputAudio, startSample);
+    }
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        const void* voices = nullptr;
+        int numVoices = 0, numChannels = 0, numSamples = 0;
+        void (*renderVoice) (const void* voices, int index, void* buffer, int startSample, int numSamples) = nullptr;
+        bool isDouble = false;
+    };
+
+    class Worker;
+    OwnedArray<Worker> workers;
+    int maxChannels = 0, maxBlockSize = 0;
+
+    Job currentJob;
+    std::atomic<uint32> jobCounter { 0 };
+    std::atomic<int> nextVoiceIndex { 0 }, numBusyWorkers { 0 };
+    std::atomic<bool> isJobOpen { false };
+
+    bool canRenderInParallel (int numVoices, int numChannels, int numSamples) const noexcept;
+    void runJob (const Job&, void* outputBuffer, int startSample);
+    void joinCurrentJob (Worker&);
+    void renderVoicesFromCurrentJob (void* buffer, int startSample, Worker*);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelVoiceRenderer)
+};
+
+} // namespace juce
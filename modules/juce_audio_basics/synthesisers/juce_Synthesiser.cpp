@@ -94,19 +94,37 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    updateVoiceNoteTable();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
-    return voices.add (newVoice);
+    activeVoices.ensureStorageAllocated (voices.size() + 1);
+    voices.add (newVoice);
+    updateVoiceNoteTable();
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    updateVoiceNoteTable();
+}
+
+// Rebuilds the table after the voice list has changed, as the voice indexes will have moved
+void Synthesiser::updateVoiceNoteTable()
+{
+    voiceNoteTable.setNumVoices (voices.size());
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        auto* voice = voices.getUnchecked (i);
+        voice->voiceIndex = i;
+        voiceNoteTable.setVoiceNote (i, voice->getCurrentlyPlayingNote());
+    }
 }
 
 void Synthesiser::clearSounds()
@@ -230,16 +248,49 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (parallelRenderer.getNumWorkerThreads() > 0)
+    {
+        renderVoicesInParallel (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (parallelRenderer.getNumWorkerThreads() > 0)
+    {
+        renderVoicesInParallel (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
+template <typename floatType>
+void Synthesiser::renderVoicesInParallel (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    // (the storage for this is allocated when voices are added, so it won't allocate here)
+    activeVoices.clearQuick();
+
+    for (auto* voice : voices)
+        if (voice->isVoiceActive())
+            activeVoices.add (voice);
+
+    parallelRenderer.render (activeVoices.getRawDataPointer(), activeVoices.size(),
+                             buffer, startSample, numSamples);
+}
+
+void Synthesiser::setParallelVoiceRendering (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    const ScopedLock sl (lock);
+    activeVoices.ensureStorageAllocated (voices.size());
+    parallelRenderer.prepare (numWorkerThreads, maximumNumChannels, maximumBlockSize);
+}
+
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
 {
     const int channel = m.getChannel();
@@ -287,15 +338,23 @@ void Synthesiser::noteOn (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
+    // (the voice list is protected, so this catches any subclasses that have changed it directly)
+    if (voiceNoteTable.getNumVoices() != voices.size())
+        updateVoiceNoteTable();
+
     for (auto* sound : sounds)
     {
         if (sound->appliesToNote (midiNoteNumber) && sound->appliesToChannel (midiChannel))
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
+            for (auto i = voiceNoteTable.getFirstVoiceForNote (midiNoteNumber); i >= 0; i = voiceNoteTable.getNextVoiceForSameNote (i))
+            {
+                auto* voice = voices.getUnchecked (i);
+
                 if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
                     stopVoice (voice, 1.0f, true);
+            }
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -322,6 +381,13 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         voice->setSostenutoPedalDown (false);
         voice->setSustainPedalDown (sustainPedalsDown[midiChannel]);
 
+        // (a subclass may have changed the voice list directly, in which case the indexes need updating)
+        if (voices[voice->voiceIndex] != voice || voiceNoteTable.getNumVoices() != voices.size())
+            updateVoiceNoteTable();
+
+        if (voices[voice->voiceIndex] == voice)
+            voiceNoteTable.setVoiceNote (voice->voiceIndex, midiNoteNumber);
+
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
     }
@@ -344,8 +410,13 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    if (voiceNoteTable.getNumVoices() != voices.size())
+        updateVoiceNoteTable();
+
+    for (auto i = voiceNoteTable.getFirstVoiceForNote (midiNoteNumber); i >= 0; i = voiceNoteTable.getNextVoiceForSameNote (i))
     {
+        auto* voice = voices.getUnchecked (i);
+
         if (voice->getCurrentlyPlayingNote() == midiNoteNumber
               && voice->isPlayingChannel (midiChannel))
         {
@@ -409,10 +480,17 @@ void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aft
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    if (voiceNoteTable.getNumVoices() != voices.size())
+        updateVoiceNoteTable();
+
+    for (auto i = voiceNoteTable.getFirstVoiceForNote (midiNoteNumber); i >= 0; i = voiceNoteTable.getNextVoiceForSameNote (i))
+    {
+        auto* voice = voices.getUnchecked (i);
+
         if (voice->getCurrentlyPlayingNote() == midiNoteNumber
               && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
             voice->aftertouchChanged (aftertouchValue);
+    }
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
@@ -500,6 +578,11 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
     return nullptr;
 }
 
+static bool isOlderVoice (const SynthesiserVoice* voice, const SynthesiserVoice* oldestSoFar) noexcept
+{
+    return oldestSoFar == nullptr || voice->wasStartedBefore (*oldestSoFar);
+}
+
 SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
                                                  int /*midiChannel*/, int midiNoteNumber) const
 {
@@ -514,27 +597,12 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     SynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     SynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // this is a list of voices we can steal, sorted by how long they've been running
-    Array<SynthesiserVoice*> usableVoices;
-    usableVoices.ensureStorageAllocated (voices.size());
-
     for (auto* voice : voices)
     {
         if (voice->canPlaySound (soundToPlay))
         {
             jassert (voice->isVoiceActive()); // We wouldn't be here otherwise
 
-            usableVoices.add (voice);
-
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoices.begin(), usableVoices.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -552,24 +620,36 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     if (top == low)
         top = nullptr;
 
-    // The oldest note that's playing with the target pitch is ideal..
-    for (auto* voice : usableVoices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
-            return voice;
+    // Rather than sorting the usable voices by age, this finds the oldest one in each of
+    // these categories, in order of preference:
+    SynthesiserVoice* oldestWithSameNote = nullptr; // The oldest note that's playing with the target pitch is ideal..
+    SynthesiserVoice* oldestReleased = nullptr;     // Oldest voice that has been released (no finger on it and not held by sustain pedal)
+    SynthesiserVoice* oldestNotHeld = nullptr;      // Oldest voice that doesn't have a finger on it
+    SynthesiserVoice* oldestUnprotected = nullptr;  // Oldest voice that isn't protected
 
-    // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    for (auto* voice : voices)
+    {
+        if (! voice->canPlaySound (soundToPlay))
+            continue;
 
-    // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && ! voice->isKeyDown())
-            return voice;
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber && isOlderVoice (voice, oldestWithSameNote))
+            oldestWithSameNote = voice;
+
+        if (voice == low || voice == top)
+            continue;
+
+        if (voice->isPlayingButReleased() && isOlderVoice (voice, oldestReleased))
+            oldestReleased = voice;
+
+        if (! voice->isKeyDown() && isOlderVoice (voice, oldestNotHeld))
+            oldestNotHeld = voice;
+
+        if (isOlderVoice (voice, oldestUnprotected))
+            oldestUnprotected = voice;
+    }
 
-    // Oldest voice that isn't protected
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top)
+    for (auto* voice : { oldestWithSameNote, oldestReleased, oldestNotHeld, oldestUnprotected })
+        if (voice != nullptr)
             return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
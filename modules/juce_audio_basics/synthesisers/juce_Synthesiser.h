@@ -268,6 +268,7 @@ private:
 
     double currentSampleRate = 44100.0;
     int currentlyPlayingNote = -1, currentPlayingMidiChannel = 0;
+    int voiceIndex = -1; // (this voice's position in the synth's voice list)
     uint32 noteOnTime = 0;
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
@@ -557,6 +558,33 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Makes the synthesiser render its voices in parallel, using some worker threads.
+
+        When this is enabled, each sub-block's active voices are shared out between the
+        audio thread and the worker threads, which render them into their own buffers
+        before they're all added together. The midi events are still handled in between
+        the sub-blocks in the same way, so the timing of the output doesn't change.
+
+        maximumNumChannels and maximumBlockSize must be large enough for the buffers that
+        you'll be passing to renderNextBlock(), because the worker threads' buffers are
+        allocated here rather than on the audio thread. Any blocks that don't fit will
+        just be rendered without using the worker threads.
+
+        Because the voices will be rendered concurrently, they mustn't modify any state
+        that's shared between them. The number of worker threads should be less than the
+        number of CPU cores, and passing 0 for numWorkerThreads turns this off again.
+
+        Note that this only affects the default implementation of renderVoices().
+
+        @see ParallelVoiceRenderer
+    */
+    void setParallelVoiceRendering (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads being used to render voices in parallel.
+        @see setParallelVoiceRendering
+    */
+    int getNumParallelRenderingThreads() const noexcept         { return parallelRenderer.getNumWorkerThreads(); }
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -628,6 +656,15 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    ParallelVoiceRenderer parallelRenderer;
+    Array<SynthesiserVoice*> activeVoices;
+    VoiceNoteTable voiceNoteTable;
+
+    void updateVoiceNoteTable();
+
+    template <typename floatType>
+    void renderVoicesInParallel (AudioBuffer<floatType>&, int startSample, int numSamples);
+
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
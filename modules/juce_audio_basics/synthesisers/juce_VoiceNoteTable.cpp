@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+VoiceNoteTable::VoiceNoteTable() noexcept
+{
+    setNumVoices (0);
+}
+
+void VoiceNoteTable::setNumVoices (int numVoices)
+{
+    voiceNotes.clearQuick();
+    nextVoice.clearQuick();
+    previousVoice.clearQuick();
+
+    voiceNotes.insertMultiple (0, -1, numVoices);
+    nextVoice.insertMultiple (0, -1, numVoices);
+    previousVoice.insertMultiple (0, -1, numVoices);
+
+    std::fill (std::begin (firstVoiceForNote), std::end (firstVoiceForNote), -1);
+    std::fill (std::begin (lastVoiceForNote),  std::end (lastVoiceForNote),  -1);
+}
+
+void VoiceNoteTable::setVoiceNote (int voiceIndex, int midiNoteNumber) noexcept
+{
+    jassert (isPositiveAndBelow (voiceIndex, voiceNotes.size()));
+    jassert (midiNoteNumber < 128);
+
+    removeVoice (voiceIndex);
+
+    if (! isPositiveAndBelow (midiNoteNumber, 128))
+        return;
+
+    voiceNotes.setUnchecked (voiceIndex, midiNoteNumber);
+
+    auto last = lastVoiceForNote[midiNoteNumber];
+    previousVoice.setUnchecked (voiceIndex, last);
+
+    if (last >= 0)
+        nextVoice.setUnchecked (last, voiceIndex);
+    else
+        firstVoiceForNote[midiNoteNumber] = voiceIndex;
+
+    lastVoiceForNote[midiNoteNumber] = voiceIndex;
+}
+
+void VoiceNoteTable::removeVoice (int voiceIndex) noexcept
+{
+    auto note = voiceNotes.getUnchecked (voiceIndex);
+
+    if (note < 0)
+        return;
+
+    auto previous = previousVoice.getUnchecked (voiceIndex);
+    auto next = nextVoice.getUnchecked (voiceIndex);
+
+    if (previous >= 0)
+        nextVoice.setUnchecked (previous, next);
+    else
+        firstVoiceForNote[note] = next;
+
+    if (next >= 0)
+        previousVoice.setUnchecked (next, previous);
+    else
+        lastVoiceForNote[note] = previous;
+
+    voiceNotes.setUnchecked (voiceIndex, -1);
+    nextVoice.setUnchecked (voiceIndex, -1);
+    previousVoice.setUnchecked (voiceIndex, -1);
+}
+
+int VoiceNoteTable::getVoiceNote (int voiceIndex) const noexcept
+{
+    return isPositiveAndBelow (voiceIndex, voiceNotes.size()) ? voiceNotes.getUnchecked (voiceIndex) : -1;
+}
+
+int VoiceNoteTable::getNextVoiceForSameNote (int voiceIndex) const noexcept
+{
+    return isPositiveAndBelow (voiceIndex, nextVoice.size()) ? nextVoice.getUnchecked (voiceIndex) : -1;
+}
+
+int VoiceNoteTable::getFirstVoiceForNote (int midiNoteNumber) const noexcept
+{
+    return isPositiveAndBelow (midiNoteNumber, 128) ? firstVoiceForNote[midiNoteNumber] : -1;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class VoiceNoteTableTests  : public UnitTest
+{
+public:
+    VoiceNoteTableTests()
+        : UnitTest ("VoiceNoteTable", UnitTestCategories::audio)
+    {}
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override      { return true; }
+        bool appliesToChannel (int) override   { return true; }
+    };
+
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override          { return true; }
+        void startNote (int, float, SynthesiserSound*, int) override {}
+        void stopNote (float, bool allowTailOff) override       { if (! allowTailOff) clearCurrentNote(); }
+        void pitchWheelMoved (int) override                     {}
+        void controllerMoved (int, int) override                {}
+        void renderNextBlock (AudioBuffer<float>&, int, int) override {}
+    };
+
+    struct TestMPEVoice  : public MPESynthesiserVoice
+    {
+        void noteStarted() override                  {}
+        void noteStopped (bool) override             { clearCurrentNote(); }
+        void notePressureChanged() override          {}
+        void notePitchbendChanged() override         {}
+        void noteTimbreChanged() override            {}
+        void noteKeyStateChanged() override          {}
+        void renderNextBlock (AudioBuffer<float>&, int, int) override   {}
+        void renderNextBlock (AudioBuffer<double>&, int, int) override  {}
+    };
+
+    static MidiBuffer createDenseMidi (Random& r, int numSamples, int numEvents, bool isMPE)
+    {
+        MidiBuffer midi;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto channel = isMPE ? 2 + r.nextInt (15) : 1;
+            auto note = 36 + r.nextInt (48);
+            auto pos = r.nextInt (numSamples);
+
+            if (r.nextBool())
+                midi.addEvent (MidiMessage::noteOn (channel, note, (uint8) (1 + r.nextInt (127))), pos);
+            else
+                midi.addEvent (MidiMessage::noteOff (channel, note), pos);
+        }
+
+        return midi;
+    }
+
+    template <typename SynthType>
+    double timeDenseMidi (SynthType& synth, bool isMPE)
+    {
+        constexpr int blockSize = 256, numBlocks = 200;
+        AudioBuffer<float> output (2, blockSize);
+        Random r (1234);
+
+        std::vector<MidiBuffer> blocks;
+
+        for (int i = 0; i < numBlocks; ++i)
+            blocks.push_back (createDenseMidi (r, blockSize, 200, isMPE));
+
+        auto start = Time::getHighResolutionTicks();
+
+        for (auto& midi : blocks)
+            synth.renderNextBlock (output, midi, 0, blockSize);
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1.0e6 / numBlocks;
+    }
+
+    static Array<int> getVoicesForNote (const VoiceNoteTable& table, int note)
+    {
+        Array<int> result;
+
+        for (auto i = table.getFirstVoiceForNote (note); i >= 0; i = table.getNextVoiceForSameNote (i))
+            result.add (i);
+
+        return result;
+    }
+
+    static Array<int> getNotesPlaying (Synthesiser& synth)
+    {
+        Array<int> result;
+
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            result.add (synth.getVoice (i)->getCurrentlyPlayingNote());
+
+        return result;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Voices are listed in the order they were started");
+        {
+            VoiceNoteTable table;
+            table.setNumVoices (8);
+
+            for (auto note : { 0, 1, 2, 3, 4, 5, 6, 7 })
+                expect (getVoicesForNote (table, note).isEmpty());
+
+            table.setVoiceNote (5, 60);
+            table.setVoiceNote (2, 60);
+            table.setVoiceNote (7, 60);
+            table.setVoiceNote (3, 64);
+
+            expect (getVoicesForNote (table, 60) == Array<int> (5, 2, 7));
+            expect (getVoicesForNote (table, 64) == Array<int> (3));
+            expectEquals (table.getVoiceNote (2), 60);
+            expectEquals (table.getVoiceNote (0), -1);
+        }
+
+        beginTest ("Voices can be moved and removed");
+        {
+            VoiceNoteTable table;
+            table.setNumVoices (8);
+
+            for (int i = 0; i < 8; ++i)
+                table.setVoiceNote (i, 60);
+
+            table.setVoiceNote (0, 61);
+            table.setVoiceNote (4, -1);
+            table.setVoiceNote (7, 127);
+            table.setVoiceNote (3, 60);
+
+            expect (getVoicesForNote (table, 60) == Array<int> (1, 2, 5, 6, 3));
+            expect (getVoicesForNote (table, 61) == Array<int> (0));
+            expect (getVoicesForNote (table, 127) == Array<int> (7));
+            expectEquals (table.getVoiceNote (4), -1);
+
+            table.setNumVoices (4);
+            expect (getVoicesForNote (table, 60).isEmpty());
+            expectEquals (table.getNextVoiceForSameNote (6), -1);
+        }
+
+        beginTest ("Synthesiser note-offs only stop the voices playing that note");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 6; ++i)
+                synth.addVoice (new TestVoice());
+
+            for (auto note : { 60, 62, 60, 64 })
+                synth.noteOn (1, note, 1.0f);
+
+            // the first 60 is still tailing off when the second one starts
+            expect (getNotesPlaying (synth) == Array<int> (60, 62, 60, 64, -1, -1));
+
+            synth.noteOff (1, 60, 1.0f, false);
+            expect (! getNotesPlaying (synth).contains (60));
+            expect (getNotesPlaying (synth).contains (62));
+            expect (getNotesPlaying (synth).contains (64));
+
+            synth.noteOff (1, 62, 1.0f, false);
+            synth.noteOff (1, 64, 1.0f, false);
+            expect (getNotesPlaying (synth) == Array<int> (-1, -1, -1, -1, -1, -1));
+        }
+
+        beginTest ("Synthesiser steals the oldest unprotected voice");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            for (auto note : { 50, 70, 60, 65 })
+                synth.noteOn (1, note, 1.0f);
+
+            // 50 and 70 are protected as the lowest and highest notes, so 60 is the oldest candidate
+            synth.noteOn (1, 55, 1.0f);
+            expect (getNotesPlaying (synth) == Array<int> (50, 70, 55, 65));
+
+            // ..but a voice that's already playing the same note is preferred
+            synth.noteOn (1, 70, 1.0f);
+            expect (getNotesPlaying (synth) == Array<int> (50, 70, 55, 65));
+
+            // ..followed by voices that have been released, even if they're protected
+            synth.noteOff (1, 50, 1.0f, true);
+            synth.noteOn (1, 80, 1.0f);
+            expect (getNotesPlaying (synth) == Array<int> (80, 70, 55, 65));
+        }
+
+        beginTest ("Voice indexes follow changes to the voice list");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            synth.noteOn (1, 60, 1.0f);
+            synth.noteOn (1, 62, 1.0f);
+            synth.removeVoice (0);
+            synth.noteOn (1, 64, 1.0f);
+            expect (getNotesPlaying (synth) == Array<int> (62, 64, -1));
+
+            synth.noteOff (1, 62, 1.0f, false);
+            synth.noteOff (1, 64, 1.0f, false);
+            expect (getNotesPlaying (synth) == Array<int> (-1, -1, -1));
+        }
+
+        beginTest ("Benchmark");
+        {
+            for (int numVoices : { 16, 64, 256 })
+            {
+                Synthesiser synth;
+                synth.addSound (new TestSound());
+                synth.setCurrentPlaybackSampleRate (44100.0);
+
+                MPESynthesiser mpeSynth;
+                mpeSynth.setCurrentPlaybackSampleRate (44100.0);
+                mpeSynth.setVoiceStealingEnabled (true);
+
+                for (int i = 0; i < numVoices; ++i)
+                {
+                    synth.addVoice (new TestVoice());
+                    mpeSynth.addVoice (new TestMPEVoice());
+                }
+
+                auto synthTime = timeDenseMidi (synth, false);
+                auto mpeTime = timeDenseMidi (mpeSynth, true);
+
+                logMessage (String (numVoices) + " voices, 200 events per 256-sample block: Synthesiser "
+                              + String (synthTime, 1) + " us, MPESynthesiser " + String (mpeTime, 1) + " us per block");
+            }
+        }
+    }
+};
+
+static VoiceNoteTableTests voiceNoteTableTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Keeps track of which of a synthesiser's voices were started on each midi note number.
+
+    Synthesiser and MPESynthesiser use this so that they can find the voices that are
+    playing a particular note without having to look through all of their voices. The
+    voices are referred to by their index in the synth's voice list.
+
+    The table only changes when setVoiceNote() is called, so if a voice stops playing on
+    its own, it'll still be listed until it's started on another note. That means that
+    callers must check that the voices they get back really are still playing the note
+    they're interested in.
+
+    None of the methods allocate memory apart from setNumVoices().
+
+    @tags{Audio}
+*/
+class JUCE_API  VoiceNoteTable
+{
+public:
+    //==============================================================================
+    /** Creates an empty table. */
+    VoiceNoteTable() noexcept;
+
+    //==============================================================================
+    /** Allocates space for a number of voices, and clears the table. */
+    void setNumVoices (int numVoices);
+
+    /** Returns the number of voices that the table has space for. */
+    int getNumVoices() const noexcept                           { return voiceNotes.size(); }
+
+    /** Records that a voice has started playing a note.
+        The voice is added to the end of that note's list, so each note's voices are kept in
+        the order in which they were started. Passing -1 as the note number removes the voice
+        from the table.
+    */
+    void setVoiceNote (int voiceIndex, int midiNoteNumber) noexcept;
+
+    /** Returns the note that a voice was last started on, or -1 if there isn't one. */
+    int getVoiceNote (int voiceIndex) const noexcept;
+
+    //==============================================================================
+    /** Returns the index of the first voice that was started on a note, or -1 if there
+        aren't any. Use getNextVoiceForSameNote() to find the rest of them.
+    */
+    int getFirstVoiceForNote (int midiNoteNumber) const noexcept;
+
+    /** Returns the index of the next voice that was started on the same note as this one,
+        or -1 if there aren't any more.
+    */
+    int getNextVoiceForSameNote (int voiceIndex) const noexcept;
+
+private:
+    //==============================================================================
+    Array<int> voiceNotes, nextVoice, previousVoice;
+    int firstVoiceForNote[128], lastVoiceForNote[128];
+
+    void removeVoice (int voiceIndex) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceNoteTable)
+};
+
+} // namespace juce
@@ -0,0 +1,573 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    static int roundUpToMultipleOf4 (int n) noexcept      { return (n + 3) & ~3; }
+
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 50 && term > sum * 1.0e-12; ++k)
+        {
+            auto t = x / (2.0 * k);
+            term *= t * t;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    // Calculates two dot products at once: a section of the input with two phases of the
+    // filter bank. The phases must be 16-byte aligned, and num must be a multiple of 4.
+    static forcedinline void dotProducts (const float* input, const float* phase1, const float* phase2,
+                                          int num, float& result1, float& result2) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        auto sum1 = _mm_setzero_ps();
+        auto sum2 = _mm_setzero_ps();
+
+        for (int i = 0; i < num; i += 4)
+        {
+            auto in = _mm_loadu_ps (input + i);
+            sum1 = _mm_add_ps (sum1, _mm_mul_ps (in, _mm_load_ps (phase1 + i)));
+            sum2 = _mm_add_ps (sum2, _mm_mul_ps (in, _mm_load_ps (phase2 + i)));
+        }
+
+        // adds up the four values in each sum, leaving sum1's total in element 0 and sum2's in element 1
+        auto low  = _mm_unpacklo_ps (sum1, sum2);
+        auto high = _mm_unpackhi_ps (sum1, sum2);
+        auto sums = _mm_add_ps (low, high);
+        sums = _mm_add_ps (sums, _mm_movehl_ps (sums, sums));
+
+        result1 = _mm_cvtss_f32 (sums);
+        result2 = _mm_cvtss_f32 (_mm_shuffle_ps (sums, sums, 1));
+       #elif JUCE_USE_ARM_NEON
+        auto sum1 = vdupq_n_f32 (0);
+        auto sum2 = vdupq_n_f32 (0);
+
+        for (int i = 0; i < num; i += 4)
+        {
+            auto in = vld1q_f32 (input + i);
+            sum1 = vmlaq_f32 (sum1, in, vld1q_f32 (phase1 + i));
+            sum2 = vmlaq_f32 (sum2, in, vld1q_f32 (phase2 + i));
+        }
+
+        auto pairs1 = vadd_f32 (vget_low_f32 (sum1), vget_high_f32 (sum1));
+        auto pairs2 = vadd_f32 (vget_low_f32 (sum2), vget_high_f32 (sum2));
+
+        result1 = vget_lane_f32 (vpadd_f32 (pairs1, pairs1), 0);
+        result2 = vget_lane_f32 (vpadd_f32 (pairs2, pairs2), 0);
+       #else
+        float sum1[4] = {}, sum2[4] = {};
+
+        for (int i = 0; i < num; i += 4)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                sum1[j] += input[i + j] * phase1[i + j];
+                sum2[j] += input[i + j] * phase2[i + j];
+            }
+        }
+
+        result1 = (sum1[0] + sum1[1]) + (sum1[2] + sum1[3]);
+        result2 = (sum2[0] + sum2[1]) + (sum2[2] + sum2[3]);
+       #endif
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (int numChannels, int zeroCrossings, double maximumSpeedRatio)
+    : numZeroCrossings (jmax (1, zeroCrossings)),
+      numChannelsAllocated (jmax (1, numChannels)),
+      windowSize (PolyphaseResamplerHelpers::roundUpToMultipleOf4 ((int) std::ceil (2.0 * numZeroCrossings * jmax (1.0, maximumSpeedRatio)))),
+      maxSpeedRatio (jmax (1.0, maximumSpeedRatio))
+{
+    // The prototype is one side of a Kaiser-windowed sinc, with its cutoff a little below
+    // Nyquist. The filter bank's phases are made by stretching and sampling it.
+    const double cutoff = 0.45, beta = 8.0;
+    auto numPrototypeSamples = numZeroCrossings * prototypeResolution;
+
+    prototype.malloc ((size_t) numPrototypeSamples + 2);
+
+    for (int i = 0; i <= numPrototypeSamples; ++i)
+    {
+        auto x = i / (double) prototypeResolution;
+        auto t = MathConstants<double>::pi * 2.0 * cutoff * x;
+        auto sinc = i == 0 ? 1.0 : std::sin (t) / t;
+        auto w = x / numZeroCrossings;
+
+        prototype[i] = (float) (sinc * PolyphaseResamplerHelpers::besselI0 (beta * std::sqrt (jmax (0.0, 1.0 - w * w)))
+                                     / PolyphaseResamplerHelpers::besselI0 (beta));
+    }
+
+    prototype[numPrototypeSamples + 1] = 0;
+
+    filterBankData.calloc ((size_t) (numPhases + 1) * (size_t) windowSize * sizeof (float) + 16);
+    filterBank = snapPointerToAlignment (reinterpret_cast<float*> (filterBankData.get()), 16);
+
+    history.malloc ((size_t) (numChannelsAllocated * windowSize * 2));
+    reset();
+    updateFilterBank (1.0);
+}
+
+PolyphaseResampler::~PolyphaseResampler() {}
+
+void PolyphaseResampler::reset (bool compensateForLatency) noexcept
+{
+    history.clear ((size_t) (numChannelsAllocated * windowSize * 2));
+    subSamplePos = 1.0 + (compensateForLatency ? getLatencyInSamples() : 0);
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept
+{
+    if (numOutputSamplesToProduce <= 0)
+        return 0;
+
+    return (int) (subSamplePos + speedRatio * (numOutputSamplesToProduce - 1)) + 1;
+}
+
+void PolyphaseResampler::updateFilterBank (double speedRatio) noexcept
+{
+    // The stretch is rounded up to the nearest 1/8, so that small changes in the
+    // ratio don't keep triggering a rebuild
+    auto stretch = jlimit (1.0, maxSpeedRatio, std::ceil (speedRatio * 8.0) / 8.0);
+
+    if (stretch == currentStretch)
+        return;
+
+    currentStretch = stretch;
+    numTaps = jmin (windowSize, PolyphaseResamplerHelpers::roundUpToMultipleOf4 ((int) std::ceil (2.0 * numZeroCrossings * stretch)));
+
+    auto centre = numTaps / 2 - 1;
+    auto scale = prototypeResolution / stretch;
+    auto limit = numZeroCrossings * prototypeResolution;
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        auto* coeffs = getPhase (phase);
+        auto offset = phase / (double) numPhases;
+        float sum = 0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            auto x = std::abs (i - centre - offset) * scale;
+            auto index = (int) x;
+            auto value = 0.0f;
+
+            if (index < limit)
+                value = prototype[index] + (float) (x - index) * (prototype[index + 1] - prototype[index]);
+
+            coeffs[i] = value;
+            sum += value;
+        }
+
+        // normalising each phase keeps the DC gain at exactly 1
+        FloatVectorOperations::multiply (coeffs, 1.0f / sum, numTaps);
+    }
+}
+
+int PolyphaseResampler::process (double speedRatio,
+                                 const float* const* inputChannels,
+                                 float* const* outputChannels,
+                                 int numChannels,
+                                 int numOutputSamplesToProduce) noexcept
+{
+    jassert (numChannels <= numChannelsAllocated);
+    jassert (speedRatio > 0);
+
+    numChannels = jmin (numChannels, numChannelsAllocated);
+    updateFilterBank (speedRatio);
+
+    auto tapOffset = (windowSize - numTaps) / 2;
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    // Each channel's history holds its last windowSize input samples, followed by space to
+    // append the first few new ones, so that the filter can run across the join.
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            if (numUsed < windowSize)
+                for (int chan = 0; chan < numChannels; ++chan)
+                    getHistory (chan)[windowSize + numUsed] = inputChannels[chan][numUsed];
+
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        auto phasePos = pos * numPhases;
+        auto phase = (int) phasePos;
+        auto alpha = (float) (phasePos - phase);
+        auto* phase1 = getPhase (phase);
+        auto* phase2 = getPhase (phase + 1);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto* window = numUsed < windowSize ? getHistory (chan) + numUsed
+                                                : inputChannels[chan] + (numUsed - windowSize);
+            float result1, result2;
+            PolyphaseResamplerHelpers::dotProducts (window + tapOffset, phase1, phase2, numTaps, result1, result2);
+
+            outputChannels[chan][i] = result1 + alpha * (result2 - result1);
+        }
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        auto* h = getHistory (chan);
+
+        if (numUsed >= windowSize)
+            FloatVectorOperations::copy (h, inputChannels[chan] + (numUsed - windowSize), windowSize);
+        else
+            memmove (h, h + numUsed, (size_t) windowSize * sizeof (float));
+    }
+
+    return numUsed;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PolyphaseResamplerTests  : public UnitTest
+{
+public:
+    PolyphaseResamplerTests()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Passes a band-limited signal through unchanged at a ratio of 1");
+        {
+            auto input = makeSine (0.05, 4096);
+            auto output = resample (1.0, input, 3000);
+
+            expectLessThan (getMaxError (output, 1.0, 0.05, 64), 1.0e-3f);
+        }
+
+        beginTest ("Resamples sine waves accurately");
+        {
+            for (auto ratio : { 0.31, 0.5, 0.9187, 1.5, 2.7 })
+            {
+                auto input = makeSine (0.1, 8192);
+                auto numOut = (int) (6000 / ratio);
+                auto output = resample (ratio, input, numOut);
+
+                expectLessThan (getMaxError (output, ratio, 0.1, (int) (64 / ratio)), 1.0e-3f);
+            }
+        }
+
+        beginTest ("Removes frequencies above the new Nyquist");
+        {
+            auto input = makeSine (0.35, 8192);
+            auto output = resample (2.0, input, 3000);
+
+            auto peak = FloatVectorOperations::findMinAndMax (output.getRawDataPointer() + 100, 2800);
+            expectLessThan (jmax (-peak.getStart(), peak.getEnd()), 1.0e-3f);
+        }
+
+        beginTest ("Gives the same results when processed in blocks");
+        {
+            auto random = getRandom();
+            auto input = makeSine (0.07, 16384);
+            const double ratio = 1.37;
+            auto expected = resample (ratio, input, 10000);
+
+            PolyphaseResampler resampler (1);
+            resampler.reset (true);
+
+            Array<float> output;
+            output.resize (10000);
+            int numUsed = 0, numDone = 0;
+
+            while (numDone < output.size())
+            {
+                auto numToDo = jmin (output.size() - numDone, random.nextInt (300));
+                auto numNeeded = resampler.getNumInputSamplesNeeded (ratio, numToDo);
+                expect (numUsed + numNeeded <= input.size());
+
+                const float* in = input.getRawDataPointer() + numUsed;
+                float* out = output.getRawDataPointer() + numDone;
+                auto used = resampler.process (ratio, &in, &out, 1, numToDo);
+
+                expect (used <= numNeeded);
+                numUsed += used;
+                numDone += numToDo;
+            }
+
+            for (int i = 0; i < output.size(); ++i)
+                expectWithinAbsoluteError (output[i], expected[i], 1.0e-6f);
+        }
+
+        beginTest ("Follows changes to the ratio");
+        {
+            auto input = makeSine (0.02, 32768);
+            PolyphaseResampler resampler (1);
+            resampler.reset (true);
+
+            const float* in = input.getRawDataPointer();
+            HeapBlock<float> block (256);
+            double position = 0;
+            float maxError = 0;
+
+            for (int i = 0; i < 60; ++i)
+            {
+                auto ratio = 0.8 + i * 0.04;
+                float* out = block.get();
+                in += resampler.process (ratio, &in, &out, 1, 256);
+
+                for (int j = 0; j < 256; ++j)
+                {
+                    if (position > 64)
+                        maxError = jmax (maxError, std::abs (block[j] - (float) std::sin (MathConstants<double>::twoPi * 0.02 * position)));
+
+                    position += ratio;
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-3f);
+        }
+
+        beginTest ("ResamplingAudioSource uses the polyphase resampler");
+        {
+            AudioBuffer<float> source (2, 32768);
+
+            for (int chan = 0; chan < source.getNumChannels(); ++chan)
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    source.setSample (chan, i, (float) std::sin (MathConstants<double>::twoPi * 0.03 * i));
+
+            ResamplingAudioSource resamplingSource (new MemoryAudioSource (source, false), true, 2);
+            resamplingSource.setResamplingRatio (1.5);
+            resamplingSource.setPolyphaseResamplingEnabled (true);
+            expect (resamplingSource.isPolyphaseResamplingEnabled());
+            resamplingSource.prepareToPlay (512, 48000.0);
+
+            AudioBuffer<float> block (2, 512);
+            float maxError = 0;
+
+            for (int i = 0; i < 30; ++i)
+            {
+                resamplingSource.getNextAudioBlock (AudioSourceChannelInfo (block));
+
+                for (int j = 0; j < block.getNumSamples(); ++j)
+                {
+                    auto position = (i * block.getNumSamples() + j) * 1.5;
+
+                    if (position > 64)
+                        for (int chan = 0; chan < block.getNumChannels(); ++chan)
+                            maxError = jmax (maxError, std::abs (block.getSample (chan, j)
+                                                                   - (float) std::sin (MathConstants<double>::twoPi * 0.03 * position)));
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-3f);
+            resamplingSource.releaseResources();
+        }
+
+        beginTest ("Benchmark");
+        {
+            const int numOutputSamples = 1 << 20;
+            const double frequency = 0.1;
+
+            for (auto ratio : { 0.726, 1.088, 2.0 })
+            {
+                auto input = makeSine (frequency, (int) (numOutputSamples * ratio) + 4096);
+
+                // When downsampling, also add a tone above the new Nyquist frequency, so
+                // that anything that aliases back into the output counts as noise
+                if (ratio > 1.0)
+                {
+                    auto aliasingFrequency = 0.25 * (1.0 + 1.0 / ratio);
+
+                    for (int i = 0; i < input.size(); ++i)
+                        input.getReference (i) += (float) std::sin (MathConstants<double>::twoPi * aliasingFrequency * i);
+                }
+                Array<float> output;
+                output.resize (numOutputSamples);
+
+                auto report = [&] (const String& resamplerName, double seconds)
+                {
+                    logMessage ("Ratio " + String (ratio) + ", " + resamplerName + ": SNR "
+                                  + String (getSignalToNoiseRatio (output, frequency * ratio), 1) + " dB, "
+                                  + String (numOutputSamples / (seconds * 1.0e6), 1) + " million samples/s");
+                };
+
+                {
+                    AudioBuffer<float> source (1, input.size());
+                    source.copyFrom (0, 0, input.getRawDataPointer(), input.size());
+
+                    ResamplingAudioSource resamplingSource (new MemoryAudioSource (source, false), true, 1);
+                    resamplingSource.setResamplingRatio (ratio);
+                    resamplingSource.prepareToPlay (blockSize, 48000.0);
+
+                    auto seconds = timeInBlocks (output, [&] (float* out, int numSamples)
+                    {
+                        AudioBuffer<float> block (&out, 1, numSamples);
+                        resamplingSource.getNextAudioBlock (AudioSourceChannelInfo (block));
+                    });
+
+                    report ("ResamplingAudioSource", seconds);
+                    resamplingSource.releaseResources();
+                }
+
+                {
+                    PolyphaseResampler resampler (1);
+                    resampler.reset (true);
+                    const float* in = input.getRawDataPointer();
+
+                    auto seconds = timeInBlocks (output, [&] (float* out, int numSamples)
+                    {
+                        in += resampler.process (ratio, &in, &out, 1, numSamples);
+                    });
+
+                    report ("PolyphaseResampler", seconds);
+                }
+
+                {
+                    LagrangeInterpolator interpolator;
+                    const float* in = input.getRawDataPointer();
+
+                    auto seconds = timeInBlocks (output, [&] (float* out, int numSamples)
+                    {
+                        in += interpolator.process (ratio, in, out, numSamples);
+                    });
+
+                    report ("LagrangeInterpolator", seconds);
+                }
+
+                {
+                    WindowedSincInterpolator interpolator;
+                    const float* in = input.getRawDataPointer();
+
+                    auto seconds = timeInBlocks (output, [&] (float* out, int numSamples)
+                    {
+                        in += interpolator.process (ratio, in, out, numSamples);
+                    });
+
+                    report ("WindowedSincInterpolator", seconds);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr int blockSize = 512;
+
+    template <typename ProcessBlock>
+    static double timeInBlocks (Array<float>& output, ProcessBlock&& processBlock)
+    {
+        auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < output.size(); i += blockSize)
+            processBlock (output.getRawDataPointer() + i, jmin (blockSize, output.size() - i));
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+    }
+
+    // Fits a sine wave of the expected frequency to the output, with any phase, and
+    // compares its power with whatever is left over, so that resamplers with different
+    // latencies and phase responses can be compared fairly
+    static double getSignalToNoiseRatio (const Array<float>& output, double frequency)
+    {
+        const int numToSkip = 1024;
+        double sinSum = 0, cosSum = 0;
+
+        for (int i = numToSkip; i < output.size(); ++i)
+        {
+            auto phase = MathConstants<double>::twoPi * frequency * i;
+            sinSum += output[i] * std::sin (phase);
+            cosSum += output[i] * std::cos (phase);
+        }
+
+        auto numSamples = output.size() - numToSkip;
+        auto sinAmount = 2.0 * sinSum / numSamples;
+        auto cosAmount = 2.0 * cosSum / numSamples;
+        double noisePower = 0;
+
+        for (int i = numToSkip; i < output.size(); ++i)
+        {
+            auto phase = MathConstants<double>::twoPi * frequency * i;
+            auto error = output[i] - (sinAmount * std::sin (phase) + cosAmount * std::cos (phase));
+            noisePower += error * error;
+        }
+
+        auto signalPower = 0.5 * (sinAmount * sinAmount + cosAmount * cosAmount) * numSamples;
+        return 10.0 * std::log10 (signalPower / jmax (noisePower, 1.0e-30));
+    }
+
+    static Array<float> makeSine (double frequency, int numSamples)
+    {
+        Array<float> samples;
+
+        for (int i = 0; i < numSamples; ++i)
+            samples.add ((float) std::sin (MathConstants<double>::twoPi * frequency * i));
+
+        return samples;
+    }
+
+    static Array<float> resample (double ratio, const Array<float>& input, int numOutputSamples)
+    {
+        PolyphaseResampler resampler (1);
+        resampler.reset (true);
+
+        jassert (resampler.getNumInputSamplesNeeded (ratio, numOutputSamples) <= input.size());
+
+        Array<float> output;
+        output.resize (numOutputSamples);
+
+        const float* in = input.getRawDataPointer();
+        float* out = output.getRawDataPointer();
+        resampler.process (ratio, &in, &out, 1, numOutputSamples);
+
+        return output;
+    }
+
+    // Compares the output with the ideal sine wave, ignoring the first few samples, where
+    // the filter is still running into the start of the signal
+    static float getMaxError (const Array<float>& output, double ratio, double frequency, int numToSkip)
+    {
+        float maxError = 0;
+
+        for (int i = numToSkip; i < output.size(); ++i)
+            maxError = jmax (maxError, std::abs (output[i] - (float) std::sin (MathConstants<double>::twoPi * frequency * i * ratio)));
+
+        return maxError;
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high-quality resampler for multi-channel streams of floats, which uses a
+    polyphase bank of windowed-sinc filters.
+
+    Unlike the interpolators in the Interpolators class, this low-pass filters the
+    signal properly, so it can be used to change the sample rate of a stream
+    without aliasing. The speed ratio can be changed on every call to process().
+    When it's above 1.0 the filter's cutoff is moved down to suit, and the filter
+    bank is recalculated, but this doesn't allocate any memory.
+
+    Each output sample is calculated by taking the dot product of a section of the
+    input with the two nearest phases of the filter bank, and interpolating between
+    the results. The filter bank is stored in aligned rows so that this can be done
+    with SIMD instructions.
+
+    Like the interpolators, the resampler is stateful, so when there's a break in the
+    continuity of the input stream you should call reset() before feeding it any
+    new data.
+
+    @see ResamplingAudioSource, Interpolators
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** Creates a resampler.
+
+        @param numChannels          the maximum number of channels that process() will be given
+        @param numZeroCrossings     the number of zero-crossings on each side of the filter kernel.
+                                    Higher values give a steeper filter, but use more CPU
+        @param maximumSpeedRatio    the highest speed ratio that the filter will be adjusted for.
+                                    Above this ratio, the filter can't be made any narrower, so
+                                    some aliasing will creep in
+    */
+    explicit PolyphaseResampler (int numChannels,
+                                 int numZeroCrossings = 32,
+                                 double maximumSpeedRatio = 4.0);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Returns the delay, in input samples, between a sample going in and coming out
+        of the resampler.
+        If you call reset() with compensateForLatency set to true, this delay is skipped.
+    */
+    int getLatencyInSamples() const noexcept                    { return windowSize / 2; }
+
+    /** Resets the state of the resampler.
+
+        Call this when there's a break in the continuity of the input data stream.
+
+        If compensateForLatency is true, the next call to process() will read an extra
+        getLatencyInSamples() samples of input before producing any output, so that the
+        first output sample lines up with the first input sample.
+    */
+    void reset (bool compensateForLatency = false) noexcept;
+
+    /** Returns the number of input samples that the next call to process() will need
+        to be given in order to produce a block of output.
+        This can be one more than process() actually uses, because of rounding.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept;
+
+    /** Resamples some blocks of samples.
+
+        @param speedRatio                   the number of input samples to use for each output sample
+        @param inputChannels                the source data to read from. Each channel must contain
+                                            enough samples for the number of outputs requested, as
+                                            returned by getNumInputSamplesNeeded()
+        @param outputChannels               the buffers to write the results into
+        @param numChannels                  the number of channels to process
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* const* inputChannels,
+                 float* const* outputChannels,
+                 int numChannels,
+                 int numOutputSamplesToProduce) noexcept;
+
+private:
+    //==============================================================================
+    enum
+    {
+        numPhases = 256,
+        prototypeResolution = 512
+    };
+
+    const int numZeroCrossings, numChannelsAllocated, windowSize;
+    const double maxSpeedRatio;
+
+    HeapBlock<float> prototype, history;
+    HeapBlock<char> filterBankData;
+    float* filterBank = nullptr;
+
+    double subSamplePos = 1.0, currentStretch = 0;
+    int numTaps = 0;
+
+    void updateFilterBank (double speedRatio) noexcept;
+    float* getPhase (int phase) const noexcept          { return filterBank + phase * windowSize; }
+    float* getHistory (int channel) const noexcept      { return history + channel * windowSize * 2; }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
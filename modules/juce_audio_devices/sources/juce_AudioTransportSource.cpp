@@ -80,6 +80,9 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         else
             newMasterSource = newPositionableSource;
 
+        if (newResamplerSource != nullptr)
+            newResamplerSource->setPolyphaseResamplingEnabled (usePolyphaseResampler);
+
         if (isPrepared)
         {
             if (newResamplerSource != nullptr && sourceSampleRate > 0 && sampleRate > 0)
@@ -208,6 +211,16 @@ void AudioTransportSource::setGain (const float newGain) noexcept
     gain = newGain;
 }
 
+void AudioTransportSource::setPolyphaseResamplingEnabled (bool shouldUsePolyphaseResampler)
+{
+    const ScopedLock sl (callbackLock);
+
+    usePolyphaseResampler = shouldUsePolyphaseResampler;
+
+    if (resamplerSource != nullptr)
+        resamplerSource->setPolyphaseResamplingEnabled (shouldUsePolyphaseResampler);
+}
+
 void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
 {
     const ScopedLock sl (callbackLock);
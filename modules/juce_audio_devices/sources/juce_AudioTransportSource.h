@@ -134,6 +134,20 @@ public:
     */
     float getGain() const noexcept      { return gain; }
 
+    //==============================================================================
+    /** Chooses whether sample-rate correction should use a windowed-sinc polyphase
+        resampler rather than the default linear interpolation.
+
+        This applies to the current source and to any that are set later.
+        @see ResamplingAudioSource::setPolyphaseResamplingEnabled
+    */
+    void setPolyphaseResamplingEnabled (bool shouldUsePolyphaseResampler);
+
+    /** Returns true if the polyphase resampler is being used for sample-rate correction.
+        @see setPolyphaseResamplingEnabled
+    */
+    bool isPolyphaseResamplingEnabled() const noexcept      { return usePolyphaseResampler; }
+
     //==============================================================================
     /** Implementation of the AudioSource method. */
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
@@ -170,7 +184,7 @@ private:
     std::atomic<bool> playing { false }, stopped { true };
     double sampleRate = 44100.0, sourceSampleRate = 0;
     int blockSize = 128, readAheadBufferSize = 0;
-    bool isPrepared = false, inputStreamEOF = false;
+    bool isPrepared = false, inputStreamEOF = false, usePolyphaseResampler = false;
 
     void releaseMasterResources();
 
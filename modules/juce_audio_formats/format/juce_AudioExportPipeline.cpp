@@ -0,0 +1,621 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioExportPipeline::Block
+{
+    Block (int numChannels, int samplesPerBlock, bool needsIntegerData)
+        : floatData (numChannels, samplesPerBlock)
+    {
+        channels.calloc ((size_t) numChannels + 1);
+
+        if (needsIntegerData)
+        {
+            intData.malloc ((size_t) (numChannels * samplesPerBlock));
+
+            for (int i = 0; i < numChannels; ++i)
+                channels[i] = intData + i * samplesPerBlock;
+        }
+        else
+        {
+            // floating-point writers take their data as floats, disguised as ints
+            for (int i = 0; i < numChannels; ++i)
+                channels[i] = reinterpret_cast<const int*> (floatData.getReadPointer (i));
+        }
+    }
+
+    size_t getSizeInBytes() const noexcept
+    {
+        auto numValues = (size_t) (floatData.getNumChannels() * floatData.getNumSamples());
+        return numValues * sizeof (float) + (intData != nullptr ? numValues * sizeof (int) : 0);
+    }
+
+    enum class State
+    {
+        empty,
+        rendered,
+        converted
+    };
+
+    AudioBuffer<float> floatData;
+    HeapBlock<int> intData;
+    HeapBlock<const int*> channels;
+    int numSamples = 0;
+    State state = State::empty;
+
+    JUCE_DECLARE_NON_COPYABLE (Block)
+};
+
+struct AudioExportPipeline::Stream
+{
+    std::unique_ptr<Source> source;
+    std::unique_ptr<AudioFormatWriter> writer;
+    OwnedArray<Block> blocks;
+
+    int64 length = 0, nextRenderPosition = 0;
+    std::atomic<int64> numSamplesWritten { 0 };
+    int nextBlockToRender = 0, nextBlockToEncode = 0;
+    bool isRendering = false, isEncoding = false, isFinished = false;
+    std::atomic<bool> failed { false };
+
+    CriticalSection lock;
+};
+
+//==============================================================================
+AudioExportPipeline::AudioExportPipeline (ThreadPool& threadPool, int samplesPerBlock, int numBlocks)
+    : pool (threadPool),
+      blockSize (samplesPerBlock),
+      numBlocksPerStream (numBlocks)
+{
+    jassert (blockSize > 0 && numBlocksPerStream > 0);
+}
+
+AudioExportPipeline::~AudioExportPipeline()
+{
+    cancel();
+}
+
+int AudioExportPipeline::addStream (Source* source, AudioFormatWriter* writer, int64 totalNumSamples)
+{
+    // Streams can't be added once the export has started
+    jassert (! started);
+
+    std::unique_ptr<Source> sourceToUse (source);
+    std::unique_ptr<AudioFormatWriter> writerToUse (writer);
+
+    if (source == nullptr || writer == nullptr)
+    {
+        jassertfalse;
+        return -1;
+    }
+
+    auto* stream = new Stream();
+    stream->source = std::move (sourceToUse);
+    stream->writer = std::move (writerToUse);
+    stream->length = jmax ((int64) 0, totalNumSamples);
+
+    for (int i = 0; i < numBlocksPerStream; ++i)
+        stream->blocks.add (new Block ((int) writer->getNumChannels(), blockSize, ! writer->isFloatingPoint()));
+
+    streams.add (stream);
+    return streams.size() - 1;
+}
+
+int AudioExportPipeline::addStream (Source* source,
+                                    AudioFormatManager& formatManager,
+                                    const File& file,
+                                    double sampleRate,
+                                    int numChannels,
+                                    int bitsPerSample,
+                                    int qualityOptionIndex,
+                                    int64 totalNumSamples)
+{
+    std::unique_ptr<Source> sourceToUse (source);
+
+    if (auto* format = formatManager.findFormatForFileExtension (file.getFileExtension()))
+    {
+        file.deleteFile();
+
+        if (auto out = file.createOutputStream())
+        {
+            if (auto* writer = format->createWriterFor (out.get(), sampleRate, (unsigned int) numChannels,
+                                                        bitsPerSample, {}, qualityOptionIndex))
+            {
+                out.release();
+                return addStream (sourceToUse.release(), writer, totalNumSamples);
+            }
+        }
+    }
+
+    return -1;
+}
+
+int AudioExportPipeline::getNumStreams() const noexcept
+{
+    return streams.size();
+}
+
+//==============================================================================
+void AudioExportPipeline::start()
+{
+    jassert (! started);
+
+    started = true;
+    finishedEvent.reset();
+    numStreamsUnfinished = streams.size();
+
+    if (streams.isEmpty())
+        finishedEvent.signal();
+
+    for (auto* stream : streams)
+    {
+        if (stream->length == 0)
+        {
+            stream->isFinished = true;
+            streamFinished (*stream, false);
+        }
+        else
+        {
+            const ScopedLock sl (stream->lock);
+            scheduleJobs (*stream);
+        }
+    }
+}
+
+void AudioExportPipeline::cancel()
+{
+    cancelled = true;
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (jobCountLock);
+
+            if (numJobsRunning == 0)
+                break;
+        }
+
+        jobsFinishedEvent.wait (10);
+    }
+
+    finishedEvent.signal();
+}
+
+bool AudioExportPipeline::waitUntilFinished (int timeoutMilliseconds)
+{
+    jassert (started);
+
+    return finishedEvent.wait (timeoutMilliseconds) && isFinished();
+}
+
+bool AudioExportPipeline::isFinished() const noexcept
+{
+    return started && numStreamsUnfinished.load() == 0;
+}
+
+double AudioExportPipeline::getProgress (int streamIndex) const noexcept
+{
+    if (auto* stream = streams[streamIndex])
+        return stream->length > 0 ? (double) stream->numSamplesWritten.load() / (double) stream->length : 1.0;
+
+    return 0.0;
+}
+
+double AudioExportPipeline::getOverallProgress() const noexcept
+{
+    int64 totalWritten = 0, totalLength = 0;
+
+    for (auto* stream : streams)
+    {
+        totalWritten += stream->numSamplesWritten.load();
+        totalLength  += stream->length;
+    }
+
+    return totalLength > 0 ? (double) totalWritten / (double) totalLength : 1.0;
+}
+
+bool AudioExportPipeline::hasStreamFailed (int streamIndex) const noexcept
+{
+    if (auto* stream = streams[streamIndex])
+        return stream->failed;
+
+    return false;
+}
+
+size_t AudioExportPipeline::getBufferSizeInBytes() const noexcept
+{
+    size_t total = 0;
+
+    for (auto* stream : streams)
+        for (auto* block : stream->blocks)
+            total += block->getSizeInBytes();
+
+    return total;
+}
+
+//==============================================================================
+void AudioExportPipeline::addJob (std::function<void()> job)
+{
+    {
+        const ScopedLock sl (jobCountLock);
+        ++numJobsRunning;
+    }
+
+    pool.addJob ([this, job]
+                 {
+                     if (! cancelled)
+                         job();
+
+                     const ScopedLock sl (jobCountLock);
+
+                     if (--numJobsRunning == 0)
+                         jobsFinishedEvent.signal();
+                 });
+}
+
+// Must be called with the stream's lock held. Starts rendering the next block if there's
+// space for it, and starts encoding if the next block to encode is ready. Each stream has
+// at most one job of each of these kinds at a time, because its source and writer can
+// only be used by one thread at once.
+void AudioExportPipeline::scheduleJobs (Stream& stream)
+{
+    if (cancelled || stream.isFinished)
+        return;
+
+    if (! stream.isRendering
+         && stream.nextRenderPosition < stream.length
+         && stream.blocks.getUnchecked (stream.nextBlockToRender)->state == Block::State::empty)
+    {
+        stream.isRendering = true;
+        addJob ([this, &stream] { renderBlock (stream); });
+    }
+
+    if (! stream.isEncoding
+         && stream.blocks.getUnchecked (stream.nextBlockToEncode)->state == Block::State::converted)
+    {
+        stream.isEncoding = true;
+        addJob ([this, &stream] { encodeBlocks (stream); });
+    }
+}
+
+void AudioExportPipeline::renderBlock (Stream& stream)
+{
+    Block* block;
+    int64 startSample;
+    int numSamples;
+
+    {
+        const ScopedLock sl (stream.lock);
+        block = stream.blocks.getUnchecked (stream.nextBlockToRender);
+        startSample = stream.nextRenderPosition;
+        numSamples = (int) jmin ((int64) blockSize, stream.length - startSample);
+    }
+
+    AudioBuffer<float> buffer (block->floatData.getArrayOfWritePointers(),
+                               block->floatData.getNumChannels(), numSamples);
+
+    stream.source->renderNextBlock (buffer, startSample);
+
+    const ScopedLock sl (stream.lock);
+
+    block->numSamples = numSamples;
+    block->state = Block::State::rendered;
+    stream.nextRenderPosition += numSamples;
+    stream.nextBlockToRender = (stream.nextBlockToRender + 1) % numBlocksPerStream;
+    stream.isRendering = false;
+
+    addJob ([this, &stream, block] { convertBlock (stream, *block); });
+    scheduleJobs (stream);
+}
+
+void AudioExportPipeline::convertBlock (Stream& stream, Block& block)
+{
+    if (block.intData != nullptr)
+        for (int i = 0; i < block.floatData.getNumChannels(); ++i)
+            convertFloatsToInts (block.intData + i * blockSize, block.floatData.getReadPointer (i), block.numSamples, nullptr);
+
+    const ScopedLock sl (stream.lock);
+
+    block.state = Block::State::converted;
+    scheduleJobs (stream);
+}
+
+void AudioExportPipeline::encodeBlocks (Stream& stream)
+{
+    for (;;)
+    {
+        Block* block;
+
+        {
+            const ScopedLock sl (stream.lock);
+            block = stream.blocks.getUnchecked (stream.nextBlockToEncode);
+
+            if (cancelled || block->state != Block::State::converted)
+            {
+                stream.isEncoding = false;
+                return;
+            }
+        }
+
+        auto ok = stream.writer->write (block->channels, block->numSamples);
+        bool isComplete;
+
+        {
+            const ScopedLock sl (stream.lock);
+
+            stream.numSamplesWritten += block->numSamples;
+            block->state = Block::State::empty;
+            stream.nextBlockToEncode = (stream.nextBlockToEncode + 1) % numBlocksPerStream;
+
+            isComplete = ! ok || stream.numSamplesWritten.load() >= stream.length;
+
+            if (isComplete)
+            {
+                stream.isFinished = true;
+                stream.isEncoding = false;
+            }
+            else
+            {
+                scheduleJobs (stream);
+            }
+        }
+
+        if (isComplete)
+        {
+            streamFinished (stream, ! ok);
+            return;
+        }
+    }
+}
+
+void AudioExportPipeline::streamFinished (Stream& stream, bool failed)
+{
+    stream.failed = failed;
+
+    // deleting the writer finishes off its file
+    stream.writer.reset();
+
+    if (--numStreamsUnfinished == 0)
+        finishedEvent.signal();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioExportPipelineTests  : public UnitTest
+{
+    AudioExportPipelineTests()
+        : UnitTest ("AudioExportPipeline", UnitTestCategories::audio)
+    {}
+
+    struct TestSource  : public AudioExportPipeline::Source
+    {
+        TestSource (int seedToUse, int msToWait = 0) : seed (seedToUse), waitMs (msToWait) {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int64 startSample) override
+        {
+            // the blocks must arrive in order
+            jassert (startSample == nextStartSample);
+            nextStartSample = startSample + buffer.getNumSamples();
+
+            fill (buffer, startSample, seed);
+
+            if (waitMs > 0)
+                Thread::sleep (waitMs);
+        }
+
+        static void fill (AudioBuffer<float>& buffer, int64 startSample, int seed)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (ch, i, 0.9f * (float) std::sin ((double) (startSample + i) * 0.001 * (seed + 1) + ch));
+        }
+
+        int seed, waitMs;
+        int64 nextStartSample = 0;
+    };
+
+    struct FailingWriter  : public AudioFormatWriter
+    {
+        FailingWriter() : AudioFormatWriter (nullptr, "Failing", 44100.0, 1, 16) {}
+        bool write (const int**, int) override   { return false; }
+    };
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+        WavAudioFormat wav;
+        FlacAudioFormat flac;
+
+        beginTest ("Exported files match files written directly");
+        {
+            struct Format { AudioFormat& format; int bitsPerSample; };
+            Format formats[] = { { wav, 16 }, { wav, 32 }, { flac, 24 } };
+            Array<int64> lengths { 0, 1, 999, 1000, 2500, 10000 };
+
+            OwnedArray<MemoryBlock> results, expected;
+            AudioExportPipeline pipeline (pool, 1000, 3);
+
+            for (int i = 0; i < lengths.size() * numElementsInArray (formats); ++i)
+            {
+                auto length = lengths[i % lengths.size()];
+                auto& format = formats[i / lengths.size()];
+
+                auto* result = results.add (new MemoryBlock());
+                auto index = pipeline.addStream (new TestSource (i),
+                                                 createWriter (format.format, *result, format.bitsPerSample),
+                                                 length);
+                expectEquals (index, i);
+
+                AudioBuffer<float> content (2, (int) length);
+                TestSource::fill (content, 0, i);
+
+                std::unique_ptr<AudioFormatWriter> writer (createWriter (format.format, *expected.add (new MemoryBlock()), format.bitsPerSample));
+                writer->writeFromAudioSampleBuffer (content, 0, content.getNumSamples());
+            }
+
+            expectEquals (pipeline.getBufferSizeInBytes(),
+                          (size_t) (lengths.size() * 3 * 2 * 1000) * (sizeof (float) * 3 + sizeof (int) * 2));
+
+            pipeline.start();
+            expect (pipeline.waitUntilFinished (20000));
+            expectEquals (pipeline.getOverallProgress(), 1.0);
+
+            for (int i = 0; i < results.size(); ++i)
+            {
+                expect (*results[i] == *expected[i]);
+                expectEquals (pipeline.getProgress (i), 1.0);
+                expect (! pipeline.hasStreamFailed (i));
+            }
+        }
+
+        beginTest ("Files can be written using an AudioFormatManager");
+        {
+            AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+
+            TemporaryFile file (".flac");
+
+            {
+                AudioExportPipeline pipeline (pool);
+                expectEquals (pipeline.addStream (new TestSource (1), formatManager, file.getFile(), 44100.0, 2, 16, 0, 50000), 0);
+                expectEquals (pipeline.addStream (new TestSource (1), formatManager, file.getFile().withFileExtension ("xyz"), 44100.0, 2, 16, 0, 50000), -1);
+
+                pipeline.start();
+                expect (pipeline.waitUntilFinished (20000));
+            }
+
+            std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (file.getFile()));
+            expect (reader != nullptr);
+            expectEquals (reader->lengthInSamples, (int64) 50000);
+            expectEquals ((int) reader->numChannels, 2);
+        }
+
+        beginTest ("Failed writes are reported");
+        {
+            AudioExportPipeline pipeline (pool, 1000, 3);
+            pipeline.addStream (new TestSource (1), new FailingWriter(), 10000);
+
+            pipeline.start();
+            expect (pipeline.waitUntilFinished (20000));
+            expect (pipeline.hasStreamFailed (0));
+        }
+
+        beginTest ("Exports can be cancelled");
+        {
+            MemoryBlock result;
+            AudioExportPipeline pipeline (pool, 1000, 3);
+            pipeline.addStream (new TestSource (1, 5), createWriter (wav, result, 16), 1000000);
+
+            pipeline.start();
+            expect (! pipeline.waitUntilFinished (50));
+
+            pipeline.cancel();
+            expect (! pipeline.isFinished());
+
+            auto progress = pipeline.getProgress (0);
+            expect (progress < 1.0);
+            Thread::sleep (20);
+            expectEquals (pipeline.getProgress (0), progress);
+        }
+
+        beginTest ("Pipelines can be deleted as soon as they're cancelled");
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                OwnedArray<MemoryBlock> results;
+                std::unique_ptr<AudioExportPipeline> pipeline (new AudioExportPipeline (pool, 100, 2));
+
+                for (int j = 0; j < 3; ++j)
+                    pipeline->addStream (new TestSource (j), createWriter (wav, *results.add (new MemoryBlock()), 16), 100000);
+
+                pipeline->start();
+
+                if (i % 2 == 0)
+                    pipeline->cancel();
+
+                pipeline.reset();
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            const int numStreams = 4, length = 200000, samplesPerBlock = 4096;
+
+            for (auto* format : { static_cast<AudioFormat*> (&wav), static_cast<AudioFormat*> (&flac) })
+            {
+                OwnedArray<MemoryBlock> results;
+
+                auto directStart = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numStreams; ++i)
+                {
+                    std::unique_ptr<AudioFormatWriter> writer (createWriter (*format, *results.add (new MemoryBlock()), 24));
+                    TestSource source (i);
+                    AudioBuffer<float> block (2, samplesPerBlock);
+
+                    for (int pos = 0; pos < length; pos += samplesPerBlock)
+                    {
+                        AudioBuffer<float> buffer (block.getArrayOfWritePointers(), 2, jmin (samplesPerBlock, length - pos));
+                        source.renderNextBlock (buffer, pos);
+                        writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+                    }
+                }
+
+                auto directSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - directStart);
+
+                results.clear();
+                AudioExportPipeline pipeline (pool, samplesPerBlock, 4);
+
+                for (int i = 0; i < numStreams; ++i)
+                    pipeline.addStream (new TestSource (i), createWriter (*format, *results.add (new MemoryBlock()), 24), length);
+
+                auto pipelineStart = Time::getHighResolutionTicks();
+                pipeline.start();
+                expect (pipeline.waitUntilFinished (60000));
+                auto pipelineSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - pipelineStart);
+
+                logMessage (format->getFormatName() + ", " + String (numStreams) + " streams of " + String (length)
+                              + " stereo samples at 24 bits: one at a time " + String (roundToInt (directSeconds * 1000.0))
+                              + " ms, pipeline with " + String (pool.getNumThreads()) + " threads "
+                              + String (roundToInt (pipelineSeconds * 1000.0)) + " ms");
+            }
+        }
+    }
+
+    static AudioFormatWriter* createWriter (AudioFormat& format, MemoryBlock& block, int bitsPerSample)
+    {
+        return format.createWriterFor (new MemoryOutputStream (block, false), 44100.0, 2, bitsPerSample, {}, 0);
+    }
+};
+
+static AudioExportPipelineTests audioExportPipelineTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes many audio files at once, spreading the work across a ThreadPool.
+
+    Each stream that you add has a Source, which renders its audio, and an
+    AudioFormatWriter which encodes it. A stream's audio is handled in blocks,
+    and each block moves through three stages:
+    - the Source renders it into a float buffer
+    - it's converted into the sample format that the writer needs
+    - the writer encodes it and writes it to its stream
+
+    Each stage runs as a separate job on the pool, so while one block of a stream
+    is being encoded, the next one can be converted and the one after that rendered.
+    The jobs for all the streams share the pool's threads, so exporting a large
+    number of stems can keep every core busy, even though each writer (FLAC, Ogg,
+    etc.) can only encode its own stream on one thread at a time.
+
+    Every stream has a fixed number of blocks, which are all allocated when it's
+    added, so the amount of memory used doesn't depend on how fast the sources
+    and writers run compared to each other. If a writer falls behind, its source
+    will just wait until a block is free.
+
+    Unlike AudioFormatWriter::ThreadedWriter, which buffers a stream that's being
+    written in real-time, this is intended for offline exports, where the sources
+    can render as fast as the writers can consume the data.
+
+    @see AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioExportPipeline
+{
+public:
+    //==============================================================================
+    /** Provides the audio for one of the streams in an AudioExportPipeline. */
+    class JUCE_API  Source
+    {
+    public:
+        /** Destructor. */
+        virtual ~Source() = default;
+
+        /** Renders the next block of audio.
+
+            The buffer will have the same number of channels as the stream's writer, and
+            the number of samples to render, which will be the pipeline's block size for
+            all but the last block. Its contents are undefined, so every sample must be
+            written.
+
+            This is called on one of the pool's threads. It's called with the blocks in
+            order, and never more than once at the same time for the same source, but
+            calls for different sources may happen concurrently.
+        */
+        virtual void renderNextBlock (AudioBuffer<float>& buffer, int64 startSampleInStream) = 0;
+    };
+
+    //==============================================================================
+    /** Creates a pipeline.
+
+        @param threadPool           the pool that will run the jobs. This must not be deleted
+                                    while the pipeline still exists, and it can be shared
+                                    with other work
+        @param samplesPerBlock      the number of samples in each block that's passed from
+                                    one stage to the next
+        @param numBlocksPerStream   the number of blocks that each stream can have in the
+                                    pipeline at once. This needs to be at least 3 for all
+                                    three stages of a stream to run at the same time
+    */
+    AudioExportPipeline (ThreadPool& threadPool,
+                         int samplesPerBlock = 16384,
+                         int numBlocksPerStream = 4);
+
+    /** Destructor.
+        If the export hasn't finished, this will cancel it and wait for any jobs that are
+        running to finish.
+    */
+    ~AudioExportPipeline();
+
+    //==============================================================================
+    /** Adds a stream to export.
+
+        This must be called before start().
+
+        @param source           the source of the audio. The pipeline takes ownership of this
+        @param writer           the writer that will encode the audio. The pipeline takes
+                                ownership of this, and deletes it as soon as the stream is
+                                complete, so that its file is closed
+        @param totalNumSamples  the number of samples to export
+        @returns the index of the stream
+    */
+    int addStream (Source* source, AudioFormatWriter* writer, int64 totalNumSamples);
+
+    /** Adds a stream that's written to a file, using the AudioFormat that the manager
+        has registered for the file's extension.
+
+        The file will be replaced if it already exists.
+
+        @returns the index of the stream, or -1 if no suitable writer could be created,
+                 in which case the source will have been deleted
+        @see AudioFormat::createWriterFor
+    */
+    int addStream (Source* source,
+                   AudioFormatManager& formatManager,
+                   const File& file,
+                   double sampleRate,
+                   int numChannels,
+                   int bitsPerSample,
+                   int qualityOptionIndex,
+                   int64 totalNumSamples);
+
+    /** Returns the number of streams that have been added. */
+    int getNumStreams() const noexcept;
+
+    //==============================================================================
+    /** Starts exporting all the streams. */
+    void start();
+
+    /** Stops the export as soon as possible, and waits for any jobs that are running
+        to finish. Any files that weren't complete will be left partially written.
+    */
+    void cancel();
+
+    /** Waits for all the streams to finish.
+        A timeout of less than 0 means "wait forever".
+        @returns true if the export finished before the timeout expired
+    */
+    bool waitUntilFinished (int timeoutMilliseconds = -1);
+
+    /** Returns true if every stream has either been completed, or has failed. */
+    bool isFinished() const noexcept;
+
+    //==============================================================================
+    /** Returns the proportion of a stream that has been written, from 0 to 1.
+        This can be called from any thread.
+    */
+    double getProgress (int streamIndex) const noexcept;
+
+    /** Returns the proportion of all the streams' samples that have been written, from 0 to 1.
+        This can be called from any thread.
+    */
+    double getOverallProgress() const noexcept;
+
+    /** Returns true if a stream's writer failed to write some of its data. */
+    bool hasStreamFailed (int streamIndex) const noexcept;
+
+    /** Returns the number of bytes that are allocated for the blocks of all the streams. */
+    size_t getBufferSizeInBytes() const noexcept;
+
+private:
+    //==============================================================================
+    struct Block;
+    struct Stream;
+
+    ThreadPool& pool;
+    const int blockSize, numBlocksPerStream;
+    OwnedArray<Stream> streams;
+
+    std::atomic<int> numStreamsUnfinished { 0 };
+    std::atomic<bool> started { false }, cancelled { false };
+    WaitableEvent finishedEvent { true }, jobsFinishedEvent;
+
+    // A job decrements the count and signals the event while holding this lock, so that
+    // cancel() can't see the count reach zero and return while the job is still using them
+    CriticalSection jobCountLock;
+    int numJobsRunning = 0;
+
+    void addJob (std::function<void()>);
+    void scheduleJobs (Stream&);
+    void renderBlock (Stream&);
+    void convertBlock (Stream&, Block&);
+    void encodeBlocks (Stream&);
+    void streamFinished (Stream&, bool failed);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioExportPipeline)
+};
+
+} // namespace juce
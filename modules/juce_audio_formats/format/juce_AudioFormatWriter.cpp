@@ -61,21 +61,27 @@ AudioFormatWriter::~AudioFormatWriter()
     delete output;
 }
 
-static void convertFloatsToInts (int* dest, const float* src, int numSamples) noexcept
+void AudioFormatWriter::setDitherType (AudioDataConverters::Dither::Type newType)
 {
-    while (--numSamples >= 0)
-    {
-        const double samp = *src++;
-
-        if (samp <= -1.0)
-            *dest = std::numeric_limits<int>::min();
-        else if (samp >= 1.0)
-            *dest = std::numeric_limits<int>::max();
-        else
-            *dest = roundToInt (std::numeric_limits<int>::max() * samp);
+    if (newType == AudioDataConverters::Dither::Type::none || isFloatingPoint() || bitsPerSample >= 32)
+        dither.reset();
+    else
+        dither.reset (new AudioDataConverters::Dither (newType, (float) (1 << (32 - bitsPerSample))));
+}
 
-        ++dest;
-    }
+static void convertFloatsToInts (int* dest, const float* src, int numSamples, AudioDataConverters::Dither* dither) noexcept
+{
+   #if JUCE_BIG_ENDIAN
+    AudioDataConverters::convertFloatToFormat (AudioDataConverters::int32BE, src, dest, numSamples, 4, dither);
+   #else
+    AudioDataConverters::convertFloatToFormat (AudioDataConverters::int32LE, src, dest, numSamples, 4, dither);
+   #endif
+
+    // The converter clips to +/- 0x7fffffff, but a full-scale negative
+    // sample should use the whole range
+    for (int i = 0; i < numSamples; ++i)
+        if (dest[i] == -std::numeric_limits<int>::max())
+            dest[i] = std::numeric_limits<int>::min();
 }
 
 bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
@@ -113,7 +119,7 @@ bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                 if (isFloatingPoint())
                     FloatVectorOperations::convertFixedToFloat ((float*) b, (int*) b, scaleFactor, numToDo);
                 else
-                    convertFloatsToInts ((int*) b, (float*) b, numToDo);
+                    convertFloatsToInts ((int*) b, (float*) b, numToDo, dither.get());
             }
         }
 
@@ -174,7 +180,7 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
         auto numToDo = jmin (numSamples, maxSamples);
 
         for (int i = 0; i < numSourceChannels; ++i)
-            convertFloatsToInts (chans[i], channels[i] + startSample, numToDo);
+            convertFloatsToInts (chans[i], channels[i] + startSample, numToDo, dither.get());
 
         if (! write ((const int**) chans, numToDo))
             return false;
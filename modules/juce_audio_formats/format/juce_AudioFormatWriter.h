@@ -126,6 +126,16 @@ public:
     */
     virtual bool flush();
 
+    /** Sets the type of dither that's added when floating-point data is written to a
+        fixed-point format with fewer than 32 bits per sample.
+
+        This affects writeFromFloatArrays(), writeFromAudioSampleBuffer(), writeFromAudioSource(),
+        and writeFromAudioReader() when the reader provides floating-point data. The noise is
+        scaled to the least significant bit of the stream's bit-depth. By default, no dither
+        is added.
+    */
+    void setDitherType (AudioDataConverters::Dither::Type newType);
+
     //==============================================================================
     /** Reads a section of samples from an AudioFormatReader, and writes these to
         the output.
@@ -291,6 +301,7 @@ protected:
 
 private:
     String formatName;
+    std::unique_ptr<AudioDataConverters::Dither> dither;
     friend class ThreadedWriter;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriter)
@@ -0,0 +1,721 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+// A file that's being read through the cache. These are kept for a while after all
+// their readers have been deleted, so that the blocks decoded from a file can still be
+// found if the same file is opened again. Each one has an ID that's never re-used, so
+// that once a source has been removed, any blocks left over from it can't be mistaken
+// for blocks of a different file.
+//
+// The decoder can be used by the background thread and by createReaderFor() at the same
+// time, so it's only touched while holding decoderLock.
+struct DecodedAudioBlockCache::Reader::Source
+{
+    Source (const File& f, uint32 sourceId)  : file (f), id (sourceId) {}
+
+    bool open (AudioFormatManager& formatManager)
+    {
+        if (decoder != nullptr)
+            return true;
+
+        mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile->getData() != nullptr)
+            decoder.reset (formatManager.createReaderFor (std::make_unique<MemoryInputStream> (mappedFile->getData(),
+                                                                                               mappedFile->getSize(),
+                                                                                               false)));
+
+        if (decoder == nullptr)
+        {
+            mappedFile.reset();
+            decoder.reset (formatManager.createReaderFor (file));
+        }
+
+        return decoder != nullptr;
+    }
+
+    void close()
+    {
+        decoder.reset();
+        mappedFile.reset();
+    }
+
+    const File file;
+    const uint32 id;
+    CriticalSection decoderLock;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    std::unique_ptr<AudioFormatReader> decoder;
+    int numReaders = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Source)
+};
+
+// A block of decoded samples. Before a thread writes to a slot it claims it by swapping
+// its key for decodingKey, which stops any other thread from choosing the same slot, and
+// then checks that no reader has locked it. Readers lock a slot and then check that its
+// key is still the one they want, so either the reader will see the changed key, or the
+// decoding thread will see the lock and choose a different slot.
+struct DecodedAudioBlockCache::Slot
+{
+    static constexpr uint64 emptyKey = 0;
+    static constexpr uint64 decodingKey = ~(uint64) 0;
+
+    std::atomic<uint64> key { emptyKey };
+    mutable std::atomic<int> numReaders { 0 };
+    std::atomic<uint32> lastUsed { 0 };
+    float* data = nullptr;
+};
+
+//==============================================================================
+DecodedAudioBlockCache::DecodedAudioBlockCache (TimeSliceThread& backgroundThread,
+                                                size_t maxSizeInBytes,
+                                                int maxChannels,
+                                                int blockSize)
+    : thread (backgroundThread),
+      maxNumChannels (jmax (1, maxChannels)),
+      samplesPerBlock (jmax (256, blockSize))
+{
+    auto samplesPerSlot = (size_t) maxNumChannels * (size_t) samplesPerBlock;
+
+    // Each block can go into any slot of a small set, which keeps lookups quick
+    // without letting a few busy blocks push each other out too often
+    numSlots = jmax (1, (int) (maxSizeInBytes / (samplesPerSlot * sizeof (float))));
+    numWays  = jmin (8, numSlots);
+    numSets  = numSlots / numWays;
+    numSlots = numSets * numWays;
+
+    slots.reset (new Slot[(size_t) numSlots]);
+    sampleData.allocate ((size_t) numSlots * samplesPerSlot, true);
+
+    for (int i = 0; i < numSlots; ++i)
+        slots[(size_t) i].data = sampleData + (size_t) i * samplesPerSlot;
+
+    thread.addTimeSliceClient (this);
+}
+
+DecodedAudioBlockCache::~DecodedAudioBlockCache()
+{
+    // All the readers must be deleted before the cache that they're using!
+    jassert (readers.isEmpty());
+
+    thread.removeTimeSliceClient (this);
+}
+
+DecodedAudioBlockCache::Reader* DecodedAudioBlockCache::createReaderFor (const File& file,
+                                                                         AudioFormatManager& formatManager,
+                                                                         int samplesToReadAhead)
+{
+    Reader* reader = nullptr;
+
+    {
+        const ScopedLock sl (lock);
+
+        Source* source = nullptr;
+
+        for (auto* s : sources)
+        {
+            if (s->file == file)
+            {
+                source = s;
+                break;
+            }
+        }
+
+        if (source == nullptr)
+        {
+            source = sources.add (new Source (file, nextSourceId));
+
+            // The top bits of each key hold the source's ID, and the all-ones key is reserved
+            nextSourceId = (nextSourceId == 0xfffffffe) ? 1 : nextSourceId + 1;
+        }
+
+        // Until a source has a reader, no other thread will use its decoder, so it's safe to open here
+        if (! source->open (formatManager))
+        {
+            if (source->numReaders == 0)
+                sources.removeObject (source);
+
+            return nullptr;
+        }
+
+        reader = new Reader (*this, *source, samplesToReadAhead);
+        readers.add (reader);
+    }
+
+    // Decode the start of the file straight away, as that's where most readers begin. The new
+    // reader keeps the source open, so this doesn't need to hold up the rest of the cache.
+    {
+        const ScopedLock sl (reader->source.decoderLock);
+        decodeBlock (reader->source, 0);
+    }
+
+    return reader;
+}
+
+void DecodedAudioBlockCache::removeReader (Reader& reader)
+{
+    const ScopedLock sl (lock);
+
+    readers.removeFirstMatchingValue (&reader);
+
+    auto& source = reader.source;
+
+    if (--source.numReaders > 0)
+        return;
+
+    {
+        const ScopedLock dl (source.decoderLock);
+        source.close();
+    }
+
+    // Keep the idle sources in the order they became idle, and forget the oldest ones
+    sources.move (sources.indexOf (&source), -1);
+
+    int numIdle = 0;
+
+    for (auto* s : sources)
+        if (s->numReaders == 0)
+            ++numIdle;
+
+    for (int i = 0; i < sources.size() && numIdle > maxNumIdleSources;)
+    {
+        if (sources.getUnchecked (i)->numReaders == 0)
+        {
+            sources.remove (i);
+            --numIdle;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+//==============================================================================
+uint64 DecodedAudioBlockCache::makeKey (const Source& source, int64 blockIndex) noexcept
+{
+    return ((uint64) source.id << 32) | (uint64) (uint32) blockIndex;
+}
+
+DecodedAudioBlockCache::Slot* DecodedAudioBlockCache::getSet (uint64 key) const noexcept
+{
+    auto hash = (key * 0x9e3779b97f4a7c15ull) >> 32;
+    return slots.get() + (size_t) (hash % (uint64) numSets) * (size_t) numWays;
+}
+
+const DecodedAudioBlockCache::Slot* DecodedAudioBlockCache::findAndLockBlock (uint64 key) const noexcept
+{
+    auto* set = getSet (key);
+
+    for (int i = 0; i < numWays; ++i)
+    {
+        auto& slot = set[i];
+
+        if (slot.key == key)
+        {
+            ++slot.numReaders;
+
+            if (slot.key == key)
+            {
+                slot.lastUsed.store (useCounter.load (std::memory_order_relaxed), std::memory_order_relaxed);
+                return &slot;
+            }
+
+            --slot.numReaders;
+        }
+    }
+
+    return nullptr;
+}
+
+void DecodedAudioBlockCache::unlockBlock (const Slot& slot) noexcept
+{
+    --slot.numReaders;
+}
+
+bool DecodedAudioBlockCache::isBlockCached (uint64 key) const noexcept
+{
+    auto* set = getSet (key);
+
+    for (int i = 0; i < numWays; ++i)
+        if (set[i].key == key)
+            return true;
+
+    return false;
+}
+
+bool DecodedAudioBlockCache::decodeBlock (Source& source, int64 blockIndex)
+{
+    jassert (source.decoder != nullptr);
+
+    auto key = makeKey (source, blockIndex);
+
+    if (isBlockCached (key))
+        return false;
+
+    auto* set = getSet (key);
+
+    auto isBetterToReplace = [] (const Slot& slot, const Slot& current)
+    {
+        auto isEmpty = (slot.key == Slot::emptyKey);
+
+        if (isEmpty != (current.key == Slot::emptyKey))
+            return isEmpty;
+
+        return (int32) (slot.lastUsed - current.lastUsed) < 0;
+    };
+
+    for (;;)
+    {
+        Slot* oldest = nullptr;
+
+        for (int i = 0; i < numWays; ++i)
+        {
+            auto& slot = set[i];
+
+            if (slot.numReaders == 0 && slot.key != Slot::decodingKey
+                 && (oldest == nullptr || isBetterToReplace (slot, *oldest)))
+                oldest = &slot;
+        }
+
+        if (oldest == nullptr)
+            return false; // every slot in the set is being read from or written to
+
+        auto oldKey = oldest->key.load();
+
+        if (oldKey == Slot::decodingKey || ! oldest->key.compare_exchange_strong (oldKey, Slot::decodingKey))
+            continue; // another thread has just claimed this one, so try again
+
+        if (oldest->numReaders != 0)
+        {
+            oldest->key = oldKey;
+            continue; // a reader has just locked this one, so try again
+        }
+
+        float* channels[64] = {};
+        auto numChannels = jmin ((int) numElementsInArray (channels), maxNumChannels, (int) source.decoder->numChannels);
+
+        for (int i = 0; i < numChannels; ++i)
+            channels[i] = oldest->data + (size_t) i * (size_t) samplesPerBlock;
+
+        AudioBuffer<float> buffer (channels, numChannels, samplesPerBlock);
+        source.decoder->read (&buffer, 0, samplesPerBlock, blockIndex * samplesPerBlock, true, true);
+
+        oldest->lastUsed = useCounter.load();
+        oldest->key = key;
+        ++numBlocksDecoded;
+        return true;
+    }
+}
+
+DecodedAudioBlockCache::Source* DecodedAudioBlockCache::findSourceToDecode (int64& blockIndex) const noexcept
+{
+    // Fill the blocks closest to each reader's position first, so that a reader that's
+    // just jumped to a new position doesn't have to wait behind the others' read-ahead
+    int maxBlocksAhead = 0;
+
+    for (auto* r : readers)
+        maxBlocksAhead = jmax (maxBlocksAhead, r->numBlocksToReadAhead);
+
+    for (int i = 0; i < maxBlocksAhead; ++i)
+    {
+        for (auto* r : readers)
+        {
+            if (i < r->numBlocksToReadAhead)
+            {
+                blockIndex = r->nextReadPosition / samplesPerBlock + i;
+
+                if (blockIndex * samplesPerBlock < r->lengthInSamples
+                     && ! isBlockCached (makeKey (r->source, blockIndex)))
+                    return &r->source;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+int DecodedAudioBlockCache::useTimeSlice()
+{
+    ++useCounter;
+
+    Source* source = nullptr;
+    int64 blockIndex = 0;
+
+    {
+        const ScopedLock sl (lock);
+        source = findSourceToDecode (blockIndex);
+
+        if (source == nullptr)
+            return 100;
+
+        // This keeps the source open until the block has been decoded, as removeReader()
+        // can't close it without taking the same lock
+        source->decoderLock.enter();
+    }
+
+    auto decoded = decodeBlock (*source, blockIndex);
+    source->decoderLock.exit();
+
+    return decoded ? 1 : 100;
+}
+
+//==============================================================================
+DecodedAudioBlockCache::Reader::Reader (DecodedAudioBlockCache& c, Source& s, int samplesToReadAhead)
+    : AudioFormatReader (nullptr, s.decoder->getFormatName()),
+      cache (c), source (s),
+      numBlocksToReadAhead (1 + (samplesToReadAhead / c.samplesPerBlock))
+{
+    auto& decoder = *source.decoder;
+
+    // If this fails, you'll need to create a cache with enough channels for your files
+    jassert ((int) decoder.numChannels <= cache.maxNumChannels);
+
+    sampleRate            = decoder.sampleRate;
+    lengthInSamples       = decoder.lengthInSamples;
+    numChannels           = (unsigned int) jmin ((int) decoder.numChannels, cache.maxNumChannels);
+    metadataValues        = decoder.metadataValues;
+    bitsPerSample         = 32;
+    usesFloatingPointData = true;
+
+    ++source.numReaders;
+}
+
+DecodedAudioBlockCache::Reader::~Reader()
+{
+    cache.removeReader (*this);
+}
+
+void DecodedAudioBlockCache::Reader::setReadTimeout (int timeoutMilliseconds) noexcept
+{
+    timeoutMs = timeoutMilliseconds;
+}
+
+bool DecodedAudioBlockCache::Reader::readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                                  int64 startSampleInFile, int numSamples)
+{
+    auto startTime = Time::getMillisecondCounter();
+    clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                       startSampleInFile, numSamples, lengthInSamples);
+
+    auto samplesPerBlock = cache.samplesPerBlock;
+    nextReadPosition = startSampleInFile;
+
+    while (numSamples > 0)
+    {
+        auto blockIndex = startSampleInFile / samplesPerBlock;
+
+        if (auto* slot = cache.findAndLockBlock (makeKey (source, blockIndex)))
+        {
+            auto offset = (int) (startSampleInFile - blockIndex * samplesPerBlock);
+            auto numToDo = jmin (numSamples, samplesPerBlock - offset);
+
+            for (int j = 0; j < numDestChannels; ++j)
+            {
+                if (auto dest = (float*) destSamples[j])
+                {
+                    dest += startOffsetInDestBuffer;
+
+                    if (j < (int) numChannels)
+                        FloatVectorOperations::copy (dest, slot->data + (size_t) j * (size_t) samplesPerBlock + (size_t) offset, numToDo);
+                    else
+                        FloatVectorOperations::clear (dest, numToDo);
+                }
+            }
+
+            unlockBlock (*slot);
+
+            startOffsetInDestBuffer += numToDo;
+            startSampleInFile += numToDo;
+            numSamples -= numToDo;
+        }
+        else
+        {
+            // make sure the missing block is the next one to be decoded
+            nextReadPosition = startSampleInFile;
+
+            if (timeoutMs >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMs)
+            {
+                for (int j = 0; j < numDestChannels; ++j)
+                    if (auto dest = (float*) destSamples[j])
+                        FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
+
+                break;
+            }
+
+            Thread::yield();
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct DecodedAudioBlockCacheTests  : public UnitTest
+{
+    DecodedAudioBlockCacheTests()
+        : UnitTest ("DecodedAudioBlockCache", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile fileA (".wav"), fileB (".wav");
+        AudioBuffer<float> contentA, contentB;
+
+        writeTestFile (fileA.getFile(), contentA, 100000, 2);
+        writeTestFile (fileB.getFile(), contentB, 70000, 1);
+
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        TimeSliceThread thread ("Decoder");
+        thread.startThread();
+
+        beginTest ("Readers return the same data as the file");
+        {
+            DecodedAudioBlockCache cache (thread, 1 << 20, 2, 4096);
+
+            std::unique_ptr<DecodedAudioBlockCache::Reader> reader (cache.createReaderFor (fileA.getFile(), formatManager, 16384));
+            expect (reader != nullptr);
+            expectEquals ((int) reader->numChannels, 2);
+            expectEquals (reader->lengthInSamples, (int64) contentA.getNumSamples());
+
+            reader->setReadTimeout (-1);
+            expectReadsMatch (*reader, contentA, 1000);
+        }
+
+        beginTest ("Readers of the same file share its blocks");
+        {
+            DecodedAudioBlockCache cache (thread, 1 << 21, 2, 4096);
+            OwnedArray<AudioFormatReader> readers;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                auto* r = cache.createReaderFor (fileA.getFile(), formatManager, 8192);
+                r->setReadTimeout (-1);
+                readers.add (r);
+            }
+
+            for (auto* r : readers)
+                expectReadsMatch (*r, contentA, 777);
+
+            auto numBlocksInFile = (contentA.getNumSamples() + 4095) / 4096;
+            expect (cache.getNumBlocksDecoded() <= numBlocksInFile);
+
+            readers.clear();
+
+            // the blocks are still available to new readers for the same file
+            std::unique_ptr<DecodedAudioBlockCache::Reader> r (cache.createReaderFor (fileA.getFile(), formatManager, 8192));
+            r->setReadTimeout (-1);
+            expectReadsMatch (*r, contentA, 1000);
+            expect (cache.getNumBlocksDecoded() <= numBlocksInFile);
+        }
+
+        beginTest ("Old blocks are re-used when the cache is full");
+        {
+            DecodedAudioBlockCache cache (thread, 8 * 2 * 1024 * sizeof (float), 2, 1024);
+            expectEquals (cache.getNumBlocks(), 8);
+
+            std::unique_ptr<DecodedAudioBlockCache::Reader> readerA (cache.createReaderFor (fileA.getFile(), formatManager, 1024)),
+                                                            readerB (cache.createReaderFor (fileB.getFile(), formatManager, 1024));
+            readerA->setReadTimeout (-1);
+            readerB->setReadTimeout (-1);
+
+            expectEquals ((int) readerB->numChannels, 1);
+
+            expectReadsMatch (*readerA, contentA, 500);
+            expectReadsMatch (*readerB, contentB, 300);
+            expectReadsMatch (*readerA, contentA, 2000);
+        }
+
+        beginTest ("Readers can be created on several threads while blocks are being decoded");
+        {
+            DecodedAudioBlockCache cache (thread, 1 << 20, 2, 1024);
+
+            struct ReaderThread  : public Thread
+            {
+                ReaderThread (DecodedAudioBlockCache& c, AudioFormatManager& m, const File& f)
+                    : Thread ("Reader"), cache (c), manager (m), file (f) {}
+
+                void run() override
+                {
+                    AudioBuffer<float> buffer (2, 1000);
+
+                    for (int i = 0; i < 20; ++i)
+                    {
+                        std::unique_ptr<DecodedAudioBlockCache::Reader> reader (cache.createReaderFor (file, manager, 4096));
+
+                        if (reader == nullptr)
+                        {
+                            failed = true;
+                            return;
+                        }
+
+                        reader->setReadTimeout (-1);
+                        reader->read (&buffer, 0, buffer.getNumSamples(), i * 3000, true, true);
+                    }
+                }
+
+                DecodedAudioBlockCache& cache;
+                AudioFormatManager& manager;
+                const File file;
+                std::atomic<bool> failed { false };
+            };
+
+            OwnedArray<ReaderThread> readerThreads;
+
+            for (int i = 0; i < 4; ++i)
+                readerThreads.add (new ReaderThread (cache, formatManager, (i % 2 == 0 ? fileA : fileB).getFile()))->startThread();
+
+            for (auto* t : readerThreads)
+            {
+                expect (t->waitForThreadToExit (10000));
+                expect (! t->failed);
+            }
+
+            std::unique_ptr<DecodedAudioBlockCache::Reader> reader (cache.createReaderFor (fileB.getFile(), formatManager, 4096));
+            reader->setReadTimeout (-1);
+            expectReadsMatch (*reader, contentB, 1000);
+        }
+
+        thread.stopThread (5000);
+
+        beginTest ("Missing blocks are silent when the timeout expires");
+        {
+            TimeSliceThread stoppedThread ("Decoder");
+            DecodedAudioBlockCache cache (stoppedThread, 1 << 20, 2, 4096);
+            std::unique_ptr<DecodedAudioBlockCache::Reader> reader (cache.createReaderFor (fileA.getFile(), formatManager, 0));
+
+            // the first block is decoded when the reader is created
+            AudioBuffer<float> result (2, 100);
+            reader->read (&result, 0, 100, 0, true, true);
+            expect (buffersMatch (result, contentA, 0));
+
+            result.clear();
+            reader->read (&result, 0, 100, 80000, true, true);
+            expectEquals (result.getMagnitude (0, 100), 0.0f);
+        }
+
+        beginTest ("Only the most recently used files without any readers are remembered");
+        {
+            TimeSliceThread stoppedThread ("Decoder");
+            DecodedAudioBlockCache cache (stoppedThread, 1024 * 2 * 256 * sizeof (float), 2, 256);
+            OwnedArray<TemporaryFile> files;
+            AudioBuffer<float> content;
+
+            for (int i = 0; i < 40; ++i)
+                writeTestFile (files.add (new TemporaryFile (".wav"))->getFile(), content, 1000, 1);
+
+            auto openAndClose = [&] (int index)
+            {
+                std::unique_ptr<DecodedAudioBlockCache::Reader> reader (cache.createReaderFor (files[index]->getFile(), formatManager, 0));
+                expect (reader != nullptr);
+            };
+
+            // Only the first block of each file is decoded, as the background thread isn't running
+            for (int i = 0; i < files.size(); ++i)
+                openAndClose (i);
+
+            expectEquals (cache.getNumBlocksDecoded(), (int64) files.size());
+
+            // A recent file's first block can still be found...
+            openAndClose (files.size() - 1);
+            expectEquals (cache.getNumBlocksDecoded(), (int64) files.size());
+
+            // ...but the first file has been forgotten, so it has to be decoded again
+            openAndClose (0);
+            expectEquals (cache.getNumBlocksDecoded(), (int64) files.size() + 1);
+        }
+    }
+
+    static void writeTestFile (const File& file, AudioBuffer<float>& content, int numSamples, int numChannels)
+    {
+        Random random (numSamples);
+        content.setSize (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                content.setSample (ch, i, (float) (random.nextInt (65535) - 32767) / 32768.0f);
+
+        WavAudioFormat format;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (file.createOutputStream().release(),
+                                                                               44100.0, (unsigned int) numChannels,
+                                                                               16, {}, 0));
+            writer->writeFromAudioSampleBuffer (content, 0, numSamples);
+        }
+
+        // read it back, so that the content matches the file's 16-bit samples exactly
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (file.createInputStream().release(), true));
+        reader->read (&content, 0, numSamples, 0, true, true);
+    }
+
+    void expectReadsMatch (AudioFormatReader& reader, const AudioBuffer<float>& content, int samplesPerRead)
+    {
+        AudioBuffer<float> result (content.getNumChannels(), samplesPerRead);
+        bool allMatch = true;
+
+        for (int pos = 0; pos < content.getNumSamples(); pos += samplesPerRead)
+        {
+            result.clear();
+            reader.read (&result, 0, samplesPerRead, pos, true, true);
+            allMatch = allMatch && buffersMatch (result, content, pos);
+        }
+
+        expect (allMatch);
+    }
+
+    static bool buffersMatch (const AudioBuffer<float>& result, const AudioBuffer<float>& content, int pos)
+    {
+        auto numToCompare = jmin (result.getNumSamples(), content.getNumSamples() - pos);
+
+        for (int ch = 0; ch < content.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < numToCompare; ++i)
+                if (std::abs (result.getSample (ch, i) - content.getSample (ch, pos + i)) > 1.0e-6f)
+                    return false;
+
+            for (int i = numToCompare; i < result.getNumSamples(); ++i)
+                if (result.getSample (ch, i) != 0.0f)
+                    return false;
+        }
+
+        return true;
+    }
+};
+
+static DecodedAudioBlockCacheTests decodedAudioBlockCacheTests;
+
+#endif
+
+} // namespace juce
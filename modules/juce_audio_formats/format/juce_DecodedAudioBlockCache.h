@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fixed-size cache of decoded audio, which can be shared by many readers that
+    are streaming the same compressed files.
+
+    A BufferingAudioReader decodes its source into its own buffers, so if a sampler
+    has dozens of voices playing the same FLAC or Ogg file, each one of them will be
+    decoding the file separately. This cache instead keeps blocks of decoded samples
+    which are identified by their file and position, and the readers that it creates
+    share them. A background TimeSliceThread decodes the blocks that lie ahead of each
+    reader's current position, and the readers copy from them without taking any locks,
+    so they're safe to use on the audio thread.
+
+    When possible, each file is memory-mapped rather than opened as a stream, so the
+    decoders can read the compressed data without any extra copying.
+
+    The size of the cache is fixed when it's created. If the readers between them
+    need more blocks than will fit, the least recently used ones will be thrown away,
+    so make sure that the cache is big enough for the number of files and the
+    amount of read-ahead you're using.
+
+    When all the readers for a file have been deleted, the cache remembers the file
+    for a while, so that if it's opened again any of its blocks which are still in the
+    cache can be re-used. Only the most recent few of these files are remembered.
+
+    The files mustn't be modified while the cache exists, as blocks decoded from
+    the old version of a file could still be in use.
+
+    @see BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  DecodedAudioBlockCache  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param backgroundThread     the thread that should be used to decode the blocks.
+                                    Make sure that the thread you supply is running, and
+                                    won't be deleted while the cache still exists.
+        @param maxSizeInBytes       the total amount of memory to allocate for decoded
+                                    samples. This is all allocated by the constructor.
+        @param maxNumChannels       the maximum number of channels that each block can
+                                    hold. Readers for files with more channels than this
+                                    will only provide this number of channels.
+        @param samplesPerBlock      the number of samples in each block
+    */
+    DecodedAudioBlockCache (TimeSliceThread& backgroundThread,
+                            size_t maxSizeInBytes,
+                            int maxNumChannels = 2,
+                            int samplesPerBlock = 16384);
+
+    /** Destructor.
+        All the readers that were created by this cache must have been deleted
+        before the cache is.
+    */
+    ~DecodedAudioBlockCache() override;
+
+    //==============================================================================
+    /** An AudioFormatReader that reads its data from a DecodedAudioBlockCache.
+
+        Its readSamples() method doesn't take any locks or allocate any memory. If it's
+        asked for samples that haven't been decoded yet, it'll wait for them until its
+        timeout expires, and then return silence for them.
+
+        @see DecodedAudioBlockCache::createReaderFor
+    */
+    class JUCE_API  Reader  : public AudioFormatReader
+    {
+    public:
+        ~Reader() override;
+
+        /** Sets a number of milliseconds that the reader can block for in its readSamples()
+            method before giving up and returning silence.
+            A value of less that 0 means "wait forever".
+            The default timeout is 0.
+        */
+        void setReadTimeout (int timeoutMilliseconds) noexcept;
+
+        bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override;
+
+    private:
+        friend class DecodedAudioBlockCache;
+        struct Source;
+
+        Reader (DecodedAudioBlockCache&, Source&, int samplesToReadAhead);
+
+        DecodedAudioBlockCache& cache;
+        Source& source;
+        std::atomic<int64> nextReadPosition { 0 };
+        const int numBlocksToReadAhead;
+        int timeoutMs = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Reader)
+    };
+
+    /** Creates a reader that will stream the given file through this cache.
+
+        If other readers have already been created for the same file, they'll all
+        share its decoded blocks.
+
+        @param file                 the file to read
+        @param formatManager        the formats that may be used to decode the file
+        @param samplesToReadAhead   the number of samples beyond the reader's current
+                                    position which should be decoded in advance
+        @returns    a new reader, which the caller must delete, or nullptr if the file
+                    couldn't be opened by any of the formats
+    */
+    Reader* createReaderFor (const File& file,
+                             AudioFormatManager& formatManager,
+                             int samplesToReadAhead);
+
+    //==============================================================================
+    /** Returns the number of blocks that the cache can hold. */
+    int getNumBlocks() const noexcept                   { return numSlots; }
+
+    /** Returns the number of samples in each block. */
+    int getSamplesPerBlock() const noexcept             { return samplesPerBlock; }
+
+    /** Returns the number of blocks which have been decoded so far. */
+    int64 getNumBlocksDecoded() const noexcept          { return numBlocksDecoded; }
+
+private:
+    //==============================================================================
+    using Source = Reader::Source;
+    struct Slot;
+
+    TimeSliceThread& thread;
+    const int maxNumChannels, samplesPerBlock;
+    int numSlots = 0, numWays = 0, numSets = 0;
+    std::unique_ptr<Slot[]> slots;
+    HeapBlock<float> sampleData;
+    std::atomic<uint32> useCounter { 0 };
+    std::atomic<int64> numBlocksDecoded { 0 };
+
+    CriticalSection lock;
+    OwnedArray<Source> sources;
+    Array<Reader*> readers;
+    uint32 nextSourceId = 1;
+
+    static constexpr int maxNumIdleSources = 32;
+
+    static uint64 makeKey (const Source&, int64 blockIndex) noexcept;
+    Slot* getSet (uint64 key) const noexcept;
+    const Slot* findAndLockBlock (uint64 key) const noexcept;
+    static void unlockBlock (const Slot&) noexcept;
+    bool isBlockCached (uint64 key) const noexcept;
+    bool decodeBlock (Source&, int64 blockIndex);
+    Source* findSourceToDecode (int64& blockIndex) const noexcept;
+    void removeReader (Reader&);
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedAudioBlockCache)
+};
+
+} // namespace juce
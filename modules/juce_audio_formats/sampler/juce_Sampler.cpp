@@ -162,4 +162,563 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
     }
 }
 
+//==============================================================================
+int StreamingSamplerSound::PreloadPolicy::getNumSamplesToPreload (int lengthInSamples, double sampleRate) const noexcept
+{
+    if (lengthInSamples <= loadWholeSampleBelowSeconds * sampleRate)
+        return lengthInSamples;
+
+    return jlimit (0, lengthInSamples, roundToInt (preloadSeconds * sampleRate));
+}
+
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              AudioFormatReader* source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double maxSampleLengthSeconds,
+                                              PreloadPolicy preloadPolicy)
+    : name (soundName),
+      reader (source),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    jassert (source != nullptr);
+
+    if (source != nullptr && source->sampleRate > 0 && source->lengthInSamples > 0)
+    {
+        sourceSampleRate = source->sampleRate;
+        length = (int) jmin (source->lengthInSamples,
+                             (int64) (maxSampleLengthSeconds * sourceSampleRate));
+
+        auto numToPreload = preloadPolicy.getNumSamplesToPreload (length, sourceSampleRate);
+        preloadedData.setSize (jmin (2, (int) source->numChannels), numToPreload);
+        source->read (&preloadedData, 0, numToPreload, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+int64 StreamingSamplerSound::readFromSource (AudioBuffer<float>& buffer, int startSample,
+                                             int numSamples, int64 sourcePosition)
+{
+    // several voices may be streaming this sound, possibly on different threads
+    const ScopedLock sl (readerLock);
+
+    reader->read (&buffer, startSample, numSamples, sourcePosition, true, true);
+    return (int64) numSamples * reader->numChannels * reader->bitsPerSample / 8;
+}
+
+//==============================================================================
+double StreamingSamplerVoice::Statistics::getReadBandwidth() const noexcept
+{
+    return secondsSpentReading > 0 ? (double) numBytesRead / secondsSpentReading : 0.0;
+}
+
+StreamingSamplerVoice::Statistics& StreamingSamplerVoice::Statistics::operator+= (const Statistics& other) noexcept
+{
+    numUnderruns        += other.numUnderruns;
+    numSamplesRead      += other.numSamplesRead;
+    numBytesRead        += other.numBytesRead;
+    secondsSpentReading += other.secondsSpentReading;
+    return *this;
+}
+
+StreamingSamplerVoice::StreamingSamplerVoice (TimeSliceThread& diskThread, int bufferSizeInSamples)
+    : thread (diskThread),
+      ringBuffer (2, bufferSizeInSamples),
+      fifo (bufferSizeInSamples)
+{
+    thread.addTimeSliceClient (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+StreamingSamplerVoice::Statistics StreamingSamplerVoice::getStatistics() const noexcept
+{
+    Statistics stats;
+    stats.numUnderruns        = numUnderruns.load();
+    stats.numSamplesRead      = numSamplesRead.load();
+    stats.numBytesRead        = numBytesRead.load();
+    stats.secondsSpentReading = Time::highResolutionTicksToSeconds (ticksSpentReading.load());
+    return stats;
+}
+
+void StreamingSamplerVoice::resetStatistics() noexcept
+{
+    numUnderruns = 0;
+    numSamplesRead = 0;
+    numBytesRead = 0;
+    ticksSpentReading = 0;
+}
+
+StreamingSamplerVoice::Statistics StreamingSamplerVoice::getTotalStatistics (const Synthesiser& synth)
+{
+    Statistics total;
+
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (auto* voice = dynamic_cast<const StreamingSamplerVoice*> (synth.getVoice (i)))
+            total += voice->getStatistics();
+
+    return total;
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        streamedPosition = sound->getNumPreloadedSamples();
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        adsr.noteOn();
+
+        requestStream (sound->isFullyLoaded() ? nullptr : sound);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        requestStream (nullptr);
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+void StreamingSamplerVoice::requestStream (StreamingSamplerSound* sound)
+{
+    // Each request gets a new generation number, and the audio thread won't touch the
+    // ring buffer again until the disk thread has emptied it and acknowledged that number
+    auto& request = streamRequests[audioThreadRequest];
+
+    if (request.sound != nullptr && request.sound.get() != sound)
+    {
+        auto writer = soundsToReleaseFifo.write (1);
+
+        // If this gets hit, the disk thread has fallen so far behind that the sound has
+        // to be released here instead
+        jassert (writer.blockSize1 > 0);
+
+        writer.forEach ([&] (int index) { soundsToRelease[index] = std::move (request.sound); });
+    }
+
+    request.sound = sound;
+    request.generation = ++noteGeneration;
+
+    audioThreadRequest = pendingRequest.exchange (audioThreadRequest | newRequestFlag, std::memory_order_acq_rel)
+                           & ~newRequestFlag;
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        auto& head = playingSound->preloadedData;
+        auto numPreloaded = head.getNumSamples();
+        auto length = playingSound->length;
+
+        const float* const headL = head.getReadPointer (0);
+        const float* const headR = head.getNumChannels() > 1 ? head.getReadPointer (1) : nullptr;
+
+        // Find the part of the ring buffer that the disk thread has filled so far
+        int numStreamed = 0, ringStart = 0;
+
+        if (readyGeneration.load (std::memory_order_acquire) == noteGeneration)
+        {
+            int size1, start2, size2;
+            numStreamed = fifo.getNumReady();
+            fifo.prepareToRead (numStreamed, ringStart, size1, start2, size2);
+        }
+
+        const float* const ringL = ringBuffer.getReadPointer (0);
+        const float* const ringR = head.getNumChannels() > 1 ? ringBuffer.getReadPointer (1) : nullptr;
+        auto ringSize = ringBuffer.getNumSamples();
+
+        auto getSample = [&] (const float* fromHead, const float* fromRing, int index) noexcept
+        {
+            if (index < numPreloaded)
+                return fromHead[index];
+
+            if (index >= length)
+                return 0.0f;
+
+            auto ringIndex = ringStart + index - streamedPosition;
+            return fromRing[ringIndex < ringSize ? ringIndex : ringIndex - ringSize];
+        };
+
+        auto lastAvailable = streamedPosition + numStreamed;
+        auto generation = noteGeneration;
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int) sourceSamplePosition;
+
+            if (pos + 1 >= lastAvailable && pos + 1 >= numPreloaded && pos + 1 < length)
+            {
+                // the disk thread hasn't caught up, so wait for it
+                ++numUnderruns;
+                break;
+            }
+
+            auto alpha = (float) (sourceSamplePosition - pos);
+            auto invAlpha = 1.0f - alpha;
+
+            // just using a very simple linear interpolation here..
+            float l = (getSample (headL, ringL, pos) * invAlpha + getSample (headL, ringL, pos + 1) * alpha);
+            float r = (headR != nullptr) ? (getSample (headR, ringR, pos) * invAlpha + getSample (headR, ringR, pos + 1) * alpha)
+                                         : l;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > length || ! adsr.isActive())
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+
+        // Release the streamed samples that have been played
+        if (numStreamed > 0 && generation == noteGeneration)
+        {
+            auto numFinished = jlimit (0, numStreamed, (int) sourceSamplePosition - streamedPosition);
+            fifo.finishedRead (numFinished);
+            streamedPosition += numFinished;
+        }
+    }
+}
+
+//==============================================================================
+int StreamingSamplerVoice::useTimeSlice()
+{
+    soundsToReleaseFifo.read (soundsToReleaseFifo.getNumReady())
+                       .forEach ([this] (int index) { soundsToRelease[index] = nullptr; });
+
+    if ((pendingRequest.load (std::memory_order_relaxed) & newRequestFlag) != 0)
+    {
+        diskThreadRequest = pendingRequest.exchange (diskThreadRequest, std::memory_order_acq_rel) & ~newRequestFlag;
+
+        auto& request = streamRequests[diskThreadRequest];
+        SynthesiserSound::Ptr newSound;
+        std::swap (newSound, request.sound);
+        streamingGeneration = request.generation;
+
+        // The old sound is released here rather than on the audio thread, and the request
+        // is left empty, ready for the audio thread to reuse
+        std::swap (streamingSound, newSound);
+
+        fifo.reset();
+        nextReadPosition = streamingSound != nullptr ? static_cast<StreamingSamplerSound*> (streamingSound.get())->getNumPreloadedSamples()
+                                                     : 0;
+        readyGeneration.store (streamingGeneration, std::memory_order_release);
+    }
+
+    auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get());
+
+    if (sound == nullptr)
+        return 10;
+
+    constexpr int minSamplesPerRead = 1024, maxSamplesPerRead = 16384;
+
+    auto numLeft = (int) (sound->length - nextReadPosition);
+    auto numToRead = jmin (fifo.getFreeSpace(), numLeft, maxSamplesPerRead);
+
+    if (numToRead < jmin (minSamplesPerRead, numLeft))
+        return numLeft > 0 ? 2 : 10;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+    auto startTicks = Time::getHighResolutionTicks();
+    int64 bytesRead = 0;
+
+    if (size1 > 0)  bytesRead += sound->readFromSource (ringBuffer, start1, size1, nextReadPosition);
+    if (size2 > 0)  bytesRead += sound->readFromSource (ringBuffer, start2, size2, nextReadPosition + size1);
+
+    ticksSpentReading += Time::getHighResolutionTicks() - startTicks;
+    numBytesRead += bytesRead;
+    numSamplesRead += size1 + size2;
+
+    fifo.finishedWrite (size1 + size2);
+    nextReadPosition += size1 + size2;
+
+    return 0;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct StreamingSamplerTests  : public UnitTest
+{
+    StreamingSamplerTests()
+        : UnitTest ("StreamingSampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile file (".wav");
+        writeTestFile (file.getFile(), 100000, 2);
+
+        WavAudioFormat format;
+        auto createReader = [&] { return format.createReaderFor (file.getFile().createInputStream().release(), true); };
+
+        BigInteger allNotes;
+        allNotes.setRange (0, 128, true);
+
+        StreamingSamplerSound::PreloadPolicy policy { 0.1, 0.5 };
+
+        beginTest ("Preload policy");
+        {
+            ReferenceCountedObjectPtr<StreamingSamplerSound> streamed (new StreamingSamplerSound ("s", createReader(), allNotes, 60, 0.0, 0.0, 10.0, policy));
+            expectEquals (streamed->getLengthInSamples(), 100000);
+            expectEquals (streamed->getNumPreloadedSamples(), 4410);
+            expect (! streamed->isFullyLoaded());
+
+            ReferenceCountedObjectPtr<StreamingSamplerSound> shortSound (new StreamingSamplerSound ("s", createReader(), allNotes, 60, 0.0, 0.0, 0.4, policy));
+            expectEquals (shortSound->getLengthInSamples(), 17640);
+            expect (shortSound->isFullyLoaded());
+        }
+
+        TimeSliceThread thread ("Sampler disk thread");
+        thread.startThread();
+
+        beginTest ("Streamed playback matches an in-memory sampler");
+        {
+            for (auto note : { 60, 67, 53 })
+            {
+                std::unique_ptr<AudioFormatReader> reader (createReader());
+
+                Synthesiser inMemory, streaming;
+                inMemory.addVoice (new SamplerVoice());
+                inMemory.addSound (new SamplerSound ("s", *reader, allNotes, 60, 0.0, 0.0, 10.0));
+
+                auto* voice = new StreamingSamplerVoice (thread, 8192);
+                streaming.addVoice (voice);
+                streaming.addSound (new StreamingSamplerSound ("s", createReader(), allNotes, 60, 0.0, 0.0, 10.0, policy));
+
+                auto expected = render (inMemory, note, false);
+                auto result   = render (streaming, note, true);
+
+                auto stats = StreamingSamplerVoice::getTotalStatistics (streaming);
+                expectEquals (stats.numUnderruns, (int64) 0);
+                expect (stats.numSamplesRead > 0);
+                expectEquals (stats.numBytesRead, stats.numSamplesRead * 2 * 2);
+                expect (buffersMatch (result, expected));
+                expect (! voice->isVoiceActive());
+            }
+        }
+
+        beginTest ("Retriggering a voice streams only the latest note");
+        {
+            // Several requests are made in one block, before the disk thread can pick any of them up
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 53, 1.0f), 64);
+            midi.addEvent (MidiMessage::noteOn (1, 67, 1.0f), 128);
+            midi.addEvent (MidiMessage::noteOn (1, 62, 1.0f), 192);
+
+            std::unique_ptr<AudioFormatReader> reader (createReader());
+
+            Synthesiser inMemory, streaming;
+            inMemory.addVoice (new SamplerVoice());
+            inMemory.addSound (new SamplerSound ("s", *reader, allNotes, 60, 0.0, 0.0, 10.0));
+
+            streaming.addVoice (new StreamingSamplerVoice (thread, 8192));
+            streaming.addSound (new StreamingSamplerSound ("s", createReader(), allNotes, 60, 0.0, 0.0, 10.0, policy));
+
+            auto expected = render (inMemory, midi, false);
+            auto result   = render (streaming, midi, true);
+
+            expectEquals (StreamingSamplerVoice::getTotalStatistics (streaming).numUnderruns, (int64) 0);
+            expect (buffersMatch (result, expected));
+        }
+
+        thread.stopThread (5000);
+
+        beginTest ("Sounds from overtaken requests are released by the disk thread");
+        {
+            TimeSliceThread stoppedThread ("Sampler disk thread");
+
+            BigInteger lowNotes, highNotes;
+            lowNotes.setRange (0, 64, true);
+            highNotes.setRange (64, 64, true);
+
+            SynthesiserSound::Ptr low (new StreamingSamplerSound ("low", createReader(), lowNotes, 30, 0.0, 0.0, 10.0, policy));
+            SynthesiserSound::Ptr high (new StreamingSamplerSound ("high", createReader(), highNotes, 90, 0.0, 0.0, 10.0, policy));
+
+            Synthesiser streaming;
+            streaming.addVoice (new StreamingSamplerVoice (stoppedThread, 8192));
+            streaming.addSound (low);
+            streaming.addSound (high);
+            streaming.setCurrentPlaybackSampleRate (44100.0);
+
+            // The second note steals the voice, so the request for the first one is
+            // overtaken before the disk thread can pick it up
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 30, 1.0f), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 90, 1.0f), 64);
+
+            AudioBuffer<float> block (2, 512);
+            block.clear();
+            streaming.renderNextBlock (block, midi, 0, block.getNumSamples());
+            streaming.removeSound (0);
+
+            expectEquals (low->getReferenceCount(), 2);
+
+            stoppedThread.startThread();
+
+            for (int i = 0; i < 500 && low->getReferenceCount() > 1; ++i)
+                Thread::sleep (2);
+
+            expectEquals (low->getReferenceCount(), 1);
+            stoppedThread.stopThread (5000);
+        }
+
+        beginTest ("Underruns are counted when the disk can't keep up");
+        {
+            TimeSliceThread stoppedThread ("Sampler disk thread");
+
+            Synthesiser streaming;
+            auto* voice = new StreamingSamplerVoice (stoppedThread, 8192);
+            streaming.addVoice (voice);
+            streaming.addSound (new StreamingSamplerSound ("s", createReader(), allNotes, 60, 0.0, 0.0, 10.0, policy));
+
+            auto result = render (streaming, 60, false);
+
+            expect (voice->getStatistics().numUnderruns > 0);
+            expectEquals (voice->getStatistics().numSamplesRead, (int64) 0);
+            expect (result.getMagnitude (0, 4400) > 0.0f);
+            expectEquals (result.getMagnitude (4410, result.getNumSamples() - 4410), 0.0f);
+            expect (voice->isVoiceActive());
+
+            voice->resetStatistics();
+            expectEquals (voice->getStatistics().numUnderruns, (int64) 0);
+        }
+    }
+
+    static AudioBuffer<float> render (Synthesiser& synth, int note, bool waitForDisk)
+    {
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), 0);
+
+        return render (synth, midi, waitForDisk);
+    }
+
+    static AudioBuffer<float> render (Synthesiser& synth, MidiBuffer midi, bool waitForDisk)
+    {
+        constexpr int blockSize = 512, numBlocks = 320;
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        AudioBuffer<float> output (2, blockSize * numBlocks);
+        output.clear();
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            AudioBuffer<float> block (output.getArrayOfWritePointers(), 2, i * blockSize, blockSize);
+            synth.renderNextBlock (block, midi, 0, blockSize);
+            midi.clear();
+
+            // give the disk thread a chance to stay ahead of playback
+            if (waitForDisk)
+                Thread::sleep (2);
+        }
+
+        return output;
+    }
+
+    static void writeTestFile (const File& file, int numSamples, int numChannels)
+    {
+        Random random (numSamples);
+        AudioBuffer<float> content (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                content.setSample (ch, i, (float) (random.nextInt (65535) - 32767) / 32768.0f);
+
+        WavAudioFormat format;
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (file.createOutputStream().release(),
+                                                                           44100.0, (unsigned int) numChannels,
+                                                                           16, {}, 0));
+        writer->writeFromAudioSampleBuffer (content, 0, numSamples);
+    }
+
+    static bool buffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (a.getSample (ch, i) != b.getSample (ch, i))
+                    return false;
+
+        return true;
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
 } // namespace juce
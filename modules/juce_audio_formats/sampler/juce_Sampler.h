@@ -150,4 +150,246 @@ private:
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
+
+//==============================================================================
+/**
+    A SynthesiserSound that plays a sample which is streamed from disk.
+
+    Unlike SamplerSound, this only loads the start of the sample into memory. The
+    rest of it is read from the AudioFormatReader by a background thread while the
+    sound is playing, so it can be used for sets of samples that are far too big
+    to fit in memory.
+
+    It must be played by StreamingSamplerVoice objects.
+
+    @see StreamingSamplerVoice, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Decides how much of the start of each sample is kept in memory. */
+    struct PreloadPolicy
+    {
+        /** The length of the start of the sample that's loaded when the sound is created.
+
+            A voice plays from this while the disk thread fetches the rest of the sample,
+            so it must cover the worst-case time that the disk can take to respond, at
+            the highest pitch that the sound will be played at.
+        */
+        double preloadSeconds;
+
+        /** Samples no longer than this are loaded into memory completely, and never streamed. */
+        double loadWholeSampleBelowSeconds;
+
+        /** Returns the number of samples to preload for a sample of the given length. */
+        int getNumSamplesToPreload (int lengthInSamples, double sampleRate) const noexcept;
+    };
+
+    //==============================================================================
+    /** Creates a streamed sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the audio to play. This object takes ownership of the reader,
+                            and will read from it on the disk thread of each voice that
+                            plays the sound
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the audio
+                                        source, in seconds
+        @param preloadPolicy    decides how much of the sample is loaded up-front. By
+                                default, 0.25 seconds are preloaded, and samples shorter
+                                than a second are loaded completely
+    */
+    StreamingSamplerSound (const String& name,
+                           AudioFormatReader* source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double maxSampleLengthSeconds,
+                           PreloadPolicy preloadPolicy = { 0.25, 1.0 });
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the length of the sample that will be played. */
+    int getLengthInSamples() const noexcept                 { return length; }
+
+    /** Returns the number of samples that were loaded into memory up-front. */
+    int getNumPreloadedSamples() const noexcept             { return preloadedData.getNumSamples(); }
+
+    /** Returns true if the whole sample is in memory, so doesn't need to be streamed. */
+    bool isFullyLoaded() const noexcept                     { return getNumPreloadedSamples() >= length; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preloadedData;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int length = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    int64 readFromSource (AudioBuffer<float>&, int startSample, int numSamples, int64 sourcePosition);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+
+//==============================================================================
+/**
+    A SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice has a ring buffer which a background thread fills with the part of
+    the sample that follows the preloaded section. The audio thread reads from it
+    without taking any locks. If the disk can't keep up and the voice runs out of
+    data, it stays silent until more arrives, and the underrun is counted in its
+    statistics.
+
+    The thread can be shared between as many voices as you like, and also with
+    other objects that use a TimeSliceThread.
+
+    @see StreamingSamplerSound, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice,
+                                           private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a StreamingSamplerVoice.
+
+        @param diskThread           the thread that should be used to read from the samples.
+                                    Make sure that the thread you supply is running, and won't
+                                    be deleted while the voice still exists.
+        @param bufferSizeInSamples  the size of the ring buffer that holds the samples which
+                                    have been read ahead of the playback position
+    */
+    StreamingSamplerVoice (TimeSliceThread& diskThread, int bufferSizeInSamples = 32768);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    /** Counters describing how well the streaming is keeping up. */
+    struct Statistics
+    {
+        /** The number of blocks in which a voice ran out of streamed data. */
+        int64 numUnderruns = 0;
+
+        /** The number of samples that have been read from the disk. */
+        int64 numSamplesRead = 0;
+
+        /** The number of bytes of (uncompressed) audio that have been read from the disk. */
+        int64 numBytesRead = 0;
+
+        /** The total time that the disk thread has spent reading. */
+        double secondsSpentReading = 0;
+
+        /** Returns the rate at which data has been read, in bytes per second of reading time. */
+        double getReadBandwidth() const noexcept;
+
+        Statistics& operator+= (const Statistics&) noexcept;
+    };
+
+    /** Returns the counters for this voice. This can be called from any thread. */
+    Statistics getStatistics() const noexcept;
+
+    /** Resets this voice's counters to zero. */
+    void resetStatistics() noexcept;
+
+    /** Returns the totals of the counters for all the StreamingSamplerVoices in a synth. */
+    static Statistics getTotalStatistics (const Synthesiser&);
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    TimeSliceThread& thread;
+    AudioBuffer<float> ringBuffer;
+    AbstractFifo fifo;
+
+    // audio thread state
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+    int noteGeneration = 0, streamedPosition = 0;
+
+    ADSR adsr;
+
+    // The audio thread asks for a new sound to be streamed by filling in the request it
+    // owns and swapping it with the pending one. The disk thread swaps its own (emptied)
+    // request for the pending one when it's marked as new, so neither thread ever waits
+    // for the other, and only the latest request is acted upon.
+    struct StreamRequest
+    {
+        SynthesiserSound::Ptr sound;
+        int generation = 0;
+    };
+
+    static constexpr int newRequestFlag = 4;
+
+    StreamRequest streamRequests[3];
+    int audioThreadRequest = 0, diskThreadRequest = 1;
+    std::atomic<int> pendingRequest { 2 };
+
+    // A request that was overtaken before the disk thread picked it up comes back to the
+    // audio thread still holding its sound, which might be the last reference to it. The
+    // audio thread hands those back through this fifo, so only the disk thread releases them.
+    static constexpr int maxSoundsToRelease = 32;
+    AbstractFifo soundsToReleaseFifo { maxSoundsToRelease };
+    SynthesiserSound::Ptr soundsToRelease[maxSoundsToRelease];
+
+    // set by the disk thread when it has emptied the ring buffer for a new note
+    std::atomic<int> readyGeneration { 0 };
+
+    // disk thread state
+    SynthesiserSound::Ptr streamingSound;
+    int streamingGeneration = 0;
+    int64 nextReadPosition = 0;
+
+    std::atomic<int64> numUnderruns { 0 }, numSamplesRead { 0 }, numBytesRead { 0 }, ticksSpentReading { 0 };
+
+    void requestStream (StreamingSamplerSound*);
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
 } // namespace juce
@@ -291,6 +291,29 @@ public:
     */
     bool removeIllegalConnections();
 
+    //==============================================================================
+    /** Lets the graph use some additional threads to render independent branches
+        of the graph in parallel.
+
+        By default (i.e. with zero render threads) every node is processed one after
+        another on the thread that calls processBlock(). If you set this to a positive
+        number, that many real-time worker threads will be started, and each block will
+        be split between them and the calling thread wherever the connections between
+        nodes allow it. The output is identical to the serial rendering path.
+
+        Only do this if the processors in your graph are safe to be called from
+        different threads, and bear in mind that in this mode the graph will use
+        more memory for its intermediate buffers.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of additional threads that the graph uses for rendering.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -412,6 +435,9 @@ private:
     std::unique_ptr<RenderSequenceFloat> renderSequenceFloat;
     std::unique_ptr<RenderSequenceDouble> renderSequenceDouble;
 
+    struct RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+
     friend class AudioGraphIOProcessor;
 
     std::atomic<bool> isPrepared { false };
@@ -33,6 +33,8 @@ void KnownPluginList::clear()
 {
     ScopedLock lock (typesArrayLock);
 
+    emptyScanResults.clear();
+
     if (! types.isEmpty())
     {
         types.clear();
@@ -40,6 +42,12 @@ void KnownPluginList::clear()
     }
 }
 
+void KnownPluginList::clearEmptyScanResults()
+{
+    ScopedLock lock (typesArrayLock);
+    emptyScanResults.clear();
+}
+
 int KnownPluginList::getNumTypes() const noexcept
 {
     ScopedLock lock (typesArrayLock);
@@ -127,7 +135,7 @@ bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
                                          AudioPluginFormat& formatToUse) const
 {
     if (getTypeForFile (fileOrIdentifier) == nullptr)
-        return false;
+        return isEmptyScanResultUpToDate (fileOrIdentifier, formatToUse);
 
     ScopedLock lock (typesArrayLock);
 
@@ -172,11 +180,25 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         if (! needsRescanning)
             return false;
     }
+    else if (dontRescanIfAlreadyInList
+              && isEmptyScanResultUpToDate (fileOrIdentifier, format))
+    {
+        return false;
+    }
 
     if (blacklist.contains (fileOrIdentifier))
-        return false;
+    {
+        // Files that crashed a scan get another chance once they've been modified,
+        // but anything that was blacklisted by hand stays that way
+        if (! hasEmptyScanResult (fileOrIdentifier, format)
+             || isEmptyScanResultUpToDate (fileOrIdentifier, format))
+            return false;
+
+        removeFromBlacklist (fileOrIdentifier);
+    }
 
     OwnedArray<PluginDescription> found;
+    bool scanWasAbandoned = false;
 
     {
         const ScopedUnlock sl2 (scanLock);
@@ -185,6 +207,8 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         {
             if (! scanner->findPluginTypesFor (format, found, fileOrIdentifier))
                 addToBlacklist (fileOrIdentifier);
+
+            scanWasAbandoned = scanner->shouldExit();
         }
         else
         {
@@ -199,9 +223,54 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         typesFound.add (new PluginDescription (*desc));
     }
 
+    if (! scanWasAbandoned)
+        setEmptyScanResult (fileOrIdentifier, format, found.isEmpty());
+
     return ! found.isEmpty();
 }
 
+bool KnownPluginList::hasEmptyScanResult (const String& fileOrIdentifier, AudioPluginFormat& format) const
+{
+    ScopedLock lock (typesArrayLock);
+    return emptyScanResults.find ({ format.getName(), fileOrIdentifier }) != emptyScanResults.end();
+}
+
+bool KnownPluginList::isEmptyScanResultUpToDate (const String& fileOrIdentifier, AudioPluginFormat& format) const
+{
+    PluginDescription desc;
+
+    {
+        ScopedLock lock (typesArrayLock);
+
+        auto it = emptyScanResults.find ({ format.getName(), fileOrIdentifier });
+
+        if (it == emptyScanResults.end())
+            return false;
+
+        desc.lastFileModTime = it->second;
+    }
+
+    // Let the format decide whether the file has changed, in the same way it
+    // would for a description of a plugin that it had found
+    desc.fileOrIdentifier = fileOrIdentifier;
+    desc.pluginFormatName = format.getName();
+
+    return ! format.pluginNeedsRescanning (desc);
+}
+
+void KnownPluginList::setEmptyScanResult (const String& fileOrIdentifier, AudioPluginFormat& format, bool isEmpty)
+{
+    const std::pair<String, String> key (format.getName(), fileOrIdentifier);
+
+    ScopedLock lock (typesArrayLock);
+
+    // Only files have a modification time that can tell us when to look at them again
+    if (isEmpty && File::isAbsolutePath (fileOrIdentifier))
+        emptyScanResults[key] = File (fileOrIdentifier).getLastModificationTime();
+    else
+        emptyScanResults.erase (key);
+}
+
 void KnownPluginList::scanAndAddDragAndDroppedFiles (AudioPluginFormatManager& formatManager,
                                                      const StringArray& files,
                                                      OwnedArray<PluginDescription>& typesFound)
@@ -368,6 +437,18 @@ std::unique_ptr<XmlElement> KnownPluginList::createXml() const
     for (auto& b : blacklist)
         e->createNewChildElement ("BLACKLISTED")->setAttribute ("id", b);
 
+    {
+        ScopedLock lock (typesArrayLock);
+
+        for (auto& r : emptyScanResults)
+        {
+            auto* child = e->createNewChildElement ("EMPTYFILE");
+            child->setAttribute ("format", r.first.first);
+            child->setAttribute ("file", r.first.second);
+            child->setAttribute ("fileTime", String::toHexString (r.second.toMilliseconds()));
+        }
+    }
+
     return e;
 }
 
@@ -384,6 +465,9 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
 
             if (e->hasTagName ("BLACKLISTED"))
                 blacklist.add (e->getStringAttribute ("id"));
+            else if (e->hasTagName ("EMPTYFILE"))
+                emptyScanResults[{ e->getStringAttribute ("format"), e->getStringAttribute ("file") }]
+                    = Time (e->getStringAttribute ("fileTime").getHexValue64());
             else if (info.loadFromXml (*e))
                 addType (info);
         }
@@ -633,5 +717,209 @@ std::unique_ptr<KnownPluginList::PluginTree> KnownPluginList::createTree (const
     return createTree (getTypes(), sortMethod);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class KnownPluginListTests  : public UnitTest
+{
+public:
+    KnownPluginListTests()
+        : UnitTest ("Known Plugin List", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser_gui;
+
+        auto folder = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("PluginScanTest", {});
+        expect (folder.createDirectory());
+
+        auto createFile = [&] (const String& fileName)
+        {
+            auto file = folder.getChildFile (fileName);
+            file.replaceWithText (fileName);
+            file.setLastModificationTime (Time (2020, 0, 1, 12, 0));
+            return file;
+        };
+
+        auto touch = [] (const File& file)
+        {
+            file.setLastModificationTime (file.getLastModificationTime() + RelativeTime::hours (1));
+        };
+
+        auto pluginA = createFile ("a.plugin");
+        auto pluginB = createFile ("b.plugin");
+        auto empty   = createFile ("c.txt");
+        auto crashy  = createFile ("d.crash");
+
+        TestFormat format;
+        KnownPluginList list;
+        list.setCustomScanner (std::make_unique<TestScanner>());
+
+        auto scan = [&] (KnownPluginList& listToScan, int numThreads)
+        {
+            format.scannedFiles.clear();
+
+            PluginDirectoryScanner scanner (listToScan, format, FileSearchPath (folder.getFullPathName()), false, {});
+            scanner.scanAllFiles (true, numThreads);
+
+            return scanner.getFailedFiles();
+        };
+
+        beginTest ("All the files are scanned the first time");
+        {
+            auto failed = scan (list, 3);
+
+            expectEquals (list.getNumTypes(), 2);
+            expectEquals (format.scannedFiles.size(), 4);
+            expect (failed.contains (empty.getFullPathName()));
+            expect (list.getBlacklistedFiles().contains (crashy.getFullPathName()));
+        }
+
+        beginTest ("Unchanged files aren't scanned again, even if they contained no plugins");
+        {
+            auto failed = scan (list, 2);
+
+            expectEquals (list.getNumTypes(), 2);
+            expectEquals (format.scannedFiles.size(), 0);
+            expect (failed.isEmpty());
+        }
+
+        beginTest ("The scan results survive being saved as XML");
+        {
+            KnownPluginList restored;
+            restored.setCustomScanner (std::make_unique<TestScanner>());
+
+            if (auto xml = list.createXml())
+                restored.recreateFromXml (*xml);
+
+            scan (restored, 1);
+            expectEquals (restored.getNumTypes(), 2);
+            expectEquals (format.scannedFiles.size(), 0);
+        }
+
+        beginTest ("Modified files are rescanned");
+        {
+            touch (pluginA);
+            touch (empty);
+
+            scan (list, 2);
+            format.scannedFiles.sort (false);
+
+            expectEquals (format.scannedFiles.joinIntoString (";"),
+                          pluginA.getFullPathName() + ";" + empty.getFullPathName());
+        }
+
+        beginTest ("A crashed file is tried again once it has been modified");
+        {
+            touch (crashy);
+            crashy.replaceWithText ("fixed");
+
+            scan (list, 2);
+
+            expect (format.scannedFiles.contains (crashy.getFullPathName()));
+            expect (! list.getBlacklistedFiles().contains (crashy.getFullPathName()));
+        }
+
+        beginTest ("Files blacklisted by hand stay blacklisted");
+        {
+            list.addToBlacklist (pluginB.getFullPathName());
+            touch (pluginB);
+
+            scan (list, 1);
+            expect (! format.scannedFiles.contains (pluginB.getFullPathName()));
+        }
+
+        beginTest ("Clearing the list forgets the scan results");
+        {
+            list.clear();
+            list.clearBlacklistedFiles();
+
+            scan (list, 4);
+            expectEquals (format.scannedFiles.size(), 4);
+            expectEquals (list.getNumTypes(), 3);
+        }
+
+        expect (folder.deleteRecursively());
+    }
+
+private:
+    struct TestFormat  : public AudioPluginFormat
+    {
+        String getName() const override                                     { return "Test"; }
+
+        void findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& fileOrIdentifier) override
+        {
+            File file (fileOrIdentifier);
+
+            {
+                const ScopedLock sl (lock);
+                scannedFiles.add (fileOrIdentifier);
+            }
+
+            if (file.getFileExtension() == ".txt")
+                return;
+
+            auto* desc = results.add (new PluginDescription());
+            desc->name = file.getFileNameWithoutExtension();
+            desc->pluginFormatName = getName();
+            desc->fileOrIdentifier = fileOrIdentifier;
+            desc->lastFileModTime = file.getLastModificationTime();
+            desc->uid = fileOrIdentifier.hashCode();
+        }
+
+        bool fileMightContainThisPluginType (const String&) override       { return true; }
+        String getNameOfPluginFromIdentifier (const String& f) override     { return f; }
+        bool pluginNeedsRescanning (const PluginDescription& d) override    { return File (d.fileOrIdentifier).getLastModificationTime() != d.lastFileModTime; }
+        bool doesPluginStillExist (const PluginDescription& d) override     { return File (d.fileOrIdentifier).exists(); }
+        bool canScanForPlugins() const override                             { return true; }
+        bool isTrivialToScan() const override                               { return false; }
+        FileSearchPath getDefaultLocationsToSearch() override               { return {}; }
+
+        StringArray searchPathsForPlugins (const FileSearchPath& path, bool, bool) override
+        {
+            StringArray files;
+
+            for (auto& f : path[0].findChildFiles (File::findFiles, false))
+                files.add (f.getFullPathName());
+
+            return files;
+        }
+
+        void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback) override
+        {
+            callback (nullptr, "Not supported");
+        }
+
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override  { return false; }
+
+        CriticalSection lock;
+        StringArray scannedFiles;
+    };
+
+    // Pretends that anything still containing its original text crashes when it's loaded
+    struct TestScanner  : public KnownPluginList::CustomScanner
+    {
+        bool findPluginTypesFor (AudioPluginFormat& format, OwnedArray<PluginDescription>& result,
+                                 const String& fileOrIdentifier) override
+        {
+            File file (fileOrIdentifier);
+            format.findAllTypesForFile (result, fileOrIdentifier);
+
+            if (file.getFileExtension() == ".crash" && file.loadFileAsString() == file.getFileName())
+            {
+                result.clear();
+                return false;
+            }
+
+            return true;
+        }
+    };
+};
+
+static KnownPluginListTests knownPluginListTests;
+
+#endif
 
 } // namespace juce
@@ -98,6 +98,11 @@ public:
 
     /** Returns true if the specified file is already known about and if it
         hasn't been modified since our entry was created.
+
+        As well as files that contain known types, this includes files which were
+        scanned but didn't contain any plugins, or which were blacklisted because
+        they crashed a custom scanner, so that rescanning a large set of plugins
+        only needs to look at the files that have changed.
     */
     bool isListingUpToDate (const String& possiblePluginFileOrIdentifier,
                             AudioPluginFormat& formatToUse) const;
@@ -164,6 +169,13 @@ public:
     /** Recreates the state of this list from its stored XML format. */
     void recreateFromXml (const XmlElement& xml);
 
+    /** Forgets about any files that were scanned without finding any types, so
+        that they'll be tried again by the next scan.
+
+        clear() also does this.
+    */
+    void clearEmptyScanResults();
+
     //==============================================================================
     /** A structure that recursively holds a tree of plugins.
         @see KnownPluginList::createTree()
@@ -229,9 +241,14 @@ private:
     //==============================================================================
     Array<PluginDescription> types;
     StringArray blacklist;
+    std::map<std::pair<String, String>, Time> emptyScanResults;
     std::unique_ptr<CustomScanner> scanner;
     CriticalSection scanLock, typesArrayLock;
 
+    bool hasEmptyScanResult (const String&, AudioPluginFormat&) const;
+    bool isEmptyScanResultUpToDate (const String&, AudioPluginFormat&) const;
+    void setEmptyScanResult (const String&, AudioPluginFormat&, bool isEmpty);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginList)
 };
 
@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct OutOfProcessPluginScanner::WorkerProcess  : public ChildProcessMaster
+{
+    enum class Result
+    {
+        succeeded,
+        failed,
+        abandoned
+    };
+
+    Result scan (AudioPluginFormat& format, const String& fileOrIdentifier, int timeoutMs,
+                 const KnownPluginList::CustomScanner& owner, OwnedArray<PluginDescription>& result)
+    {
+        {
+            const ScopedLock sl (replyLock);
+            reply.reset();
+            hasReply = false;
+        }
+
+        MemoryOutputStream request;
+        request.writeString (format.getName());
+        request.writeString (fileOrIdentifier);
+        request.writeInt (timeoutMs);
+
+        if (connectionLost || ! sendMessageToSlave (request.getMemoryBlock()))
+            return Result::failed;
+
+        auto startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            replyReceived.wait (100);
+
+            {
+                const ScopedLock sl (replyLock);
+
+                if (hasReply)
+                {
+                    if (auto xml = parseXML (reply.toString()))
+                    {
+                        forEachXmlChildElement (*xml, e)
+                        {
+                            auto desc = std::make_unique<PluginDescription>();
+
+                            if (desc->loadFromXml (*e))
+                                result.add (desc.release());
+                        }
+                    }
+
+                    return Result::succeeded;
+                }
+            }
+
+            if (connectionLost || ! isSlaveProcessRunning())
+                return Result::failed;
+
+            if (owner.shouldExit())
+                return Result::abandoned;
+
+            // The worker should have given up by itself by now, but may be too stuck to do so
+            if (Time::getMillisecondCounter() - startTime >= (uint32) timeoutMs + 1000)
+                return Result::failed;
+        }
+    }
+
+    void handleMessageFromSlave (const MemoryBlock& message) override
+    {
+        {
+            const ScopedLock sl (replyLock);
+            reply = message;
+            hasReply = true;
+        }
+
+        replyReceived.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        connectionLost = true;
+        replyReceived.signal();
+    }
+
+    CriticalSection replyLock;
+    MemoryBlock reply;
+    bool hasReply = false;
+    std::atomic<bool> connectionLost { false };
+    WaitableEvent replyReceived;
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const File& executable,
+                                                      const String& uniqueID,
+                                                      int timeoutMs)
+    : workerExecutable (executable),
+      commandLineUniqueID (uniqueID),
+      scanTimeoutMs (timeoutMs)
+{
+    jassert (scanTimeoutMs > 0);
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner() = default;
+
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    auto worker = getIdleWorker();
+
+    if (worker == nullptr)
+    {
+        // Couldn't start a worker process! Make sure that the executable creates a Worker
+        // and connects it with a matching ID when it starts up. Until then, the plugins
+        // will have to be scanned in this process.
+        jassertfalse;
+        format.findAllTypesForFile (result, fileOrIdentifier);
+        return true;
+    }
+
+    switch (worker->scan (format, fileOrIdentifier, scanTimeoutMs, *this, result))
+    {
+        case WorkerProcess::Result::succeeded:
+            returnIdleWorker (std::move (worker));
+            return true;
+
+        case WorkerProcess::Result::abandoned:
+            retireWorker (std::move (worker));
+            return true;
+
+        case WorkerProcess::Result::failed:
+        default:
+            retireWorker (std::move (worker));
+            return false;
+    }
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    const ScopedLock sl (workerLock);
+    idleWorkers.clear();
+}
+
+std::unique_ptr<OutOfProcessPluginScanner::WorkerProcess> OutOfProcessPluginScanner::getIdleWorker()
+{
+    {
+        const ScopedLock sl (workerLock);
+
+        if (! idleWorkers.isEmpty())
+            return std::unique_ptr<WorkerProcess> (idleWorkers.removeAndReturn (idleWorkers.size() - 1));
+    }
+
+    auto worker = std::make_unique<WorkerProcess>();
+
+    if (worker->launchSlaveProcess (workerExecutable, commandLineUniqueID, 0, 0))
+        return worker;
+
+    return {};
+}
+
+void OutOfProcessPluginScanner::returnIdleWorker (std::unique_ptr<WorkerProcess> worker)
+{
+    const ScopedLock sl (workerLock);
+    idleWorkers.add (worker.release());
+}
+
+void OutOfProcessPluginScanner::retireWorker (std::unique_ptr<WorkerProcess> worker)
+{
+    // A worker that has lost its connection may have a pending message telling it so,
+    // which means that it has to be deleted on the message thread
+    if (MessageManager::getInstance()->isThisTheMessageThread())
+        worker.reset();
+    else
+        MessageManager::callAsync ([deadWorker = std::shared_ptr<WorkerProcess> (std::move (worker))] {});
+}
+
+//==============================================================================
+// Terminates the worker if a plugin holds up the message thread for longer than the
+// scanner is prepared to wait, as the scanner will have given up on it by then anyway
+struct OutOfProcessPluginScanner::Worker::Watchdog  : public Thread
+{
+    Watchdog()  : Thread ("plugin scan watchdog")   { startThread(); }
+    ~Watchdog() override                            { stopThread (2000); }
+
+    void scanStarted (int timeoutMs)
+    {
+        deadline = Time::getMillisecondCounter() + (uint32) timeoutMs;
+        isScanning = true;
+    }
+
+    void scanFinished()
+    {
+        isScanning = false;
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (isScanning && (int) (Time::getMillisecondCounter() - deadline.load()) > 0)
+                Process::terminate();
+
+            wait (100);
+        }
+    }
+
+    std::atomic<uint32> deadline { 0 };
+    std::atomic<bool> isScanning { false };
+};
+
+OutOfProcessPluginScanner::Worker::Worker()
+{
+    formatManager.addDefaultFormats();
+}
+
+OutOfProcessPluginScanner::Worker::~Worker() = default;
+
+void OutOfProcessPluginScanner::Worker::handleMessageFromMaster (const MemoryBlock& message)
+{
+    MemoryInputStream request (message, false);
+    auto formatName = request.readString();
+    auto fileOrIdentifier = request.readString();
+    auto timeoutMs = request.readInt();
+
+    MessageManager::callAsync ([this, formatName, fileOrIdentifier, timeoutMs]
+    {
+        if (watchdog == nullptr)
+            watchdog = std::make_unique<Watchdog>();
+
+        watchdog->scanStarted (timeoutMs);
+        XmlElement found ("PLUGINS");
+
+        for (auto* format : formatManager.getFormats())
+        {
+            if (format->getName() == formatName)
+            {
+                OwnedArray<PluginDescription> types;
+                format->findAllTypesForFile (types, fileOrIdentifier);
+
+                for (auto* desc : types)
+                    found.addChildElement (desc->createXml().release());
+            }
+        }
+
+        watchdog->scanFinished();
+
+        auto reply = found.toString (XmlElement::TextFormat().singleLine().withoutHeader());
+        sendMessageToMaster ({ reply.toRawUTF8(), reply.getNumBytesAsUTF8() });
+    });
+}
+
+void OutOfProcessPluginScanner::Worker::handleConnectionLost()
+{
+    // The scanner has either finished with us or given up on a plugin that's still
+    // running on the message thread, so there's nothing to gain from a clean shutdown
+    Process::terminate();
+}
+
+} // namespace juce
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a separate worker
+    process, so that a plugin that crashes or hangs while being scanned can't take
+    the host down with it.
+
+    Each thread that scans a file borrows a worker, launching a new one if none
+    are free, so scanning with several threads at once (e.g. with
+    PluginDirectoryScanner::scanAllFiles() or
+    PluginListComponent::setNumberOfThreadsForScanning()) scans that many plugins
+    in parallel. A plugin whose worker dies, or doesn't reply within the timeout,
+    is reported as having crashed, and gets blacklisted by the KnownPluginList.
+
+    The workers are launched by running an executable - usually your own app -
+    which must create an OutOfProcessPluginScanner::Worker on startup and connect
+    it with ChildProcessSlave::initialiseFromCommandLine(), using the same ID as
+    the one given to the scanner:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginScanner::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine, "pluginscanner"))
+        {
+            scannerWorker = std::move (worker); // we're a worker, so don't create any windows
+            return;
+        }
+
+        knownPluginList.setCustomScanner (std::make_unique<OutOfProcessPluginScanner> (File::getSpecialLocation (File::currentExecutableFile),
+                                                                                       "pluginscanner"));
+        ...
+    }
+    @endcode
+
+    @see KnownPluginList::setCustomScanner, PluginDirectoryScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner that launches the given executable to do its work.
+
+        @param workerExecutable     the executable to launch for each worker process
+        @param commandLineUniqueID  the ID that the executable's Worker expects to see
+                                    in its command-line (see ChildProcessMaster::launchSlaveProcess())
+        @param scanTimeoutMs        how long a worker may take to scan a single file
+                                    before it's killed and the file is treated as having
+                                    crashed
+    */
+    OutOfProcessPluginScanner (const File& workerExecutable,
+                               const String& commandLineUniqueID,
+                               int scanTimeoutMs = 60000);
+
+    /** Destructor. This kills any workers that are still running. */
+    ~OutOfProcessPluginScanner() override;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        The other end of an OutOfProcessPluginScanner, which runs in each of its
+        worker processes and scans whatever files it's asked to.
+
+        It starts off with the default formats for the platform - if your host uses
+        any others, add them to the format manager before calling
+        initialiseFromCommandLine(). The scans are run on the message thread, so the
+        worker process needs to have a running message loop.
+
+        As the worker may be stuck inside a plugin when its scanner gives up on it,
+        losing the connection or taking longer than the scanner's timeout terminates
+        the process immediately.
+    */
+    class JUCE_API  Worker  : public ChildProcessSlave
+    {
+    public:
+        /** Creates a worker that can scan all the default formats. */
+        Worker();
+
+        /** Destructor. */
+        ~Worker() override;
+
+        /** Returns the formats that this worker is able to scan. */
+        AudioPluginFormatManager& getFormatManager() noexcept     { return formatManager; }
+
+        /** @internal */
+        void handleMessageFromMaster (const MemoryBlock&) override;
+        /** @internal */
+        void handleConnectionLost() override;
+
+    private:
+        struct Watchdog;
+
+        AudioPluginFormatManager formatManager;
+        std::unique_ptr<Watchdog> watchdog;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    struct WorkerProcess;
+
+    std::unique_ptr<WorkerProcess> getIdleWorker();
+    void returnIdleWorker (std::unique_ptr<WorkerProcess>);
+    void retireWorker (std::unique_ptr<WorkerProcess>);
+
+    const File workerExecutable;
+    const String commandLineUniqueID;
+    const int scanTimeoutMs;
+
+    OwnedArray<WorkerProcess> idleWorkers;
+    CriticalSection workerLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
@@ -96,19 +96,18 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             OwnedArray<PluginDescription> typesFound;
 
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+            addToDeadMansPedal (file);
 
             list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
 
             // Managed to load without crashing, so remove it from the dead-man's-pedal..
-            crashedPlugins.removeString (file);
-            setDeadMansPedalFile (crashedPlugins);
+            removeFromDeadMansPedal (file);
 
             if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
+            {
+                const ScopedLock sl (scanLock);
                 failedFiles.add (file);
+            }
         }
     }
 
@@ -116,6 +115,41 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
     return index > 0;
 }
 
+void PluginDirectoryScanner::scanAllFiles (bool dontRescanIfAlreadyInList, int numThreads)
+{
+    struct ScanJob  : public ThreadPoolJob
+    {
+        ScanJob (PluginDirectoryScanner& s, bool dontRescan)
+            : ThreadPoolJob ("pluginscan"), scanner (s), dontRescanIfAlreadyInList (dontRescan)
+        {}
+
+        JobStatus runJob() override
+        {
+            String pluginBeingScanned;
+
+            while (scanner.scanNextFile (dontRescanIfAlreadyInList, pluginBeingScanned) && ! shouldExit())
+            {}
+
+            return jobHasFinished;
+        }
+
+        PluginDirectoryScanner& scanner;
+        const bool dontRescanIfAlreadyInList;
+    };
+
+    jassert (numThreads > 0);
+    numThreads = jmax (1, numThreads);
+
+    ThreadPool pool (numThreads);
+    OwnedArray<ScanJob> jobs;
+
+    for (int i = 0; i < numThreads; ++i)
+        pool.addJob (jobs.add (new ScanJob (*this, dontRescanIfAlreadyInList)), false);
+
+    for (auto* job : jobs)
+        pool.waitForJobToFinish (job, -1);
+}
+
 bool PluginDirectoryScanner::skipNextFile()
 {
     updateProgress();
@@ -128,6 +162,25 @@ void PluginDirectoryScanner::setDeadMansPedalFile (const StringArray& newContent
         deadMansPedalFile.replaceWithText (newContents.joinIntoString ("\n"), true, true);
 }
 
+void PluginDirectoryScanner::addToDeadMansPedal (const String& file)
+{
+    const ScopedLock sl (scanLock);
+
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+    crashedPlugins.add (file);
+    setDeadMansPedalFile (crashedPlugins);
+}
+
+void PluginDirectoryScanner::removeFromDeadMansPedal (const String& file)
+{
+    const ScopedLock sl (scanLock);
+
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+    setDeadMansPedalFile (crashedPlugins);
+}
+
 void PluginDirectoryScanner::applyBlacklistingsFromDeadMansPedal (KnownPluginList& list, const File& file)
 {
     // If any plugins have crashed recently when being loaded, move them to the
@@ -89,10 +89,26 @@ public:
         scanned before the scan starts.
 
         Returns false when there are no more files to try.
+
+        This can be called by several threads at once, each of which will be given
+        a different file to scan.
     */
     bool scanNextFile (bool dontRescanIfAlreadyInList,
                        String& nameOfPluginBeingScanned);
 
+    /** Scans all the remaining files, using a number of threads at once, and
+        returns when they've all been tried.
+
+        This works best with a KnownPluginList::CustomScanner that loads each
+        plugin in a separate process, such as OutOfProcessPluginScanner, so that
+        one that hangs or crashes can't hold up or bring down the others. Formats
+        that need the message thread to be running while they scan shouldn't be
+        scanned like this.
+
+        @see scanNextFile
+    */
+    void scanAllFiles (bool dontRescanIfAlreadyInList, int numThreads);
+
     /** Skips over the next file without scanning it.
         Returns false when there are no more files to try.
     */
@@ -107,7 +123,7 @@ public:
     String getNextPluginFileThatWillBeScanned() const;
 
     /** Returns the estimated progress, between 0 and 1. */
-    float getProgress() const                                       { return progress; }
+    float getProgress() const                                       { return progress.load(); }
 
     /** This returns a list of all the filenames of things that looked like being
         a plugin file, but which failed to open for some reason.
@@ -125,12 +141,15 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    CriticalSection scanLock;
     Atomic<int> nextIndex;
-    float progress = 0;
+    std::atomic<float> progress { 0.0f }; // written by whichever scanning thread last finished a file
     const bool allowAsync;
 
     void updateProgress();
     void setDeadMansPedalFile (const StringArray& newContents);
+    void addToDeadMansPedal (const String&);
+    void removeFromDeadMansPedal (const String&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginDirectoryScanner)
 };
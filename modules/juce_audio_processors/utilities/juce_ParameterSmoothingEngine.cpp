@@ -0,0 +1,517 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ParameterSmoothingEngine::ParameterSmoothingEngine() = default;
+
+ParameterSmoothingEngine::ParameterSmoothingEngine (AudioProcessorValueTreeState& state, double rampLengthInSeconds)
+{
+    for (auto* p : state.processor.getParameters())
+        if (auto* ranged = dynamic_cast<RangedAudioParameter*> (p))
+            if (auto* rawValue = state.getRawParameterValue (ranged->paramID))
+                addParameter (*rawValue, ranged->isDiscrete() ? 0.0 : rampLengthInSeconds,
+                              SmoothingType::linear, ranged->paramID);
+}
+
+ParameterSmoothingEngine::~ParameterSmoothingEngine() = default;
+
+//==============================================================================
+int ParameterSmoothingEngine::addParameter (std::atomic<float>& targetValueSource,
+                                            double rampLengthInSeconds,
+                                            SmoothingType type,
+                                            const String& parameterID)
+{
+    jassert (rampLengthInSeconds >= 0);
+
+    Ramp ramp;
+    ramp.source = &targetValueSource;
+    ramp.parameterID = parameterID;
+    ramp.rampLengthInSeconds = rampLengthInSeconds;
+    ramp.type = type;
+    ramp.currentValue = ramp.targetValue = targetValueSource.load();
+
+    ramps.push_back (std::move (ramp));
+
+    // If you add parameters after calling prepare(), you'll need to call it again
+    // before the next block so that the new ones get buffers of their own.
+    jassert (maxBlockSize == 0 || rampBuffers.getNumChannels() < (int) ramps.size());
+
+    return (int) ramps.size() - 1;
+}
+
+int ParameterSmoothingEngine::addParameter (AudioProcessorValueTreeState& state,
+                                            StringRef parameterID,
+                                            double rampLengthInSeconds,
+                                            SmoothingType type)
+{
+    if (auto* rawValue = state.getRawParameterValue (parameterID))
+        return addParameter (*rawValue, rampLengthInSeconds, type, parameterID);
+
+    jassertfalse; // there's no parameter with this ID in the state!
+    return -1;
+}
+
+int ParameterSmoothingEngine::getParameterIndex (StringRef parameterID) const
+{
+    for (size_t i = 0; i < ramps.size(); ++i)
+        if (ramps[i].parameterID == parameterID)
+            return (int) i;
+
+    return -1;
+}
+
+//==============================================================================
+void ParameterSmoothingEngine::prepare (double sampleRate, int maximumBlockSize)
+{
+    jassert (sampleRate > 0 && maximumBlockSize > 0);
+
+    currentSampleRate = sampleRate;
+    maxBlockSize = maximumBlockSize;
+
+    rampBuffers.setSize (jmax (1, getNumParameters()), maxBlockSize);
+    sampleIndices.setSize (1, maxBlockSize);
+
+    auto* indices = sampleIndices.getWritePointer (0);
+
+    for (int i = 0; i < maxBlockSize; ++i)
+        indices[i] = (float) (i + 1);
+
+    for (auto& ramp : ramps)
+        ramp.stepsToTarget = (int) std::floor (ramp.rampLengthInSeconds * sampleRate);
+
+    activeRamps.clear();
+    activeRamps.reserve (ramps.size());
+
+    reset();
+}
+
+void ParameterSmoothingEngine::reset() noexcept
+{
+    for (auto& ramp : ramps)
+    {
+        ramp.currentValue = ramp.targetValue = ramp.source->load (std::memory_order_relaxed);
+        ramp.countdown = 0;
+        ramp.isActive = false;
+        ramp.isSettling = false;
+        ramp.changedInLastBlock = false;
+    }
+
+    activeRamps.clear();
+    numActiveInLastBlock = 0;
+
+    if (maxBlockSize > 0)
+        for (size_t i = 0; i < ramps.size(); ++i)
+            fillConstant (ramps[i], (int) i);
+}
+
+void ParameterSmoothingEngine::process (int numSamples) noexcept
+{
+    // You need to call prepare() before processing, and again if you've added parameters since!
+    jassert (maxBlockSize > 0 && rampBuffers.getNumChannels() >= getNumParameters());
+    jassert (numSamples <= maxBlockSize);
+
+    numSamples = jmin (numSamples, maxBlockSize);
+
+    for (size_t i = 0; i < ramps.size(); ++i)
+    {
+        auto& ramp = ramps[i];
+        ramp.changedInLastBlock = false;
+
+        auto newTarget = ramp.source->load (std::memory_order_relaxed);
+
+        if (newTarget != ramp.targetValue)
+        {
+            startRamp (ramp, newTarget);
+
+            if (! ramp.isActive)
+            {
+                ramp.isActive = true;
+                activeRamps.push_back ((int) i); // never allocates, as prepare() reserved space for every parameter
+            }
+        }
+    }
+
+    numActiveInLastBlock = (int) activeRamps.size();
+
+    for (size_t i = 0; i < activeRamps.size();)
+    {
+        auto index = activeRamps[i];
+        auto& ramp = ramps[(size_t) index];
+
+        if (ramp.isSettling && ramp.countdown == 0)
+        {
+            // The ramp finished part-way through the last block, so the start of
+            // its buffer still holds ramp values that need overwriting
+            ramp.isSettling = false;
+            fillConstant (ramp, index);
+        }
+        else
+        {
+            auto wasRamping = (ramp.countdown > 0);
+
+            ramp.changedInLastBlock = true;
+            ramp.isSettling = false;
+            fillRamp (ramp, rampBuffers.getWritePointer (index), numSamples);
+
+            if (ramp.countdown == 0 && wasRamping)
+                ramp.isSettling = true;
+        }
+
+        if (ramp.countdown == 0 && ! ramp.isSettling)
+        {
+            ramp.isActive = false;
+            activeRamps[i] = activeRamps.back();
+            activeRamps.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+//==============================================================================
+const float* ParameterSmoothingEngine::getRampBuffer (int parameterIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (parameterIndex, getNumParameters()));
+    return rampBuffers.getReadPointer (parameterIndex);
+}
+
+float ParameterSmoothingEngine::getCurrentValue (int parameterIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (parameterIndex, getNumParameters()));
+    return ramps[(size_t) parameterIndex].currentValue;
+}
+
+float ParameterSmoothingEngine::getTargetValue (int parameterIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (parameterIndex, getNumParameters()));
+    return ramps[(size_t) parameterIndex].targetValue;
+}
+
+bool ParameterSmoothingEngine::isSmoothing (int parameterIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (parameterIndex, getNumParameters()));
+    return ramps[(size_t) parameterIndex].changedInLastBlock;
+}
+
+//==============================================================================
+void ParameterSmoothingEngine::startRamp (Ramp& ramp, float newTarget) noexcept
+{
+    ramp.targetValue = newTarget;
+    ramp.countdown = ramp.stepsToTarget;
+
+    if (ramp.countdown > 0)
+    {
+        if (ramp.type == SmoothingType::linear)
+        {
+            ramp.step = (ramp.targetValue - ramp.currentValue) / (float) ramp.countdown;
+            return;
+        }
+
+        // A multiplicative ramp can't pass through or start from zero, so these just jump
+        if (ramp.currentValue * ramp.targetValue > 0)
+        {
+            ramp.step = std::exp ((std::log (std::abs (ramp.targetValue)) - std::log (std::abs (ramp.currentValue)))
+                                    / (float) ramp.countdown);
+            return;
+        }
+    }
+
+    ramp.currentValue = ramp.targetValue;
+    ramp.countdown = 0;
+}
+
+void ParameterSmoothingEngine::fillRamp (Ramp& ramp, float* dest, int numSamples) noexcept
+{
+    auto numToRamp = jmin (numSamples, ramp.countdown);
+
+    if (numToRamp > 0)
+    {
+        if (ramp.type == SmoothingType::linear)
+        {
+            FloatVectorOperations::copyWithMultiply (dest, sampleIndices.getReadPointer (0), ramp.step, numToRamp);
+            FloatVectorOperations::add (dest, ramp.currentValue, numToRamp);
+        }
+        else
+        {
+            auto value = ramp.currentValue;
+
+            for (int i = 0; i < numToRamp; ++i)
+            {
+                value *= ramp.step;
+                dest[i] = value;
+            }
+        }
+
+        ramp.countdown -= numToRamp;
+        ramp.currentValue = dest[numToRamp - 1];
+    }
+
+    if (ramp.countdown == 0)
+    {
+        // Fill the whole of the rest of the buffer, so that nothing needs to be
+        // written for this parameter until its target changes again
+        ramp.currentValue = ramp.targetValue;
+        FloatVectorOperations::fill (dest + numToRamp, ramp.targetValue, maxBlockSize - numToRamp);
+    }
+}
+
+void ParameterSmoothingEngine::fillConstant (const Ramp& ramp, int index) noexcept
+{
+    FloatVectorOperations::fill (rampBuffers.getWritePointer (index), ramp.currentValue, maxBlockSize);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterSmoothingEngineTests  : public UnitTest
+{
+public:
+    ParameterSmoothingEngineTests()
+        : UnitTest ("Parameter Smoothing Engine", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser_gui;
+
+        beginTest ("Linear ramps match SmoothedValue");
+        {
+            std::atomic<float> target { 1.0f };
+
+            ParameterSmoothingEngine engine;
+            auto index = engine.addParameter (target, 0.01);
+            engine.prepare (44100.0, 100);
+
+            SmoothedValue<float> reference (1.0f);
+            reference.reset (44100.0, 0.01);
+
+            target = 3.0f;
+            reference.setTargetValue (3.0f);
+
+            for (int block = 0; block < 6; ++block)
+            {
+                engine.process (100);
+                expect (engine.isSmoothing (index) == (block < 5));
+
+                auto* ramp = engine.getRampBuffer (index);
+
+                for (int i = 0; i < 100; ++i)
+                    expectWithinAbsoluteError (ramp[i], reference.getNextValue(), 1.0e-4f);
+            }
+
+            expectEquals (engine.getCurrentValue (index), 3.0f);
+            expectEquals (engine.getRampBuffer (index)[99], 3.0f);
+
+            engine.process (100);
+            expect (! engine.isSmoothing (index));
+            expectEquals (engine.getNumActiveRamps(), 0);
+        }
+
+        beginTest ("Multiplicative ramps match SmoothedValue");
+        {
+            std::atomic<float> target { 100.0f };
+
+            ParameterSmoothingEngine engine;
+            auto index = engine.addParameter (target, 0.005, SmoothingType::multiplicative);
+            engine.prepare (48000.0, 64);
+
+            SmoothedValue<float, ValueSmoothingTypes::Multiplicative> reference (100.0f);
+            reference.reset (48000.0, 0.005);
+
+            target = 10000.0f;
+            reference.setTargetValue (10000.0f);
+
+            for (int block = 0; block < 5; ++block)
+            {
+                engine.process (64);
+                expect (engine.isSmoothing (index) == (block < 4));
+
+                auto* ramp = engine.getRampBuffer (index);
+
+                for (int i = 0; i < 64; ++i)
+                {
+                    auto expected = reference.getNextValue();
+                    expectWithinAbsoluteError (ramp[i], expected, expected * 1.0e-4f);
+                }
+            }
+
+            expectEquals (engine.getCurrentValue (index), 10000.0f);
+        }
+
+        beginTest ("Changing the target during a ramp continues from the current value");
+        {
+            std::atomic<float> target { 0.0f };
+
+            ParameterSmoothingEngine engine;
+            auto index = engine.addParameter (target, 1.0);
+            engine.prepare (1000.0, 250);
+
+            target = 1.0f;
+            engine.process (250);
+            expectWithinAbsoluteError (engine.getCurrentValue (index), 0.25f, 1.0e-5f);
+
+            target = -1.0f;
+            engine.process (250);
+
+            auto* ramp = engine.getRampBuffer (index);
+            expectWithinAbsoluteError (ramp[0], 0.25f - 1.25f / 1000.0f, 1.0e-5f);
+            expectWithinAbsoluteError (engine.getCurrentValue (index), 0.25f - 1.25f / 4.0f, 1.0e-5f);
+            expectEquals (engine.getTargetValue (index), -1.0f);
+        }
+
+        beginTest ("Short blocks and jumps");
+        {
+            std::atomic<float> smoothed { 0.0f }, jumping { 0.0f };
+
+            ParameterSmoothingEngine engine;
+            auto smoothedIndex = engine.addParameter (smoothed, 0.001);
+            auto jumpingIndex  = engine.addParameter (jumping, 0.0);
+            engine.prepare (10000.0, 32);
+
+            smoothed = 1.0f;
+            jumping = 1.0f;
+
+            engine.process (7);
+            expect (engine.isSmoothing (jumpingIndex));
+            expect (engine.isSmoothing (smoothedIndex));
+            expectEquals (engine.getRampBuffer (jumpingIndex)[0], 1.0f);
+            expectWithinAbsoluteError (engine.getRampBuffer (smoothedIndex)[6], 0.7f, 1.0e-5f);
+            expectEquals (engine.getNumActiveRamps(), 2);
+
+            engine.process (7);
+            expect (! engine.isSmoothing (jumpingIndex));
+            expectEquals (engine.getNumActiveRamps(), 1);
+
+            auto* ramp = engine.getRampBuffer (smoothedIndex);
+            expectWithinAbsoluteError (ramp[2], 1.0f, 1.0e-5f);
+
+            for (int i = 3; i < 32; ++i)
+                expectEquals (ramp[i], 1.0f);
+        }
+
+        beginTest ("Parameters that don't change are skipped");
+        {
+            std::vector<std::unique_ptr<std::atomic<float>>> targets;
+            ParameterSmoothingEngine engine;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                targets.push_back (std::make_unique<std::atomic<float>> ((float) i));
+                engine.addParameter (*targets.back(), 0.05);
+            }
+
+            engine.prepare (44100.0, 512);
+            engine.process (512);
+            expectEquals (engine.getNumActiveRamps(), 0);
+
+            *targets[17] = 0.5f;
+            *targets[150] = 0.5f;
+
+            engine.process (512);
+            expectEquals (engine.getNumActiveRamps(), 2);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                expect (engine.isSmoothing (i) == (i == 17 || i == 150));
+
+                if (! engine.isSmoothing (i))
+                    expectEquals (engine.getRampBuffer (i)[511], (float) i);
+            }
+
+            engine.reset();
+            expectEquals (engine.getRampBuffer (17)[0], 0.5f);
+            engine.process (512);
+            expectEquals (engine.getNumActiveRamps(), 0);
+        }
+
+        beginTest ("All the parameters of an AudioProcessorValueTreeState can be smoothed");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("gain", "Gain", NormalisableRange<float> (0.0f, 2.0f), 1.0f),
+                                       std::make_unique<AudioParameterBool> ("bypass", "Bypass", false) });
+
+            ParameterSmoothingEngine engine (proc.state, 0.01);
+            expectEquals (engine.getNumParameters(), 2);
+
+            auto gainIndex = engine.getParameterIndex ("gain");
+            auto bypassIndex = engine.getParameterIndex ("bypass");
+            expect (gainIndex >= 0 && bypassIndex >= 0);
+            expectEquals (engine.getParameterIndex ("nonexistent"), -1);
+
+            engine.prepare (1000.0, 20);
+            expectEquals (engine.getRampBuffer (gainIndex)[0], 1.0f);
+
+            auto* gain = proc.state.getParameter ("gain");
+            gain->setValueNotifyingHost (gain->convertTo0to1 (2.0f));
+            proc.state.getParameter ("bypass")->setValueNotifyingHost (1.0f);
+
+            engine.process (5);
+            expectWithinAbsoluteError (engine.getRampBuffer (gainIndex)[4], 1.5f, 1.0e-5f);
+            expectEquals (engine.getRampBuffer (bypassIndex)[0], 1.0f);
+
+            engine.process (20);
+            expectEquals (engine.getCurrentValue (gainIndex), 2.0f);
+        }
+    }
+
+private:
+    using SmoothingType = ParameterSmoothingEngine::SmoothingType;
+
+    struct TestAudioProcessor  : public AudioProcessor
+    {
+        explicit TestAudioProcessor (AudioProcessorValueTreeState::ParameterLayout layout)
+            : state (*this, nullptr, "state", std::move (layout)) {}
+
+        const String getName() const override { return {}; }
+        void prepareToPlay (double, int) override {}
+        void releaseResources() override {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override { return {}; }
+        bool acceptsMidi() const override { return {}; }
+        bool producesMidi() const override { return {}; }
+        AudioProcessorEditor* createEditor() override { return {}; }
+        bool hasEditor() const override { return {}; }
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return {}; }
+        void setCurrentProgram (int) override {}
+        const String getProgramName (int) override { return {}; }
+        void changeProgramName (int, const String&) override {}
+        void getStateInformation (MemoryBlock&) override {}
+        void setStateInformation (const void*, int) override {}
+
+        AudioProcessorValueTreeState state;
+    };
+};
+
+static ParameterSmoothingEngineTests parameterSmoothingEngineTests;
+
+#endif
+
+} // namespace juce
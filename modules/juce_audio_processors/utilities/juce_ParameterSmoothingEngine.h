@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Turns the raw values of a set of parameters into per-sample ramps, once per
+    block.
+
+    Rather than keeping a SmoothedValue for every parameter and stepping each of
+    them on every sample, a processor can create one of these engines, call
+    process() at the start of each block, and then read a dense buffer of
+    smoothed values for any parameter it needs with getRampBuffer().
+
+    Each parameter's target is read from an atomic - usually one returned by
+    AudioProcessorValueTreeState::getRawParameterValue() - so host automation
+    and UI changes are both picked up. Only the parameters that are currently
+    moving have their buffers rewritten: the buffer of a parameter that has
+    settled is filled with its final value once, after which it costs a single
+    atomic load and comparison per block.
+
+    @code
+    MyProcessor()
+        : parameters (*this, nullptr, "PARAMETERS", createParameterLayout()),
+          smoother (parameters, 0.02)
+    {
+        gainIndex = smoother.getParameterIndex ("gain");
+    }
+
+    void prepareToPlay (double sampleRate, int maximumBlockSize) override
+    {
+        smoother.prepare (sampleRate, maximumBlockSize);
+    }
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        smoother.process (buffer.getNumSamples());
+
+        auto* gain = smoother.getRampBuffer (gainIndex);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            FloatVectorOperations::multiply (buffer.getWritePointer (ch), gain, buffer.getNumSamples());
+    }
+    @endcode
+
+    Apart from process(), reset() and the getters, none of the methods are
+    real-time safe, so the set of parameters should be built before prepare()
+    is called.
+
+    @see AudioProcessorValueTreeState, SmoothedValue
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterSmoothingEngine
+{
+public:
+    //==============================================================================
+    /** The shape of the ramp used when a parameter's target changes. */
+    enum class SmoothingType
+    {
+        linear,         /**< Moves towards the target in equal steps, like SmoothedValue<float, ValueSmoothingTypes::Linear>. */
+        multiplicative  /**< Moves towards the target in equal ratios, like SmoothedValue<float, ValueSmoothingTypes::Multiplicative>. */
+    };
+
+    //==============================================================================
+    /** Creates an empty engine. Use addParameter() to give it something to do. */
+    ParameterSmoothingEngine();
+
+    /** Creates an engine that smooths every parameter managed by an
+        AudioProcessorValueTreeState.
+
+        Continuous parameters get a linear ramp of the given length, and discrete
+        ones (see AudioProcessorParameter::isDiscrete()) jump straight to their
+        new value. The state must outlive the engine.
+    */
+    ParameterSmoothingEngine (AudioProcessorValueTreeState& state, double rampLengthInSeconds);
+
+    /** Destructor. */
+    ~ParameterSmoothingEngine();
+
+    //==============================================================================
+    /** Adds a parameter whose target value is read from the given atomic, and
+        returns the index to use when asking for its ramp.
+
+        A ramp length of zero makes the parameter jump to each new value without
+        any smoothing. The atomic must outlive the engine.
+    */
+    int addParameter (std::atomic<float>& targetValueSource,
+                      double rampLengthInSeconds,
+                      SmoothingType type = SmoothingType::linear,
+                      const String& parameterID = {});
+
+    /** Adds one of the parameters of an AudioProcessorValueTreeState, returning
+        its index, or -1 if the state doesn't have a parameter with this ID.
+    */
+    int addParameter (AudioProcessorValueTreeState& state,
+                      StringRef parameterID,
+                      double rampLengthInSeconds,
+                      SmoothingType type = SmoothingType::linear);
+
+    /** Returns the number of parameters that have been added. */
+    int getNumParameters() const noexcept                       { return (int) ramps.size(); }
+
+    /** Returns the index of the parameter with the given ID, or -1 if there isn't
+        one. This does a linear search, so look the indices up once rather than in
+        your audio callback.
+    */
+    int getParameterIndex (StringRef parameterID) const;
+
+    //==============================================================================
+    /** Allocates the ramp buffers and snaps every parameter to its current value.
+
+        This must be called before process(), and again whenever the sample rate or
+        maximum block size change or more parameters are added.
+    */
+    void prepare (double sampleRate, int maximumBlockSize);
+
+    /** Stops any ramps in progress and snaps every parameter to its current value. */
+    void reset() noexcept;
+
+    /** Picks up any new target values and writes the next numSamples values of
+        each moving parameter into its ramp buffer.
+
+        This is real-time safe, and should be called once at the start of each
+        block, before any of the ramp buffers are read. numSamples must not be
+        greater than the maximum block size passed to prepare().
+    */
+    void process (int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the smoothed values that a parameter takes during the block that
+        was passed to the last call to process().
+
+        The buffer holds at least as many samples as the block, and stays valid
+        until the next call to process() or prepare().
+    */
+    const float* getRampBuffer (int parameterIndex) const noexcept;
+
+    /** Returns the value a parameter reached at the end of the last block. */
+    float getCurrentValue (int parameterIndex) const noexcept;
+
+    /** Returns the value a parameter is moving towards. */
+    float getTargetValue (int parameterIndex) const noexcept;
+
+    /** Returns true if the parameter's value changed at any point during the last
+        block, so its ramp buffer isn't just a constant.
+    */
+    bool isSmoothing (int parameterIndex) const noexcept;
+
+    /** Returns the number of parameters whose ramp buffers were rewritten by the
+        last call to process().
+    */
+    int getNumActiveRamps() const noexcept                      { return numActiveInLastBlock; }
+
+private:
+    //==============================================================================
+    struct Ramp
+    {
+        std::atomic<float>* source = nullptr;
+        String parameterID;
+        double rampLengthInSeconds = 0;
+        SmoothingType type = SmoothingType::linear;
+
+        float currentValue = 0, targetValue = 0, step = 0;
+        int stepsToTarget = 0, countdown = 0;
+        bool isActive = false, isSettling = false, changedInLastBlock = false;
+    };
+
+    void startRamp (Ramp&, float newTarget) noexcept;
+    void fillRamp (Ramp&, float* dest, int numSamples) noexcept;
+    void fillConstant (const Ramp&, int index) noexcept;
+
+    std::vector<Ramp> ramps;
+    std::vector<int> activeRamps;
+    AudioBuffer<float> rampBuffers, sampleIndices;
+    double currentSampleRate = 0;
+    int maxBlockSize = 0, numActiveInLastBlock = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterSmoothingEngine)
+};
+
+} // namespace juce
@@ -100,6 +100,9 @@ public:
     ~LevelDataSource() override
     {
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+
+        for (auto* job : readerJobs)
+            owner.cache.getThreadPool()->removeJob (job, true, -1);
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -120,7 +123,7 @@ public:
 
             if (lengthInSamples <= 0 || isFullyLoaded())
                 reader.reset();
-            else
+            else if (! startReaderJobs())
                 owner.cache.getTimeSliceThread().addTimeSliceClient (this);
         }
     }
@@ -159,7 +162,7 @@ public:
 
     int useTimeSlice() override
     {
-        if (isFullyLoaded())
+        if (isFullyLoaded() || readerJobs.size() > 0)
         {
             if (reader != nullptr && source != nullptr)
             {
@@ -203,7 +206,8 @@ public:
         return (int) (originalSample / owner.samplesPerThumbSample);
     }
 
-    int64 lengthInSamples = 0, numSamplesFinished = 0;
+    int64 lengthInSamples = 0;
+    std::atomic<int64> numSamplesFinished { 0 };
     double sampleRate = 0;
     unsigned int numChannels = 0;
     int64 hashCode = 0;
@@ -214,12 +218,148 @@ private:
     std::unique_ptr<AudioFormatReader> reader;
     CriticalSection readerLock;
     std::atomic<uint32> lastReaderUseTime { 0 };
+    AudioBuffer<float> readBuffer;
+
+    struct ReaderJob  : public ThreadPoolJob
+    {
+        ReaderJob (LevelDataSource& s)  : ThreadPoolJob ("Thumbnail reader"), owner (s) {}
+
+        JobStatus runJob() override
+        {
+            owner.readChunks (*this);
+            return jobHasFinished;
+        }
+
+        LevelDataSource& owner;
+    };
+
+    OwnedArray<ReaderJob> readerJobs;
+    int firstChunkThumbIndex = 0, lastChunkThumbIndex = 0, thumbSamplesPerChunk = 0, numChunks = 0;
+    std::atomic<int> nextChunk { 0 };
+    CriticalSection chunkLock;
+    BigInteger finishedChunks;
+    int numChunksFinished = 0;
+
+    AudioFormatReader* createReaderForSource() const
+    {
+        if (auto* audioFileStream = source->createInputStream())
+            return owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream));
+
+        return nullptr;
+    }
 
     void createReader()
     {
         if (reader == nullptr && source != nullptr)
-            if (auto* audioFileStream = source->createInputStream())
-                reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+            reader.reset (createReaderForSource());
+    }
+
+    // Reads a section of the source into the buffer, and fills in the levels for each channel
+    void readLevels (AudioFormatReader& r, int firstThumbIndex, int numThumbSamps, AudioBuffer<float>& buffer,
+                     HeapBlock<MinMaxValue>& levelData, HeapBlock<MinMaxValue*>& levels) const
+    {
+        auto startSample = firstThumbIndex * (int64) owner.samplesPerThumbSample;
+        auto numSamples = (int) jmin (numThumbSamps * (int64) owner.samplesPerThumbSample, lengthInSamples - startSample);
+
+        buffer.setSize ((int) numChannels, numSamples, false, false, true);
+        r.read (&buffer, 0, numSamples, startSample, true, true);
+
+        levelData.malloc ((size_t) numThumbSamps * numChannels);
+        levels.malloc (numChannels);
+
+        for (int i = 0; i < (int) numChannels; ++i)
+        {
+            levels[i] = levelData + i * numThumbSamps;
+
+            for (int j = 0; j < numThumbSamps; ++j)
+            {
+                auto start = j * owner.samplesPerThumbSample;
+
+                levels[i][j].setFloat (FloatVectorOperations::findMinAndMax (buffer.getReadPointer (i, start),
+                                                                             jmin (owner.samplesPerThumbSample, numSamples - start)));
+            }
+        }
+    }
+
+    //==============================================================================
+    // When the cache has a thread pool, the source is split into chunks, and each of the
+    // pool's threads opens its own reader and takes the next unread chunk until they're done.
+    bool startReaderJobs()
+    {
+        auto* pool = owner.cache.getThreadPool();
+
+        if (pool == nullptr || source == nullptr)
+            return false;
+
+        firstChunkThumbIndex = sampleToThumbSample (numSamplesFinished);
+        lastChunkThumbIndex  = sampleToThumbSample (lengthInSamples);
+        thumbSamplesPerChunk = jmax (1, 65536 / owner.samplesPerThumbSample);
+        numChunks = (lastChunkThumbIndex - firstChunkThumbIndex + thumbSamplesPerChunk - 1) / thumbSamplesPerChunk;
+
+        // (not worth the trouble for short files)
+        if (numChunks < 2)
+            return false;
+
+        reader.reset();
+
+        for (int i = jmin (pool->getNumThreads(), numChunks); --i >= 0;)
+            pool->addJob (readerJobs.add (new ReaderJob (*this)), false);
+
+        return true;
+    }
+
+    void readChunks (ThreadPoolJob& job)
+    {
+        std::unique_ptr<AudioFormatReader> r (createReaderForSource());
+
+        if (r == nullptr)
+            return;
+
+        AudioBuffer<float> buffer;
+        HeapBlock<MinMaxValue> levelData;
+        HeapBlock<MinMaxValue*> levels;
+
+        while (! job.shouldExit())
+        {
+            auto chunk = nextChunk++;
+
+            if (chunk >= numChunks)
+                break;
+
+            auto firstThumbIndex = firstChunkThumbIndex + chunk * thumbSamplesPerChunk;
+            auto numThumbSamps = jmin (thumbSamplesPerChunk, lastChunkThumbIndex - firstThumbIndex);
+
+            readLevels (*r, firstThumbIndex, numThumbSamps, buffer, levelData, levels);
+            owner.setLevels (levels, firstThumbIndex, (int) numChannels, numThumbSamps);
+
+            if (chunkFinished (chunk))
+                owner.cache.storeThumb (owner, hashCode);
+        }
+    }
+
+    // Returns true if this was the last chunk to be read
+    bool chunkFinished (int chunk)
+    {
+        const ScopedLock sl (chunkLock);
+
+        finishedChunks.setBit (chunk);
+
+        if (chunk != numChunksFinished)
+            return false;
+
+        while (finishedChunks[numChunksFinished])
+            ++numChunksFinished;
+
+        auto thumbSamplesFinished = jmin (lastChunkThumbIndex, firstChunkThumbIndex + numChunksFinished * thumbSamplesPerChunk);
+        owner.setNumSamplesFinished (thumbSamplesFinished * (int64) owner.samplesPerThumbSample);
+
+        // Like readNextBlock(), this leaves out any part of a thumbnail sample at the end of the source
+        if (numChunksFinished == numChunks)
+            numSamplesFinished = lengthInSamples;
+        else
+            numSamplesFinished = thumbSamplesFinished * (int64) owner.samplesPerThumbSample;
+
+        return isFullyLoaded();
     }
 
     bool readNextBlock()
@@ -232,28 +372,16 @@ private:
 
             if (numToDo > 0)
             {
-                auto startSample = numSamplesFinished;
+                auto startSample = numSamplesFinished.load();
 
                 auto firstThumbIndex = sampleToThumbSample (startSample);
                 auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
-                auto numThumbSamps = lastThumbIndex - firstThumbIndex;
-
-                HeapBlock<MinMaxValue> levelData ((unsigned int) numThumbSamps * numChannels);
-                HeapBlock<MinMaxValue*> levels (numChannels);
 
-                for (int i = 0; i < (int) numChannels; ++i)
-                    levels[i] = levelData + i * numThumbSamps;
-
-                HeapBlock<Range<float>> levelsRead (numChannels);
-
-                for (int i = 0; i < numThumbSamps; ++i)
-                {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+                auto numThumbSamps = lastThumbIndex - firstThumbIndex;
 
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
-                }
+                HeapBlock<MinMaxValue> levelData;
+                HeapBlock<MinMaxValue*> levels;
+                readLevels (*reader, firstThumbIndex, numThumbSamps, readBuffer, levelData, levels);
 
                 {
                     const ScopedUnlock su (readerLock);
@@ -275,37 +403,46 @@ class AudioThumbnail::ThumbData
 public:
     ThumbData (int numThumbSamples)
     {
+        levels.add ({});
         ensureSize (numThumbSamples);
     }
 
     inline MinMaxValue* getData (int thumbSampleIndex) noexcept
     {
-        jassert (thumbSampleIndex < data.size());
-        return data.getRawDataPointer() + thumbSampleIndex;
+        jassert (thumbSampleIndex < getSize());
+        return levels.getReference (0).getRawDataPointer() + thumbSampleIndex;
     }
 
     int getSize() const noexcept
     {
-        return data.size();
+        return levels.getReference (0).size();
     }
 
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
         if (startSample >= 0)
         {
-            endSample = jmin (endSample, data.size() - 1);
-
             int8 mx = -128;
             int8 mn = 127;
 
-            while (startSample <= endSample)
+            auto start = startSample;
+            auto end = jmin (endSample, getSize() - 1) + 1;
+
+            // This takes values from each end of the range until both ends line up with
+            // the blocks in the next level, then moves up and carries on from there.
+            for (int level = 0; start < end; ++level)
             {
-                auto& v = data.getReference (startSample);
+                auto& values = levels.getReference (level);
+                auto isTopLevel = (level == levels.size() - 1);
+
+                while (start < end && (isTopLevel || start % levelScale != 0))
+                    addToRange (values.getReference (start++), mn, mx);
 
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+                while (start < end && end % levelScale != 0)
+                    addToRange (values.getReference (--end), mn, mx);
 
-                ++startSample;
+                start /= levelScale;
+                end /= levelScale;
             }
 
             if (mn <= mx)
@@ -320,48 +457,96 @@ public:
 
     void write (const MinMaxValue* values, int startIndex, int numValues)
     {
-        resetPeak();
-
-        if (startIndex + numValues > data.size())
+        if (startIndex + numValues > getSize())
             ensureSize (startIndex + numValues);
 
         auto* dest = getData (startIndex);
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
-    }
 
-    void resetPeak() noexcept
-    {
-        peakLevel = -1;
+        updateLevels (startIndex, numValues);
     }
 
-    int getPeak() noexcept
+    // Call this after changing the values returned by getData()
+    void updateLevels (int startIndex, int numValues) noexcept
     {
-        if (peakLevel < 0)
+        for (int level = 1; level < levels.size() && numValues > 0; ++level)
         {
-            for (auto& s : data)
+            auto& source = levels.getReference (level - 1);
+            auto& dest = levels.getReference (level);
+
+            auto first = startIndex / levelScale;
+            auto last = jmin (dest.size(), (startIndex + numValues + levelScale - 1) / levelScale);
+
+            for (int i = first; i < last; ++i)
             {
-                auto peak = s.getPeak();
+                int8 mx = -128;
+                int8 mn = 127;
+
+                for (int j = i * levelScale; j < jmin ((i + 1) * levelScale, source.size()); ++j)
+                    addToRange (source.getReference (j), mn, mx);
 
-                if (peak > peakLevel)
-                    peakLevel = peak;
+                dest.getReference (i).set (mn, mx);
             }
+
+            startIndex = first;
+            numValues = last - first;
         }
+    }
+
+    int getPeak() const noexcept
+    {
+        int peakLevel = 0;
+
+        for (auto& s : levels.getReference (levels.size() - 1))
+            peakLevel = jmax (peakLevel, s.getPeak());
 
         return peakLevel;
     }
 
 private:
-    Array<MinMaxValue> data;
-    int peakLevel = -1;
+    // levels[0] holds the thumbnail data, and each entry in the levels above it
+    // holds the range of a block of levelScale entries in the level below.
+    Array<Array<MinMaxValue>> levels;
+
+    enum { levelScale = 4 };
+
+    static void addToRange (const MinMaxValue& v, int8& mn, int8& mx) noexcept
+    {
+        if (v.getMinValue() < mn)  mn = v.getMinValue();
+        if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+    }
 
     void ensureSize (int thumbSamples)
     {
-        auto extraNeeded = thumbSamples - data.size();
+        auto oldSize = getSize();
+
+        if (thumbSamples <= oldSize)
+            return;
+
+        auto numLevels = levels.size();
+
+        for (int level = 0, size = thumbSamples;; ++level)
+        {
+            if (level == levels.size())
+                levels.add ({});
+
+            auto& values = levels.getReference (level);
+
+            if (size > values.size())
+                values.insertMultiple (-1, MinMaxValue(), size - values.size());
+
+            if (size <= levelScale)
+                break;
+
+            size = (size + levelScale - 1) / levelScale;
+        }
 
-        if (extraNeeded > 0)
-            data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+        if (levels.size() == numLevels)
+            updateLevels (oldSize, thumbSamples - oldSize);
+        else
+            updateLevels (0, thumbSamples);
     }
 };
 
@@ -614,6 +799,10 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked(chan)->getData(i)->read (input);
 
+    // (the summary levels aren't stored, as they're quick to recalculate)
+    for (auto* c : channels)
+        c->updateLevels (0, numThumbnailSamples);
+
     return true;
 }
 
@@ -727,6 +916,15 @@ void AudioThumbnail::addBlock (int64 startSample, const AudioBuffer<float>& inco
     }
 }
 
+void AudioThumbnail::setNumSamplesFinished (int64 numSamplesDone)
+{
+    const ScopedLock sl (lock);
+
+    numSamplesFinished = jmax (numSamplesFinished, numSamplesDone);
+    totalSamples = jmax (numSamplesFinished, totalSamples.load());
+    sendChangeMessage();
+}
+
 void AudioThumbnail::setLevels (const MinMaxValue* const* values, int thumbIndex, int numChans, int numValues)
 {
     const ScopedLock sl (lock);
@@ -823,4 +1021,169 @@ void AudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area, doub
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioThumbnailTests  : public UnitTest
+{
+public:
+    AudioThumbnailTests()
+        : UnitTest ("AudioThumbnail", UnitTestCategories::audio)
+    {}
+
+    struct MemorySource  : public InputSource
+    {
+        MemorySource (const MemoryBlock& d)  : data (d) {}
+
+        InputStream* createInputStream() override                   { return new MemoryInputStream (data, false); }
+        InputStream* createInputStreamFor (const String&) override  { return nullptr; }
+        int64 hashCode() const override                             { return (int64) data.getSize(); }
+
+        const MemoryBlock& data;
+    };
+
+    static AudioBuffer<float> createTestSignal (Random& r, int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto level = 0.0f;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (i % 1000 == 0)
+                    level = r.nextFloat();
+
+                buffer.setSample (chan, i, level * (r.nextFloat() * 2.0f - 1.0f));
+            }
+        }
+
+        return buffer;
+    }
+
+    static MemoryBlock createWavFile (const AudioBuffer<float>& buffer)
+    {
+        MemoryBlock data;
+        WavAudioFormat format;
+
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (data, false), 44100.0,
+                                                                           (unsigned int) buffer.getNumChannels(), 16, {}, 0));
+        writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+        writer.reset();
+
+        return data;
+    }
+
+    static MemoryBlock getSavedData (const AudioThumbnail& thumb)
+    {
+        MemoryOutputStream out;
+        thumb.saveTo (out);
+        return out.getMemoryBlock();
+    }
+
+    bool waitUntilLoaded (const AudioThumbnail& thumb)
+    {
+        for (int i = 0; i < 10000 && ! thumb.isFullyLoaded(); ++i)
+            Thread::sleep (1);
+
+        return thumb.isFullyLoaded();
+    }
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser;
+
+        auto r = getRandom();
+
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        beginTest ("Ranges of thumbnail samples are the same as their individual values");
+        {
+            const int samplesPerThumbSample = 64;
+
+            AudioThumbnailCache cache (1);
+            AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+            auto signal = createTestSignal (r, 2, 500000);
+            thumb.reset (2, (double) samplesPerThumbSample, signal.getNumSamples());
+            thumb.addBlock (0, signal, 0, signal.getNumSamples());
+
+            // With this sample rate, each second of the thumbnail is one thumbnail sample
+            auto numThumbSamples = (int) thumb.getTotalLength();
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto chan = r.nextInt (2);
+                auto start = r.nextInt (numThumbSamples);
+                auto end = start + r.nextInt (i < 100 ? 20 : numThumbSamples - start);
+
+                auto expectedMin = 1.0f, expectedMax = -1.0f;
+
+                for (int j = start; j <= end; ++j)
+                {
+                    float mn, mx;
+                    thumb.getApproximateMinMax (j, j, chan, mn, mx);
+
+                    expectedMin = jmin (expectedMin, mn);
+                    expectedMax = jmax (expectedMax, mx);
+                }
+
+                float actualMin, actualMax;
+                thumb.getApproximateMinMax (start, end, chan, actualMin, actualMax);
+
+                expectEquals (actualMin, expectedMin);
+                expectEquals (actualMax, expectedMax);
+            }
+        }
+
+        auto data = createWavFile (createTestSignal (r, 2, 1000000));
+
+        AudioThumbnailCache serialCache (1);
+        AudioThumbnail serialThumb (512, formatManager, serialCache);
+
+        beginTest ("Reading a source in parallel gives the same thumbnail as reading it on one thread");
+        {
+            AudioThumbnailCache parallelCache (1, 3);
+            AudioThumbnail parallelThumb (512, formatManager, parallelCache);
+
+            expect (serialThumb.setSource (new MemorySource (data)));
+            expect (parallelThumb.setSource (new MemorySource (data)));
+
+            expect (waitUntilLoaded (serialThumb));
+            expect (waitUntilLoaded (parallelThumb));
+
+            expect (getSavedData (serialThumb) == getSavedData (parallelThumb));
+        }
+
+        beginTest ("Reloaded thumbnails give the same ranges");
+        {
+            AudioThumbnail loadedThumb (512, formatManager, serialCache);
+
+            auto savedData = getSavedData (serialThumb);
+            MemoryInputStream in (savedData, false);
+            expect (loadedThumb.loadFrom (in));
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto start = r.nextDouble() * serialThumb.getTotalLength();
+                auto end = start + r.nextDouble() * (serialThumb.getTotalLength() - start);
+
+                float expectedMin, expectedMax, actualMin, actualMax;
+                serialThumb.getApproximateMinMax (start, end, 1, expectedMin, expectedMax);
+                loadedThumb.getApproximateMinMax (start, end, 1, actualMin, actualMax);
+
+                expectEquals (actualMin, expectedMin);
+                expectEquals (actualMax, expectedMax);
+            }
+        }
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+#endif
+
 } // namespace juce
@@ -40,8 +40,13 @@ namespace juce
     AudioThumbnail is a ChangeBroadcaster, and will broadcast a message when its
     listeners should repaint themselves.
 
+    If the AudioThumbnailCache was created with some reader threads and you use
+    setSource(), the file will be scanned in several sections at once.
+
     The thumbnail stores an internal low-res version of the wave data, and this can
-    be loaded and saved to avoid having to scan the file again.
+    be loaded and saved to avoid having to scan the file again. It also keeps a set of
+    progressively coarser summaries of this data, so that drawing a zoomed-out view
+    of a long file doesn't need to look at every low-res sample.
 
     @see AudioThumbnailCache, AudioThumbnailBase
 
@@ -214,6 +219,7 @@ private:
     void clearChannelData();
     bool setDataSource (LevelDataSource* newSource);
     void setLevels (const MinMaxValue* const* values, int thumbIndex, int numChans, int numValues);
+    void setNumSamplesFinished (int64 numSamplesDone);
     void createChannels (int length);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnail)
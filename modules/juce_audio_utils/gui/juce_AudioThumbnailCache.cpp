@@ -60,11 +60,21 @@ private:
 
 //==============================================================================
 AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
+    : AudioThumbnailCache (maxNumThumbs, 0)
+{
+}
+
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numReaderThreads)
     : thread ("thumb cache"),
       maxNumThumbsToStore (maxNumThumbs)
 {
     jassert (maxNumThumbsToStore > 0);
+    jassert (numReaderThreads >= 0);
+
     thread.startThread (2);
+
+    if (numReaderThreads > 0)
+        pool.reset (new ThreadPool (numReaderThreads));
 }
 
 AudioThumbnailCache::~AudioThumbnailCache()
@@ -49,6 +49,19 @@ public:
     */
     explicit AudioThumbnailCache (int maxNumThumbsToStore);
 
+    /** Creates a cache object which can read thumbnails' sources in parallel.
+
+        As well as the usual background thread, this creates a pool of threads that
+        an AudioThumbnail will use to read different sections of its source at the
+        same time, when it's been given an InputSource with AudioThumbnail::setSource().
+        Each of these threads opens its own stream from the InputSource, so the source
+        must be able to create more than one stream at once.
+
+        Passing 0 for numReaderThreads gives you the same behaviour as the other
+        constructor.
+    */
+    AudioThumbnailCache (int maxNumThumbsToStore, int numReaderThreads);
+
     /** Destructor. */
     virtual ~AudioThumbnailCache();
 
@@ -89,6 +102,11 @@ public:
     /** Returns the thread that client thumbnails can use. */
     TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
 
+    /** Returns the pool that client thumbnails can use to read their sources in parallel.
+        This will be nullptr unless the cache was created with some reader threads.
+    */
+    ThreadPool* getThreadPool() noexcept                { return pool.get(); }
+
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
@@ -103,6 +121,7 @@ protected:
 private:
     //==============================================================================
     TimeSliceThread thread;
+    std::unique_ptr<ThreadPool> pool;
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
@@ -1214,6 +1214,62 @@ public:
         expect (tempFile.exists());
         expect (! tempFile2.exists());
 
+        beginTest ("Direct writes");
+        {
+            auto directFile = demoFolder.getNonexistentChildFile ("direct", ".bin", false);
+            auto r = getRandom();
+            MemoryBlock expected;
+
+            {
+                FileOutputStream fo (directFile, 65536);
+                expect (fo.openedOk());
+
+                // the result depends on the platform and file system, but either way the file's length mustn't change
+                fo.preallocate (1 << 20);
+                expect (directFile.getSize() == 0);
+
+                fo.setDirectWritesEnabled (true);
+                fo.write ("header..", 8);
+                expected.append ("header..", 8);
+
+                HeapBlock<char> chunk (70000);
+
+                for (int i = 0; i < 40; ++i)
+                {
+                    auto size = (size_t) r.nextInt (70000);
+
+                    for (size_t j = 0; j < size; ++j)
+                        chunk[j] = (char) r.nextInt (256);
+
+                    expect (fo.write (chunk, size));
+                    expected.append (chunk, size);
+                    expect (fo.getPosition() == (int64) expected.getSize());
+                }
+
+                expect (fo.writeRepeatedByte (7, 5000));
+
+                for (int i = 0; i < 5000; ++i)
+                    expected.append ("\x07", 1);
+
+                expect (fo.setPosition (0));
+                fo.write ("HEADER", 6);
+                expected.copyFrom ("HEADER", 0, 6);
+
+                expect (fo.setPosition ((int64) expected.getSize()));
+                fo.write ("end", 3);
+                expected.append ("end", 3);
+
+                expect (fo.setDirectWritesEnabled (false));
+                fo.write ("!", 1);
+                expected.append ("!", 1);
+            }
+
+            MemoryBlock written;
+            expect (directFile.loadFileAsData (written));
+            expect (written == expected);
+            expect (directFile.deleteFile());
+        }
+
         expect (demoFolder.deleteRecursively());
         expect (! demoFolder.exists());
 
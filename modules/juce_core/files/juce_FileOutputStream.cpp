@@ -56,6 +56,9 @@ bool FileOutputStream::setPosition (int64 newPosition)
 
 bool FileOutputStream::flushBuffer()
 {
+    if (directWrites)
+        return flushDirectBuffer (true);
+
     bool ok = true;
 
     if (bytesInBuffer > 0)
@@ -80,6 +83,9 @@ bool FileOutputStream::write (const void* const src, const size_t numBytes)
     if (! openedOk())
         return false;
 
+    if (directWrites)
+        return writeDirect (static_cast<const char*> (src), numBytes);
+
     if (bytesInBuffer + numBytes < bufferSize)
     {
         memcpy (buffer + bytesInBuffer, src, numBytes);
@@ -116,7 +122,7 @@ bool FileOutputStream::writeRepeatedByte (uint8 byte, size_t numBytes)
 {
     jassert (((ssize_t) numBytes) >= 0);
 
-    if (bytesInBuffer + numBytes < bufferSize)
+    if (! directWrites && bytesInBuffer + numBytes < bufferSize)
     {
         memset (buffer + bytesInBuffer, byte, numBytes);
         bytesInBuffer += numBytes;
@@ -127,4 +133,130 @@ bool FileOutputStream::writeRepeatedByte (uint8 byte, size_t numBytes)
     return OutputStream::writeRepeatedByte (byte, numBytes);
 }
 
+//==============================================================================
+static constexpr size_t directWriteBlockSize = 4096;
+
+bool FileOutputStream::setDirectWritesEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == directWrites)
+        return true;
+
+    if (! openedOk() || ! flushBuffer())
+        return false;
+
+    if (shouldBeEnabled)
+    {
+        // check that the file system will let us use direct writes before committing to them
+        if (! setDirectFlag (true))
+            return false;
+
+        directFlagSet = true;
+        directBufferSize = jmax (directWriteBlockSize, bufferSize - bufferSize % directWriteBlockSize);
+        buffer.malloc (directBufferSize + directWriteBlockSize);
+        directBuffer = snapPointerToAlignment (buffer.get(), directWriteBlockSize);
+    }
+    else
+    {
+        if (directFlagSet)
+            directFlagSet = ! setDirectFlag (false);
+
+        buffer.malloc (jmax (bufferSize, (size_t) 16));
+        directBuffer = nullptr;
+    }
+
+    directWrites = shouldBeEnabled;
+    return true;
+}
+
+bool FileOutputStream::writeDirect (const char* src, size_t numBytes)
+{
+    while (numBytes > 0)
+    {
+        // The data is positioned in the buffer so that the blocks in memory line up
+        // with the blocks in the file
+        if (bytesInBuffer == 0)
+            directBufferStart = (size_t) (currentPosition % (int64) directWriteBlockSize);
+
+        auto space = directBufferSize - directBufferStart - bytesInBuffer;
+        auto numToCopy = jmin (numBytes, space);
+
+        memcpy (directBuffer + directBufferStart + bytesInBuffer, src, numToCopy);
+        bytesInBuffer += numToCopy;
+        currentPosition += (int64) numToCopy;
+        src += numToCopy;
+        numBytes -= numToCopy;
+
+        if (numToCopy == space && ! flushDirectBuffer (false))
+            return false;
+    }
+
+    return true;
+}
+
+bool FileOutputStream::flushDirectBuffer (bool writeEverything)
+{
+    auto data = directBuffer + directBufferStart;
+    auto remaining = bytesInBuffer;
+    bool ok = true;
+
+    // Anything before the first block boundary has to go through the cache..
+    if (directBufferStart > 0 && remaining > 0)
+    {
+        auto numToWrite = jmin (remaining, directWriteBlockSize - directBufferStart);
+        ok = writeBlock (data, numToWrite, false);
+        data += numToWrite;
+        remaining -= numToWrite;
+    }
+
+    // ..then all the whole blocks can be written directly..
+    auto numInWholeBlocks = remaining - remaining % directWriteBlockSize;
+
+    if (ok && numInWholeBlocks > 0)
+    {
+        ok = writeBlock (data, numInWholeBlocks, true);
+        data += numInWholeBlocks;
+        remaining -= numInWholeBlocks;
+    }
+
+    // ..and a partial block at the end is kept back until it's been filled, unless
+    // we're being asked to write everything
+    if (ok && remaining > 0 && writeEverything)
+    {
+        ok = writeBlock (data, remaining, false);
+        remaining = 0;
+    }
+
+    if (ok && remaining > 0)
+    {
+        memmove (directBuffer, data, remaining);
+        directBufferStart = 0;
+    }
+
+    bytesInBuffer = ok ? remaining : 0;
+    return ok;
+}
+
+bool FileOutputStream::writeBlock (const char* data, size_t numBytes, bool direct)
+{
+    direct = direct && ! directWritesRefused;
+
+    if (direct != directFlagSet && setDirectFlag (direct))
+        directFlagSet = direct;
+
+    auto previousStatus = status;
+    auto bytesWritten = writeInternal (data, numBytes);
+
+    if (bytesWritten < 0 && directFlagSet)
+    {
+        // Some file systems accept the flag but then refuse the writes, in which
+        // case we'll carry on through the cache
+        status = previousStatus;
+        directWritesRefused = true;
+        directFlagSet = ! setDirectFlag (false);
+        bytesWritten = writeInternal (data, numBytes);
+    }
+
+    return bytesWritten == (ssize_t) numBytes;
+}
+
 } // namespace juce
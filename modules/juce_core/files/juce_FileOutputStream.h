@@ -96,6 +96,36 @@ public:
     */
     Result truncate();
 
+    /** Asks the file system to reserve space for the file to grow to the given size.
+
+        This doesn't change the file's length, but when you know roughly how much data
+        is going to be written (e.g. when recording or bouncing audio), reserving it up-front
+        reduces fragmentation and avoids the file system having to allocate more blocks
+        as the file grows.
+
+        Returns false if the space couldn't be reserved, or if the platform doesn't support it.
+    */
+    bool preallocate (int64 totalNumBytes);
+
+    /** Enables or disables direct writes, which bypass the operating system's file cache.
+
+        When many large files are being written at once, passing all their data through
+        the cache can cause long, unpredictable stalls when the OS decides to flush it.
+        When direct writes are enabled, the stream's buffer is aligned and filled so that
+        it can be written straight to disk in whole blocks, and only the odd bytes at the
+        start or end of a run of writes (or after a call to setPosition()) go through
+        the cache. For this to be worthwhile the stream should have a large buffer, e.g.
+        a few hundred KB or more.
+
+        Direct writes are currently supported on Linux and Android (using O_DIRECT) and
+        on macOS and iOS (using F_NOCACHE). Returns false if they aren't available for
+        this stream.
+    */
+    bool setDirectWritesEnabled (bool shouldBeEnabled);
+
+    /** Returns true if direct writes have been enabled with setDirectWritesEnabled(). */
+    bool areDirectWritesEnabled() const noexcept        { return directWrites; }
+
     //==============================================================================
     void flush() override;
     int64 getPosition() override;
@@ -112,6 +142,9 @@ private:
     int64 currentPosition = 0;
     size_t bufferSize, bytesInBuffer = 0;
     HeapBlock<char> buffer;
+    char* directBuffer = nullptr;
+    size_t directBufferSize = 0, directBufferStart = 0;
+    bool directWrites = false, directFlagSet = false, directWritesRefused = false;
 
     void openHandle();
     void closeHandle();
@@ -119,6 +152,10 @@ private:
     bool flushBuffer();
     int64 setPositionInternal (int64);
     ssize_t writeInternal (const void*, size_t);
+    bool setDirectFlag (bool);
+    bool writeDirect (const char*, size_t);
+    bool flushDirectBuffer (bool writeEverything);
+    bool writeBlock (const char*, size_t, bool direct);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileOutputStream)
 };
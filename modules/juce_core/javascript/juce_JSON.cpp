@@ -27,7 +27,10 @@ struct JSONParser
 {
     JSONParser (String::CharPointerType text) : startLocation (text), currentLocation (text) {}
 
-    String::CharPointerType startLocation, currentLocation;
+    JSONParser (String::CharPointerType text, String::CharPointerType end)
+        : startLocation (text), currentLocation (text), endLocation (end) {}
+
+    String::CharPointerType startLocation, currentLocation, endLocation { nullptr };
 
     struct ErrorException
     {
@@ -80,12 +83,31 @@ struct JSONParser
         return {};
     }
 
+    // If we know where the text ends, this skips quickly to the next quote or escape character,
+    // copying everything before it straight into the buffer
+    void copyPlainText (MemoryOutputStream& buffer, const juce_wchar quoteChar)
+    {
+       #if JUCE_STRING_UTF_TYPE == 8
+        if (endLocation.getAddress() != nullptr)
+        {
+            auto* start = currentLocation.getAddress();
+            auto* end = CharacterFunctions::findFirstOf (start, endLocation.getAddress(), quoteChar == '"' ? "\"\\" : "'\\");
+
+            buffer.write (start, (size_t) (end - start));
+            currentLocation = String::CharPointerType (end);
+        }
+       #else
+        ignoreUnused (buffer, quoteChar);
+       #endif
+    }
+
     String parseString (const juce_wchar quoteChar)
     {
         MemoryOutputStream buffer (256);
 
         for (;;)
         {
+            copyPlainText (buffer, quoteChar);
             auto c = readChar();
 
             if (c == quoteChar)
@@ -469,7 +491,7 @@ var JSON::fromString (StringRef text)
 {
     try
     {
-        return JSONParser (text.text).parseAny();
+        return JSONParser (text.text, text.text.findTerminatingNull()).parseAny();
     }
     catch (const JSONParser::ErrorException&) {}
 
@@ -490,7 +512,7 @@ Result JSON::parse (const String& text, var& result)
 {
     try
     {
-        result = JSONParser (text.getCharPointer()).parseObjectOrArray();
+        result = JSONParser (text.getCharPointer(), text.getCharPointer().findTerminatingNull()).parseObjectOrArray();
     }
     catch (const JSONParser::ErrorException& error)
     {
@@ -71,6 +71,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     }
 
     Time timeout;
+    bool useBytecode = false;
 
     using Args = const var::NativeFunctionArgs&;
     using TokenType = const char*;
@@ -78,13 +79,23 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     void execute (const String& code)
     {
         ExpressionTreeBuilder tb (code);
-        std::unique_ptr<BlockStatement> (tb.parseStatementList())->perform (Scope ({}, *this, *this), nullptr);
+        std::unique_ptr<BlockStatement> block (tb.parseStatementList());
+
+        if (useBytecode)
+            BytecodeCompiler::compileStatement (*block)->run (Scope ({}, *this, *this));
+        else
+            block->perform (Scope ({}, *this, *this), nullptr);
     }
 
     var evaluate (const String& code)
     {
         ExpressionTreeBuilder tb (code);
-        return ExpPtr (tb.parseExpression())->getResult (Scope ({}, *this, *this));
+        ExpPtr expression (tb.parseExpression());
+
+        if (useBytecode)
+            return BytecodeCompiler::compileExpression (*expression)->run (Scope ({}, *this, *this));
+
+        return expression->getResult (Scope ({}, *this, *this));
     }
 
     //==============================================================================
@@ -241,6 +252,15 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Scope)
     };
 
+    struct BytecodeCompiler;
+
+    // The binary operators which CompiledCode can apply directly when both operands are numbers
+    enum class NumericOperator
+    {
+        none, add, subtract, multiply, modulo,
+        equals, notEquals, lessThan, lessThanOrEqual, greaterThan, greaterThanOrEqual
+    };
+
     //==============================================================================
     struct Statement
     {
@@ -250,6 +270,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         enum ResultCode  { ok = 0, returnWasHit, breakWasHit, continueWasHit };
         virtual ResultCode perform (const Scope&, var*) const  { return ok; }
 
+        // Generates the bytecode equivalent of perform()
+        virtual void compile (BytecodeCompiler&) const {}
+
         CodeLocation location;
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Statement)
     };
@@ -262,6 +285,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         virtual void assign (const Scope&, const var&) const  { location.throwError ("Cannot assign to this expression!"); }
 
         ResultCode perform (const Scope& s, var*) const override  { getResult (s); return ok; }
+
+        // The bytecode equivalents of getResult() and assign(). The code generated by compileResult()
+        // pushes a single value, and compileAssignment() expects the new value to be on the top of the
+        // stack, and leaves it there.
+        virtual void compileResult (BytecodeCompiler& c) const      { c.emit (OpCode::pushUndefined, *this); }
+        virtual void compileAssignment (BytecodeCompiler& c) const  { c.emit (OpCode::cannotAssign, *this); }
+
+        void compile (BytecodeCompiler& c) const override           { compileResult (c); c.emit (OpCode::pop, *this); }
     };
 
     using ExpPtr = std::unique_ptr<Expression>;
@@ -279,6 +310,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return ok;
         }
 
+        void compile (BytecodeCompiler& c) const override
+        {
+            for (auto* statement : statements)
+                statement->compile (c);
+        }
+
         OwnedArray<Statement> statements;
     };
 
@@ -291,6 +328,17 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return (condition->getResult(s) ? trueBranch : falseBranch)->perform (s, returnedValue);
         }
 
+        void compile (BytecodeCompiler& c) const override
+        {
+            condition->compileResult (c);
+            auto jumpToFalseBranch = c.emit (OpCode::jumpIfFalse, *this);
+            trueBranch->compile (c);
+            auto jumpToEnd = c.emit (OpCode::jump, *this);
+            c.setJumpTarget (jumpToFalseBranch);
+            falseBranch->compile (c);
+            c.setJumpTarget (jumpToEnd);
+        }
+
         ExpPtr condition;
         std::unique_ptr<Statement> trueBranch, falseBranch;
     };
@@ -305,6 +353,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return ok;
         }
 
+        void compile (BytecodeCompiler& c) const override
+        {
+            initialiser->compileResult (c);
+            c.emit (OpCode::declareVar, *this, c.addName (name));
+        }
+
         Identifier name;
         ExpPtr initialiser;
     };
@@ -334,6 +388,57 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return ok;
         }
 
+        void compile (BytecodeCompiler& c) const override
+        {
+            initialiser->compile (c);
+
+            BytecodeCompiler::LoopLabels labels;
+            auto* outerLoop = c.currentLoop;
+            c.currentLoop = &labels;
+
+            auto start = c.getNextPosition();
+
+            if (! isDoLoop)
+            {
+                condition->compileResult (c);
+                labels.breaks.add (c.emit (OpCode::jumpIfFalse, *this));
+            }
+
+            c.emit (OpCode::checkTimeOut, *this);
+            body->compile (c);
+
+            if (isDoLoop)
+            {
+                iterator->compile (c);
+                condition->compileResult (c);
+                labels.breaks.add (c.emit (OpCode::jumpIfFalse, *this));
+                c.emit (OpCode::jump, *this, start);
+
+                // a 'continue' in a do-loop skips the condition, just like perform() does
+                if (! labels.continues.isEmpty())
+                {
+                    for (auto i : labels.continues)
+                        c.setJumpTarget (i);
+
+                    iterator->compile (c);
+                    c.emit (OpCode::jump, *this, start);
+                }
+            }
+            else
+            {
+                for (auto i : labels.continues)
+                    c.setJumpTarget (i);
+
+                iterator->compile (c);
+                c.emit (OpCode::jump, *this, start);
+            }
+
+            for (auto i : labels.breaks)
+                c.setJumpTarget (i);
+
+            c.currentLoop = outerLoop;
+        }
+
         std::unique_ptr<Statement> initialiser, iterator, body;
         ExpPtr condition;
         bool isDoLoop;
@@ -349,6 +454,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return returnWasHit;
         }
 
+        void compile (BytecodeCompiler& c) const override
+        {
+            returnValue->compileResult (c);
+            c.emit (OpCode::returnValue, *this);
+        }
+
         ExpPtr returnValue;
     };
 
@@ -356,18 +467,35 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     {
         BreakStatement (const CodeLocation& l) noexcept : Statement (l) {}
         ResultCode perform (const Scope&, var*) const override  { return breakWasHit; }
+
+        void compile (BytecodeCompiler& c) const override
+        {
+            if (c.currentLoop != nullptr)
+                c.currentLoop->breaks.add (c.emit (OpCode::jump, *this));
+            else
+                c.emitReturnVoid (*this);
+        }
     };
 
     struct ContinueStatement  : public Statement
     {
         ContinueStatement (const CodeLocation& l) noexcept : Statement (l) {}
         ResultCode perform (const Scope&, var*) const override  { return continueWasHit; }
+
+        void compile (BytecodeCompiler& c) const override
+        {
+            if (c.currentLoop != nullptr)
+                c.currentLoop->continues.add (c.emit (OpCode::jump, *this));
+            else
+                c.emitReturnVoid (*this);
+        }
     };
 
     struct LiteralValue  : public Expression
     {
         LiteralValue (const CodeLocation& l, const var& v) noexcept : Expression (l), value (v) {}
         var getResult (const Scope&) const override   { return value; }
+        void compileResult (BytecodeCompiler& c) const override  { c.emit (OpCode::pushConstant, *this, c.addConstant (value)); }
         var value;
     };
 
@@ -385,6 +513,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 s.root->setProperty (name, newValue);
         }
 
+        void compileResult (BytecodeCompiler& c) const override      { c.emit (OpCode::getName, *this, c.addName (name)); }
+        void compileAssignment (BytecodeCompiler& c) const override  { c.emit (OpCode::setName, *this, c.addName (name)); }
+
         Identifier name;
     };
 
@@ -418,6 +549,18 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 Expression::assign (s, newValue);
         }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            parent->compileResult (c);
+            c.emit (OpCode::getProperty, *this, c.addName (child));
+        }
+
+        void compileAssignment (BytecodeCompiler& c) const override
+        {
+            parent->compileResult (c);
+            c.emit (OpCode::setProperty, *this, c.addName (child));
+        }
+
         ExpPtr parent;
         Identifier child;
     };
@@ -431,6 +574,34 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
             auto key = index->getResult (s);
 
+            return getElement (arrayVar, key);
+        }
+
+        void assign (const Scope& s, const var& newValue) const override
+        {
+            auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
+            auto key = index->getResult (s);
+
+            if (! setElement (arrayVar, key, newValue))
+                Expression::assign (s, newValue);
+        }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            object->compileResult (c);
+            index->compileResult (c);
+            c.emit (OpCode::getElement, *this);
+        }
+
+        void compileAssignment (BytecodeCompiler& c) const override
+        {
+            object->compileResult (c);
+            index->compileResult (c);
+            c.emit (OpCode::setElement, *this);
+        }
+
+        static var getElement (const var& arrayVar, const var& key)
+        {
             if (const auto* array = arrayVar.getArray())
                 if (key.isInt() || key.isInt64() || key.isDouble())
                     return (*array) [static_cast<int> (key)];
@@ -443,11 +614,8 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return var::undefined();
         }
 
-        void assign (const Scope& s, const var& newValue) const override
+        static bool setElement (const var& arrayVar, const var& key, const var& newValue)
         {
-            auto arrayVar = object->getResult (s); // must stay alive for the scope of this method
-            auto key = index->getResult (s);
-
             if (auto* array = arrayVar.getArray())
             {
                 if (key.isInt() || key.isInt64() || key.isDouble())
@@ -457,7 +625,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                         array->add (var::undefined());
 
                     array->set (i, newValue);
-                    return;
+                    return true;
                 }
             }
 
@@ -466,11 +634,11 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 if (key.isString())
                 {
                     o->setProperty (Identifier (key), newValue);
-                    return;
+                    return true;
                 }
             }
 
-            Expression::assign (s, newValue);
+            return false;
         }
 
         ExpPtr object, index;
@@ -488,7 +656,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     struct BinaryOperator  : public BinaryOperatorBase
     {
         BinaryOperator (const CodeLocation& l, ExpPtr& a, ExpPtr& b, TokenType op) noexcept
-            : BinaryOperatorBase (l, a, b, op) {}
+            : BinaryOperatorBase (l, a, b, op), numericOperator (getNumericOperator (op)) {}
 
         virtual var getWithUndefinedArg() const                           { return var::undefined(); }
         virtual var getWithDoubles (double, double) const                 { return throwError ("Double"); }
@@ -499,7 +667,46 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var getResult (const Scope& s) const override
         {
             var a (lhs->getResult (s)), b (rhs->getResult (s));
+            return getResult (a, b);
+        }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            lhs->compileResult (c);
+
+            // a constant right-hand side (e.g. 'i < 10' or 'n - 1') is read straight from the node
+            if (dynamic_cast<const LiteralValue*> (rhs.get()) != nullptr)
+            {
+                c.emit (OpCode::binaryOperatorWithConstant, *this);
+                return;
+            }
+
+            rhs->compileResult (c);
+            c.emit (OpCode::binaryOperator, *this);
+        }
+
+        const var& getConstantRHS() const noexcept    { return static_cast<const LiteralValue*> (rhs.get())->value; }
+
+        static NumericOperator getNumericOperator (TokenType op) noexcept
+        {
+            if (op == TokenTypes::plus)                return NumericOperator::add;
+            if (op == TokenTypes::minus)               return NumericOperator::subtract;
+            if (op == TokenTypes::times)               return NumericOperator::multiply;
+            if (op == TokenTypes::modulo)              return NumericOperator::modulo;
+            if (op == TokenTypes::equals)              return NumericOperator::equals;
+            if (op == TokenTypes::notEquals)           return NumericOperator::notEquals;
+            if (op == TokenTypes::lessThan)            return NumericOperator::lessThan;
+            if (op == TokenTypes::lessThanOrEqual)     return NumericOperator::lessThanOrEqual;
+            if (op == TokenTypes::greaterThan)         return NumericOperator::greaterThan;
+            if (op == TokenTypes::greaterThanOrEqual)  return NumericOperator::greaterThanOrEqual;
+
+            return NumericOperator::none;
+        }
+
+        const NumericOperator numericOperator;
 
+        var getResult (const var& a, const var& b) const
+        {
             if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
                 return getWithUndefinedArg();
 
@@ -644,24 +851,64 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     {
         LogicalAndOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::logicalAnd) {}
         var getResult (const Scope& s) const override       { return lhs->getResult (s) && rhs->getResult (s); }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            lhs->compileResult (c);
+            auto jumpIfFalse = c.emit (OpCode::jumpIfFalse, *this);
+            rhs->compileResult (c);
+            c.emit (OpCode::toBool, *this);
+            auto jumpToEnd = c.emit (OpCode::jump, *this);
+            c.setJumpTarget (jumpIfFalse);
+            c.adjustStackDepth (-1);
+            c.emit (OpCode::pushConstant, *this, c.addConstant (false));
+            c.setJumpTarget (jumpToEnd);
+        }
     };
 
     struct LogicalOrOp  : public BinaryOperatorBase
     {
         LogicalOrOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::logicalOr) {}
         var getResult (const Scope& s) const override       { return lhs->getResult (s) || rhs->getResult (s); }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            lhs->compileResult (c);
+            auto jumpIfFalse = c.emit (OpCode::jumpIfFalse, *this);
+            c.emit (OpCode::pushConstant, *this, c.addConstant (true));
+            auto jumpToEnd = c.emit (OpCode::jump, *this);
+            c.setJumpTarget (jumpIfFalse);
+            c.adjustStackDepth (-1);
+            rhs->compileResult (c);
+            c.emit (OpCode::toBool, *this);
+            c.setJumpTarget (jumpToEnd);
+        }
     };
 
     struct TypeEqualsOp  : public BinaryOperatorBase
     {
         TypeEqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::typeEquals) {}
         var getResult (const Scope& s) const override       { return areTypeEqual (lhs->getResult (s), rhs->getResult (s)); }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            lhs->compileResult (c);
+            rhs->compileResult (c);
+            c.emit (OpCode::typeEquals, *this);
+        }
     };
 
     struct TypeNotEqualsOp  : public BinaryOperatorBase
     {
         TypeNotEqualsOp (const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperatorBase (l, a, b, TokenTypes::typeNotEquals) {}
         var getResult (const Scope& s) const override       { return ! areTypeEqual (lhs->getResult (s), rhs->getResult (s)); }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            lhs->compileResult (c);
+            rhs->compileResult (c);
+            c.emit (OpCode::typeNotEquals, *this);
+        }
     };
 
     struct ConditionalOp  : public Expression
@@ -671,6 +918,29 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var getResult (const Scope& s) const override              { return (condition->getResult (s) ? trueBranch : falseBranch)->getResult (s); }
         void assign (const Scope& s, const var& v) const override  { (condition->getResult (s) ? trueBranch : falseBranch)->assign (s, v); }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            condition->compileResult (c);
+            auto jumpToFalseBranch = c.emit (OpCode::jumpIfFalse, *this);
+            trueBranch->compileResult (c);
+            auto jumpToEnd = c.emit (OpCode::jump, *this);
+            c.setJumpTarget (jumpToFalseBranch);
+            c.adjustStackDepth (-1);
+            falseBranch->compileResult (c);
+            c.setJumpTarget (jumpToEnd);
+        }
+
+        void compileAssignment (BytecodeCompiler& c) const override
+        {
+            condition->compileResult (c);
+            auto jumpToFalseBranch = c.emit (OpCode::jumpIfFalse, *this);
+            trueBranch->compileAssignment (c);
+            auto jumpToEnd = c.emit (OpCode::jump, *this);
+            c.setJumpTarget (jumpToFalseBranch);
+            falseBranch->compileAssignment (c);
+            c.setJumpTarget (jumpToEnd);
+        }
+
         ExpPtr condition, trueBranch, falseBranch;
     };
 
@@ -685,6 +955,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return value;
         }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            newValue->compileResult (c);
+            target->compileAssignment (c);
+        }
+
         ExpPtr target, newValue;
     };
 
@@ -700,6 +976,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return value;
         }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            newValue->compileResult (c);
+            target->compileAssignment (c);
+        }
+
         Expression* target; // Careful! this pointer aliases a sub-term of newValue!
         ExpPtr newValue;
         TokenType op;
@@ -715,6 +997,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             target->assign (s, newValue->getResult (s));
             return oldValue;
         }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            target->compileResult (c);
+            newValue->compileResult (c);
+            target->compileAssignment (c);
+            c.emit (OpCode::pop, *this);
+        }
     };
 
     struct FunctionCall  : public Expression
@@ -742,21 +1032,55 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                 argVars.add (a->getResult (s));
 
             const var::NativeFunctionArgs args (thisObject, argVars.begin(), argVars.size());
+            return invokeFunction (s, function, args, getMethodName());
+        }
 
+        var invokeFunction (const Scope& s, const var& function, const var::NativeFunctionArgs& args, const Identifier* methodName) const
+        {
             if (var::NativeFunction nativeFunction = function.getNativeFunction())
                 return nativeFunction (args);
 
             if (auto* fo = dynamic_cast<FunctionObject*> (function.getObject()))
                 return fo->invoke (s, args);
 
-            if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
-                if (auto* o = thisObject.getDynamicObject())
-                    if (o->hasMethod (dot->child)) // allow an overridden DynamicObject::invokeMethod to accept a method call.
-                        return o->invokeMethod (dot->child, args);
+            if (methodName != nullptr)
+                if (auto* o = args.thisObject.getDynamicObject())
+                    if (o->hasMethod (*methodName)) // allow an overridden DynamicObject::invokeMethod to accept a method call.
+                        return o->invokeMethod (*methodName, args);
 
             location.throwError ("This expression is not a function!"); return {};
         }
 
+        const Identifier* getMethodName() const noexcept
+        {
+            if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
+                return &(dot->child);
+
+            return nullptr;
+        }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            if (auto* dot = dynamic_cast<DotOperator*> (object.get()))
+            {
+                dot->parent->compileResult (c);
+                c.emit (OpCode::findMethod, *this, c.addName (dot->child));
+                compileArguments (c);
+                c.emit (OpCode::callMethod, *this, arguments.size());
+                return;
+            }
+
+            object->compileResult (c);
+            compileArguments (c);
+            c.emit (OpCode::call, *this, arguments.size());
+        }
+
+        void compileArguments (BytecodeCompiler& c) const
+        {
+            for (auto* a : arguments)
+                a->compileResult (c);
+        }
+
         ExpPtr object;
         OwnedArray<Expression> arguments;
     };
@@ -782,6 +1106,15 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             return newObject.get();
         }
+
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            object->compileResult (c);
+            auto jumpIfNotAFunction = c.emit (OpCode::beginNew, *this);
+            compileArguments (c);
+            c.emit (OpCode::callNew, *this, arguments.size());
+            c.setJumpTarget (jumpIfNotAFunction);
+        }
     };
 
     struct ObjectDeclaration  : public Expression
@@ -798,6 +1131,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return newObject.get();
         }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            for (auto* i : initialisers)
+                i->compileResult (c);
+
+            c.emit (OpCode::makeObject, *this, initialisers.size());
+        }
+
         Array<Identifier> names;
         OwnedArray<Expression> initialisers;
     };
@@ -819,9 +1160,566 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             JUCE_END_IGNORE_WARNINGS_GCC_LIKE
         }
 
+        void compileResult (BytecodeCompiler& c) const override
+        {
+            for (auto* v : values)
+                v->compileResult (c);
+
+            c.emit (OpCode::makeArray, *this, values.size());
+        }
+
         OwnedArray<Expression> values;
     };
 
+    //==============================================================================
+    enum class OpCode
+    {
+        pushUndefined, pushConstant, pop,
+        getName, setName, declareVar,
+        getProperty, setProperty, getElement, setElement,
+        binaryOperator, binaryOperatorWithConstant, typeEquals, typeNotEquals, toBool,
+        jump, jumpIfFalse,
+        call, findMethod, callMethod, beginNew, callNew,
+        makeObject, makeArray,
+        cannotAssign, checkTimeOut, returnValue
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        int arg;                    // a constant, name, jump target or argument count, depending on the op
+        const Statement* source;    // the node that generated this instruction, for error locations etc.
+        int cachedIndex, cachedOuterIndex;
+    };
+
+    //==============================================================================
+    /** A block of bytecode, which is run on a stack of vars.
+
+        Names are held in a table rather than being looked up by string, and each instruction
+        that accesses a property remembers the index at which it found it last time. A function's
+        scope object always gets its 'this', parameters and local variables added in the same
+        order, so after the first call, these lookups almost never need to search.
+    */
+    struct CompiledCode
+    {
+        Array<Instruction> instructions;
+        Array<var> constants;
+        Array<Identifier> names;
+        int maxStackSize = 0;
+
+        var run (const Scope& s)
+        {
+            ValueStack::Frame frame (s.root->valueStack, maxStackSize);
+            auto* sp = frame.base;
+
+            auto pop = [&sp]   { return std::move (*--sp); };
+            uint32 numLoopIterations = 0;
+
+            for (int pc = 0;;)
+            {
+                auto& i = instructions.getReference (pc++);
+
+                switch (i.op)
+                {
+                    case OpCode::pushUndefined:  *sp++ = var::undefined(); break;
+                    case OpCode::pushConstant:   *sp++ = constants.getReference (i.arg); break;
+                    case OpCode::pop:            pop(); break;
+
+                    case OpCode::getName:
+                        *sp++ = findSymbol (s, i);
+                        break;
+
+                    case OpCode::setName:
+                    {
+                        auto& name = names.getReference (i.arg);
+
+                        if (auto* v = findProperty (*s.scope, name, i.cachedIndex))
+                            *v = sp[-1];
+                        else
+                            s.root->setProperty (name, sp[-1]);
+
+                        break;
+                    }
+
+                    case OpCode::declareVar:
+                        s.scope->setProperty (names.getReference (i.arg), pop());
+                        break;
+
+                    case OpCode::getProperty:
+                        sp[-1] = getProperty (sp[-1], i);
+                        break;
+
+                    case OpCode::setProperty:
+                    {
+                        auto object = pop();
+
+                        if (auto* o = object.getDynamicObject())
+                            o->setProperty (names.getReference (i.arg), sp[-1]);
+                        else
+                            i.source->location.throwError ("Cannot assign to this expression!");
+
+                        break;
+                    }
+
+                    case OpCode::getElement:
+                    {
+                        auto key = pop();
+                        sp[-1] = ArraySubscript::getElement (sp[-1], key);
+                        break;
+                    }
+
+                    case OpCode::setElement:
+                    {
+                        auto key = pop();
+                        auto object = pop();
+
+                        if (! ArraySubscript::setElement (object, key, sp[-1]))
+                            i.source->location.throwError ("Cannot assign to this expression!");
+
+                        break;
+                    }
+
+                    case OpCode::binaryOperator:
+                    {
+                        auto b = pop();
+                        applyBinaryOperator (i, sp[-1], b);
+                        break;
+                    }
+
+                    case OpCode::binaryOperatorWithConstant:
+                        applyBinaryOperator (i, sp[-1], static_cast<const BinaryOperator*> (i.source)->getConstantRHS());
+                        break;
+
+                    case OpCode::typeEquals:     { auto b = pop(); sp[-1] = areTypeEqual (sp[-1], b); break; }
+                    case OpCode::typeNotEquals:  { auto b = pop(); sp[-1] = ! areTypeEqual (sp[-1], b); break; }
+                    case OpCode::toBool:         sp[-1] = (bool) sp[-1]; break;
+
+                    case OpCode::jump:           pc = i.arg; break;
+                    case OpCode::jumpIfFalse:    if (! pop()) pc = i.arg; break;
+
+                    case OpCode::call:
+                    {
+                        sp -= i.arg;
+                        auto& function = sp[-1];
+                        function = invoke (s, i, function, var::NativeFunctionArgs (var (s.scope.get()), sp, i.arg), nullptr);
+                        clear (sp, i.arg);
+                        break;
+                    }
+
+                    case OpCode::findMethod:
+                    {
+                        auto& object = sp[-1];
+                        auto& name = names.getReference (i.arg);
+                        auto* o = object.getDynamicObject();
+                        auto* v = o != nullptr ? findProperty (*o, name, i.cachedIndex) : nullptr;
+
+                        *sp = v != nullptr ? *v : s.findFunctionCall (i.source->location, object, name);
+                        ++sp;
+                        break;
+                    }
+
+                    case OpCode::callMethod:
+                    {
+                        sp -= i.arg;
+                        auto& function = sp[-1];
+                        auto& object = sp[-2];
+                        object = invoke (s, i, function, var::NativeFunctionArgs (object, sp, i.arg),
+                                         static_cast<const FunctionCall*> (i.source)->getMethodName());
+                        clear (sp - 1, i.arg + 1);
+                        --sp;
+                        break;
+                    }
+
+                    case OpCode::beginNew:
+                    {
+                        auto& classOrFunc = sp[-1];
+
+                        if (isFunction (classOrFunc))
+                        {
+                            *sp++ = new DynamicObject();
+                        }
+                        else
+                        {
+                            if (classOrFunc.getDynamicObject() != nullptr)
+                            {
+                                DynamicObject::Ptr newObject (new DynamicObject());
+                                newObject->setProperty (getPrototypeIdentifier(), classOrFunc);
+                                classOrFunc = newObject.get();
+                            }
+                            else
+                            {
+                                classOrFunc = var::undefined();
+                            }
+
+                            pc = i.arg;
+                        }
+
+                        break;
+                    }
+
+                    case OpCode::callNew:
+                    {
+                        sp -= i.arg;
+                        auto& newObject = sp[-1];
+                        auto& function = sp[-2];
+                        invoke (s, i, function, var::NativeFunctionArgs (newObject, sp, i.arg),
+                                static_cast<const FunctionCall*> (i.source)->getMethodName());
+                        function = std::move (newObject);
+                        clear (sp - 1, i.arg + 1);
+                        --sp;
+                        break;
+                    }
+
+                    case OpCode::makeObject:
+                    {
+                        sp -= i.arg;
+                        DynamicObject::Ptr newObject (new DynamicObject());
+                        auto& propertyNames = static_cast<const ObjectDeclaration*> (i.source)->names;
+
+                        for (int n = 0; n < i.arg; ++n)
+                            newObject->setProperty (propertyNames.getReference (n), std::move (sp[n]));
+
+                        *sp++ = newObject.get();
+                        break;
+                    }
+
+                    case OpCode::makeArray:
+                    {
+                        sp -= i.arg;
+                        Array<var> a;
+                        a.ensureStorageAllocated (i.arg);
+
+                        for (int n = 0; n < i.arg; ++n)
+                            a.add (std::move (sp[n]));
+
+                        *sp++ = std::move (a);
+                        break;
+                    }
+
+                    case OpCode::cannotAssign:   i.source->location.throwError ("Cannot assign to this expression!"); break;
+                    case OpCode::checkTimeOut:
+                        // reading the clock costs more than a typical loop body, so only do it every few iterations
+                        if ((++numLoopIterations & 15) == 0)
+                            s.checkTimeOut (i.source->location);
+
+                        break;
+
+                    case OpCode::returnValue:    return pop();
+
+                    default:                     jassertfalse; break;
+                }
+            }
+        }
+
+    private:
+        // Returns the property with the given name if the object has one, checking the index at which
+        // it was last found before searching for it.
+        static var* findProperty (DynamicObject& o, const Identifier& name, int& cachedIndex) noexcept
+        {
+            auto& props = o.getProperties();
+
+            if (! (isPositiveAndBelow (cachedIndex, props.size()) && props.begin()[cachedIndex].name == name))
+            {
+                cachedIndex = props.indexOf (name);
+
+                if (cachedIndex < 0)
+                    return nullptr;
+            }
+
+            return props.getVarPointerAt (cachedIndex);
+        }
+
+        // Does the same search as Scope::findSymbolInParentScopes()
+        var findSymbol (const Scope& s, Instruction& i) const
+        {
+            auto& name = names.getReference (i.arg);
+
+            if (auto* v = findProperty (*s.scope, name, i.cachedIndex))
+                return *v;
+
+            for (auto* p = s.parent; p != nullptr; p = p->parent)
+            {
+                if (p->parent == nullptr)
+                {
+                    if (auto* v = findProperty (*p->scope, name, i.cachedOuterIndex))
+                        return *v;
+                }
+                else if (auto* v = getPropertyPointer (*p->scope, name))
+                {
+                    return *v;
+                }
+            }
+
+            return var::undefined();
+        }
+
+        // Does the same as DotOperator::getResult()
+        var getProperty (const var& object, Instruction& i) const
+        {
+            static const Identifier lengthID ("length");
+            auto& name = names.getReference (i.arg);
+
+            if (name == lengthID)
+            {
+                if (auto* array = object.getArray())   return array->size();
+                if (object.isString())                 return object.toString().length();
+            }
+
+            if (auto* o = object.getDynamicObject())
+                if (auto* v = findProperty (*o, name, i.cachedIndex))
+                    return *v;
+
+            return var::undefined();
+        }
+
+        static void applyBinaryOperator (const Instruction& i, var& a, const var& b)
+        {
+            auto& op = *static_cast<const BinaryOperator*> (i.source);
+
+            if (! applyNumericOperator (op.numericOperator, a, b))
+                a = op.getResult (a, b);
+        }
+
+        // Gives the same results as BinaryOperator::getResult() when both operands are ints or doubles,
+        // but without the virtual calls. Returns false for anything that it doesn't handle.
+        static bool applyNumericOperator (NumericOperator op, var& a, const var& b)
+        {
+            if (op == NumericOperator::none)
+                return false;
+
+            auto aIsInt = a.isInt() || a.isInt64();
+            auto bIsInt = b.isInt() || b.isInt64();
+
+            if (aIsInt && bIsInt)
+            {
+                a = applyNumericOperator (op, (int64) a, (int64) b);
+                return true;
+            }
+
+            if ((aIsInt || a.isDouble()) && (bIsInt || b.isDouble()))
+            {
+                a = applyNumericOperator (op, (double) a, (double) b);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <typename NumericType>
+        static var applyNumericOperator (NumericOperator op, NumericType a, NumericType b)
+        {
+            switch (op)
+            {
+                case NumericOperator::add:                 return a + b;
+                case NumericOperator::subtract:            return a - b;
+                case NumericOperator::multiply:            return a * b;
+                case NumericOperator::modulo:              return b != 0 ? var (modulo (a, b)) : var (std::numeric_limits<double>::infinity());
+                case NumericOperator::equals:              return a == b;
+                case NumericOperator::notEquals:           return a != b;
+                case NumericOperator::lessThan:            return a < b;
+                case NumericOperator::lessThanOrEqual:     return a <= b;
+                case NumericOperator::greaterThan:         return a > b;
+                case NumericOperator::greaterThanOrEqual:  return a >= b;
+                case NumericOperator::none:
+                default:                                   jassertfalse; return {};
+            }
+        }
+
+        static int64 modulo (int64 a, int64 b) noexcept     { return a % b; }
+        static double modulo (double a, double b) noexcept  { return fmod (a, b); }
+
+        static var invoke (const Scope& s, const Instruction& i, const var& function,
+                           const var::NativeFunctionArgs& args, const Identifier* methodName)
+        {
+            s.checkTimeOut (i.source->location);
+            return static_cast<const FunctionCall*> (i.source)->invokeFunction (s, function, args, methodName);
+        }
+
+        static void clear (var* values, int num)
+        {
+            for (int n = 0; n < num; ++n)
+                values[n] = var();
+        }
+    };
+
+    //==============================================================================
+    /** Holds the values used by running CompiledCode. Each call allocates a frame from the
+        end of the current chunk, so a frame never moves while native functions that have been
+        given pointers into it are still running.
+    */
+    struct ValueStack
+    {
+        struct Frame
+        {
+            Frame (ValueStack& s, int numSlots) : stack (s), size (numSlots)
+            {
+                base = stack.allocate (size, chunkIndex);
+            }
+
+            ~Frame()
+            {
+                for (int i = 0; i < size; ++i)
+                    base[i] = var();
+
+                stack.release (size, chunkIndex);
+            }
+
+            ValueStack& stack;
+            var* base;
+            int size, chunkIndex;
+        };
+
+    private:
+        struct Chunk
+        {
+            std::unique_ptr<var[]> slots;
+            int size, used;
+        };
+
+        std::vector<Chunk> chunks;
+        size_t currentChunk = 0;
+
+        var* allocate (int num, int& chunkIndex)
+        {
+            for (;; ++currentChunk)
+            {
+                if (currentChunk == chunks.size())
+                {
+                    auto size = jmax (num, 1024);
+                    chunks.push_back ({ std::unique_ptr<var[]> (new var[(size_t) size]), size, 0 });
+                }
+
+                auto& c = chunks[currentChunk];
+
+                if (c.used + num <= c.size)
+                {
+                    chunkIndex = (int) currentChunk;
+                    auto* base = c.slots.get() + c.used;
+                    c.used += num;
+                    return base;
+                }
+            }
+        }
+
+        void release (int num, int chunkIndex) noexcept
+        {
+            chunks[(size_t) chunkIndex].used -= num;
+
+            while (currentChunk > 0 && chunks[currentChunk].used == 0)
+                --currentChunk;
+        }
+    };
+
+    ValueStack valueStack;
+
+    //==============================================================================
+    struct BytecodeCompiler
+    {
+        static std::unique_ptr<CompiledCode> compileStatement (const Statement& statement)
+        {
+            std::unique_ptr<CompiledCode> code (new CompiledCode());
+            BytecodeCompiler c (*code);
+            statement.compile (c);
+            c.emitReturnVoid (statement);
+            return code;
+        }
+
+        static std::unique_ptr<CompiledCode> compileExpression (const Expression& expression)
+        {
+            std::unique_ptr<CompiledCode> code (new CompiledCode());
+            BytecodeCompiler c (*code);
+            expression.compileResult (c);
+            c.emit (OpCode::returnValue, expression);
+            return code;
+        }
+
+        int emit (OpCode op, const Statement& source, int arg = 0)
+        {
+            stackDepth += getStackChange (op, arg);
+            jassert (stackDepth >= 0);
+            code.maxStackSize = jmax (code.maxStackSize, stackDepth);
+
+            code.instructions.add ({ op, arg, &source, -1, -1 });
+            return code.instructions.size() - 1;
+        }
+
+        // When the end of a function is reached, or a 'break' or 'continue' is found outside a loop,
+        // perform() returns without setting the result, which leaves it void.
+        void emitReturnVoid (const Statement& source)
+        {
+            emit (OpCode::pushConstant, source, addConstant (var()));
+            emit (OpCode::returnValue, source);
+        }
+
+        int getNextPosition() const noexcept                       { return code.instructions.size(); }
+        void setJumpTarget (int instruction) noexcept              { setJumpTarget (instruction, getNextPosition()); }
+        void setJumpTarget (int instruction, int target) noexcept  { code.instructions.getReference (instruction).arg = target; }
+
+        // Used when the code following a jump starts with fewer items on the stack than the jump left there
+        void adjustStackDepth (int delta) noexcept                 { stackDepth += delta; }
+
+        int addConstant (const var& value)
+        {
+            code.constants.add (value);
+            return code.constants.size() - 1;
+        }
+
+        int addName (const Identifier& name)
+        {
+            auto index = code.names.indexOf (name);
+
+            if (index >= 0)
+                return index;
+
+            code.names.add (name);
+            return code.names.size() - 1;
+        }
+
+        struct LoopLabels
+        {
+            Array<int> breaks, continues;
+        };
+
+        LoopLabels* currentLoop = nullptr;
+
+    private:
+        BytecodeCompiler (CompiledCode& c) noexcept : code (c) {}
+
+        CompiledCode& code;
+        int stackDepth = 0;
+
+        static int getStackChange (OpCode op, int arg) noexcept
+        {
+            switch (op)
+            {
+                case OpCode::pushUndefined:
+                case OpCode::pushConstant:
+                case OpCode::getName:
+                case OpCode::findMethod:
+                case OpCode::beginNew:       return 1;
+
+                case OpCode::pop:
+                case OpCode::declareVar:
+                case OpCode::setProperty:
+                case OpCode::getElement:
+                case OpCode::binaryOperator:
+                case OpCode::typeEquals:
+                case OpCode::typeNotEquals:
+                case OpCode::jumpIfFalse:
+                case OpCode::returnValue:    return -1;
+
+                case OpCode::setElement:     return -2;
+                case OpCode::call:           return -arg;
+                case OpCode::callMethod:
+                case OpCode::callNew:        return -(arg + 1);
+                case OpCode::makeObject:
+                case OpCode::makeArray:      return 1 - arg;
+
+                default:                     return 0;
+            }
+        }
+    };
+
     //==============================================================================
     struct FunctionObject  : public DynamicObject
     {
@@ -852,13 +1750,27 @@ struct JavascriptEngine::RootObject   : public DynamicObject
                                            i < args.numArguments ? args.arguments[i] : var::undefined());
 
             var result;
-            body->perform (Scope (&s, s.root, functionRoot), &result);
+
+            if (s.root->useBytecode)
+                result = getCompiledBody().run (Scope (&s, s.root, functionRoot));
+            else
+                body->perform (Scope (&s, s.root, functionRoot), &result);
+
             return result;
         }
 
+        CompiledCode& getCompiledBody() const
+        {
+            if (compiledBody == nullptr)
+                compiledBody = BytecodeCompiler::compileStatement (*body);
+
+            return *compiledBody;
+        }
+
         String functionCode;
         Array<Identifier> parameters;
         std::unique_ptr<Statement> body;
+        mutable std::unique_ptr<CompiledCode> compiledBody;
     };
 
     //==============================================================================
@@ -1834,6 +2746,9 @@ JavascriptEngine::~JavascriptEngine() {}
 void JavascriptEngine::prepareTimeout() const noexcept   { root->timeout = Time::getCurrentTime() + maximumExecutionTime; }
 void JavascriptEngine::stop() noexcept                   { root->timeout = {}; }
 
+void JavascriptEngine::setBytecodeCompilationEnabled (bool shouldCompile) noexcept   { root->useBytecode = shouldCompile; }
+bool JavascriptEngine::isBytecodeCompilationEnabled() const noexcept                 { return root->useBytecode; }
+
 void JavascriptEngine::registerNativeObject (const Identifier& name, DynamicObject* object)
 {
     root->setProperty (name, object);
@@ -1916,4 +2831,172 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
 
 JUCE_END_IGNORE_WARNINGS_MSVC
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptEngineTests  : public UnitTest
+{
+public:
+    JavascriptEngineTests()
+        : UnitTest ("JavascriptEngine", UnitTestCategories::javascript)
+    {}
+
+    struct Outcome
+    {
+        String error, result, type;
+    };
+
+    static Outcome run (const String& script, bool useBytecode)
+    {
+        JavascriptEngine engine;
+        engine.setBytecodeCompilationEnabled (useBytecode);
+
+        auto r = engine.execute (script);
+
+        if (r.failed())
+            return { r.getErrorMessage(), {}, {} };
+
+        auto result = engine.evaluate ("result", &r);
+
+        if (r.failed())
+            return { r.getErrorMessage(), {}, {} };
+
+        return { {}, JSON::toString (result, true), engine.evaluate ("typeof (result)").toString() };
+    }
+
+    void expectSameOutcome (const String& script, const String& expectedResult)
+    {
+        auto treeWalked = run (script, false);
+        auto compiled   = run (script, true);
+
+        expectEquals (compiled.error,  treeWalked.error);
+        expectEquals (compiled.result, treeWalked.result);
+        expectEquals (compiled.type,   treeWalked.type);
+
+        if (expectedResult.isNotEmpty())
+            expectEquals (compiled.result, expectedResult);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Bytecode matches the tree-walker");
+        {
+            expectSameOutcome ("var result = 1 + 2 * 3 - 4 / 2;", "5.0");
+            expectSameOutcome ("var result = (7 % 3) + (1 << 4) + (-16 >> 2) + (-16 >>> 28) + (5 & 3) + (5 | 3) + (5 ^ 3);", "");
+            expectSameOutcome ("var result = [ 1 < 2, 2 <= 1, 3 > 2, 3 >= 4, 1 == 1.0, 1 != 2, 1 === '1', 1 !== 1 ];", "");
+            expectSameOutcome ("var result = [ 1 && 0, 0 || 'x', null && foo(), 1 || foo(), ! 0, -(3) ];", "");
+            expectSameOutcome ("var result = [ typeof (undefined), typeof (null), typeof (1), typeof ('s'), typeof ([]), typeof ({}) ];", "");
+            expectSameOutcome ("var result = 'abc' + 1 + 2.5 + true;", "");
+            expectSameOutcome ("var a = 7; var b = 2.5; var result = [ a + b, a - 2, a * b, a % 3, b % 2, a % 0, b % 0, a / 0, 3 - a ];", "");
+            expectSameOutcome ("var a = 3; var b = 3.0; var result = [ a == b, a != 3, a < 3.5, b <= a, a > 2, b >= 4, a == '3', a < 'x' ];", "");
+            expectSameOutcome ("var a = 1; var result = [ a + true, true + a, a + undefined, a + null, null + 1, a + 'x', 'x' + a, a + [], a - 'x' ];", "");
+            expectSameOutcome ("var big = 4000000000; var result = [ big + 1, big * big, big % 7, typeof (big + 1), 5 / 2, typeof (4 / 2) ];", "");
+            expectSameOutcome ("var result = 1 < 2 ? 'yes' : 'no';", "\"yes\"");
+            expectSameOutcome ("var result = missing;", "");
+            expectSameOutcome ("var a = { x: 1 }; var result = a.y;", "");
+
+            expectSameOutcome ("var result = 0; for (var i = 0; i < 10; ++i) { if (i == 2) continue; if (i == 7) break; result += i; }", "19");
+            expectSameOutcome ("var result = 0; var i = 0; while (true) { if (++i > 5) break; result = result * 2 + i; }", "57");
+            expectSameOutcome ("var result = []; var i = 0; do { ++i; if (i % 2 == 0) continue; result.push (i); } while (i < 9);", "[1, 3, 5, 7, 9]");
+            expectSameOutcome ("var result = 0; for (var i = 0; i < 3; i++) for (var j = 0; j < 3; j++) { if (j > i) break; result += 10 * i + j; }", "");
+            expectSameOutcome ("var result = 1; var n = 5; while (n--) result *= 2;", "32");
+
+            expectSameOutcome ("function fib (n) { return n < 2 ? n : fib (n - 1) + fib (n - 2); } var result = fib (15);", "610");
+            expectSameOutcome ("function f() { } var result = f();", "");
+            expectSameOutcome ("function f() { break; } var result = [ f(), typeof (f()) ];", "");
+            expectSameOutcome ("function f (a, b) { return typeof (b); } var result = f (1);", "\"undefined\"");
+            expectSameOutcome ("var x = 1; function f() { return x; } function g() { var x = 2; return f(); } var result = [ f(), g() ];", "");
+            expectSameOutcome ("var counter = 0; function bump() { counter = counter + 1; } bump(); bump(); var result = counter;", "2");
+            expectSameOutcome ("function makeAdder (n) { return function (x) { return x + n; }; } var result = makeAdder (1) (2);", "");
+            expectSameOutcome ("var o = { v: 3, get: function() { return this.v; } }; var result = o.get();", "3");
+
+            expectSameOutcome ("function Point (x, y) { this.x = x; this.y = y; } var p = new Point (1, 2); var result = p.x + p.y;", "3");
+            expectSameOutcome ("var proto = { hello: function() { return 'hi'; } }; var o = new proto(); var result = o.hello();", "\"hi\"");
+            expectSameOutcome ("var result = new 3;", "");
+
+            expectSameOutcome ("var result = [ 1, 2, 3 ]; result[1] = 5; result[1] += 2; result[4] = 'z';", "");
+            expectSameOutcome ("var a = [ 1, 2, 3 ]; var result = [ a.length, a[0], a[7], a.indexOf (3), 'hello'.length ];", "");
+            expectSameOutcome ("var o = {}; o['k'] = 1; o.j = 2; o.j++; var result = [ o.k, o.j, o['j'] ];", "");
+            expectSameOutcome ("var a = [ 1 ]; var result = a[0]++ + a[0];", "3");
+            expectSameOutcome ("var result = 'Hello World'.substring (1, 4) + 'abc'.charAt (2) + 'a,b'.split (',').length;", "");
+            expectSameOutcome ("var result = Math.max (3, Math.abs (-7), Math.floor (2.5)) + Math.round (Math.sqrt (16));", "11");
+            expectSameOutcome ("var result = JSON.stringify ({ a: [ 1, 'x' ] });", "");
+            expectSameOutcome ("var result = eval ('1 + 2');", "3");
+
+            expectSameOutcome ("var result = undefinedFunction();", "");
+            expectSameOutcome ("var result = 3; result();", "");
+            expectSameOutcome ("var a = 1; (a + 1) = 2;", "");
+            expectSameOutcome ("var s = 'x'; s.foo = 1;", "");
+            expectSameOutcome ("var result = {}; result.noSuchMethod();", "");
+        }
+
+        beginTest ("Timeouts");
+        {
+            for (auto useBytecode : { false, true })
+            {
+                JavascriptEngine engine;
+                engine.setBytecodeCompilationEnabled (useBytecode);
+                expect (engine.isBytecodeCompilationEnabled() == useBytecode);
+
+                engine.maximumExecutionTime = RelativeTime::milliseconds (50);
+                auto r = engine.execute ("while (true) {}");
+                expect (r.getErrorMessage().contains ("timed-out"));
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            struct Benchmark  { const char* name; const char* script; };
+
+            const Benchmark benchmarks[] =
+            {
+                { "fib (22)",            "function fib (n) { return n < 2 ? n : fib (n - 1) + fib (n - 2); } var result = fib (22);" },
+                { "Integer loop",        "var result = 0; for (var i = 0; i < 300000; ++i) { result += i % 7; }" },
+                { "Double arithmetic",   "var result = 0.0; for (var i = 0; i < 100000; ++i) { result = result * 0.5 + i / 3.0; }" },
+                { "Property read/write", "var o = { x: 1, y: 2 }; var result = 0; for (var i = 0; i < 200000; ++i) { o.x = o.x + o.y; result = o.x; }" },
+                { "Array fill and sum",  "var a = []; for (var i = 0; i < 50000; ++i) a.push (i * 2); var result = 0; for (var i = 0; i < a.length; ++i) result += a[i];" },
+                { "Method calls",        "var o = { v: 0, add: function (n) { this.v += n; } }; for (var i = 0; i < 50000; ++i) o.add (i); var result = o.v;" },
+                { "New objects",         "function P (x) { this.x = x; } var result = 0; for (var i = 0; i < 50000; ++i) { var p = new P (i); result += p.x; }" },
+                { "String building",     "var result = ''; for (var i = 0; i < 20000; ++i) result += i % 10;" }
+            };
+
+            for (auto& b : benchmarks)
+            {
+                double bestTimes[2];
+                String results[2];
+
+                for (auto useBytecode : { false, true })
+                {
+                    auto& best = bestTimes[useBytecode ? 1 : 0];
+                    best = std::numeric_limits<double>::max();
+
+                    for (int run = 0; run < 3; ++run)
+                    {
+                        JavascriptEngine engine;
+                        engine.setBytecodeCompilationEnabled (useBytecode);
+                        engine.maximumExecutionTime = RelativeTime::seconds (60);
+
+                        auto start = Time::getHighResolutionTicks();
+                        auto r = engine.execute (b.script);
+                        best = jmin (best, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0);
+
+                        results[useBytecode ? 1 : 0] = r.failed() ? r.getErrorMessage() : engine.evaluate ("result").toString();
+                    }
+                }
+
+                expectEquals (results[1], results[0]);
+
+                logMessage (String (b.name) + ": tree-walker " + String (bestTimes[0], 1) + " ms, bytecode "
+                              + String (bestTimes[1], 1) + " ms (" + String (bestTimes[0] / bestTimes[1], 2) + "x)");
+            }
+        }
+    }
+};
+
+static JavascriptEngineTests javascriptEngineTests;
+
+#endif
+
 } // namespace juce
@@ -108,6 +108,21 @@ public:
     /** When called from another thread, causes the interpreter to time-out as soon as possible */
     void stop() noexcept;
 
+    /** Enables or disables running scripts by compiling them to bytecode.
+
+        By default, the engine runs a script by walking its parsed expression tree. When
+        this is enabled, each script and function body is instead compiled to a compact
+        bytecode the first time it's run, and that's executed on a stack-based virtual machine,
+        which avoids most of the virtual calls and name lookups of the tree-walker.
+        Both modes should produce exactly the same results.
+    */
+    void setBytecodeCompilationEnabled (bool shouldCompileToBytecode) noexcept;
+
+    /** Returns true if scripts are compiled to bytecode.
+        @see setBytecodeCompilationEnabled
+    */
+    bool isBytecodeCompilationEnabled() const noexcept;
+
     /** Provides access to the set of properties of the root namespace object. */
     const NamedValueSet& getRootObjectProperties() const noexcept;
 
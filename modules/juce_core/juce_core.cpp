@@ -40,6 +40,14 @@
 #include <cctype>
 #include <cstdarg>
 
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_CORE_USE_SSE2 1
+ #include <emmintrin.h>
+#elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON)) && JUCE_LITTLE_ENDIAN
+ #define JUCE_CORE_USE_NEON 1
+ #include <arm_neon.h>
+#endif
+
 #if ! JUCE_ANDROID
  #include <sys/timeb.h>
  #include <cwctype>
@@ -176,6 +184,7 @@
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlPullParser.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -65,6 +65,13 @@ namespace SystemStatsHelpers
 
         a = la; b = lb; c = lc; d = ld;
     }
+
+    static uint64 doXGETBV()
+    {
+        uint32 lo = 0, hi = 0;
+        asm ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        return ((uint64) hi << 32) | lo;
+    }
    #endif
 }
 
@@ -86,6 +93,12 @@ void CPUInformation::initialise() noexcept
     hasSSE42 = (c & (1u << 20)) != 0;
     hasAVX   = (c & (1u << 28)) != 0;
 
+    // The AVX registers can only be used if the OS saves them on a context switch,
+    // which it reports through XCR0. XGETBV itself is only available if OSXSAVE is set.
+    const auto xcr0 = (c & (1u << 27)) != 0 ? SystemStatsHelpers::doXGETBV() : 0;
+    const auto osSavesAVXState    = (xcr0 & 0x06) == 0x06;
+    const auto osSavesAVX512State = (xcr0 & 0xe6) == 0xe6;
+
     SystemStatsHelpers::doCPUID (a, b, c, d, 0x80000001);
     hasFMA4  = (c & (1u << 16)) != 0;
 
@@ -101,6 +114,13 @@ void CPUInformation::initialise() noexcept
     hasAVX512VL        = (b & (1u << 31)) != 0;
     hasAVX512VBMI      = (c & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = (c & (1u << 14)) != 0;
+
+    if (! osSavesAVXState)
+        hasAVX = hasAVX2 = hasFMA3 = false;
+
+    if (! osSavesAVX512State)
+        hasAVX512F = hasAVX512DQ = hasAVX512IFMA = hasAVX512PF = hasAVX512ER = hasAVX512CD
+          = hasAVX512BW = hasAVX512VL = hasAVX512VBMI = hasAVX512VPOPCNTDQ = false;
    #endif
 
     numLogicalCPUs = (int) [[NSProcessInfo processInfo] activeProcessorCount];
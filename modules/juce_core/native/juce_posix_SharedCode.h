@@ -506,6 +506,42 @@ ssize_t FileOutputStream::writeInternal (const void* data, size_t numBytes)
     return (ssize_t) result;
 }
 
+bool FileOutputStream::setDirectFlag (bool shouldBeSet)
+{
+    if (fileHandle == nullptr)
+        return false;
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    auto fd = getFD (fileHandle);
+    auto flags = fcntl (fd, F_GETFL);
+
+    if (flags == -1)
+        return false;
+
+    auto newFlags = shouldBeSet ? (flags | O_DIRECT) : (flags & ~O_DIRECT);
+    return newFlags == flags || fcntl (fd, F_SETFL, newFlags) != -1;
+   #elif JUCE_MAC || JUCE_IOS
+    return fcntl (getFD (fileHandle), F_NOCACHE, shouldBeSet ? 1 : 0) != -1;
+   #else
+    return ! shouldBeSet;
+   #endif
+}
+
+bool FileOutputStream::preallocate (int64 totalNumBytes)
+{
+    if (fileHandle == nullptr || totalNumBytes <= 0)
+        return false;
+
+   #if JUCE_LINUX
+    return fallocate (getFD (fileHandle), FALLOC_FL_KEEP_SIZE, 0, (off_t) totalNumBytes) == 0;
+   #elif JUCE_MAC
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t) totalNumBytes, 0 };
+    return fcntl (getFD (fileHandle), F_PREALLOCATE, &store) != -1;
+   #else
+    return false;
+   #endif
+}
+
 #ifndef JUCE_ANDROID
 void FileOutputStream::flushInternal()
 {
@@ -356,6 +356,17 @@ ssize_t FileOutputStream::writeInternal (const void* bufferToWrite, size_t numBy
     return (ssize_t) actualNum;
 }
 
+bool FileOutputStream::setDirectFlag (bool shouldBeSet)
+{
+    // Unbuffered writes can only be chosen when a file is opened on Windows
+    return ! shouldBeSet;
+}
+
+bool FileOutputStream::preallocate (int64)
+{
+    return false;
+}
+
 void FileOutputStream::flushInternal()
 {
     if (fileHandle != nullptr)
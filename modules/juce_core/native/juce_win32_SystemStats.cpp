@@ -59,6 +59,13 @@ static void callCPUID (int result[4], uint32 type)
   result[0] = (int) la; result[1] = (int) lb;
   result[2] = (int) lc; result[3] = (int) ld;
 }
+
+static uint64 callXGETBV()
+{
+  uint32 lo = 0, hi = 0;
+  asm ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+  return ((uint64) hi << 32) | lo;
+}
 #else
 static void callCPUID (int result[4], int infoType)
 {
@@ -68,6 +75,15 @@ static void callCPUID (int result[4], int infoType)
     __cpuid (result, infoType);
    #endif
 }
+
+static uint64 callXGETBV()
+{
+   #if JUCE_PROJUCER_LIVE_BUILD
+    return 0;
+   #else
+    return (uint64) _xgetbv (0);
+   #endif
+}
 #endif
 
 String SystemStats::getCpuVendor()
@@ -152,6 +168,12 @@ void CPUInformation::initialise() noexcept
     hasSSE42 = (info[2] & (1 << 20)) != 0;
     has3DNow = (info[1] & (1 << 31)) != 0;
 
+    // The AVX registers can only be used if the OS saves them on a context switch,
+    // which it reports through XCR0. XGETBV itself is only available if OSXSAVE is set.
+    const auto xcr0 = (info[2] & (1 << 27)) != 0 ? callXGETBV() : 0;
+    const auto osSavesAVXState    = (xcr0 & 0x06) == 0x06;
+    const auto osSavesAVX512State = (xcr0 & 0xe6) == 0xe6;
+
     callCPUID (info, 0x80000001);
     hasFMA4  = (info[2] & (1 << 16)) != 0;
 
@@ -169,6 +191,13 @@ void CPUInformation::initialise() noexcept
     hasAVX512VBMI      = ((unsigned int) info[2] & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = ((unsigned int) info[2] & (1u << 14)) != 0;
 
+    if (! osSavesAVXState)
+        hasAVX = hasAVX2 = hasFMA3 = false;
+
+    if (! osSavesAVX512State)
+        hasAVX512F = hasAVX512DQ = hasAVX512IFMA = hasAVX512PF = hasAVX512ER = hasAVX512CD
+          = hasAVX512BW = hasAVX512VL = hasAVX512VBMI = hasAVX512VPOPCNTDQ = false;
+
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
     numLogicalCPUs  = (int) systemInfo.dwNumberOfProcessors;
@@ -174,6 +174,84 @@ juce_wchar CharacterFunctions::getUnicodeCharFromWindows1252Codepage (const uint
     return (juce_wchar) lookup[c - 0x80];
 }
 
+//==============================================================================
+#if JUCE_CORE_USE_SSE2 || JUCE_CORE_USE_NEON
+static int findLowestSetBit (uint64 n) noexcept
+{
+    jassert (n != 0);
+
+   #if JUCE_GCC || JUCE_CLANG
+    return __builtin_ctzll (n);
+   #else
+    unsigned long lowest;
+
+    if (_BitScanForward (&lowest, (unsigned long) n))
+        return (int) lowest;
+
+    _BitScanForward (&lowest, (unsigned long) (n >> 32));
+    return (int) lowest + 32;
+   #endif
+}
+#endif
+
+const char* CharacterFunctions::findFirstOf (const char* start, const char* end, const char* charsToFind) noexcept
+{
+    jassert (start <= end);
+
+    auto numChars = (int) strlen (charsToFind);
+    jassert (numChars > 0 && numChars <= 4);
+
+    char c[4];
+
+    // repeating the last character means that the SIMD loops can always check for four of them
+    for (int i = 0; i < 4; ++i)
+    {
+        c[i] = charsToFind[jmin (i, numChars - 1)];
+        jassert (c[i] > 0); // these must all be ASCII characters!
+    }
+
+   #if JUCE_CORE_USE_SSE2
+    auto c0 = _mm_set1_epi8 (c[0]), c1 = _mm_set1_epi8 (c[1]),
+         c2 = _mm_set1_epi8 (c[2]), c3 = _mm_set1_epi8 (c[3]);
+
+    for (; end - start >= 16; start += 16)
+    {
+        auto block = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (start));
+        auto matches = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (block, c0), _mm_cmpeq_epi8 (block, c1)),
+                                     _mm_or_si128 (_mm_cmpeq_epi8 (block, c2), _mm_cmpeq_epi8 (block, c3)));
+
+        if (auto mask = _mm_movemask_epi8 (matches))
+            return start + findLowestSetBit ((uint64) mask);
+    }
+   #elif JUCE_CORE_USE_NEON
+    auto c0 = vdupq_n_u8 ((uint8) c[0]), c1 = vdupq_n_u8 ((uint8) c[1]),
+         c2 = vdupq_n_u8 ((uint8) c[2]), c3 = vdupq_n_u8 ((uint8) c[3]);
+
+    for (; end - start >= 16; start += 16)
+    {
+        auto block = vld1q_u8 (reinterpret_cast<const uint8*> (start));
+        auto matches = vorrq_u8 (vorrq_u8 (vceqq_u8 (block, c0), vceqq_u8 (block, c1)),
+                                 vorrq_u8 (vceqq_u8 (block, c2), vceqq_u8 (block, c3)));
+
+        // there's no movemask on NEON, so narrow each byte of the result to 4 bits instead
+        auto mask = vget_lane_u64 (vreinterpret_u64_u8 (vshrn_n_u16 (vreinterpretq_u16_u8 (matches), 4)), 0);
+
+        if (mask != 0)
+            return start + (findLowestSetBit (mask) >> 2);
+    }
+   #endif
+
+    for (; start < end; ++start)
+    {
+        auto b = *start;
+
+        if (b == c[0] || b == c[1] || b == c[2] || b == c[3])
+            break;
+    }
+
+    return start;
+}
+
 
 //==============================================================================
 //==============================================================================
@@ -288,6 +366,31 @@ public:
                 expect (std::isinf (CharacterFunctions::readDoubleValue (charPtr)));
             }
         }
+
+        beginTest ("findFirstOf");
+        {
+            auto r = getRandom();
+            HeapBlock<char> text (100);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto length = r.nextInt (100);
+
+                for (int j = 0; j < length; ++j)
+                    text[j] = (char) (r.nextBool() ? 'a' + r.nextInt (26) : 1 + r.nextInt (255));
+
+                const char* charsToFind[] = { "<", "<&", "\"'\\", "<&]\r" };
+                auto* chars = charsToFind[r.nextInt (numElementsInArray (charsToFind))];
+                auto start = r.nextInt (length + 1);
+
+                auto* expected = text + start;
+
+                while (expected < text + length && strchr (chars, *expected) == nullptr)
+                    ++expected;
+
+                expect (CharacterFunctions::findFirstOf (text + start, text + length, chars) == expected);
+            }
+        }
     }
 };
 
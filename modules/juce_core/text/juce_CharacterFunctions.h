@@ -798,6 +798,20 @@ public:
         return text;
     }
 
+    /** Returns a pointer to the first byte in a block of text which matches any of the
+        given ASCII characters, or the end pointer if none of them are found.
+
+        This checks 16 bytes at a time using SSE2 or NEON where they're available, so it's
+        a quick way for a parser to skip over long runs of ordinary text. Because the
+        characters being searched for must be 7-bit ASCII, they can't be mistaken for part
+        of a multi-byte UTF-8 sequence, so the result will always be a character boundary.
+
+        @param start            the first byte to check
+        @param end              the end of the block, which doesn't need to be null-terminated
+        @param charsToFind      a null-terminated string of between 1 and 4 ASCII characters
+    */
+    static const char* findFirstOf (const char* start, const char* end, const char* charsToFind) noexcept;
+
 private:
     static double mulexp10 (double value, int exponent) noexcept;
 };
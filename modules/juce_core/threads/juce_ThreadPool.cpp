@@ -23,22 +23,48 @@
 namespace juce
 {
 
+// A list of jobs in the order in which they'll be run. A pool using Scheduling::sharedQueue
+// has just one of these, and a pool using Scheduling::workStealing has one per thread.
+struct ThreadPool::JobQueue
+{
+    JobQueue() = default;
+
+    CriticalSection lock;
+    Array<ThreadPoolJob*> jobs;
+    std::atomic<int> numWaitingJobs { 0 }; // the number of jobs in the list that aren't running
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JobQueue)
+};
+
 struct ThreadPool::ThreadPoolThread  : public Thread
 {
-    ThreadPoolThread (ThreadPool& p, size_t stackSize)
-       : Thread ("Pool", stackSize), pool (p)
+    ThreadPoolThread (ThreadPool& p, size_t stackSize, int queueIndexToUse)
+       : Thread ("Pool", stackSize), pool (p), queueIndex (queueIndexToUse)
     {
     }
 
     void run() override
     {
         while (! threadShouldExit())
+        {
             if (! pool.runNextJob (*this))
-                wait (500);
+            {
+                // Once this flag is set, addJob() may choose this thread to wake up, so
+                // the queues need checking again before going to sleep
+                isWaiting = true;
+
+                if (! pool.hasWaitingJobs())
+                    wait (500);
+
+                isWaiting = false;
+            }
+        }
     }
 
     std::atomic<ThreadPoolJob*> currentJob { nullptr };
+    std::atomic<bool> isWaiting { false };
     ThreadPool& pool;
+    const int queueIndex;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolThread)
 };
@@ -90,11 +116,11 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
 }
 
 //==============================================================================
-ThreadPool::ThreadPool (int numThreads, size_t threadStackSize)
+ThreadPool::ThreadPool (int numThreads, size_t threadStackSize, Scheduling scheduling)
 {
     jassert (numThreads > 0); // not much point having a pool without any threads!
 
-    createThreads (numThreads, threadStackSize);
+    createThreads (numThreads, threadStackSize, scheduling);
 }
 
 ThreadPool::ThreadPool()
@@ -108,10 +134,15 @@ ThreadPool::~ThreadPool()
     stopThreads();
 }
 
-void ThreadPool::createThreads (int numThreads, size_t threadStackSize)
+void ThreadPool::createThreads (int numThreads, size_t threadStackSize, Scheduling scheduling)
 {
-    for (int i = jmax (1, numThreads); --i >= 0;)
-        threads.add (new ThreadPoolThread (*this, threadStackSize));
+    numThreads = jmax (1, numThreads);
+
+    for (int i = (scheduling == Scheduling::workStealing ? numThreads : 1); --i >= 0;)
+        queues.add (new JobQueue());
+
+    for (int i = numThreads; --i >= 0;)
+        threads.add (new ThreadPoolThread (*this, threadStackSize, i % queues.size()));
 
     for (auto* t : threads)
         t->startThread();
@@ -138,16 +169,65 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
         job->isActive = false;
         job->shouldBeDeleted = deleteJobWhenFinished;
 
+        auto queueIndex = getQueueIndexForNewJob();
+        auto& queue = *queues.getUnchecked (queueIndex);
+
         {
-            const ScopedLock sl (lock);
-            jobs.add (job);
+            const ScopedLock sl (queue.lock);
+            queue.jobs.add (job);
+            ++queue.numWaitingJobs;
         }
 
+        wakeUpWaitingThread (queueIndex);
+    }
+}
+
+int ThreadPool::getQueueIndexForNewJob() noexcept
+{
+    if (queues.size() == 1)
+        return 0;
+
+    // Jobs that are added by another of this pool's jobs go onto that thread's own queue..
+    if (auto* t = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread()))
+        if (&t->pool == this)
+            return t->queueIndex;
+
+    // ..and all the others are shared out between the queues
+    return (int) (nextQueueIndex++ % (unsigned int) queues.size());
+}
+
+void ThreadPool::wakeUpWaitingThread (int queueIndex)
+{
+    // Any waiting thread could run the job, but one that owns the job's queue is preferred.
+    // Each thread is claimed by clearing its flag, so that if several jobs are added at once,
+    // they'll wake up different threads.
+    for (int pass = 0; pass < 2; ++pass)
+    {
         for (auto* t : threads)
-            t->notify();
+        {
+            if (pass == 0 && t->queueIndex != queueIndex)
+                continue;
+
+            auto expected = true;
+
+            if (t->isWaiting.compare_exchange_strong (expected, false))
+            {
+                t->notify();
+                return;
+            }
+        }
     }
 }
 
+bool ThreadPool::hasWaitingJobs() const noexcept
+{
+    for (auto* queue : queues)
+        if (queue->numWaitingJobs > 0)
+            return true;
+
+    return false;
+}
+
 void ThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
 {
     struct LambdaJobWrapper  : public ThreadPoolJob
@@ -176,8 +256,15 @@ void ThreadPool::addJob (std::function<void()> jobToRun)
 
 int ThreadPool::getNumJobs() const noexcept
 {
-    const ScopedLock sl (lock);
-    return jobs.size();
+    int numJobs = 0;
+
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
+        numJobs += queue->jobs.size();
+    }
+
+    return numJobs;
 }
 
 int ThreadPool::getNumThreads() const noexcept
@@ -187,30 +274,61 @@ int ThreadPool::getNumThreads() const noexcept
 
 ThreadPoolJob* ThreadPool::getJob (int index) const noexcept
 {
-    const ScopedLock sl (lock);
-    return jobs [index];
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
+
+        if (index < queue->jobs.size())
+            return queue->jobs [index];
+
+        index -= queue->jobs.size();
+    }
+
+    return nullptr;
 }
 
 bool ThreadPool::contains (const ThreadPoolJob* job) const noexcept
 {
-    const ScopedLock sl (lock);
-    return jobs.contains (const_cast<ThreadPoolJob*> (job));
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
+
+        if (queue->jobs.contains (const_cast<ThreadPoolJob*> (job)))
+            return true;
+    }
+
+    return false;
 }
 
 bool ThreadPool::isJobRunning (const ThreadPoolJob* job) const noexcept
 {
-    const ScopedLock sl (lock);
-    return jobs.contains (const_cast<ThreadPoolJob*> (job)) && job->isActive;
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
+
+        if (queue->jobs.contains (const_cast<ThreadPoolJob*> (job)))
+            return job->isActive;
+    }
+
+    return false;
 }
 
 void ThreadPool::moveJobToFront (const ThreadPoolJob* job) noexcept
 {
-    const ScopedLock sl (lock);
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
 
-    auto index = jobs.indexOf (const_cast<ThreadPoolJob*> (job));
+        auto index = queue->jobs.indexOf (const_cast<ThreadPoolJob*> (job));
 
-    if (index > 0 && ! job->isActive)
-        jobs.move (index, 0);
+        if (index >= 0)
+        {
+            if (index > 0 && ! job->isActive)
+                queue->jobs.move (index, 0);
+
+            return;
+        }
+    }
 }
 
 bool ThreadPool::waitForJobToFinish (const ThreadPoolJob* job, int timeOutMs) const
@@ -238,21 +356,27 @@ bool ThreadPool::removeJob (ThreadPoolJob* job, bool interruptIfRunning, int tim
 
     if (job != nullptr)
     {
-        const ScopedLock sl (lock);
-
-        if (jobs.contains (job))
+        for (auto* queue : queues)
         {
-            if (job->isActive)
-            {
-                if (interruptIfRunning)
-                    job->signalJobShouldExit();
+            const ScopedLock sl (queue->lock);
 
-                dontWait = false;
-            }
-            else
+            if (queue->jobs.contains (job))
             {
-                jobs.removeFirstMatchingValue (job);
-                addToDeleteList (deletionList, job);
+                if (job->isActive)
+                {
+                    if (interruptIfRunning)
+                        job->signalJobShouldExit();
+
+                    dontWait = false;
+                }
+                else
+                {
+                    queue->jobs.removeFirstMatchingValue (job);
+                    --queue->numWaitingJobs;
+                    addToDeleteList (deletionList, job);
+                }
+
+                break;
             }
         }
     }
@@ -268,12 +392,13 @@ bool ThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs,
     {
         OwnedArray<ThreadPoolJob> deletionList;
 
+        for (auto* queue : queues)
         {
-            const ScopedLock sl (lock);
+            const ScopedLock sl (queue->lock);
 
-            for (int i = jobs.size(); --i >= 0;)
+            for (int i = queue->jobs.size(); --i >= 0;)
             {
-                auto* job = jobs.getUnchecked(i);
+                auto* job = queue->jobs.getUnchecked(i);
 
                 if (selectedJobsToRemove == nullptr || selectedJobsToRemove->isJobSuitable (job))
                 {
@@ -286,7 +411,8 @@ bool ThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs,
                     }
                     else
                     {
-                        jobs.remove (i);
+                        queue->jobs.remove (i);
+                        --queue->numWaitingJobs;
                         addToDeleteList (deletionList, job);
                     }
                 }
@@ -321,11 +447,15 @@ bool ThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs,
 StringArray ThreadPool::getNamesOfAllJobs (bool onlyReturnActiveJobs) const
 {
     StringArray s;
-    const ScopedLock sl (lock);
 
-    for (auto* job : jobs)
-        if (job->isActive || ! onlyReturnActiveJobs)
-            s.add (job->getJobName());
+    for (auto* queue : queues)
+    {
+        const ScopedLock sl (queue->lock);
+
+        for (auto* job : queue->jobs)
+            if (job->isActive || ! onlyReturnActiveJobs)
+                s.add (job->getJobName());
+    }
 
     return s;
 }
@@ -341,28 +471,37 @@ bool ThreadPool::setThreadPriorities (int newPriority)
     return ok;
 }
 
-ThreadPoolJob* ThreadPool::pickNextJobToRun()
+ThreadPoolJob* ThreadPool::pickNextJobToRun (JobQueue& queue, bool stealFromBack)
 {
+    if (queue.numWaitingJobs == 0)
+        return nullptr;
+
     OwnedArray<ThreadPoolJob> deletionList;
 
     {
-        const ScopedLock sl (lock);
+        const ScopedLock sl (queue.lock);
 
-        for (int i = 0; i < jobs.size(); ++i)
+        for (int i = 0; i < queue.jobs.size(); ++i)
         {
-            if (auto* job = jobs[i])
+            auto index = stealFromBack ? queue.jobs.size() - 1 - i : i;
+
+            if (auto* job = queue.jobs[index])
             {
                 if (! job->isActive)
                 {
                     if (job->shouldStop)
                     {
-                        jobs.remove (i);
+                        // whichever end we're scanning from, the next job to check
+                        // will now be at the same value of i
+                        queue.jobs.remove (index);
+                        --queue.numWaitingJobs;
                         addToDeleteList (deletionList, job);
                         --i;
                         continue;
                     }
 
                     job->isActive = true;
+                    --queue.numWaitingJobs;
                     return job;
                 }
             }
@@ -374,50 +513,63 @@ ThreadPoolJob* ThreadPool::pickNextJobToRun()
 
 bool ThreadPool::runNextJob (ThreadPoolThread& thread)
 {
-    if (auto* job = pickNextJobToRun())
+    auto numQueues = queues.size();
+
+    // Try the thread's own queue first, and then look for something to steal from the others
+    for (int i = 0; i < numQueues; ++i)
     {
-        auto result = ThreadPoolJob::jobHasFinished;
-        thread.currentJob = job;
+        auto& queue = *queues.getUnchecked ((thread.queueIndex + i) % numQueues);
 
-        try
-        {
-            result = job->runJob();
-        }
-        catch (...)
+        if (auto* job = pickNextJobToRun (queue, i != 0))
         {
-            jassertfalse; // Your runJob() method mustn't throw any exceptions!
+            runJob (thread, queue, job);
+            return true;
         }
+    }
 
-        thread.currentJob = nullptr;
+    return false;
+}
 
-        OwnedArray<ThreadPoolJob> deletionList;
+void ThreadPool::runJob (ThreadPoolThread& thread, JobQueue& queue, ThreadPoolJob* job)
+{
+    auto result = ThreadPoolJob::jobHasFinished;
+    thread.currentJob = job;
+
+    try
+    {
+        result = job->runJob();
+    }
+    catch (...)
+    {
+        jassertfalse; // Your runJob() method mustn't throw any exceptions!
+    }
+
+    thread.currentJob = nullptr;
+
+    OwnedArray<ThreadPoolJob> deletionList;
 
+    {
+        const ScopedLock sl (queue.lock);
+
+        if (queue.jobs.contains (job))
         {
-            const ScopedLock sl (lock);
+            job->isActive = false;
 
-            if (jobs.contains (job))
+            if (result != ThreadPoolJob::jobNeedsRunningAgain || job->shouldStop)
             {
-                job->isActive = false;
-
-                if (result != ThreadPoolJob::jobNeedsRunningAgain || job->shouldStop)
-                {
-                    jobs.removeFirstMatchingValue (job);
-                    addToDeleteList (deletionList, job);
+                queue.jobs.removeFirstMatchingValue (job);
+                addToDeleteList (deletionList, job);
 
-                    jobFinishedSignal.signal();
-                }
-                else
-                {
-                    // move the job to the end of the queue if it wants another go
-                    jobs.move (jobs.indexOf (job), -1);
-                }
+                jobFinishedSignal.signal();
+            }
+            else
+            {
+                // move the job to the end of the queue if it wants another go
+                queue.jobs.move (queue.jobs.indexOf (job), -1);
+                ++queue.numWaitingJobs;
             }
         }
-
-        return true;
     }
-
-    return false;
 }
 
 void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, ThreadPoolJob* job) const
@@ -429,4 +581,186 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests  : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        for (auto scheduling : { ThreadPool::Scheduling::sharedQueue, ThreadPool::Scheduling::workStealing })
+        {
+            const String suffix (scheduling == ThreadPool::Scheduling::sharedQueue ? " (shared queue)" : " (work stealing)");
+
+            beginTest ("Every job is run once" + suffix);
+            {
+                ThreadPool pool (4, 0, scheduling);
+                std::atomic<int> numJobsRun { 0 };
+
+                for (int i = 0; i < 1000; ++i)
+                    pool.addJob ([&] { ++numJobsRun; });
+
+                expect (waitForAllJobs (pool));
+                expectEquals (numJobsRun.load(), 1000);
+            }
+
+            beginTest ("Jobs can add more jobs" + suffix);
+            {
+                ThreadPool pool (4, 0, scheduling);
+                std::atomic<int> numJobsRun { 0 };
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    pool.addJob ([&]
+                    {
+                        for (int j = 0; j < 10; ++j)
+                            pool.addJob ([&] { ++numJobsRun; });
+                    });
+                }
+
+                expect (waitForAllJobs (pool));
+                expectEquals (numJobsRun.load(), 1000);
+            }
+
+            beginTest ("Jobs can ask to be run again" + suffix);
+            {
+                ThreadPool pool (4, 0, scheduling);
+                std::atomic<int> numRuns { 0 };
+
+                std::function<ThreadPoolJob::JobStatus()> job = [&] { return ++numRuns < 10 ? ThreadPoolJob::jobNeedsRunningAgain
+                                                                                            : ThreadPoolJob::jobHasFinished; };
+                pool.addJob (std::move (job));
+
+                expect (waitForAllJobs (pool));
+                expectEquals (numRuns.load(), 10);
+            }
+
+            beginTest ("Queued jobs can be removed" + suffix);
+            {
+                ThreadPool pool (2, 0, scheduling);
+                WaitableEvent release;
+                std::atomic<int> numStarted { 0 };
+
+                // keep both threads busy, so that the next jobs stay in the queues
+                for (int i = 0; i < 2; ++i)
+                    pool.addJob ([&] { ++numStarted; release.wait (10000); });
+
+                while (numStarted < 2)
+                    Thread::sleep (1);
+
+                CountingJob jobA ("A"), jobB ("B"), jobC ("C");
+                pool.addJob (&jobA, false);
+                pool.addJob (&jobB, false);
+                pool.addJob (&jobC, false);
+
+                expectEquals (pool.getNumJobs(), 5);
+                expect (pool.contains (&jobB) && ! pool.isJobRunning (&jobB));
+                expect (pool.getNamesOfAllJobs (false).contains ("B"));
+
+                expect (pool.removeJob (&jobB, false, 0));
+                expect (! pool.contains (&jobB));
+
+                struct SelectC  : public ThreadPool::JobSelector
+                {
+                    bool isJobSuitable (ThreadPoolJob* job) override  { return job->getJobName() == "C"; }
+                };
+
+                SelectC selector;
+                expect (pool.removeAllJobs (false, 0, &selector));
+                expect (! pool.contains (&jobC));
+                expect (pool.contains (&jobA));
+
+                release.signal();
+                release.signal();
+
+                expect (waitForAllJobs (pool));
+                expectEquals (jobA.numRuns.load(), 1);
+                expectEquals (jobB.numRuns.load(), 0);
+                expectEquals (jobC.numRuns.load(), 0);
+            }
+        }
+
+        beginTest ("Contention benchmark");
+        {
+            constexpr int numJobs = 50000, numProducers = 4;
+
+            for (auto scheduling : { ThreadPool::Scheduling::sharedQueue, ThreadPool::Scheduling::workStealing })
+            {
+                ThreadPool pool (jmax (2, SystemStats::getNumCpus()), 0, scheduling);
+                std::atomic<int> numJobsRun { 0 };
+
+                const auto start = Time::getHighResolutionTicks();
+
+                OwnedArray<Thread> producers;
+
+                for (int i = 0; i < numProducers; ++i)
+                {
+                    struct Producer  : public Thread
+                    {
+                        Producer (ThreadPool& p, std::atomic<int>& c) : Thread ("Producer"), pool (p), counter (c) {}
+
+                        void run() override
+                        {
+                            for (int j = 0; j < numJobs / numProducers; ++j)
+                                pool.addJob ([this] { ++counter; });
+                        }
+
+                        ThreadPool& pool;
+                        std::atomic<int>& counter;
+                    };
+
+                    producers.add (new Producer (pool, numJobsRun))->startThread();
+                }
+
+                for (auto* p : producers)
+                    p->waitForThreadToExit (-1);
+
+                expect (waitForAllJobs (pool));
+                expectEquals (numJobsRun.load(), numJobs);
+
+                const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+                logMessage (String (scheduling == ThreadPool::Scheduling::sharedQueue ? "Shared queue:  " : "Work stealing: ")
+                              + String (roundToInt (numJobs / seconds)) + " jobs/s with "
+                              + String (pool.getNumThreads()) + " threads and "
+                              + String (numProducers) + " producers");
+            }
+        }
+    }
+
+private:
+    struct CountingJob  : public ThreadPoolJob
+    {
+        using ThreadPoolJob::ThreadPoolJob;
+        JobStatus runJob() override  { ++numRuns; return jobHasFinished; }
+
+        std::atomic<int> numRuns { 0 };
+    };
+
+    static bool waitForAllJobs (ThreadPool& pool)
+    {
+        const auto start = Time::getMillisecondCounter();
+
+        while (pool.getNumJobs() > 0)
+        {
+            if (Time::getMillisecondCounter() - start > 20000)
+                return false;
+
+            Thread::sleep (1);
+        }
+
+        return true;
+    }
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
@@ -156,6 +156,27 @@ class JUCE_API  ThreadPool
 {
 public:
     //==============================================================================
+    /** The ways in which a pool can hand out its jobs to its threads. */
+    enum class Scheduling
+    {
+        /** All the jobs are kept in a single queue, and each free thread takes the
+            next job from the front of it. Jobs are started in the order in which
+            they were added.
+        */
+        sharedQueue,
+
+        /** Each thread has its own queue. New jobs are spread across the queues (or
+            added to the current thread's queue if they're added by a job running in
+            this pool), and a thread that runs out of work will steal jobs from the
+            back of the other threads' queues.
+
+            This means that the threads rarely have to compete for the same lock, which
+            makes a big difference when there are lots of short jobs, but it also means
+            that jobs won't necessarily be started in the order in which they were added.
+        */
+        workStealing
+    };
+
     /** Creates a thread pool.
         Once you've created a pool, you can give it some jobs by calling addJob().
 
@@ -164,8 +185,11 @@ public:
         @param threadStackSize  the size of the stack of each thread. If this value
                                 is zero then the default stack size of the OS will
                                 be used.
+        @param scheduling       the way in which jobs are handed out to the threads
     */
-    ThreadPool (int numberOfThreads, size_t threadStackSize = 0);
+    ThreadPool (int numberOfThreads,
+                size_t threadStackSize = 0,
+                Scheduling scheduling = Scheduling::sharedQueue);
 
     /** Creates a thread pool with one thread per CPU core.
         Once you've created a pool, you can give it some jobs by calling addJob().
@@ -276,6 +300,7 @@ public:
 
         Note that this can be a very volatile list as jobs might be continuously getting shifted
         around in the list, and this method may return nullptr if the index is currently out-of-range.
+        If the pool uses Scheduling::workStealing, the jobs of each thread's queue are listed in turn.
     */
     ThreadPoolJob* getJob (int index) const noexcept;
 
@@ -301,6 +326,9 @@ public:
 
     /** If the given job is in the queue, this will move it to the front so that it
         is the next one to be executed.
+
+        If the pool uses Scheduling::workStealing, the job is moved to the front of
+        the queue that it was added to.
     */
     void moveJobToFront (const ThreadPoolJob* jobToMove) noexcept;
 
@@ -318,19 +346,24 @@ public:
 
 private:
     //==============================================================================
-    Array<ThreadPoolJob*> jobs;
+    struct JobQueue;
+    OwnedArray<JobQueue> queues;
+    std::atomic<unsigned int> nextQueueIndex { 0 };
 
     struct ThreadPoolThread;
     friend class ThreadPoolJob;
     OwnedArray<ThreadPoolThread> threads;
 
-    CriticalSection lock;
     WaitableEvent jobFinishedSignal;
 
     bool runNextJob (ThreadPoolThread&);
-    ThreadPoolJob* pickNextJobToRun();
+    ThreadPoolJob* pickNextJobToRun (JobQueue&, bool stealFromBack);
+    void runJob (ThreadPoolThread&, JobQueue&, ThreadPoolJob*);
+    int getQueueIndexForNewJob() noexcept;
+    void wakeUpWaitingThread (int queueIndex);
+    bool hasWaitingJobs() const noexcept;
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
-    void createThreads (int numThreads, size_t threadStackSize = 0);
+    void createThreads (int numThreads, size_t threadStackSize = 0, Scheduling = Scheduling::sharedQueue);
     void stopThreads();
 
     // Note that this method has changed, and no longer has a parameter to indicate
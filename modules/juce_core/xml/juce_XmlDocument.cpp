@@ -193,10 +193,27 @@ juce_wchar XmlDocument::readNextChar() noexcept
     return c;
 }
 
+// Returns the position of the next character in the input that's one of the given delimiters,
+// or the input's null terminator.
+String::CharPointerType XmlDocument::findEndOfPlainText (const char* delimiters) const noexcept
+{
+   #if JUCE_STRING_UTF_TYPE == 8
+    return String::CharPointerType (CharacterFunctions::findFirstOf (input.getAddress(), inputEnd.getAddress(), delimiters));
+   #else
+    auto p = input;
+
+    while (p != inputEnd && CharPointer_ASCII (delimiters).indexOf (*p) < 0)
+        ++p;
+
+    return p;
+   #endif
+}
+
 std::unique_ptr<XmlElement> XmlDocument::parseDocumentElement (String::CharPointerType textToParse,
                                                                bool onlyReadOuterDocumentElement)
 {
     input = textToParse;
+    inputEnd = textToParse.findTerminatingNull();
     errorOccurred = false;
     outOfData = false;
     needToLoadDTD = true;
@@ -358,6 +375,7 @@ void XmlDocument::readQuotedString (String& result)
         else
         {
             auto start = input;
+            input = findEndOfPlainText (quote == '"' ? "\"&" : "'&");
 
             for (;;)
             {
@@ -525,6 +543,7 @@ void XmlDocument::readChildElements (XmlElement& parent)
 
                 for (;;)
                 {
+                    input = findEndOfPlainText ("]");
                     auto c0 = *input;
 
                     if (c0 == 0)
@@ -598,16 +617,18 @@ void XmlDocument::readChildElements (XmlElement& parent)
 
                     if (entity.startsWithChar ('<') && entity [1] != 0)
                     {
-                        auto oldInput = input;
+                        auto oldInput = input, oldInputEnd = inputEnd;
                         auto oldOutOfData = outOfData;
 
                         input = entity.getCharPointer();
+                        inputEnd = input.findTerminatingNull();
                         outOfData = false;
 
                         while (auto* n = readNextElement (true))
                             childAppender.append (n);
 
                         input = oldInput;
+                        inputEnd = oldInputEnd;
                         outOfData = oldOutOfData;
                     }
                     else
@@ -618,30 +639,28 @@ void XmlDocument::readChildElements (XmlElement& parent)
                 }
                 else
                 {
-                    for (;; ++input)
+                    for (;;)
                     {
-                        auto nextChar = *input;
+                        // copy everything up to the next special character in one go..
+                        auto runStart = input;
+                        input = findEndOfPlainText ("<&\r");
 
-                        if (nextChar == '\r')
-                        {
-                            nextChar = '\n';
+                       #if JUCE_STRING_UTF_TYPE == 8
+                        textElementContent.write (runStart.getAddress(), (size_t) (input.getAddress() - runStart.getAddress()));
+                       #else
+                        for (auto p = runStart; p != input; ++p)
+                            textElementContent.appendUTF8Char (*p);
+                       #endif
 
-                            if (input[1] == '\n')
-                                continue;
-                        }
+                        for (auto p = runStart; p != input && ! contentShouldBeUsed; ++p)
+                            contentShouldBeUsed = ! CharacterFunctions::isWhitespace (*p);
 
-                        if (nextChar == '<' || nextChar == '&')
+                        if (*input != '\r')
                             break;
 
-                        if (nextChar == 0)
-                        {
-                            setLastError ("unmatched tags", false);
-                            outOfData = true;
-                            return;
-                        }
-
-                        textElementContent.appendUTF8Char (nextChar);
-                        contentShouldBeUsed = contentShouldBeUsed || ! CharacterFunctions::isWhitespace (nextChar);
+                        // ..and convert CR or CRLF line-endings to LF
+                        if (*++input != '\n')
+                            textElementContent.appendUTF8Char ('\n');
                     }
                 }
             }
@@ -150,7 +150,7 @@ public:
     //==============================================================================
 private:
     String originalText;
-    String::CharPointerType input { nullptr };
+    String::CharPointerType input { nullptr }, inputEnd { nullptr };
     bool outOfData = false, errorOccurred = false;
     String lastError, dtdText;
     StringArray tokenisedDTD;
@@ -163,6 +163,7 @@ private:
     bool parseDTD();
     void skipNextWhiteSpace();
     juce_wchar readNextChar() noexcept;
+    String::CharPointerType findEndOfPlainText (const char* delimiters) const noexcept;
     XmlElement* readNextElement (bool alsoParseSubElements);
     void readChildElements (XmlElement&);
     void readQuotedString (String&);
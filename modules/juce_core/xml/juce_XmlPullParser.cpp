@@ -0,0 +1,1021 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlPullParserHelpers
+{
+    static bool startsWith (const char* p, const char* end, const char* text) noexcept
+    {
+        for (; *text != 0; ++p, ++text)
+            if (p >= end || *p != *text)
+                return false;
+
+        return true;
+    }
+
+    // Returns the start of the first occurrence of some text, or the end pointer if it's not found
+    static const char* find (const char* p, const char* end, const char* text) noexcept
+    {
+        const char firstChar[] = { text[0], 0 };
+
+        for (;; ++p)
+        {
+            p = CharacterFunctions::findFirstOf (p, end, firstChar);
+
+            if (p == end || startsWith (p, end, text))
+                return p;
+        }
+    }
+
+    static const char* skipWhitespace (const char* p, const char* end) noexcept
+    {
+        while (p < end && CharacterFunctions::isWhitespace (*p))
+            ++p;
+
+        return p;
+    }
+
+    static const char* findEndOfName (const char* p, const char* end) noexcept
+    {
+        while (p < end)
+        {
+            if ((uint8) *p < 0x80)
+            {
+                if (! XmlIdentifierChars::isIdentifierChar ((juce_wchar) *p))
+                    break;
+
+                ++p;
+            }
+            else
+            {
+                // don't try to decode a multi-byte character that might run past the end of the data
+                if (end - p < 4)
+                    break;
+
+                CharPointer_UTF8 next (p);
+
+                if (! XmlIdentifierChars::isIdentifierChar (next.getAndAdvance()))
+                    break;
+
+                p = next.getAddress();
+            }
+        }
+
+        return p;
+    }
+
+    static bool equals (const char* start, const char* end, StringRef text) noexcept
+    {
+        auto t = text.text;
+
+        for (CharPointer_UTF8 p (start); p.getAddress() < end;)
+            if (p.getAndAdvance() != t.getAndAdvance())
+                return false;
+
+        return t.isEmpty();
+    }
+
+    static String makeString (const char* start, const char* end)
+    {
+        return String (CharPointer_UTF8 (start), CharPointer_UTF8 (end));
+    }
+
+    // Writes out the value of the entity at p, and returns the position after it.
+    // This behaves in the same way as XmlDocument::readEntity() does when there's no DTD.
+    static const char* expandEntity (const char* p, const char* end, MemoryOutputStream& out)
+    {
+        ++p; // skip the ampersand
+
+        struct { const char* name; char value; } static const standardEntities[] =
+        {
+            { "amp;", '&' }, { "quot;", '"' }, { "apos;", '\'' }, { "lt;", '<' }, { "gt;", '>' }
+        };
+
+        for (auto& e : standardEntities)
+        {
+            auto length = (int) strlen (e.name);
+
+            if (end - p >= length && CharacterFunctions::compareIgnoreCaseUpTo (CharPointer_UTF8 (p), CharPointer_ASCII (e.name), length) == 0)
+            {
+                out.writeByte (e.value);
+                return p + length;
+            }
+        }
+
+        if (p < end && *p == '#')
+        {
+            uint32 charCode = 0;
+            ++p;
+
+            if (p < end && (*p == 'x' || *p == 'X'))
+            {
+                ++p;
+
+                for (int numChars = 0; p < end && *p != ';' && numChars < 8; ++p, ++numChars)
+                {
+                    auto hexValue = CharacterFunctions::getHexDigitValue ((juce_wchar) *p);
+
+                    if (hexValue < 0)
+                        break;
+
+                    charCode = (charCode << 4) | (uint32) hexValue;
+                }
+            }
+            else if (p < end && CharacterFunctions::isDigit (*p))
+            {
+                for (int numChars = 0; p < end && CharacterFunctions::isDigit (*p) && numChars < 12; ++p, ++numChars)
+                    charCode = charCode * 10 + (uint32) (*p - '0');
+            }
+            else
+            {
+                out.writeByte ('&');
+                return p - 1;
+            }
+
+            if (p < end && *p == ';')
+                ++p;
+
+            if (charCode != 0)
+                out.appendUTF8Char ((juce_wchar) charCode);
+
+            return p;
+        }
+
+        auto closingSemiColon = find (p, end, ";");
+
+        if (closingSemiColon == end)
+        {
+            out.writeByte ('&');
+            return p;
+        }
+
+        // there's no DTD to look this up in, so just use its name, like XmlDocument does
+        out.write (p, (size_t) (closingSemiColon - p));
+        return closingSemiColon + 1;
+    }
+}
+
+//==============================================================================
+XmlPullParser::XmlPullParser (const File& file)
+    : mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
+{
+    if (mappedFile->getData() != nullptr)
+    {
+        setData (mappedFile->getData(), mappedFile->getSize());
+    }
+    else
+    {
+        mappedFile.reset();
+        file.loadFileAsData (loadedData);
+        setData (loadedData.getData(), loadedData.getSize());
+    }
+}
+
+XmlPullParser::XmlPullParser (const String& documentText)  : ownedText (documentText)
+{
+    setData (ownedText.toRawUTF8(), ownedText.getNumBytesAsUTF8());
+}
+
+XmlPullParser::XmlPullParser (const void* data, size_t numBytes)
+{
+    setData (data, numBytes);
+}
+
+XmlPullParser::~XmlPullParser() {}
+
+void XmlPullParser::setData (const void* data, size_t numBytes)
+{
+    auto* text = static_cast<const char*> (data);
+
+    if (numBytes >= 2 && (CharPointer_UTF16::isByteOrderMarkBigEndian (text)
+                           || CharPointer_UTF16::isByteOrderMarkLittleEndian (text)))
+    {
+        ownedText = String::createStringFromData (data, (int) numBytes);
+        text = ownedText.toRawUTF8();
+        numBytes = ownedText.getNumBytesAsUTF8();
+    }
+    else if (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (text))
+    {
+        text += 3;
+        numBytes -= 3;
+    }
+
+    input = text;
+    inputEnd = text + numBytes;
+}
+
+void XmlPullParser::setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept
+{
+    ignoreEmptyTextElements = shouldBeIgnored;
+}
+
+XmlPullParser::EventType XmlPullParser::setError (const String& message)
+{
+    lastError = message;
+    finished = true;
+    openElements.clearQuick();
+    attributes.clearQuick();
+    return currentEvent = endOfDocument;
+}
+
+//==============================================================================
+XmlPullParser::EventType XmlPullParser::next()
+{
+    using namespace XmlPullParserHelpers;
+
+    if (finished)
+        return currentEvent;
+
+    attributes.clearQuick();
+
+    if (currentEvent == startElement && currentElementIsEmpty)
+    {
+        currentElementIsEmpty = false;
+        return currentEvent = endElement;
+    }
+
+    if (currentEvent == endElement)
+    {
+        openElements.removeLast();
+
+        // nothing after the outer element's closing tag is part of the document
+        if (openElements.isEmpty())
+        {
+            finished = true;
+            return currentEvent = endOfDocument;
+        }
+    }
+
+    for (;;)
+    {
+        if (openElements.isEmpty())
+        {
+            input = skipWhitespace (input, inputEnd);
+
+            if (input == inputEnd)
+                return setError ("not enough input");
+
+            if (*input != '<')
+                return setError ("no outer element found");
+        }
+        else if (input == inputEnd)
+        {
+            return setError ("unmatched tags");
+        }
+        else if (*input != '<' || startsWith (input, inputEnd, "<!--"))
+        {
+            auto textStart = input;
+
+            if (! findEndOfText())
+                return currentEvent;
+
+            currentText = { textStart, input };
+            currentTextIsCData = false;
+
+            if (shouldSkipText (currentText))
+                continue;
+
+            return currentEvent = textElement;
+        }
+
+        if (startsWith (input, inputEnd, "<!--"))
+        {
+            input += 4;
+
+            if (! skipPast ("-->"))
+                return setError ("unterminated comment");
+
+            continue;
+        }
+
+        if (startsWith (input, inputEnd, "<?"))
+        {
+            input += 2;
+
+            if (! skipPast ("?>"))
+                return setError (openElements.isEmpty() ? "malformed header" : "unterminated processing instruction");
+
+            continue;
+        }
+
+        if (openElements.isEmpty())
+        {
+            if (startsWith (input, inputEnd, "<!DOCTYPE"))
+            {
+                input += 9;
+
+                for (int n = 1; n > 0; ++input)
+                {
+                    if (input == inputEnd)
+                        return setError ("malformed DTD");
+
+                    if (*input == '<')       ++n;
+                    else if (*input == '>')  --n;
+                }
+
+                continue;
+            }
+        }
+        else
+        {
+            if (startsWith (input, inputEnd, "<![CDATA["))
+            {
+                input += 9;
+                auto start = input;
+
+                if (! skipPast ("]]>"))
+                    return setError ("unterminated CDATA section");
+
+                currentText = { start, input - 3 };
+                currentTextIsCData = true;
+                return currentEvent = textElement;
+            }
+
+            if (startsWith (input, inputEnd, "</"))
+            {
+                // like XmlDocument, this doesn't check that the closing tag's name matches
+                if (! skipToEndOfTag())
+                    return setError ("unmatched tags");
+
+                return currentEvent = endElement;
+            }
+        }
+
+        return readOpeningTag();
+    }
+}
+
+XmlPullParser::EventType XmlPullParser::readOpeningTag()
+{
+    using namespace XmlPullParserHelpers;
+
+    // allow for a gap after the '<' before the tag name
+    input = skipWhitespace (input + 1, inputEnd);
+
+    auto nameStart = input;
+    input = findEndOfName (input, inputEnd);
+
+    if (input == nameStart)
+        return setError ("tag name missing");
+
+    openElements.add ({ nameStart, input });
+
+    for (;;)
+    {
+        input = skipWhitespace (input, inputEnd);
+
+        if (input == inputEnd)
+            return setError ("unmatched tags");
+
+        auto c = *input;
+
+        if (c == '/' && startsWith (input, inputEnd, "/>"))
+        {
+            input += 2;
+            currentElementIsEmpty = true;
+            return currentEvent = startElement;
+        }
+
+        if (c == '>')
+        {
+            ++input;
+            currentElementIsEmpty = false;
+            return currentEvent = startElement;
+        }
+
+        auto attNameStart = input;
+        auto attNameEnd = input = findEndOfName (input, inputEnd);
+
+        if (attNameEnd == attNameStart)
+        {
+            auto illegalChar = (inputEnd - input) >= 4 ? CharPointer_UTF8 (input).getAndAdvance() : (juce_wchar) (uint8) c;
+            return setError ("illegal character found in " + makeString (nameStart, openElements.getLast().end)
+                               + ": '" + String::charToString (illegalChar) + "'");
+        }
+
+        input = skipWhitespace (input, inputEnd);
+
+        if (input == inputEnd || *input != '=')
+            return setError ("expected '=' after attribute '" + makeString (attNameStart, attNameEnd) + "'");
+
+        input = skipWhitespace (input + 1, inputEnd);
+
+        if (input == inputEnd || (*input != '"' && *input != '\''))
+            return setError ("expected a quoted value for attribute '" + makeString (attNameStart, attNameEnd) + "'");
+
+        const char quote[] = { *input, 0 };
+        auto valueStart = ++input;
+        input = CharacterFunctions::findFirstOf (input, inputEnd, quote);
+
+        if (input == inputEnd)
+            return setError ("unmatched quotes");
+
+        attributes.add ({ { attNameStart, attNameEnd }, { valueStart, input } });
+        ++input;
+    }
+}
+
+// Moves the input to the '<' of the next tag that isn't a comment
+bool XmlPullParser::findEndOfText()
+{
+    for (;;)
+    {
+        input = CharacterFunctions::findFirstOf (input, inputEnd, "<");
+
+        if (input == inputEnd)
+        {
+            setError ("unmatched tags");
+            return false;
+        }
+
+        if (! XmlPullParserHelpers::startsWith (input, inputEnd, "<!--"))
+            return true;
+
+        input += 4;
+
+        if (! skipPast ("-->"))
+        {
+            setError ("unterminated comment");
+            return false;
+        }
+    }
+}
+
+bool XmlPullParser::skipPast (const char* terminator)
+{
+    auto found = XmlPullParserHelpers::find (input, inputEnd, terminator);
+
+    if (found == inputEnd)
+        return false;
+
+    input = found + strlen (terminator);
+    return true;
+}
+
+// Moves the input past the next '>' that isn't inside a quoted attribute value
+bool XmlPullParser::skipToEndOfTag()
+{
+    for (;;)
+    {
+        input = CharacterFunctions::findFirstOf (input, inputEnd, ">\"'");
+
+        if (input == inputEnd)
+            return false;
+
+        if (*input == '>')
+        {
+            ++input;
+            return true;
+        }
+
+        const char quote[] = { *input, 0 };
+        input = CharacterFunctions::findFirstOf (input + 1, inputEnd, quote);
+
+        if (input == inputEnd)
+            return false;
+
+        ++input;
+    }
+}
+
+//==============================================================================
+String XmlPullParser::getTagName() const
+{
+    jassert (currentEvent == startElement || currentEvent == endElement);
+
+    if (openElements.isEmpty())
+        return {};
+
+    auto& name = openElements.getReference (openElements.size() - 1);
+    return XmlPullParserHelpers::makeString (name.start, name.end);
+}
+
+bool XmlPullParser::hasTagName (StringRef possibleTagName) const noexcept
+{
+    jassert (currentEvent == startElement || currentEvent == endElement);
+
+    if (openElements.isEmpty())
+        return false;
+
+    auto& name = openElements.getReference (openElements.size() - 1);
+    return XmlPullParserHelpers::equals (name.start, name.end, possibleTagName);
+}
+
+String XmlPullParser::getAttributeName (int index) const
+{
+    if (isPositiveAndBelow (index, attributes.size()))
+    {
+        auto& name = attributes.getReference (index).name;
+        return XmlPullParserHelpers::makeString (name.start, name.end);
+    }
+
+    return {};
+}
+
+String XmlPullParser::getAttributeValue (int index) const
+{
+    if (isPositiveAndBelow (index, attributes.size()))
+        return decode (attributes.getReference (index).value, false);
+
+    return {};
+}
+
+const XmlPullParser::Attribute* XmlPullParser::findAttribute (StringRef attributeName) const noexcept
+{
+    for (auto& a : attributes)
+        if (XmlPullParserHelpers::equals (a.name.start, a.name.end, attributeName))
+            return &a;
+
+    return nullptr;
+}
+
+bool XmlPullParser::hasAttribute (StringRef attributeName) const noexcept
+{
+    return findAttribute (attributeName) != nullptr;
+}
+
+String XmlPullParser::getStringAttribute (StringRef attributeName, const String& defaultReturnValue) const
+{
+    if (auto* a = findAttribute (attributeName))
+        return decode (a->value, false);
+
+    return defaultReturnValue;
+}
+
+int XmlPullParser::getIntAttribute (StringRef attributeName, int defaultReturnValue) const
+{
+    if (auto* a = findAttribute (attributeName))
+        return decode (a->value, false).getIntValue();
+
+    return defaultReturnValue;
+}
+
+double XmlPullParser::getDoubleAttribute (StringRef attributeName, double defaultReturnValue) const
+{
+    if (auto* a = findAttribute (attributeName))
+        return decode (a->value, false).getDoubleValue();
+
+    return defaultReturnValue;
+}
+
+String XmlPullParser::getText() const
+{
+    jassert (currentEvent == textElement);
+
+    if (currentEvent != textElement)
+        return {};
+
+    if (currentTextIsCData)
+        return XmlPullParserHelpers::makeString (currentText.start, currentText.end);
+
+    return decode (currentText, true);
+}
+
+// Expands any entities, and for text, also removes comments and converts CR or CRLF to LF
+String XmlPullParser::decode (Span span, bool isText) const
+{
+    auto* specialChars = isText ? "&\r<" : "&";
+    auto* p = span.start;
+    auto* special = CharacterFunctions::findFirstOf (p, span.end, specialChars);
+
+    if (special == span.end)
+        return XmlPullParserHelpers::makeString (span.start, span.end);
+
+    MemoryOutputStream out ((size_t) (span.end - span.start));
+
+    for (;;)
+    {
+        out.write (p, (size_t) (special - p));
+        p = special;
+
+        if (p == span.end)
+            break;
+
+        if (*p == '\r')
+        {
+            if (++p == span.end || *p != '\n')
+                out.writeByte ('\n');
+        }
+        else if (*p == '<')
+        {
+            // the only tags that a block of text can contain are comments
+            p = XmlPullParserHelpers::find (p + 4, span.end, "-->") + 3;
+        }
+        else
+        {
+            p = XmlPullParserHelpers::expandEntity (p, span.end, out);
+        }
+
+        special = CharacterFunctions::findFirstOf (p, span.end, specialChars);
+    }
+
+    return out.toUTF8();
+}
+
+// Like XmlDocument, this always drops text that's just whitespace and comments, but text
+// that only contains whitespace entities is kept if empty text elements aren't being ignored
+bool XmlPullParser::shouldSkipText (Span span) const
+{
+    for (auto* p = span.start; p < span.end; ++p)
+    {
+        if (*p == '<')
+            p = XmlPullParserHelpers::find (p + 4, span.end, "-->") + 2;
+        else if (*p == '&')
+            return ignoreEmptyTextElements && ! decode (span, true).containsNonWhitespaceChars();
+        else if (! CharacterFunctions::isWhitespace (*p))
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+std::unique_ptr<XmlElement> XmlPullParser::readElement()
+{
+    if (currentEvent != startElement)
+    {
+        jassertfalse; // this can only be used when the parser is positioned at an opening tag
+        return {};
+    }
+
+    std::unique_ptr<XmlElement> element (createElement());
+
+    if (readChildElements (*element))
+        return element;
+
+    return {};
+}
+
+bool XmlPullParser::readChildElements (XmlElement& parent)
+{
+    LinkedListPointer<XmlElement>::Appender childAppender (parent.firstChildElement);
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case startElement:
+            {
+                auto* child = createElement();
+                childAppender.append (child);
+
+                if (! readChildElements (*child))
+                    return false;
+
+                break;
+            }
+
+            case textElement:
+                childAppender.append (XmlElement::createTextElement (getText()));
+                break;
+
+            case endElement:
+                return true;
+
+            case endOfDocument:
+            default:
+                return false;
+        }
+    }
+}
+
+XmlElement* XmlPullParser::createElement() const
+{
+    auto& name = openElements.getReference (openElements.size() - 1);
+
+   #if JUCE_STRING_UTF_TYPE == 8
+    auto* element = new XmlElement (String::CharPointerType (name.start), String::CharPointerType (name.end));
+   #else
+    auto* element = new XmlElement (XmlPullParserHelpers::makeString (name.start, name.end));
+   #endif
+
+    LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (element->attributes);
+
+    for (auto& a : attributes)
+    {
+       #if JUCE_STRING_UTF_TYPE == 8
+        auto* att = new XmlElement::XmlAttributeNode (String::CharPointerType (a.name.start), String::CharPointerType (a.name.end));
+        att->value = decode (a.value, false);
+       #else
+        auto* att = new XmlElement::XmlAttributeNode (Identifier (XmlPullParserHelpers::makeString (a.name.start, a.name.end)),
+                                                      decode (a.value, false));
+       #endif
+
+        attributeAppender.append (att);
+    }
+
+    return element;
+}
+
+void XmlPullParser::skipElement()
+{
+    using namespace XmlPullParserHelpers;
+
+    if (currentEvent != startElement)
+    {
+        jassertfalse; // this can only be used when the parser is positioned at an opening tag
+        return;
+    }
+
+    attributes.clearQuick();
+
+    if (! currentElementIsEmpty)
+    {
+        for (int nesting = 1; nesting > 0;)
+        {
+            input = CharacterFunctions::findFirstOf (input, inputEnd, "<");
+
+            if (input == inputEnd)
+            {
+                setError ("unmatched tags");
+                return;
+            }
+
+            if (startsWith (input, inputEnd, "<!--"))
+            {
+                input += 4;
+
+                if (! skipPast ("-->"))
+                {
+                    setError ("unterminated comment");
+                    return;
+                }
+            }
+            else if (startsWith (input, inputEnd, "<![CDATA["))
+            {
+                input += 9;
+
+                if (! skipPast ("]]>"))
+                {
+                    setError ("unterminated CDATA section");
+                    return;
+                }
+            }
+            else if (startsWith (input, inputEnd, "<?"))
+            {
+                input += 2;
+
+                if (! skipPast ("?>"))
+                {
+                    setError ("unterminated processing instruction");
+                    return;
+                }
+            }
+            else
+            {
+                auto isClosingTag = startsWith (input, inputEnd, "</");
+
+                if (! skipToEndOfTag())
+                {
+                    setError ("unmatched tags");
+                    return;
+                }
+
+                if (isClosingTag)
+                    --nesting;
+                else if (input[-2] != '/')
+                    ++nesting;
+            }
+        }
+    }
+
+    currentElementIsEmpty = false;
+    currentEvent = endElement;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlPullParserTests  : public UnitTest
+{
+public:
+    XmlPullParserTests()
+        : UnitTest ("XmlPullParser", UnitTestCategories::xml)
+    {}
+
+    static const char* const* getTestDocuments()
+    {
+        static const char* const documents[] =
+        {
+            "<a/>",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!-- header comment -->\n<a x=\"1\" y='two'>text</a>\n",
+            "<!DOCTYPE a [ <!ELEMENT a (#PCDATA)> ]><a>hello &amp; goodbye &lt;&gt;&quot;&apos;&#65;&#x42;</a>",
+            "<root>\r\n  <child name=\"a &amp; b\" value=\"&#x20AC;\"/>\r\n  <child>line 1\r\nline 2\rline 3</child>\r\n</root>",
+            "<root><![CDATA[some <cdata> & stuff]]><b>x<!-- a comment -->y</b>  <c  a = \"1\" /></root>",
+            "<r>\xc3\xa9\xe2\x82\xac\xf0\x9f\x8e\xb5<el a=\"\xe2\x82\xac\"/></r>",
+            "<r>  <a>  </a> &#32; <b> x </b>\n</r>",
+            "<r><a><b><c><d>deep</d></c></b></a><e f=\"&unknown;\">&unknown; &#0;</e></r>",
+            "<r a=\"1\" b=\"2\" c=\"3\"><?pi stuff?><x/><y></y>tail</r>",
+            nullptr
+        };
+
+        return documents;
+    }
+
+    void expectSameAsXmlDocument (const String& text, bool ignoreEmptyText)
+    {
+        XmlDocument doc (text);
+        doc.setEmptyTextElementsIgnored (ignoreEmptyText);
+        auto expected = doc.getDocumentElement();
+        expect (expected != nullptr, doc.getLastParseError());
+
+        XmlPullParser parser (text);
+        parser.setEmptyTextElementsIgnored (ignoreEmptyText);
+        expect (parser.next() == XmlPullParser::startElement);
+
+        auto actual = parser.readElement();
+        expect (actual != nullptr, parser.getLastParseError());
+
+        if (expected != nullptr && actual != nullptr)
+            expect (actual->isEquivalentTo (expected.get(), false),
+                    actual->toString() + " != " + expected->toString());
+
+        expect (parser.next() == XmlPullParser::endOfDocument);
+        expect (parser.getLastParseError().isEmpty());
+    }
+
+    void runTest() override
+    {
+        beginTest ("Reading elements");
+        {
+            for (auto* d = getTestDocuments(); *d != nullptr; ++d)
+            {
+                expectSameAsXmlDocument (String::fromUTF8 (*d), true);
+                expectSameAsXmlDocument (String::fromUTF8 (*d), false);
+            }
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 20; ++i)
+            {
+                XmlElement root ("root");
+                createRandomTree (r, root, 4);
+                expectSameAsXmlDocument (root.toString(), true);
+            }
+        }
+
+        beginTest ("Events");
+        {
+            XmlPullParser parser (String ("<a x=\"1&amp;2\" y=\"3.5\"><b/>text &amp; more<c z='7'>&lt;</c></a>"));
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.hasTagName ("a") && parser.getDepth() == 1);
+            expectEquals (parser.getNumAttributes(), 2);
+            expectEquals (parser.getAttributeName (0), String ("x"));
+            expectEquals (parser.getAttributeValue (0), String ("1&2"));
+            expectEquals (parser.getStringAttribute ("x"), String ("1&2"));
+            expectEquals (parser.getDoubleAttribute ("y"), 3.5);
+            expectEquals (parser.getIntAttribute ("missing", 9), 9);
+            expect (! parser.hasAttribute ("z"));
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.hasTagName ("b") && parser.getDepth() == 2);
+            expectEquals (parser.getNumAttributes(), 0);
+            expect (parser.next() == XmlPullParser::endElement);
+            expect (parser.hasTagName ("b"));
+
+            expect (parser.next() == XmlPullParser::textElement);
+            expectEquals (parser.getText(), String ("text & more"));
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expectEquals (parser.getTagName(), String ("c"));
+            expectEquals (parser.getIntAttribute ("z"), 7);
+            expect (parser.next() == XmlPullParser::textElement);
+            expectEquals (parser.getText(), String ("<"));
+            expect (parser.next() == XmlPullParser::endElement);
+            expectEquals (parser.getTagName(), String ("c"));
+
+            expect (parser.next() == XmlPullParser::endElement);
+            expect (parser.hasTagName ("a") && parser.getDepth() == 1);
+            expect (parser.next() == XmlPullParser::endOfDocument);
+            expect (parser.next() == XmlPullParser::endOfDocument);
+            expect (parser.getLastParseError().isEmpty());
+        }
+
+        beginTest ("Skipping elements");
+        {
+            XmlPullParser parser (String ("<a><b x=\"/>\"><c><![CDATA[</b>]]><!-- </b> --><d/></c></b><e/></a>"));
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.hasTagName ("b"));
+            parser.skipElement();
+            expect (parser.getCurrentEvent() == XmlPullParser::endElement);
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.hasTagName ("e"));
+            parser.skipElement();
+            expect (parser.next() == XmlPullParser::endElement);
+            expect (parser.hasTagName ("a"));
+            expect (parser.next() == XmlPullParser::endOfDocument);
+            expect (parser.getLastParseError().isEmpty());
+        }
+
+        beginTest ("Reading files");
+        {
+            auto r = getRandom();
+            XmlElement root ("root");
+            createRandomTree (r, root, 5);
+
+            TemporaryFile temp (".xml");
+            expect (temp.getFile().replaceWithText (root.toString()));
+
+            XmlPullParser parser (temp.getFile());
+            expect (parser.next() == XmlPullParser::startElement);
+            auto e = parser.readElement();
+            auto expected = parseXML (root.toString());
+            expect (e != nullptr && expected != nullptr && e->isEquivalentTo (expected.get(), false));
+
+            // a byte-order-mark should be skipped
+            MemoryOutputStream withBOM;
+            withBOM.writeByte ((char) CharPointer_UTF8::byteOrderMark1);
+            withBOM.writeByte ((char) CharPointer_UTF8::byteOrderMark2);
+            withBOM.writeByte ((char) CharPointer_UTF8::byteOrderMark3);
+            withBOM << "<a b=\"c\"/>";
+
+            XmlPullParser bomParser (withBOM.getData(), withBOM.getDataSize());
+            expect (bomParser.next() == XmlPullParser::startElement);
+            expectEquals (bomParser.getStringAttribute ("b"), String ("c"));
+        }
+
+        beginTest ("Errors");
+        {
+            const char* const badDocuments[] =
+            {
+                "", "   ", "text", "<a>", "<a><b></a>", "<a x=1/>", "<a x/>", "<a x=\"1/>",
+                "<a><!-- </a>", "<a><![CDATA[ </a>", "<>", "<a $=\"1\"/>", "<a>text"
+            };
+
+            for (auto* d : badDocuments)
+            {
+                XmlPullParser parser ((String (d)));
+
+                while (parser.next() != XmlPullParser::endOfDocument)
+                {}
+
+                expect (parser.getLastParseError().isNotEmpty(), d);
+
+                XmlPullParser elementParser ((String (d)));
+
+                if (elementParser.next() == XmlPullParser::startElement)
+                    expect (elementParser.readElement() == nullptr, d);
+            }
+        }
+    }
+
+    static String createRandomText (Random& r)
+    {
+        static const juce_wchar chars[] = { 'a', 'Z', '0', ' ', '\n', '&', '<', '>', '"', '\'', ';', '#', 0xe9, 0x20ac, 0x1f3b5 };
+
+        String s;
+
+        for (int i = r.nextInt (12); --i >= 0;)
+            s << String::charToString (chars[r.nextInt (numElementsInArray (chars))]);
+
+        return s;
+    }
+
+    static void createRandomTree (Random& r, XmlElement& parent, int depth)
+    {
+        for (int i = r.nextInt (4); --i >= 0;)
+            parent.setAttribute ("att" + String (i), createRandomText (r));
+
+        if (depth <= 0)
+            return;
+
+        for (int i = r.nextInt (5); --i >= 0;)
+        {
+            if (r.nextBool())
+                parent.addTextElement (createRandomText (r) + "x");
+            else
+                createRandomTree (r, *parent.createNewChildElement ("child" + String (r.nextInt (3))), depth - 1);
+        }
+    }
+};
+
+static XmlPullParserTests xmlPullParserTests;
+
+#endif
+
+} // namespace juce
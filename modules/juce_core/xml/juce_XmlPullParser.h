@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads through an XML document one item at a time, without building a tree of
+    XmlElement objects.
+
+    Each call to next() moves on to the next opening tag, closing tag or block of text,
+    which you can then inspect with methods such as getTagName(), getStringAttribute()
+    and getText(). When reading from a file, the file is memory-mapped, and the parser
+    only decodes the names and values that you actually ask for, so this can scan through
+    very large documents much more quickly than XmlDocument, and without needing to hold
+    the whole tree in memory.
+
+    When you reach an element that you'd rather deal with as a normal XmlElement, you can
+    call readElement() to parse just that element and its children, or skipElement() to
+    jump straight past it.
+
+    e.g.
+    @code
+    XmlPullParser parser (File ("session.xml"));
+
+    while (parser.next() != XmlPullParser::endOfDocument)
+    {
+        if (parser.getCurrentEvent() == XmlPullParser::startElement && parser.hasTagName ("TRACK"))
+        {
+            if (auto track = parser.readElement())
+                loadTrack (*track);
+        }
+    }
+
+    if (parser.getLastParseError().isNotEmpty())
+        ...
+    @endcode
+
+    The parser accepts the same syntax as XmlDocument, except that DTDs are skipped rather
+    than being used to expand any custom entities that they declare.
+
+    @see XmlDocument, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlPullParser
+{
+public:
+    //==============================================================================
+    /** Creates a parser that will read the given file.
+        The file is memory-mapped if possible, or else loaded into memory.
+    */
+    explicit XmlPullParser (const File& file);
+
+    /** Creates a parser that will read a copy of some XML text. */
+    explicit XmlPullParser (const String& documentText);
+
+    /** Creates a parser that will read a block of UTF-8 or UTF-16 data.
+        The data isn't copied, so it must remain valid for the lifetime of the parser.
+    */
+    XmlPullParser (const void* data, size_t numBytes);
+
+    /** Destructor. */
+    ~XmlPullParser();
+
+    //==============================================================================
+    /** The types of item that the parser can be positioned at. */
+    enum EventType
+    {
+        startElement,   /**< An element's opening tag. */
+        endElement,     /**< An element's closing tag. Empty elements such as <foo/> produce a
+                             startElement followed by an endElement. */
+        textElement,    /**< A block of text or a CDATA section. */
+        endOfDocument   /**< The end of the outer element has been reached, or an error has
+                             occurred, in which case getLastParseError() will describe it. */
+    };
+
+    /** Moves on to the next item in the document and returns its type. */
+    EventType next();
+
+    /** Returns the type of item that the parser is currently positioned at.
+        Before next() is called for the first time, this returns endOfDocument.
+    */
+    EventType getCurrentEvent() const noexcept              { return currentEvent; }
+
+    /** Returns the number of elements enclosing the current item, including the element
+        itself for startElement and endElement items. So the outer element has a depth of 1.
+    */
+    int getDepth() const noexcept                           { return openElements.size(); }
+
+    //==============================================================================
+    /** For a startElement or endElement item, returns the element's tag name. */
+    String getTagName() const;
+
+    /** For a startElement or endElement item, returns true if the element's tag name matches
+        the one given. This doesn't need to allocate a String to do the comparison.
+    */
+    bool hasTagName (StringRef possibleTagName) const noexcept;
+
+    /** For a startElement item, returns the number of attributes that the tag contains. */
+    int getNumAttributes() const noexcept                   { return attributes.size(); }
+
+    /** For a startElement item, returns the name of one of its attributes. */
+    String getAttributeName (int attributeIndex) const;
+
+    /** For a startElement item, returns the value of one of its attributes. */
+    String getAttributeValue (int attributeIndex) const;
+
+    /** For a startElement item, checks whether it has an attribute with the given name. */
+    bool hasAttribute (StringRef attributeName) const noexcept;
+
+    /** For a startElement item, returns the value of the named attribute, or the default
+        value if there's no such attribute.
+    */
+    String getStringAttribute (StringRef attributeName, const String& defaultReturnValue = {}) const;
+
+    /** For a startElement item, returns the value of the named attribute as an integer, or
+        the default value if there's no such attribute.
+        @see XmlElement::getIntAttribute
+    */
+    int getIntAttribute (StringRef attributeName, int defaultReturnValue = 0) const;
+
+    /** For a startElement item, returns the value of the named attribute as a double, or
+        the default value if there's no such attribute.
+        @see XmlElement::getDoubleAttribute
+    */
+    double getDoubleAttribute (StringRef attributeName, double defaultReturnValue = 0.0) const;
+
+    /** For a textElement item, returns its text, with any entities expanded. */
+    String getText() const;
+
+    //==============================================================================
+    /** When positioned at a startElement item, this parses the element and all of its
+        children into an XmlElement, and leaves the parser positioned at the element's
+        endElement item.
+        If there's a parse error, this returns nullptr.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+    /** When positioned at a startElement item, this skips over all of the element's
+        contents without decoding them, and leaves the parser positioned at the element's
+        endElement item.
+    */
+    void skipElement();
+
+    //==============================================================================
+    /** Returns a description of the error that stopped the parser, or an empty string if
+        there hasn't been one.
+    */
+    const String& getLastParseError() const noexcept        { return lastError; }
+
+    /** Sets a flag to change the treatment of empty text elements.
+
+        If this is true (the default state), then any text elements that contain only
+        whitespace characters will be skipped. If you need to catch whitespace-only text,
+        then you should set this to false before reading the document.
+    */
+    void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept;
+
+private:
+    //==============================================================================
+    struct Span
+    {
+        const char* start;
+        const char* end;
+    };
+
+    struct Attribute
+    {
+        Span name, value;
+    };
+
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    MemoryBlock loadedData;
+    String ownedText;
+
+    const char* input = nullptr;
+    const char* inputEnd = nullptr;
+    EventType currentEvent = endOfDocument;
+    Span currentText { nullptr, nullptr };
+    Array<Span> openElements;
+    Array<Attribute> attributes;
+    String lastError;
+    bool finished = false, currentElementIsEmpty = false;
+    bool currentTextIsCData = false, ignoreEmptyTextElements = true;
+
+    void setData (const void*, size_t);
+    EventType setError (const String&);
+    EventType readOpeningTag();
+    bool findEndOfText();
+    bool skipPast (const char* terminator);
+    bool skipToEndOfTag();
+    bool readChildElements (XmlElement&);
+    XmlElement* createElement() const;
+    const Attribute* findAttribute (StringRef) const noexcept;
+    bool shouldSkipText (Span) const;
+    String decode (Span, bool isText) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlPullParser)
+};
+
+} // namespace juce
@@ -34,7 +34,8 @@ public:
     explicit SharedObject (const Identifier& t) noexcept  : type (t) {}
 
     SharedObject (const SharedObject& other)
-        : ReferenceCountedObject(), type (other.type), properties (other.properties)
+        : ReferenceCountedObject(), type (other.type), properties (other.properties),
+          snapshotNode (other.snapshotNode)
     {
         for (auto* c : other.children)
         {
@@ -94,26 +95,54 @@ public:
             t->callListeners (listenerToExclude, fn);
     }
 
+    ValueTreeSnapshot::Node* getSnapshotNode()
+    {
+        if (snapshotNode == nullptr)
+        {
+            auto* node = new ValueTreeSnapshot::Node (type, properties);
+            node->children.ensureStorageAllocated (children.size());
+
+            for (auto* c : children)
+                node->children.add (c->getSnapshotNode());
+
+            snapshotNode = node;
+        }
+
+        return snapshotNode.get();
+    }
+
+    void invalidateSnapshots() noexcept
+    {
+        // a change here means that this node and all its parents will need new
+        // snapshots, but the snapshots of its children are still valid
+        for (auto* t = this; t != nullptr && t->snapshotNode != nullptr; t = t->parent)
+            t->snapshotNode = nullptr;
+    }
+
     void sendPropertyChangeMessage (const Identifier& property, ValueTree::Listener* listenerToExclude = nullptr)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (listenerToExclude, [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); });
     }
 
     void sendChildAddedMessage (ValueTree child)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreeChildAdded (tree, child); });
     }
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree, &child] (Listener& l) { l.valueTreeChildRemoved (tree, child, index); });
     }
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
+        invalidateSnapshots();
         ValueTree tree (*this);
         callListenersForAllParents (nullptr, [=, &tree] (Listener& l) { l.valueTreeChildOrderChanged (tree, oldIndex, newIndex); });
     }
@@ -570,6 +599,7 @@ public:
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent = nullptr;
+    ReferenceCountedObjectPtr<ValueTreeSnapshot::Node> snapshotNode;
 
     JUCE_LEAK_DETECTOR (SharedObject)
 };
@@ -667,6 +697,14 @@ ValueTree ValueTree::createCopy() const
     return {};
 }
 
+ValueTreeSnapshot ValueTree::createSnapshot() const
+{
+    if (object != nullptr)
+        return ValueTreeSnapshot (object->getSnapshotNode());
+
+    return {};
+}
+
 void ValueTree::copyPropertiesFrom (const ValueTree& source, UndoManager* undoManager)
 {
     jassert (object != nullptr || source.object == nullptr); // Trying to add properties to a null ValueTree will fail!
@@ -26,6 +26,8 @@
 namespace juce
 {
 
+class ValueTreeSnapshot;
+
 //==============================================================================
 /**
     A powerful tree structure that can be used to hold free-form data, and which can
@@ -176,6 +178,17 @@ public:
     /** Returns a deep copy of this tree and all its sub-trees. */
     ValueTree createCopy() const;
 
+    /** Returns an immutable snapshot of the current state of this tree and its sub-trees.
+
+        The snapshot can be read safely from other threads while this tree carries on
+        changing. Each node caches its snapshot until it's next modified, so this is
+        cheap to call, and snapshots taken before and after an edit share all the
+        sub-trees that weren't affected by it.
+
+        @see ValueTreeSnapshot, ValueTreeSnapshotPublisher
+    */
+    ValueTreeSnapshot createSnapshot() const;
+
     /** Overwrites all the properties in this tree with the properties of the source tree.
         Any properties that already exist will be updated; and new ones will be added, and
         any that are not present in the source tree will be removed.
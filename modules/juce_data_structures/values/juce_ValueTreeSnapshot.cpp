@@ -0,0 +1,463 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ValueTreeSnapshot::ValueTreeSnapshot() noexcept {}
+ValueTreeSnapshot::ValueTreeSnapshot (Node* n) noexcept  : node (n) {}
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTreeSnapshot& other) noexcept  : node (other.node) {}
+ValueTreeSnapshot::ValueTreeSnapshot (ValueTreeSnapshot&& other) noexcept  : node (std::move (other.node)) {}
+ValueTreeSnapshot::~ValueTreeSnapshot() {}
+
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (const ValueTreeSnapshot& other) noexcept
+{
+    node = other.node;
+    return *this;
+}
+
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (ValueTreeSnapshot&& other) noexcept
+{
+    node = std::move (other.node);
+    return *this;
+}
+
+bool ValueTreeSnapshot::operator== (const ValueTreeSnapshot& other) const noexcept     { return node == other.node; }
+bool ValueTreeSnapshot::operator!= (const ValueTreeSnapshot& other) const noexcept     { return node != other.node; }
+
+static bool areSnapshotNodesEquivalent (const ValueTreeSnapshot::Node& a, const ValueTreeSnapshot::Node& b)
+{
+    if (&a == &b)
+        return true;
+
+    if (a.type != b.type
+         || a.children.size() != b.children.size()
+         || a.properties != b.properties)
+        return false;
+
+    for (int i = 0; i < a.children.size(); ++i)
+        if (! areSnapshotNodesEquivalent (*a.children.getObjectPointerUnchecked (i),
+                                          *b.children.getObjectPointerUnchecked (i)))
+            return false;
+
+    return true;
+}
+
+bool ValueTreeSnapshot::isEquivalentTo (const ValueTreeSnapshot& other) const
+{
+    return node == other.node
+            || (node != nullptr && other.node != nullptr
+                 && areSnapshotNodesEquivalent (*node, *other.node));
+}
+
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier& typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+static const var& getNullSnapshotVarRef() noexcept
+{
+    static var nullVar;
+    return nullVar;
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier& name) const noexcept
+{
+    return node == nullptr ? getNullSnapshotVarRef() : node->properties[name];
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    return node == nullptr ? defaultReturnValue
+                           : node->properties.getWithDefault (name, defaultReturnValue);
+}
+
+const var* ValueTreeSnapshot::getPropertyPointer (const Identifier& name) const noexcept
+{
+    return node == nullptr ? nullptr : node->properties.getVarPointer (name);
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node == nullptr ? 0 : node->properties.size();
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (int index) const noexcept
+{
+    return node == nullptr ? Identifier() : node->properties.getName (index);
+}
+
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node == nullptr ? 0 : node->children.size();
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChild (int index) const noexcept
+{
+    if (node != nullptr)
+        if (auto* c = node->children.getObjectPointer (index))
+            return ValueTreeSnapshot (c);
+
+    return {};
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithName (const Identifier& typeToMatch) const noexcept
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->type == typeToMatch)
+                return ValueTreeSnapshot (c);
+
+    return {};
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->properties[propertyName] == propertyValue)
+                return ValueTreeSnapshot (c);
+
+    return {};
+}
+
+ValueTree ValueTreeSnapshot::createValueTree() const
+{
+    if (node == nullptr)
+        return {};
+
+    ValueTree v (node->type);
+
+    for (int i = 0; i < node->properties.size(); ++i)
+        v.setProperty (node->properties.getName (i), node->properties.getValueAt (i), nullptr);
+
+    for (auto* c : node->children)
+        v.appendChild (ValueTreeSnapshot (c).createValueTree(), nullptr);
+
+    return v;
+}
+
+std::unique_ptr<XmlElement> ValueTreeSnapshot::createXml() const
+{
+    if (node == nullptr)
+        return {};
+
+    auto xml = std::make_unique<XmlElement> (node->type);
+    node->properties.copyToXmlAttributes (*xml);
+
+    // (NB: it's faster to add nodes to XML elements in reverse order)
+    for (auto i = node->children.size(); --i >= 0;)
+        xml->prependChildElement (ValueTreeSnapshot (node->children.getObjectPointerUnchecked (i)).createXml().release());
+
+    return xml;
+}
+
+//==============================================================================
+ValueTreeSnapshotPublisher::ValueTreeSnapshotPublisher (const ValueTree& treeToPublish)
+    : tree (treeToPublish)
+{
+    tree.addListener (this);
+    publish();
+}
+
+ValueTreeSnapshotPublisher::~ValueTreeSnapshotPublisher()
+{
+    tree.removeListener (this);
+    cancelPendingUpdate();
+
+    // If this fails, another thread is still in the middle of calling getSnapshot()
+    jassert (numReaders.load() == 0);
+}
+
+ValueTreeSnapshot ValueTreeSnapshotPublisher::getSnapshot() const noexcept
+{
+    // While numReaders is non-zero, the publisher won't release any of its snapshots,
+    // so the node can't be deleted in between loading the pointer and taking a reference to it.
+    ++numReaders;
+    ValueTreeSnapshot snapshot (latest.load());
+    --numReaders;
+
+    return snapshot;
+}
+
+void ValueTreeSnapshotPublisher::publish()
+{
+    auto snapshot = tree.createSnapshot();
+
+    if (snapshot.node.get() == latest.load())
+        return;
+
+    published.add (snapshot);
+    latest = snapshot.node.get();
+    ++numPublished;
+
+    releaseUnusedSnapshots();
+}
+
+void ValueTreeSnapshotPublisher::releaseUnusedSnapshots()
+{
+    // Once the latest pointer has been swapped and there are no readers in the middle of
+    // getSnapshot(), any reader that's still using an old snapshot must be holding its own
+    // reference to it. So any old snapshots that we hold the only reference to can go.
+    if (numReaders.load() != 0)
+        return;
+
+    for (int i = published.size() - 1; --i >= 0;)
+        if (published.getReference (i).node->getReferenceCount() == 1)
+            published.remove (i);
+}
+
+void ValueTreeSnapshotPublisher::handleAsyncUpdate()
+{
+    publish();
+}
+
+void ValueTreeSnapshotPublisher::valueTreePropertyChanged (ValueTree&, const Identifier&)    { triggerAsyncUpdate(); }
+void ValueTreeSnapshotPublisher::valueTreeChildAdded (ValueTree&, ValueTree&)                { triggerAsyncUpdate(); }
+void ValueTreeSnapshotPublisher::valueTreeChildRemoved (ValueTree&, ValueTree&, int)         { triggerAsyncUpdate(); }
+void ValueTreeSnapshotPublisher::valueTreeChildOrderChanged (ValueTree&, int, int)           { triggerAsyncUpdate(); }
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSnapshotTests  : public UnitTest
+{
+public:
+    ValueTreeSnapshotTests()
+        : UnitTest ("ValueTreeSnapshots", UnitTestCategories::values)
+    {}
+
+    static ValueTree createTestTree()
+    {
+        return ValueTree ("root", { { "name", "test" } },
+                          {
+                              ValueTree ("a", { { "value", 1 } }, { ValueTree ("a1"), ValueTree ("a2") }),
+                              ValueTree ("b", { { "value", 2 } }, { ValueTree ("b1") })
+                          });
+    }
+
+    struct ReaderThread  : public Thread
+    {
+        ReaderThread (ValueTreeSnapshotPublisher& p)  : Thread ("ValueTreeSnapshot reader"), publisher (p) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                auto snapshot = publisher.getSnapshot();
+
+                if (snapshot["a"] != snapshot["b"])
+                    ++numInconsistent;
+
+                ++numReads;
+            }
+        }
+
+        ValueTreeSnapshotPublisher& publisher;
+        int numInconsistent = 0, numReads = 0;
+    };
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser;
+
+        beginTest ("Snapshots don't change when the tree does");
+        {
+            auto tree = createTestTree();
+            auto snapshot = tree.createSnapshot();
+
+            expect (snapshot.isValid());
+            expect (snapshot.hasType ("root"));
+            expectEquals (snapshot["name"].toString(), String ("test"));
+            expectEquals (snapshot.getNumChildren(), 2);
+            expect (snapshot.getChildWithName ("b").getChild (0).hasType ("b1"));
+            expect (snapshot.getChildWithProperty ("value", 2).hasType ("b"));
+            expect (! snapshot.getChild (2).isValid());
+
+            tree.setProperty ("name", "changed", nullptr);
+            tree.getChild (0).removeChild (0, nullptr);
+            tree.appendChild (ValueTree ("c"), nullptr);
+
+            expectEquals (snapshot["name"].toString(), String ("test"));
+            expectEquals (snapshot.getNumChildren(), 2);
+            expectEquals (snapshot.getChild (0).getNumChildren(), 2);
+
+            auto newSnapshot = tree.createSnapshot();
+            expectEquals (newSnapshot["name"].toString(), String ("changed"));
+            expectEquals (newSnapshot.getNumChildren(), 3);
+            expectEquals (newSnapshot.getChild (0).getNumChildren(), 1);
+
+            expect (! ValueTreeSnapshot().isValid());
+            expect (! ValueTree().createSnapshot().isValid());
+        }
+
+        beginTest ("Unchanged sub-trees are shared between snapshots");
+        {
+            auto tree = createTestTree();
+            auto snapshot1 = tree.createSnapshot();
+
+            expect (tree.createSnapshot() == snapshot1);
+
+            tree.getChild (0).getChild (1).setProperty ("x", 1, nullptr);
+            auto snapshot2 = tree.createSnapshot();
+
+            expect (snapshot2 != snapshot1);
+            expect (snapshot2.getChild (0) != snapshot1.getChild (0));
+            expect (snapshot2.getChild (0).getChild (0) == snapshot1.getChild (0).getChild (0));
+            expect (snapshot2.getChild (0).getChild (1) != snapshot1.getChild (0).getChild (1));
+            expect (snapshot2.getChild (1) == snapshot1.getChild (1));
+
+            tree.getChild (1).setProperty ("value", 2, nullptr);
+            expect (tree.createSnapshot() == snapshot2);
+
+            auto copy = tree.createCopy();
+            expect (copy.createSnapshot() == snapshot2);
+
+            copy.setProperty ("name", "copy", nullptr);
+            expect (copy.createSnapshot().getChild (1) == snapshot2.getChild (1));
+            expect (tree.createSnapshot() == snapshot2);
+        }
+
+        beginTest ("Snapshots follow undo and redo");
+        {
+            UndoManager undoManager;
+            auto tree = createTestTree();
+            auto original = tree.createSnapshot();
+
+            undoManager.beginNewTransaction();
+            tree.setProperty ("name", "changed", &undoManager);
+            tree.getChild (1).appendChild (ValueTree ("b2"), &undoManager);
+            tree.moveChild (0, 1, &undoManager);
+
+            auto changed = tree.createSnapshot();
+            expect (! changed.isEquivalentTo (original));
+            expect (changed.getChild (0).hasType ("b"));
+            expectEquals (changed.getChild (0).getNumChildren(), 2);
+
+            undoManager.undo();
+            expect (tree.createSnapshot().isEquivalentTo (original));
+
+            undoManager.redo();
+            expect (tree.createSnapshot().isEquivalentTo (changed));
+        }
+
+        beginTest ("Snapshots match the tree after random edits");
+        {
+            auto r = getRandom();
+            auto tree = createTestTree();
+            Array<ValueTree> nodes;
+
+            for (int i = 0; i < 500; ++i)
+            {
+                nodes.clearQuick();
+                nodes.add (tree);
+
+                for (int j = 0; j < nodes.size(); ++j)
+                    for (const auto& child : nodes.getReference (j))
+                        nodes.add (child);
+
+                auto node = nodes[r.nextInt (nodes.size())];
+
+                switch (r.nextInt (4))
+                {
+                    case 0:  node.setProperty ("p" + String (r.nextInt (4)), r.nextInt (100), nullptr); break;
+                    case 1:  node.appendChild (ValueTree ("n" + String (r.nextInt (4))), nullptr); break;
+                    case 2:  if (node.getNumChildren() > 0) node.removeChild (r.nextInt (node.getNumChildren()), nullptr); break;
+                    case 3:  if (node.getNumChildren() > 1) node.moveChild (0, node.getNumChildren() - 1, nullptr); break;
+                    default: break;
+                }
+
+                if (r.nextInt (10) == 0)
+                {
+                    auto snapshot = tree.createSnapshot();
+                    expect (snapshot.createValueTree().isEquivalentTo (tree));
+                    expect (snapshot.createXml()->isEquivalentTo (tree.createXml().get(), false));
+                }
+            }
+        }
+
+        beginTest ("Publisher hands out the latest snapshot");
+        {
+            auto tree = createTestTree();
+            ValueTreeSnapshotPublisher publisher (tree);
+
+            auto first = publisher.getSnapshot();
+            expect (first == tree.createSnapshot());
+            expectEquals ((int) publisher.getNumPublished(), 1);
+
+            publisher.publish();
+            expectEquals ((int) publisher.getNumPublished(), 1);
+
+            tree.setProperty ("name", "changed", nullptr);
+            publisher.publish();
+
+            expectEquals ((int) publisher.getNumPublished(), 2);
+            expectEquals (publisher.getSnapshot()["name"].toString(), String ("changed"));
+            expectEquals (first["name"].toString(), String ("test"));
+        }
+
+        beginTest ("Publisher can be read from other threads");
+        {
+            ValueTree tree ("root", { { "a", 0 }, { "b", 0 } }, {});
+            ValueTreeSnapshotPublisher publisher (tree);
+            ReaderThread reader (publisher);
+            reader.startThread();
+
+            for (int i = 1; i <= 2000; ++i)
+            {
+                tree.setProperty ("a", i, nullptr);
+                tree.setProperty ("b", i, nullptr);
+                publisher.publish();
+
+                if ((i & 63) == 0)
+                    Thread::yield();
+            }
+
+            reader.stopThread (5000);
+
+            expectEquals (reader.numInconsistent, 0);
+            expect (reader.numReads > 0);
+            expectEquals ((int) publisher.getSnapshot()["a"], 2000);
+        }
+    }
+};
+
+static ValueTreeSnapshotTests valueTreeSnapshotTests;
+
+#endif
+
+} // namespace juce
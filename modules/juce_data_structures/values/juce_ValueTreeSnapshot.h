@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An immutable, read-only copy of the state of a ValueTree.
+
+    You get a snapshot by calling ValueTree::createSnapshot(). Once it's been created,
+    a snapshot never changes, so unlike a ValueTree it can safely be read from any thread
+    while the original tree carries on being edited on the message thread.
+
+    Snapshots are cheap to make. Each node of a ValueTree caches the snapshot of its
+    state, and an edit only throws away the cached snapshots of the node that changed
+    and its parents. So after a single change, making a new snapshot of the whole tree
+    only needs a new copy of the nodes on the path from the change up to the root, and
+    every other sub-tree is shared with the previous snapshot.
+
+    Note that the properties are shared between snapshots and the tree they came from,
+    so if you've stored objects inside var properties and you modify those objects in
+    place, the changes will be visible to other threads.
+
+    To pass snapshots from the message thread to other threads, use a
+    ValueTreeSnapshotPublisher.
+
+    @see ValueTree::createSnapshot, ValueTreeSnapshotPublisher
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshot
+{
+public:
+    //==============================================================================
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept;
+
+    /** Creates a reference to the same snapshot as another one. */
+    ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept;
+
+    /** Moves a snapshot. */
+    ValueTreeSnapshot (ValueTreeSnapshot&&) noexcept;
+
+    /** Makes this object refer to the same snapshot as another one. */
+    ValueTreeSnapshot& operator= (const ValueTreeSnapshot&) noexcept;
+
+    /** Moves a snapshot. */
+    ValueTreeSnapshot& operator= (ValueTreeSnapshot&&) noexcept;
+
+    /** Destructor. */
+    ~ValueTreeSnapshot();
+
+    //==============================================================================
+    /** Returns true if both snapshots refer to the same shared node.
+        Because unchanged sub-trees are shared between snapshots, you can use this to
+        quickly find out whether a part of the tree has changed between two snapshots.
+        @see isEquivalentTo
+    */
+    bool operator== (const ValueTreeSnapshot&) const noexcept;
+
+    /** Returns true if the snapshots refer to different nodes.
+        @see isEquivalentTo
+    */
+    bool operator!= (const ValueTreeSnapshot&) const noexcept;
+
+    /** Performs a deep comparison between the properties and children of two snapshots. */
+    bool isEquivalentTo (const ValueTreeSnapshot&) const;
+
+    /** Returns true if this snapshot contains some valid data. */
+    bool isValid() const noexcept                           { return node != nullptr; }
+
+    //==============================================================================
+    /** Returns the type of the tree that this snapshot was taken from. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if the tree has this type. */
+    bool hasType (const Identifier& typeName) const noexcept;
+
+    //==============================================================================
+    /** Returns the value of a named property.
+        If no such property has been set, this will return a void variant.
+    */
+    const var& getProperty (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property, or the value of defaultReturnValue
+        if the property doesn't exist.
+    */
+    var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+    /** Returns a pointer to the value of a named property, or nullptr if the property
+        doesn't exist.
+    */
+    const var* getPropertyPointer (const Identifier& name) const noexcept;
+
+    /** Returns the value of a named property. */
+    const var& operator[] (const Identifier& name) const noexcept     { return getProperty (name); }
+
+    /** Returns true if the tree contains a named property. */
+    bool hasProperty (const Identifier& name) const noexcept;
+
+    /** Returns the total number of properties that the tree contains. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the identifier of the property with a given index. */
+    Identifier getPropertyName (int index) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of child trees inside this one. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of the snapshot's child nodes, or an invalid snapshot if the index
+        is out of range.
+    */
+    ValueTreeSnapshot getChild (int index) const noexcept;
+
+    /** Returns the first child node with the specified type name, or an invalid
+        snapshot if there isn't one.
+    */
+    ValueTreeSnapshot getChildWithName (const Identifier& type) const noexcept;
+
+    /** Looks for the first child node that has the specified property value, or
+        returns an invalid snapshot if there isn't one.
+    */
+    ValueTreeSnapshot getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
+
+    //==============================================================================
+    /** Creates a new, independent ValueTree containing a deep copy of the snapshot. */
+    ValueTree createValueTree() const;
+
+    /** Creates an XmlElement that holds a complete image of the snapshot. */
+    std::unique_ptr<XmlElement> createXml() const;
+
+    //==============================================================================
+    /** @internal */
+    struct Node  : public ReferenceCountedObject
+    {
+        Node (const Identifier& t, const NamedValueSet& p) : type (t), properties (p) {}
+
+        const Identifier type;
+        const NamedValueSet properties;
+        ReferenceCountedArray<Node> children;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
+    };
+
+    /** @internal */
+    explicit ValueTreeSnapshot (Node*) noexcept;
+
+private:
+    //==============================================================================
+    ReferenceCountedObjectPtr<Node> node;
+
+    friend class ValueTreeSnapshotPublisher;
+};
+
+//==============================================================================
+/**
+    Publishes snapshots of a ValueTree, so that other threads can read its state.
+
+    The publisher listens to a tree, and whenever it changes, it takes a new
+    snapshot of it on the message thread. Any thread can then call getSnapshot()
+    to get hold of the latest one. getSnapshot() is wait-free, and doesn't allocate
+    or free any memory, so it's safe to call from the audio thread.
+
+    The publisher also makes sure that the snapshots it hands out are only ever
+    deleted on the message thread, as long as the snapshot returned by getSnapshot()
+    outlives any of the child snapshots that you get from it. For the same reason,
+    it's best to read properties through the const references that the snapshot
+    returns, rather than keeping copies of them.
+
+    @code
+    // on the message thread..
+    ValueTreeSnapshotPublisher publisher (state);
+
+    // on the audio thread..
+    auto snapshot = publisher.getSnapshot();
+    auto gain = (float) snapshot.getChildWithName ("Mixer")["gain"];
+    @endcode
+
+    @see ValueTreeSnapshot, ValueTree::createSnapshot
+
+    @tags{DataStructures}
+*/
+class JUCE_API  ValueTreeSnapshotPublisher  : private ValueTree::Listener,
+                                              private AsyncUpdater
+{
+public:
+    /** Creates a publisher for the given tree, and publishes its current state. */
+    explicit ValueTreeSnapshotPublisher (const ValueTree& treeToPublish);
+
+    /** Destructor.
+        Make sure that no other threads are still calling getSnapshot() when this is deleted.
+    */
+    ~ValueTreeSnapshotPublisher() override;
+
+    /** Returns the most recently published snapshot.
+        This can be called from any thread.
+    */
+    ValueTreeSnapshot getSnapshot() const noexcept;
+
+    /** Immediately publishes a snapshot of the tree's current state.
+
+        When the tree changes, the publisher will call this asynchronously, so you'll only
+        need to call it yourself if you need a change to be visible to other threads
+        straight away. Like any other access to the tree, it must only be called on the
+        message thread.
+    */
+    void publish();
+
+    /** Returns the number of times that a new snapshot has been published. */
+    uint32 getNumPublished() const noexcept                 { return numPublished.load(); }
+
+private:
+    //==============================================================================
+    ValueTree tree;
+    Array<ValueTreeSnapshot> published;
+    std::atomic<ValueTreeSnapshot::Node*> latest { nullptr };
+    mutable std::atomic<int> numReaders { 0 };
+    std::atomic<uint32> numPublished { 0 };
+
+    void releaseUnusedSnapshots();
+    void handleAsyncUpdate() override;
+
+    void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeSnapshotPublisher)
+};
+
+} // namespace juce
@@ -35,7 +35,8 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batch            = 7
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -71,6 +72,76 @@ namespace ValueTreeSynchroniserHelpers
             stream.writeCompressedInt (path.getUnchecked(i));
     }
 
+    // Batches store their numbers as variable-length unsigned ints, with 7 bits in each
+    // byte, and the top bit set on all but the last byte.
+    static void writeVarInt (OutputStream& stream, uint32 value)
+    {
+        while (value >= 0x80)
+        {
+            stream.writeByte ((char) (value | 0x80));
+            value >>= 7;
+        }
+
+        stream.writeByte ((char) value);
+    }
+
+    static uint32 readVarInt (InputStream& input)
+    {
+        uint32 value = 0;
+
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            auto byte = (uint8) input.readByte();
+            value |= (uint32) (byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        return value;
+    }
+
+    static int readVarIndex (InputStream& input)
+    {
+        return (int) jmin (readVarInt (input), (uint32) std::numeric_limits<int>::max());
+    }
+
+    // Within a batch, each property name is only written out in full the first time it's used,
+    // and after that it's referred to by its position in the list of names written so far.
+    static void writeIdentifier (OutputStream& stream, const Identifier& name, Array<Identifier>& namesWritten)
+    {
+        auto index = namesWritten.indexOf (name);
+
+        if (index < 0)
+        {
+            writeVarInt (stream, 0);
+            stream.writeString (name.toString());
+            namesWritten.add (name);
+        }
+        else
+        {
+            writeVarInt (stream, (uint32) index + 1);
+        }
+    }
+
+    static Identifier readIdentifier (InputStream& input, Array<Identifier>& namesRead)
+    {
+        auto index = readVarIndex (input);
+
+        if (index == 0)
+        {
+            auto name = input.readString();
+
+            if (name.isEmpty())
+                return {};
+
+            namesRead.add (Identifier (name));
+            return namesRead.getLast();
+        }
+
+        return namesRead[index - 1];
+    }
+
     static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
     {
         const int numLevels = input.readCompressedInt();
@@ -90,8 +161,128 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static ValueTree readBatchedSubTreeLocation (InputStream& input, ValueTree v, const ValueTree& previous)
+    {
+        const int numLevels = readVarIndex (input) - 1;
+
+        if (numLevels < 0)
+            return previous;
+
+        if (numLevels >= 65536) // sanity-check
+            return {};
+
+        for (int i = numLevels; --i >= 0;)
+        {
+            const int index = readVarIndex (input);
+
+            if (! isPositiveAndBelow (index, v.getNumChildren()))
+                return {};
+
+            v = v.getChild (index);
+        }
+
+        return v;
+    }
+
+    static bool applyBatch (ValueTree& root, MemoryInputStream& input, UndoManager* undoManager)
+    {
+        const int numChanges = readVarIndex (input);
+        Array<Identifier> namesRead;
+        ValueTree v;
+
+        for (int i = 0; i < numChanges; ++i)
+        {
+            const ChangeType type = (ChangeType) input.readByte();
+            v = readBatchedSubTreeLocation (input, root, v);
+
+            if (! v.isValid())
+                return false;
+
+            switch (type)
+            {
+                case propertyChanged:
+                case propertyRemoved:
+                {
+                    auto property = readIdentifier (input, namesRead);
+
+                    if (property.isNull())
+                        return false;
+
+                    if (type == propertyChanged)
+                        v.setProperty (property, var::readFromStream (input), undoManager);
+                    else
+                        v.removeProperty (property, undoManager);
+
+                    break;
+                }
+
+                case childAdded:
+                {
+                    const int index = readVarIndex (input);
+                    v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                    break;
+                }
+
+                case childRemoved:
+                {
+                    const int index = readVarIndex (input);
+
+                    if (! isPositiveAndBelow (index, v.getNumChildren()))
+                    {
+                        jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                        return false;
+                    }
+
+                    v.removeChild (index, undoManager);
+                    break;
+                }
+
+                case childMoved:
+                {
+                    const int oldIndex = readVarIndex (input);
+                    const int newIndex = readVarIndex (input);
+
+                    if (! (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                            && isPositiveAndBelow (newIndex, v.getNumChildren())))
+                    {
+                        jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                        return false;
+                    }
+
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    break;
+                }
+
+                case fullSync:
+                case batch:
+                default:
+                    jassertfalse; // Seem to have received some corrupt data?
+                    return false;
+            }
+        }
+
+        return true;
+    }
 }
 
+//==============================================================================
+struct ValueTreeSynchroniser::PendingChange
+{
+    PendingChange (ValueTreeSynchroniserHelpers::ChangeType t, const ValueTree& v,
+                   const Identifier& p = {}, int i1 = 0, int i2 = 0)
+        : type (t), target (v), property (p), index (i1), newIndex (i2)
+    {}
+
+    ValueTreeSynchroniserHelpers::ChangeType type;
+    ValueTree target;
+    Array<int> path;
+    Identifier property;
+    int index = 0, newIndex = 0;
+    MemoryBlock childData;
+};
+
+//==============================================================================
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -102,8 +293,96 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
     valueTree.removeListener (this);
 }
 
+void ValueTreeSynchroniser::setBatchingEnabled (bool shouldBatchChanges)
+{
+    if (batchingEnabled != shouldBatchChanges)
+    {
+        flushPendingChanges();
+        batchingEnabled = shouldBatchChanges;
+    }
+}
+
+void ValueTreeSynchroniser::addPendingChange (PendingChange* change)
+{
+    ValueTreeSynchroniserHelpers::getValueTreePath (change->target, valueTree, change->path);
+    pendingChanges.add (change);
+    triggerAsyncUpdate();
+}
+
+void ValueTreeSynchroniser::handleAsyncUpdate()
+{
+    flushPendingChanges();
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    using namespace ValueTreeSynchroniserHelpers;
+
+    if (pendingChanges.isEmpty())
+        return;
+
+    cancelPendingUpdate();
+
+    MemoryOutputStream m;
+    writeHeader (m, batch);
+    writeVarInt (m, (uint32) pendingChanges.size());
+
+    Array<Identifier> namesWritten;
+    ValueTree lastTarget;
+
+    for (auto* change : pendingChanges)
+    {
+        auto type = change->type;
+        auto* value = type == propertyChanged ? change->target.getPropertyPointer (change->property) : nullptr;
+
+        // property values are only read now, so a property that was changed
+        // and then removed during this batch just gets sent as a removal
+        if (type == propertyChanged && value == nullptr)
+            type = propertyRemoved;
+
+        m.writeByte ((char) type);
+
+        // a zero-length path means that the change is to the same tree as the previous one
+        if (change->target == lastTarget)
+        {
+            writeVarInt (m, 0);
+        }
+        else
+        {
+            writeVarInt (m, (uint32) change->path.size() + 1);
+
+            for (int i = change->path.size(); --i >= 0;)
+                writeVarInt (m, (uint32) change->path.getUnchecked (i));
+
+            lastTarget = change->target;
+        }
+
+        switch (type)
+        {
+            case propertyChanged:   writeIdentifier (m, change->property, namesWritten); value->writeToStream (m); break;
+            case propertyRemoved:   writeIdentifier (m, change->property, namesWritten); break;
+            case childAdded:        writeVarInt (m, (uint32) change->index); m << change->childData; break;
+            case childRemoved:      writeVarInt (m, (uint32) change->index); break;
+            case childMoved:        writeVarInt (m, (uint32) change->index); writeVarInt (m, (uint32) change->newIndex); break;
+            case fullSync:
+            case batch:
+            default:                jassertfalse; break;
+        }
+    }
+
+    pendingChanges.clear();
+    pendingPropertyChanges.clear();
+
+    stateChanged (m.getData(), m.getDataSize());
+}
+
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    // a full sync includes everything that was waiting to be sent
+    cancelPendingUpdate();
+    pendingChanges.clear();
+    pendingPropertyChanges.clear();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
@@ -112,6 +391,30 @@ void ValueTreeSynchroniser::sendFullSyncCallback()
 
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (batchingEnabled)
+    {
+        std::unique_ptr<PendingChange> change (new PendingChange (ValueTreeSynchroniserHelpers::propertyChanged, vt, property));
+        ValueTreeSynchroniserHelpers::getValueTreePath (vt, valueTree, change->path);
+
+        // Only the last value of each property needs to be sent. Until the structure of the tree
+        // changes, each node's path is unique, so the path and name can be used to find it.
+        String key;
+
+        for (auto index : change->path)
+            key << index << '/';
+
+        key << property.toString();
+
+        if (! pendingPropertyChanges.contains (key))
+        {
+            pendingPropertyChanges.set (key, change.get());
+            pendingChanges.add (change.release());
+            triggerAsyncUpdate();
+        }
+
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -134,6 +437,17 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (batchingEnabled)
+    {
+        auto* change = new PendingChange (ValueTreeSynchroniserHelpers::childAdded, parentTree, {}, index);
+        MemoryOutputStream childStream (change->childData, false);
+        childTree.writeToStream (childStream);
+
+        pendingPropertyChanges.clear();
+        addPendingChange (change);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -143,6 +457,13 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
 {
+    if (batchingEnabled)
+    {
+        pendingPropertyChanges.clear();
+        addPendingChange (new PendingChange (ValueTreeSynchroniserHelpers::childRemoved, parentTree, {}, oldIndex));
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -151,6 +472,13 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (batchingEnabled)
+    {
+        pendingPropertyChanges.clear();
+        addPendingChange (new PendingChange (ValueTreeSynchroniserHelpers::childMoved, parent, {}, oldIndex, newIndex));
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -170,6 +498,9 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::batch)
+        return ValueTreeSynchroniserHelpers::applyBatch (root, input, undoManager);
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
@@ -229,6 +560,7 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         }
 
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::batch:
             break;
 
         default:
@@ -239,4 +571,224 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests  : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct TestSynchroniser  : public ValueTreeSynchroniser
+    {
+        TestSynchroniser (const ValueTree& source, ValueTree& dest)
+            : ValueTreeSynchroniser (source), target (dest)
+        {}
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            ++numMessages;
+            numBytes += size;
+            allApplied = applyChange (target, data, size, nullptr) && allApplied;
+        }
+
+        ValueTree& target;
+        int numMessages = 0;
+        size_t numBytes = 0;
+        bool allApplied = true;
+    };
+
+    static void makeRandomChange (Random& r, ValueTree& root)
+    {
+        Array<ValueTree> nodes;
+        nodes.add (root);
+
+        for (int i = 0; i < nodes.size(); ++i)
+            for (const auto& child : nodes.getReference (i))
+                nodes.add (child);
+
+        auto node = nodes[r.nextInt (nodes.size())];
+        auto numChildren = node.getNumChildren();
+
+        switch (r.nextInt (6))
+        {
+            case 0:
+            case 1:  node.setProperty ("p" + String (r.nextInt (5)), r.nextBool() ? var (r.nextInt (1000)) : var (String (r.nextInt())), nullptr); break;
+            case 2:  node.removeProperty ("p" + String (r.nextInt (5)), nullptr); break;
+            case 3:  if (nodes.size() < 200) node.addChild (ValueTree ("n", { { "p0", r.nextInt (10) } }), r.nextInt (numChildren + 1), nullptr); break;
+            case 4:  if (numChildren > 0) node.removeChild (r.nextInt (numChildren), nullptr); break;
+            case 5:  if (numChildren > 1) node.moveChild (r.nextInt (numChildren), r.nextInt (numChildren), nullptr); break;
+            default: break;
+        }
+    }
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser;
+        auto r = getRandom();
+
+        for (auto batching : { false, true })
+        {
+            beginTest (batching ? "Batched changes keep trees in sync" : "Unbatched changes keep trees in sync");
+
+            ValueTree source ("root"), dest;
+            TestSynchroniser sync (source, dest);
+            sync.setBatchingEnabled (batching);
+            sync.sendFullSyncCallback();
+
+            for (int round = 0; round < 50; ++round)
+            {
+                for (int i = r.nextInt (40); --i >= 0;)
+                    makeRandomChange (r, source);
+
+                sync.flushPendingChanges();
+
+                expect (sync.allApplied);
+                expect (dest.isEquivalentTo (source));
+            }
+        }
+
+        beginTest ("Repeated changes are coalesced");
+        {
+            ValueTree source ("root", {}, { ValueTree ("a"), ValueTree ("b") }), dest;
+            TestSynchroniser sync (source, dest);
+            sync.sendFullSyncCallback();
+            sync.setBatchingEnabled (true);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                source.getChild (0).setProperty ("x", i, nullptr);
+                source.getChild (1).setProperty ("y", i, nullptr);
+            }
+
+            source.getChild (1).removeProperty ("y", nullptr);
+
+            expectEquals (sync.numMessages, 1);
+            sync.flushPendingChanges();
+            expectEquals (sync.numMessages, 2);
+
+            expect (dest.isEquivalentTo (source));
+            expect (sync.numBytes < 100);
+        }
+
+        beginTest ("Batches are smaller than individual changes");
+        {
+            ValueTree source ("root");
+
+            for (int i = 0; i < 20; ++i)
+            {
+                ValueTree track ("track");
+
+                for (int j = 0; j < 20; ++j)
+                    track.appendChild (ValueTree ("clip"), nullptr);
+
+                source.appendChild (track, nullptr);
+            }
+
+            size_t sizes[2];
+
+            for (auto batching : { false, true })
+            {
+                ValueTree dest;
+                TestSynchroniser sync (source, dest);
+                sync.sendFullSyncCallback();
+                sync.setBatchingEnabled (batching);
+                sync.numBytes = 0;
+
+                for (auto track : source)
+                    for (auto clip : track)
+                        clip.setProperty ("gain", r.nextFloat(), nullptr);
+
+                sync.flushPendingChanges();
+                expect (dest.isEquivalentTo (source));
+
+                sizes[batching ? 1 : 0] = sync.numBytes;
+            }
+
+            expect (sizes[1] * 4 < sizes[0] * 3);
+        }
+
+        beginTest ("Corrupt batches are rejected");
+        {
+            ValueTree source ("root", {}, { ValueTree ("a") });
+            ValueTree dest (source.createCopy());
+            MemoryBlock message;
+
+            struct CapturingSynchroniser  : public ValueTreeSynchroniser
+            {
+                CapturingSynchroniser (const ValueTree& v, MemoryBlock& m) : ValueTreeSynchroniser (v), lastMessage (m) {}
+                void stateChanged (const void* data, size_t size) override    { lastMessage.replaceWith (data, size); }
+                MemoryBlock& lastMessage;
+            };
+
+            CapturingSynchroniser sync (source, message);
+            sync.setBatchingEnabled (true);
+            source.getChild (0).setProperty ("x", 1, nullptr);
+            sync.flushPendingChanges();
+
+            expect (ValueTreeSynchroniser::applyChange (dest, message.getData(), message.getSize(), nullptr));
+
+            expect (! ValueTreeSynchroniser::applyChange (dest, message.getData(), 3, nullptr));
+        }
+
+        beginTest ("Benchmark");
+        {
+            ValueTree source ("session");
+
+            for (int i = 0; i < 50; ++i)
+            {
+                ValueTree track ("track");
+
+                for (int j = 0; j < 100; ++j)
+                    track.appendChild (ValueTree ("clip", { { "start", j * 4 }, { "gain", 1.0 }, { "muted", false } }), nullptr);
+
+                source.appendChild (track, nullptr);
+            }
+
+            const int numEdits = 20000, numEditsPerTick = 1000;
+            const Identifier properties[] = { "start", "gain", "muted" };
+
+            for (auto batching : { false, true })
+            {
+                ValueTree dest;
+                TestSynchroniser sync (source, dest);
+                sync.sendFullSyncCallback();
+                sync.setBatchingEnabled (batching);
+                sync.numMessages = 0;
+                sync.numBytes = 0;
+
+                Random editRandom (1234);
+                auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numEdits; ++i)
+                {
+                    auto clip = source.getChild (editRandom.nextInt (50)).getChild (editRandom.nextInt (100));
+                    clip.setProperty (properties[editRandom.nextInt (3)], editRandom.nextInt (1000), nullptr);
+
+                    // Stands in for the AsyncUpdater firing on each message loop tick
+                    if ((i + 1) % numEditsPerTick == 0)
+                        sync.flushPendingChanges();
+                }
+
+                auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+                expect (sync.allApplied);
+                expect (dest.isEquivalentTo (source));
+
+                logMessage (String (batching ? "Batched: " : "Unbatched: ") + String (numEdits) + " clip edits on a 50x100 tree, "
+                              + String (sync.numMessages) + " messages, " + String ((int) (sync.numBytes / 1024)) + " KB, "
+                              + String (roundToInt (seconds * 1000.0)) + " ms, "
+                              + String (roundToInt (numEdits / seconds)) + " edits/s");
+            }
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
+
 } // namespace juce
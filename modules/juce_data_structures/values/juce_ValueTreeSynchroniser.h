@@ -40,9 +40,15 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, every change is sent as soon as it happens. If you call
+    setBatchingEnabled (true), the changes are instead collected up and sent as a
+    single, more compact message at the end of each message-loop tick, which is
+    much more efficient when lots of properties are being changed at once.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private AsyncUpdater
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -70,6 +76,30 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Chooses whether changes should be batched together.
+
+        When batching is enabled, changes aren't sent straight away. Instead, they're
+        collected until the message loop next gets round to it, and then all sent in one
+        call to stateChanged(). Repeated changes to the same property within a batch are
+        coalesced, so only its final value gets sent, and the batch uses a more compact
+        encoding for the property names and tree locations.
+
+        Any receiver that uses applyChange() will understand both kinds of message.
+        Turning batching off sends any changes that are still waiting.
+    */
+    void setBatchingEnabled (bool shouldBatchChanges);
+
+    /** Returns true if changes are being batched.
+        @see setBatchingEnabled
+    */
+    bool isBatchingEnabled() const noexcept                 { return batchingEnabled; }
+
+    /** If batching is enabled and there are some changes waiting to be sent, this sends
+        them immediately, rather than waiting for the message loop.
+        @see setBatchingEnabled
+    */
+    void flushPendingChanges();
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -84,7 +114,15 @@ public:
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
 private:
+    struct PendingChange;
+
     ValueTree valueTree;
+    OwnedArray<PendingChange> pendingChanges;
+    HashMap<String, PendingChange*> pendingPropertyChanges;
+    bool batchingEnabled = false;
+
+    void addPendingChange (PendingChange*);
+    void handleAsyncUpdate() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
@@ -285,12 +285,8 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
-        auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
+        auto* inputData  = bufferInput.getWritePointer (0);
+        auto* outputData = bufferOutput.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
         {
@@ -306,56 +302,79 @@ struct ConvolutionEngine
             // processing itself when needed (with latency)
             if (inputDataPos == blockSize)
             {
-                // Copy input data in input segment
-                auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
-                FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
+                processInputBlock();
+                inputDataPos = 0;
+            }
+        }
+    }
 
-                fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+    // Convolves exactly one block of blockSize samples, and writes out the output
+    // for that same block. This is the same computation as processSamplesWithAddedLatency,
+    // but the result is returned straight away instead of during the next block.
+    void processBlock (const float* input, float* output)
+    {
+        jassert (inputDataPos == 0);
 
-                // Complex multiplication
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
+        FloatVectorOperations::copy (bufferInput.getWritePointer (0), input, static_cast<int> (blockSize));
+        processInputBlock();
+        FloatVectorOperations::copy (output, bufferOutput.getReadPointer (0), static_cast<int> (blockSize));
+    }
 
-                auto index = currentSegment;
+    void processInputBlock()
+    {
+        auto indexStep = numInputSegments / numSegments;
 
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
+        auto* inputData      = bufferInput.getWritePointer (0);
+        auto* outputTempData = bufferTempOutput.getWritePointer (0);
+        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* overlapData    = bufferOverlap.getWritePointer (0);
 
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
+        // Copy input data in input segment
+        auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
+        FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+        fftObject->performRealOnlyForwardTransform (inputSegmentData);
+        prepareForConvolution (inputSegmentData);
 
-                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
+        // Complex multiplication
+        FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
 
-                convolutionProcessingAndAccumulate (inputSegmentData,
-                                                    buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
+        auto index = currentSegment;
 
-                updateSymmetricFrequencyDomainData (outputData);
-                fftObject->performRealOnlyInverseTransform (outputData);
+        for (size_t i = 1; i < numSegments; ++i)
+        {
+            index += indexStep;
 
-                // Add overlap
-                FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+            if (index >= numInputSegments)
+                index -= numInputSegments;
 
-                // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+            convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
+                                                buffersImpulseSegments[i].getWritePointer (0),
+                                                outputTempData);
+        }
 
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+        FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+        convolutionProcessingAndAccumulate (inputSegmentData,
+                                            buffersImpulseSegments.front().getWritePointer (0),
+                                            outputData);
 
-                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+        updateSymmetricFrequencyDomainData (outputData);
+        fftObject->performRealOnlyInverseTransform (outputData);
 
-                inputDataPos = 0;
-            }
-        }
+        // Add overlap
+        FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+
+        // Input buffer is empty again now
+        FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+
+        // Extra step for segSize > blockSize
+        FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+
+        // Save the overlap
+        FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+
+        currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
     }
 
     // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
@@ -420,6 +439,231 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+// Convolves a late section of the IR on a background thread, using a much larger
+// block size than the audio callback.
+//
+// Each time a full block of input has been collected it's handed over to the thread,
+// and the output of the previous block is collected and placed in a ring buffer at the
+// section's offset. As long as the section starts at least two blocks into the IR,
+// that output isn't needed before then.
+//
+// If the thread hasn't started on a block by the time its output is needed, the audio
+// thread convolves it itself, and if the thread is part-way through it, the audio
+// thread waits for it to finish. Every block is convolved exactly once and in order,
+// so the output never depends on how quickly the thread gets its work done.
+class BackgroundConvolutionStage  : private Thread
+{
+public:
+    BackgroundConvolutionStage (const AudioBuffer<float>& buf,
+                                int numChannels,
+                                int offset,
+                                int length,
+                                int blockSizeIn,
+                                int latency,
+                                int priority)
+        : Thread ("Convolution tail"),
+          blockSize (blockSizeIn),
+          ringSize (nextPowerOfTwo (offset + latency + blockSizeIn)),
+          outputStart ((offset + latency) % ringSize),
+          inputBuffer (numChannels, blockSizeIn),
+          ringBuffer (numChannels, ringSize)
+    {
+        // The result for each block must not be needed before the following block is complete
+        jassert (offset >= 2 * blockSize && isPowerOfTwo (blockSize));
+
+        for (int i = 0; i < numChannels; ++i)
+            engines.emplace_back (std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, i), offset),
+                                                                       static_cast<size_t> (length),
+                                                                       static_cast<size_t> (blockSize)));
+
+        job.input.setSize (numChannels, blockSize);
+        job.output.setSize (numChannels, blockSize);
+
+        reset();
+        startThread (priority);
+    }
+
+    // Engines are only ever deleted on the loader thread, so this never holds up the audio thread
+    ~BackgroundConvolutionStage() override
+    {
+        stopThread (-1);
+    }
+
+    void reset()
+    {
+        // A block that the thread hasn't started on can simply be dropped, as the engines
+        // are about to be reset anyway
+        auto expected = JobState::pending;
+        job.state.compare_exchange_strong (expected, JobState::idle, std::memory_order_acq_rel);
+
+        waitForThread();
+        job.state.store (JobState::idle, std::memory_order_relaxed);
+
+        inputBuffer.clear();
+        ringBuffer.clear();
+        inputPos = 0;
+        samplesProcessed = 0;
+        numBlocksSubmitted = 0;
+        engineNeedsReset = true;
+        numLateBlocks = 0;
+    }
+
+    // Pushes the input into the stage, and adds the stage's output to the output block.
+    void processSamples (const AudioBlock<const float>& input, const AudioBlock<float>& output, size_t numChannels, int numSamples)
+    {
+        for (int numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+        {
+            // As the ring size is a multiple of the block size, the read position never wraps
+            // around in the middle of a block
+            const auto numToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputPos);
+            const auto readPos = (int) (samplesProcessed % (uint64) ringSize);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto c = (int) channel;
+
+                FloatVectorOperations::copy (inputBuffer.getWritePointer (c, inputPos),
+                                             input.getChannelPointer (channel) + numSamplesProcessed,
+                                             numToProcess);
+
+                FloatVectorOperations::add (output.getChannelPointer (channel) + numSamplesProcessed,
+                                            ringBuffer.getReadPointer (c, readPos),
+                                            numToProcess);
+            }
+
+            numSamplesProcessed += numToProcess;
+            inputPos += numToProcess;
+            samplesProcessed += (uint64) numToProcess;
+
+            if (inputPos == blockSize)
+            {
+                submitBlock ((int) numChannels);
+                inputPos = 0;
+            }
+        }
+    }
+
+    // The number of blocks since the last reset that the thread hadn't finished in time.
+    int getNumLateBlocks() const noexcept    { return numLateBlocks.load (std::memory_order_relaxed); }
+
+private:
+    enum class JobState
+    {
+        idle,
+        pending,
+        processing,
+        finished
+    };
+
+    struct Job
+    {
+        AudioBuffer<float> input, output;
+        int numChannels = 0;
+        bool resetEnginesFirst = false;
+        std::atomic<JobState> state { JobState::idle };
+    };
+
+    void submitBlock (int numChannels)
+    {
+        const auto blockIndex = numBlocksSubmitted++;
+
+        // The previous block's output is about to be read, so it needs to go into the ring now
+        if (blockIndex > 0)
+            collectBlock (blockIndex - 1, numChannels);
+
+        for (int i = 0; i < numChannels; ++i)
+            FloatVectorOperations::copy (job.input.getWritePointer (i), inputBuffer.getReadPointer (i), blockSize);
+
+        job.numChannels = numChannels;
+        job.resetEnginesFirst = engineNeedsReset;
+        engineNeedsReset = false;
+        job.state.store (JobState::pending, std::memory_order_release);
+        notify();
+    }
+
+    void collectBlock (uint64 blockIndex, int numChannels)
+    {
+        auto expected = JobState::pending;
+
+        if (job.state.compare_exchange_strong (expected, JobState::processing, std::memory_order_acquire))
+        {
+            processJob();
+            ++numLateBlocks;
+        }
+        else if (expected == JobState::processing)
+        {
+            waitForThread();
+            ++numLateBlocks;
+        }
+
+        jassert (job.state.load (std::memory_order_acquire) != JobState::pending);
+
+        const auto writePos = (int) ((blockIndex * (uint64) blockSize + (uint64) outputStart) % (uint64) ringSize);
+        const auto numBeforeWrap = jmin (blockSize, ringSize - writePos);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto* ring = ringBuffer.getWritePointer (i);
+            const auto* source = job.output.getReadPointer (i);
+
+            FloatVectorOperations::copy (ring + writePos, source, numBeforeWrap);
+            FloatVectorOperations::copy (ring, source + numBeforeWrap, blockSize - numBeforeWrap);
+        }
+
+        job.state.store (JobState::idle, std::memory_order_relaxed);
+    }
+
+    void waitForThread()
+    {
+        while (job.state.load (std::memory_order_acquire) == JobState::processing)
+            jobFinished.wait (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            auto expected = JobState::pending;
+
+            if (job.state.compare_exchange_strong (expected, JobState::processing, std::memory_order_acquire))
+            {
+                processJob();
+                job.state.store (JobState::finished, std::memory_order_release);
+                jobFinished.signal();
+            }
+            else
+            {
+                wait (-1);
+            }
+        }
+    }
+
+    void processJob()
+    {
+        if (job.resetEnginesFirst)
+            for (const auto& e : engines)
+                e->reset();
+
+        for (int i = 0; i < job.numChannels; ++i)
+            engines[(size_t) i]->processBlock (job.input.getReadPointer (i), job.output.getWritePointer (i));
+    }
+
+    //==============================================================================
+    std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+
+    const int blockSize, ringSize, outputStart;
+    AudioBuffer<float> inputBuffer, ringBuffer;
+    Job job;
+    WaitableEvent jobFinished;
+    int inputPos = 0;
+    uint64 samplesProcessed = 0, numBlocksSubmitted = 0;
+    bool engineNeedsReset = true;
+    std::atomic<int> numLateBlocks { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionStage)
+};
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -427,16 +671,17 @@ public:
     MultichannelEngine (const AudioBuffer<float>& buf,
                         int maxBlockSize,
                         int maxBufferSize,
+                        int numPreparedChannels,
                         Convolution::NonUniform headSizeIn,
                         bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+        : numEngineChannels (jlimit (1, 2, numPreparedChannels)),
+          tailBuffer (1, maxBlockSize),
+          backgroundBuffer (numEngineChannels, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
           isZeroDelay (isZeroDelayIn)
     {
-        constexpr auto numChannels = 2;
-
         const auto makeEngine = [&] (int channel, int offset, int length, uint32 thisBlockSize)
         {
             return std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
@@ -446,21 +691,42 @@ public:
 
         if (headSizeIn.headSizeInSamples == 0)
         {
-            for (int i = 0; i < numChannels; ++i)
+            for (int i = 0; i < numEngineChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
         }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
 
-            for (int i = 0; i < numChannels; ++i)
+            for (int i = 0; i < numEngineChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
 
             const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
 
+            // If background threads were asked for, everything after the first few tail
+            // partitions is split into sections whose block size grows by a factor of 4 each
+            // time, and which are processed on background threads. Each section starts at
+            // twice its block size.
+            const auto firstStageBlockSize = jmax (4 * headSizeIn.headSizeInSamples, 2 * nextPowerOfTwo (maxBufferSize));
+            const auto tailEnd = headSizeIn.useBackgroundThreads ? jmin (buf.getNumSamples(), 2 * firstStageBlockSize)
+                                                                 : buf.getNumSamples();
+
             if (size != buf.getNumSamples())
-                for (int i = 0; i < numChannels; ++i)
-                    tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+                for (int i = 0; i < numEngineChannels; ++i)
+                    tail.emplace_back (makeEngine (i, size, tailEnd - size, tailBufferSize));
+
+            for (auto stageBlockSize = firstStageBlockSize, offset = tailEnd; offset < buf.getNumSamples(); stageBlockSize *= 4)
+            {
+                const auto isLastStage = stageBlockSize >= maxBackgroundBlockSize;
+                const auto end = isLastStage ? buf.getNumSamples() : jmin (buf.getNumSamples(), 8 * stageBlockSize);
+
+                // Smaller blocks have tighter deadlines, so they get higher priorities
+                const auto priority = jmax (4, 8 - (int) backgroundStages.size());
+
+                backgroundStages.emplace_back (std::make_unique<BackgroundConvolutionStage> (buf, numEngineChannels, offset, end - offset,
+                                                                                            stageBlockSize, latency, priority));
+                offset = end;
+            }
         }
     }
 
@@ -471,6 +737,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        for (const auto& s : backgroundStages)
+            s->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -483,6 +752,19 @@ public:
 
         const auto isUniform = tail.empty();
 
+        // The background stages need to see the input before it's overwritten, in case
+        // we're processing in-place
+        const AudioBlock<float> fullBackgroundBlock (backgroundBuffer);
+        const auto backgroundBlock = fullBackgroundBlock.getSubBlock (0, (size_t) numSamples);
+
+        if (! backgroundStages.empty())
+        {
+            backgroundBlock.clear();
+
+            for (const auto& s : backgroundStages)
+                s->processSamples (input, backgroundBlock, numChannels, (int) numSamples);
+        }
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             if (! isUniform)
@@ -501,6 +783,9 @@ public:
 
             if (! isUniform)
                 output.getSingleChannelBlock (channel) += tailBlock;
+
+            if (! backgroundStages.empty())
+                output.getSingleChannelBlock (channel) += backgroundBlock.getSingleChannelBlock (channel);
         }
 
         const auto numOutputChannels = output.getNumChannels();
@@ -513,9 +798,25 @@ public:
     int getLatency() const noexcept    { return latency; }
     int getBlockSize() const noexcept  { return blockSize; }
 
+    int getNumLateTailBlocks() const noexcept
+    {
+        int total = 0;
+
+        for (const auto& s : backgroundStages)
+            total += s->getNumLateBlocks();
+
+        return total;
+    }
+
 private:
+    static constexpr int maxBackgroundBlockSize = 1 << 16;
+
+    // Only mono and stereo are supported, so there's no point convolving any more channels
+    const int numEngineChannels;
+
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
-    AudioBuffer<float> tailBuffer;
+    std::vector<std::unique_ptr<BackgroundConvolutionStage>> backgroundStages;
+    AudioBuffer<float> tailBuffer, backgroundBuffer;
 
     const int latency;
     const int irSize;
@@ -632,17 +933,25 @@ static AudioBuffer<float> resampleImpulseResponse (const AudioBuffer<float>& buf
         return buf;
 
     const auto factorReading = srcSampleRate / destSampleRate;
+    const auto numChannels = buf.getNumChannels();
+    const auto finalSize = roundToInt (jmax (1.0, buf.getNumSamples() / factorReading));
 
-    AudioBuffer<float> original = buf;
-    MemoryAudioSource memorySource (original, false);
-    ResamplingAudioSource resamplingSource (&memorySource, false, buf.getNumChannels());
+    // The polyphase resampler's filter is narrowed to suit the ratio, so a high
+    // sample-rate IR can be converted down without aliasing
+    PolyphaseResampler resampler (numChannels, 32, jmax (1.0, factorReading));
+    resampler.reset (true);
 
-    const auto finalSize = roundToInt (jmax (1.0, buf.getNumSamples() / factorReading));
-    resamplingSource.setResamplingRatio (factorReading);
-    resamplingSource.prepareToPlay (finalSize, srcSampleRate);
+    // The input is padded with silence, so that the filter can run off the end of the IR
+    AudioBuffer<float> padded (numChannels, jmax (buf.getNumSamples(),
+                                                  resampler.getNumInputSamplesNeeded (factorReading, finalSize)));
+    padded.clear();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        padded.copyFrom (channel, 0, buf, channel, 0, buf.getNumSamples());
 
-    AudioBuffer<float> result (buf.getNumChannels(), finalSize);
-    resamplingSource.getNextAudioBlock ({ &result, 0, result.getNumSamples() });
+    AudioBuffer<float> result (numChannels, finalSize);
+    resampler.process (factorReading, padded.getArrayOfReadPointers(), result.getArrayOfWritePointers(),
+                       numChannels, finalSize);
 
     return result;
 }
@@ -714,7 +1023,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     requiredHeadSize.useBackgroundThreads },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -770,6 +1080,7 @@ private:
         return std::make_unique<MultichannelEngine> (resampled,
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
+                                                     (int) processSpec.numChannels,
                                                      headSize,
                                                      shouldBeZeroLatency);
     }
@@ -976,6 +1287,8 @@ public:
         }
     }
 
+    bool isTransitioning() const noexcept   { return smoother.isSmoothing(); }
+
     void beginTransition()
     {
         smoother.setCurrentAndTargetValue (1.0f);
@@ -1024,6 +1337,9 @@ public:
     {
         engineQueue->postPendingCommand();
 
+        if (! mixer.isTransitioning())
+            destroyPreviousEngine();
+
         if (previousEngine == nullptr)
             installPendingEngine();
 
@@ -1047,6 +1363,8 @@ public:
 
     int getLatency() const { return currentEngine != nullptr ? currentEngine->getLatency() : 0; }
 
+    int getNumLateTailBlocks() const { return currentEngine != nullptr ? currentEngine->getNumLateTailBlocks() : 0; }
+
     void loadImpulseResponse (AudioBuffer<float>&& buffer,
                               double originalSampleRate,
                               Stereo stereo,
@@ -1076,16 +1394,20 @@ public:
     }
 
 private:
+    // Engines may own background threads which have to be stopped, so they're always
+    // destroyed on the loader thread. If the queue is full, the engine is kept until the
+    // next call, and no new engine can be installed until it's gone.
     void destroyPreviousEngine()
     {
-        // If the queue is full, we'll destroy this straight away
-        BackgroundMessageQueue::IncomingCommand command = [p = std::move (previousEngine)]() mutable { p = nullptr; };
-        messageQueue->pimpl->push (command);
+        if (pendingDestruction == nullptr && previousEngine != nullptr)
+            pendingDestruction = [p = std::move (previousEngine)]() mutable { p = nullptr; };
+
+        if (pendingDestruction != nullptr && messageQueue->pimpl->push (pendingDestruction))
+            pendingDestruction = nullptr;
     }
 
     void installNewEngine (std::unique_ptr<MultichannelEngine> newEngine)
     {
-        destroyPreviousEngine();
         previousEngine = std::move (currentEngine);
         currentEngine = std::move (newEngine);
         mixer.beginTransition();
@@ -1093,6 +1415,11 @@ private:
 
     void installPendingEngine()
     {
+        destroyPreviousEngine();
+
+        if (previousEngine != nullptr)
+            return;
+
         if (auto newEngine = engineQueue->getEngine())
             installNewEngine (std::move (newEngine));
     }
@@ -1100,6 +1427,7 @@ private:
     OptionalQueue messageQueue;
     std::shared_ptr<ConvolutionEngineQueue> engineQueue;
     std::unique_ptr<MultichannelEngine> previousEngine, currentEngine;
+    BackgroundMessageQueue::IncomingCommand pendingDestruction;
     CrossoverMixer mixer;
 };
 
@@ -1268,5 +1596,7 @@ int Convolution::getCurrentIRSize() const { return pimpl->getCurrentIRSize(); }
 
 int Convolution::getLatency() const { return pimpl->getLatency(); }
 
+int Convolution::getNumLateTailBlocks() const { return pimpl->getNumLateTailBlocks(); }
+
 } // namespace dsp
 } // namespace juce
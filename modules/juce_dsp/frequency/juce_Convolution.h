@@ -130,8 +130,18 @@ public:
     */
     explicit Convolution (const Latency& requiredLatency);
 
-    /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    /** Contains configuration information for a non-uniform convolution.
+
+        If useBackgroundThreads is true, the later parts of long impulse responses are
+        split into sections with larger block sizes, and each section is convolved on its
+        own background thread. This reduces the work done on the audio thread, at the cost
+        of one extra thread per section for each loaded impulse response.
+    */
+    struct NonUniform
+    {
+        int headSizeInSamples;
+        bool useBackgroundThreads = false;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
@@ -257,6 +267,15 @@ public:
     */
     int getLatency() const;
 
+    /** Returns the number of times since the last reset that a background thread didn't
+        finish convolving part of a long impulse response's tail in time.
+
+        This only applies to NonUniform convolutions that use background threads. When a
+        thread falls behind, the audio thread finishes the block itself, so the output is
+        unaffected, but that callback will take longer than usual.
+    */
+    int getNumLateTailBlocks() const;
+
 private:
     //==============================================================================
     Convolution (const Latency&,
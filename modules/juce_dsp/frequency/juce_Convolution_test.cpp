@@ -225,6 +225,157 @@ class ConvolutionTest  : public UnitTest
             testConvolution (spec, config, ir, irSampleRate, stereo, trim, normalise, expectedResult, sequence);
     }
 
+    static AudioBuffer<float> processInBlocks (Convolution& convolution,
+                                               const ProcessSpec& spec,
+                                               const AudioBuffer<float>& input)
+    {
+        convolution.reset();
+
+        auto result = input;
+
+        for (auto start = 0; start < result.getNumSamples(); start += (int) spec.maximumBlockSize)
+        {
+            const auto numSamples = jmin ((int) spec.maximumBlockSize, result.getNumSamples() - start);
+            AudioBlock<float> block (result.getArrayOfWritePointers(), (size_t) result.getNumChannels(), (size_t) start, (size_t) numSamples);
+            convolution.process (ProcessContextReplacing<float> (block));
+        }
+
+        return result;
+    }
+
+    static AudioBuffer<float> makeDecayingNoise (Random& random, int numChannels, int length)
+    {
+        AudioBuffer<float> result (numChannels, length);
+
+        for (auto channel = 0; channel != numChannels; ++channel)
+            for (auto sample = 0; sample != length; ++sample)
+                result.setSample (channel, sample, (random.nextFloat() * 2.0f - 1.0f) * 0.1f * (1.0f - (float) sample / (float) length));
+
+        return result;
+    }
+
+    // Loads the IR, and keeps processing until it's installed and the crossfade has finished
+    static bool loadAndWait (Convolution& convolution, const ProcessSpec& spec, const AudioBuffer<float>& ir)
+    {
+        convolution.prepare (spec);
+
+        auto copiedIr = ir;
+        convolution.loadImpulseResponse (std::move (copiedIr),
+                                         spec.sampleRate,
+                                         Convolution::Stereo::yes,
+                                         Convolution::Trim::no,
+                                         Convolution::Normalise::no);
+
+        AudioBuffer<float> buffer ((int) spec.numChannels, (int) spec.maximumBlockSize);
+        AudioBlock<float> block { buffer };
+        ProcessContextReplacing<float> context { block };
+
+        const auto time = Time::getMillisecondCounter();
+
+        while (Time::getMillisecondCounter() - time < 10'000 && convolution.getCurrentIRSize() != ir.getNumSamples())
+        {
+            addDiracImpulse (block);
+            convolution.process (context);
+        }
+
+        nTimes ((int) std::ceil (spec.sampleRate / spec.maximumBlockSize), [&] { convolution.process (context); });
+
+        return convolution.getCurrentIRSize() == ir.getNumSamples();
+    }
+
+    void testBackgroundTailProcessing (const ProcessSpec& spec, int headSize, int irLength)
+    {
+        auto random = getRandom();
+
+        const auto ir = makeDecayingNoise (random, 2, irLength);
+
+        const auto numInputSamples = 2048;
+        AudioBuffer<float> input (2, irLength + numInputSamples + (int) spec.maximumBlockSize);
+        input.clear();
+
+        for (auto channel = 0; channel != input.getNumChannels(); ++channel)
+            for (auto sample = 0; sample != numInputSamples; ++sample)
+                input.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        Convolution convolution (Convolution::NonUniform { headSize, true });
+        expect (loadAndWait (convolution, spec, ir));
+
+        // Each run is processed flat out, so the background threads will fall behind at
+        // different points. That mustn't make any difference to the output.
+        const auto first = processInBlocks (convolution, spec, input);
+        const auto second = processInBlocks (convolution, spec, input);
+
+        for (auto channel = 0; channel != input.getNumChannels(); ++channel)
+        {
+            const auto* firstData = first.getReadPointer (channel);
+            const auto* secondData = second.getReadPointer (channel);
+
+            expect (std::equal (firstData, firstData + first.getNumSamples(), secondData));
+
+            auto maxError = 0.0;
+
+            for (auto sample = 0; sample != input.getNumSamples(); ++sample)
+            {
+                auto expected = 0.0;
+
+                for (auto i = jmax (0, sample - irLength + 1); i <= jmin (sample, numInputSamples - 1); ++i)
+                    expected += (double) input.getSample (channel, i) * (double) ir.getSample (channel, sample - i);
+
+                maxError = jmax (maxError, std::abs (expected - (double) firstData[sample]));
+            }
+
+            expectLessThan (maxError, 1.0e-3);
+        }
+    }
+
+    // Processes a long IR in real time, and reports how long the audio thread spends in each callback
+    void benchmarkConvolution (const String& description, Convolution& convolution, const ProcessSpec& spec,
+                               const AudioBuffer<float>& ir, double secondsToProcess)
+    {
+        if (! loadAndWait (convolution, spec, ir))
+        {
+            expect (false, description + " didn't load in time");
+            return;
+        }
+
+        auto random = getRandom();
+        AudioBuffer<float> buffer ((int) spec.numChannels, (int) spec.maximumBlockSize);
+        AudioBlock<float> block { buffer };
+        ProcessContextReplacing<float> context { block };
+
+        const auto numBlocks = (int) (secondsToProcess * spec.sampleRate / spec.maximumBlockSize);
+        const auto blockDuration = (double) spec.maximumBlockSize / spec.sampleRate;
+        const auto start = Time::getMillisecondCounterHiRes();
+        double totalTime = 0.0, worstTime = 0.0;
+
+        convolution.reset();
+
+        for (auto i = 0; i < numBlocks; ++i)
+        {
+            for (auto channel = 0; channel != buffer.getNumChannels(); ++channel)
+                for (auto sample = 0; sample != buffer.getNumSamples(); ++sample)
+                    buffer.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+            const auto blockStart = Time::getMillisecondCounterHiRes();
+            convolution.process (context);
+            const auto elapsed = Time::getMillisecondCounterHiRes() - blockStart;
+
+            totalTime += elapsed;
+            worstTime = jmax (worstTime, elapsed);
+
+            // Wait for the next callback, as an audio device would
+            const auto nextBlock = start + (i + 1) * blockDuration * 1000.0;
+            const auto now = Time::getMillisecondCounterHiRes();
+
+            if (nextBlock > now)
+                Thread::sleep ((int) (nextBlock - now));
+        }
+
+        logMessage (description + ": mean " + String (1000.0 * totalTime / numBlocks, 1) + " us, worst "
+                      + String (1000.0 * worstTime, 1) + " us per " + String (spec.maximumBlockSize)
+                      + "-sample block, " + String (convolution.getNumLateTailBlocks()) + " late tail blocks");
+    }
+
 public:
     ConvolutionTest()
         : UnitTest ("Convolution", UnitTestCategories::dsp)
@@ -445,16 +596,22 @@ public:
 
                 const auto resampled = [&]
                 {
-                    AudioBuffer<float> original = ramp;
-                    MemoryAudioSource memorySource (original, false);
-                    ResamplingAudioSource resamplingSource (&memorySource, false, original.getNumChannels());
+                    const auto numChannels = ramp.getNumChannels();
+                    const auto finalSize = roundToInt (ramp.getNumSamples() / resampleRatio);
+
+                    PolyphaseResampler resampler (numChannels, 32, jmax (1.0, resampleRatio));
+                    resampler.reset (true);
 
-                    const auto finalSize = roundToInt (original.getNumSamples() / resampleRatio);
-                    resamplingSource.setResamplingRatio (resampleRatio);
-                    resamplingSource.prepareToPlay (finalSize, spec.sampleRate * resampleRatio);
+                    AudioBuffer<float> padded (numChannels, jmax (ramp.getNumSamples(),
+                                                                  resampler.getNumInputSamplesNeeded (resampleRatio, finalSize)));
+                    padded.clear();
 
-                    AudioBuffer<float> result (original.getNumChannels(), finalSize);
-                    resamplingSource.getNextAudioBlock ({ &result, 0, result.getNumSamples() });
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        padded.copyFrom (channel, 0, ramp, channel, 0, ramp.getNumSamples());
+
+                    AudioBuffer<float> result (numChannels, finalSize);
+                    resampler.process (resampleRatio, padded.getArrayOfReadPointers(), result.getArrayOfWritePointers(),
+                                       numChannels, finalSize);
                     return result;
                 }();
 
@@ -486,6 +643,12 @@ public:
             }
         }
 
+        beginTest ("Long non-uniform convolutions can process their tails in the background");
+        {
+            for (auto headSize : { 64, 256 })
+                testBackgroundTailProcessing (spec, headSize, 40000);
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -507,6 +670,26 @@ public:
                                  ramp);
             }
         }
+
+        beginTest ("Benchmark");
+        {
+            // A 5 second stereo reverb at 48 kHz, processed in 256-sample blocks
+            const ProcessSpec benchmarkSpec { 48000.0, 256, 2 };
+            auto random = getRandom();
+            const auto ir = makeDecayingNoise (random, 2, 5 * 48000);
+
+            Convolution uniform;
+            benchmarkConvolution ("Uniform", uniform, benchmarkSpec, ir, 2.0);
+
+            for (auto headSize : { 256, 1024 })
+            {
+                Convolution onAudioThread (Convolution::NonUniform { headSize });
+                benchmarkConvolution ("Non-uniform, head " + String (headSize), onAudioThread, benchmarkSpec, ir, 2.0);
+
+                Convolution background (Convolution::NonUniform { headSize, true });
+                benchmarkConvolution ("Non-uniform with background threads, head " + String (headSize), background, benchmarkSpec, ir, 2.0);
+            }
+        }
     }
 };
 
@@ -95,6 +95,30 @@ struct FFTFallback  : public FFT::Instance
         configInverse.reset (new FFTConfig (1 << order, true));
 
         size = 1 << order;
+
+        if (size > 1)
+        {
+            // The real-only transforms are done with a complex FFT of half the size
+            const auto halfSize = size >> 1;
+
+            halfConfigForward.reset (new FFTConfig (halfSize, false));
+            halfConfigInverse.reset (new FFTConfig (halfSize, true));
+
+            realTwiddleStorage.allocate ((size_t) size + 2 * maxComplexAlignmentPadding, true);
+            forwardRealTwiddles = alignComplexPointer (realTwiddleStorage.getData());
+            inverseRealTwiddles = alignComplexPointer (forwardRealTwiddles + halfSize);
+
+            for (int i = 0; i < halfSize; ++i)
+            {
+                auto phase = i * MathConstants<double>::pi / (double) halfSize;
+
+                // -i/2 * e^(-i * phase) for the forward transform, and its conjugate for the inverse
+                forwardRealTwiddles[i] = { (float) (-0.5 * std::sin (phase)),
+                                           (float) (-0.5 * std::cos (phase)) };
+
+                inverseRealTwiddles[i] = std::conj (forwardRealTwiddles[i]);
+            }
+        }
     }
 
     void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
@@ -126,21 +150,21 @@ struct FFTFallback  : public FFT::Instance
 
     const size_t maxFFTScratchSpaceToAlloca = 256 * 1024;
 
-    void performRealOnlyForwardTransform (float* d, bool) const noexcept override
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
     {
         if (size == 1)
             return;
 
-        const size_t scratchSize = 16 + (size_t) size * sizeof (Complex<float>);
+        const size_t scratchSize = 2 * maxComplexAlignmentPadding * sizeof (Complex<float>) + (size_t) size * sizeof (Complex<float>);
 
         if (scratchSize < maxFFTScratchSpaceToAlloca)
         {
-            performRealOnlyForwardTransform (static_cast<Complex<float>*> (alloca (scratchSize)), d);
+            performRealOnlyForwardTransform (static_cast<Complex<float>*> (alloca (scratchSize)), d, ignoreNegativeFreqs);
         }
         else
         {
             HeapBlock<char> heapSpace (scratchSize);
-            performRealOnlyForwardTransform (reinterpret_cast<Complex<float>*> (heapSpace.getData()), d);
+            performRealOnlyForwardTransform (reinterpret_cast<Complex<float>*> (heapSpace.getData()), d, ignoreNegativeFreqs);
         }
     }
 
@@ -149,7 +173,7 @@ struct FFTFallback  : public FFT::Instance
         if (size == 1)
             return;
 
-        const size_t scratchSize = 16 + (size_t) size * sizeof (Complex<float>);
+        const size_t scratchSize = 2 * maxComplexAlignmentPadding * sizeof (Complex<float>) + (size_t) size * sizeof (Complex<float>);
 
         if (scratchSize < maxFFTScratchSpaceToAlloca)
         {
@@ -162,28 +186,55 @@ struct FFTFallback  : public FFT::Instance
         }
     }
 
-    void performRealOnlyForwardTransform (Complex<float>* scratch, float* d) const noexcept
+    // The even and odd input samples are used as the real and imaginary parts of a complex
+    // signal of half the length. After transforming that, the spectrum of the real signal
+    // can be separated out with one more pass over the data.
+    void performRealOnlyForwardTransform (Complex<float>* scratch, float* d, bool ignoreNegativeFreqs) const noexcept
     {
-        for (int i = 0; i < size; ++i)
-            scratch[i] = { d[i], 0 };
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto halfSize = size >> 1;
+        auto* spectrum = alignComplexPointer (scratch);
+        auto* mirrored = alignComplexPointer (spectrum + halfSize);
+        auto* output = reinterpret_cast<Complex<float>*> (d);
+
+        performHalfSize (*halfConfigForward, output, spectrum);
 
-        perform (scratch, reinterpret_cast<Complex<float>*> (d), false);
+        mirrored[0] = std::conj (spectrum[0]);
+
+        for (int i = 1; i < halfSize; ++i)
+            mirrored[i] = std::conj (spectrum[halfSize - i]);
+
+        combineHalfSpectra (spectrum, mirrored, forwardRealTwiddles, halfSize);
+
+        std::copy (mirrored, mirrored + halfSize, output);
+        output[halfSize] = { spectrum[0].real() - spectrum[0].imag(), 0.0f };
+
+        if (! ignoreNegativeFreqs)
+            for (int i = halfSize + 1; i < size; ++i)
+                output[i] = std::conj (output[size - i]);
     }
 
     void performRealOnlyInverseTransform (Complex<float>* scratch, float* d) const noexcept
     {
-        auto* input = reinterpret_cast<Complex<float>*> (d);
+        const SpinLock::ScopedLockType sl (processLock);
 
-        for (int i = size >> 1; i < size; ++i)
-            input[i] = std::conj (input[size - i]);
-
-        perform (input, scratch, true);
+        const auto halfSize = size >> 1;
+        auto* spectrum = alignComplexPointer (scratch);
+        auto* mirrored = alignComplexPointer (spectrum + halfSize);
+        auto* input = reinterpret_cast<Complex<float>*> (d);
 
-        for (int i = 0; i < size; ++i)
+        for (int i = 0; i < halfSize; ++i)
         {
-            d[i] = scratch[i].real();
-            d[i + size] = scratch[i].imag();
+            spectrum[i] = input[i];
+            mirrored[i] = std::conj (input[halfSize - i]);
         }
+
+        combineHalfSpectra (spectrum, mirrored, inverseRealTwiddles, halfSize);
+        performHalfSize (*halfConfigInverse, mirrored, input);
+
+        FloatVectorOperations::multiply (d, 1.0f / (float) halfSize, size);
+        FloatVectorOperations::clear (d + size, size);
     }
 
     //==============================================================================
@@ -413,9 +464,61 @@ struct FFTFallback  : public FFT::Instance
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTConfig)
     };
 
+    //==============================================================================
+    static void performHalfSize (const FFTConfig& config, const Complex<float>* input, Complex<float>* output) noexcept
+    {
+        if (config.fftSize == 1)
+            *output = *input;
+        else
+            config.perform (input, output);
+    }
+
+    // Replaces b[i] with (a[i] + b[i]) / 2 + twiddles[i] * (a[i] - b[i]).
+    // All three arrays must be SIMD-aligned.
+    static void combineHalfSpectra (const Complex<float>* a, Complex<float>* b, const Complex<float>* twiddles, int num) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SIMD
+        using ComplexRegister = SIMDRegister<Complex<float>>;
+        using FloatRegister   = SIMDRegister<float>;
+
+        for (const auto numPerRegister = (int) ComplexRegister::size(); i + numPerRegister <= num; i += numPerRegister)
+        {
+            const auto va = ComplexRegister::fromRawArray (a + i);
+            const auto vb = ComplexRegister::fromRawArray (b + i);
+            const auto vt = ComplexRegister::fromRawArray (twiddles + i);
+
+            // halving the sum as floats avoids a complex multiplication
+            const auto halfSum = FloatRegister::fromNative ((va + vb).value) * 0.5f;
+
+            (ComplexRegister::fromNative (halfSum.value) + vt * (va - vb)).copyToRawArray (b + i);
+        }
+       #endif
+
+        for (; i < num; ++i)
+            b[i] = 0.5f * (a[i] + b[i]) + twiddles[i] * (a[i] - b[i]);
+    }
+
+   #if JUCE_USE_SIMD
+    static constexpr size_t complexAlignment = SIMDRegister<Complex<float>>::SIMDRegisterSize;
+   #else
+    static constexpr size_t complexAlignment = sizeof (Complex<float>);
+   #endif
+
+    static constexpr size_t maxComplexAlignmentPadding = complexAlignment / sizeof (Complex<float>);
+
+    static Complex<float>* alignComplexPointer (Complex<float>* p) noexcept
+    {
+        return snapPointerToAlignment (p, complexAlignment);
+    }
+
     //==============================================================================
     SpinLock processLock;
-    std::unique_ptr<FFTConfig> configForward, configInverse;
+    std::unique_ptr<FFTConfig> configForward, configInverse, halfConfigForward, halfConfigInverse;
+    HeapBlock<Complex<float>> realTwiddleStorage;
+    Complex<float>* forwardRealTwiddles = nullptr;
+    Complex<float>* inverseRealTwiddles = nullptr;
     int size;
 };
 
@@ -66,9 +66,8 @@ public:
         it may not be necessary to calculate them for your particular application.
         You can use dontCalculateNegativeFrequencies to let the FFT
         engine know that you do not plan on using them. Note that this is only a
-        hint: some FFT engines (currently only the Fallback engine), will still
-        calculate the negative frequencies even if dontCalculateNegativeFrequencies
-        is true.
+        hint: some FFT engines may still calculate the negative frequencies
+        even if dontCalculateNegativeFrequencies is true.
 
         The size of the array passed in must be 2 * getSize(), and the first half
         should contain your raw input sample data. On return, if
@@ -133,6 +133,40 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct LargeRealTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 9; order <= 16; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                HeapBlock<float> input (n);
+                HeapBlock<Complex<float>> complexInput (n), reference (n), output (n);
+
+                fillRandom (random, input.getData(), n);
+
+                for (size_t i = 0; i < n; ++i)
+                    complexInput[i] = { input[i], 0.0f };
+
+                fft.perform (complexInput.getData(), reference.getData(), false);
+
+                zeromem (output.getData(), n * sizeof (Complex<float>));
+                memcpy (reinterpret_cast<float*> (output.getData()), input.getData(), n * sizeof (float));
+
+                fft.performRealOnlyForwardTransform ((float*) output.getData());
+                u.expect (checkArrayIsSimilar (reference.getData(), output.getData(), n));
+
+                fft.performRealOnlyInverseTransform ((float*) output.getData());
+                u.expect (checkArrayIsSimilar ((float*) output.getData(), input.getData(), n));
+            }
+        }
+    };
+
     struct FrequencyOnlyTest
     {
         static void run(FFTUnitTest& u)
@@ -192,6 +226,64 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct RealTransformBenchmark
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 6; order <= 16; ++order)
+            {
+                const auto n = (size_t) 1 << order;
+
+                // Each size processes roughly the same number of samples in total
+                const auto numIterations = jmax (16, (1 << 22) >> order);
+
+                FFT fft (order);
+
+                HeapBlock<float> input (n), spectrum (n * 2), buffer (n * 2);
+                HeapBlock<Complex<float>> complexInput (n), complexOutput (n);
+
+                fillRandom (random, input.getData(), n);
+
+                for (size_t i = 0; i < n; ++i)
+                    complexInput[i] = { input[i], 0.0f };
+
+                const auto timeTransforms = [numIterations] (auto&& transform)
+                {
+                    const auto start = Time::getHighResolutionTicks();
+
+                    for (int i = 0; i < numIterations; ++i)
+                        transform();
+
+                    return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1.0e6 / numIterations;
+                };
+
+                const auto forward = timeTransforms ([&]
+                {
+                    memcpy (buffer.getData(), input.getData(), n * sizeof (float));
+                    fft.performRealOnlyForwardTransform (buffer.getData());
+                });
+
+                memcpy (spectrum.getData(), buffer.getData(), n * 2 * sizeof (float));
+
+                const auto inverse = timeTransforms ([&]
+                {
+                    memcpy (buffer.getData(), spectrum.getData(), n * 2 * sizeof (float));
+                    fft.performRealOnlyInverseTransform (buffer.getData());
+                });
+
+                // A complex transform of the same size, which is what the real-only transforms
+                // used to cost
+                const auto complex = timeTransforms ([&] { fft.perform (complexInput.getData(), complexOutput.getData(), false); });
+
+                u.logMessage ("2^" + String (order) + ": real forward " + String (forward, 2)
+                                + " us, real inverse " + String (inverse, 2)
+                                + " us, complex " + String (complex, 2) + " us");
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -203,8 +295,10 @@ struct FFTUnitTest  : public UnitTest
     void runTest() override
     {
         runTestForAllTypes<RealTest> ("Real input numbers Test");
+        runTestForAllTypes<LargeRealTest> ("Large real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<RealTransformBenchmark> ("Real transform benchmark");
     }
 };
 
@@ -179,6 +179,11 @@ void ChildProcessMaster::killSlaveProcess()
     childProcess.reset();
 }
 
+bool ChildProcessMaster::isSlaveProcessRunning() const
+{
+    return childProcess != nullptr && childProcess->isRunning();
+}
+
 //==============================================================================
 struct ChildProcessSlave::Connection  : public InterprocessConnection,
                                         private ChildProcessPingThread
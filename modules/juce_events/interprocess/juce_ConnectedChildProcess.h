@@ -171,6 +171,13 @@ public:
     */
     void killSlaveProcess();
 
+    /** Returns true if the slave process that was launched hasn't exited or crashed.
+
+        This doesn't depend on the connection, so it can be used to find out straight
+        away if the slave has died while the master was waiting for it to reply.
+    */
+    bool isSlaveProcessRunning() const;
+
     /** This will be called to deliver a message from the slave process.
         The call will probably be made on a background thread, so be careful with your thread-safety!
     */
@@ -51,6 +51,8 @@
 
 #elif JUCE_LINUX
  #include <unistd.h>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
 #endif
 
 //==============================================================================
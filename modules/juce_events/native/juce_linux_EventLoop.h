@@ -27,9 +27,9 @@ namespace LinuxEventLoop
 {
     /** Registers a callback that will be called when a file descriptor is ready for I/O.
 
-        This will add the given file descriptor to the internal set of file descriptors
-        that will be passed to the poll() call. When this file descriptor has data to read
-        the readCallback will be called.
+        This will add the given file descriptor to the internal epoll set that the message
+        thread waits on. When this file descriptor has data to read the readCallback will
+        be called.
 
         @param fd            the file descriptor to be monitored
         @param readCallback  a callback that will be called when the file descriptor has
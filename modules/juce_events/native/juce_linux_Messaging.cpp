@@ -28,31 +28,25 @@ class InternalMessageQueue
 {
 public:
     InternalMessageQueue()
+        : wakeupFd (eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC))
     {
-        auto err = ::socketpair (AF_LOCAL, SOCK_STREAM, 0, msgpipe);
-        jassert (err == 0);
-        ignoreUnused (err);
-
-        LinuxEventLoop::registerFdCallback (getReadHandle(),
-                                            [this] (int fd)
-                                            {
-                                                while (auto msg = popNextMessage (fd))
-                                                {
-                                                    JUCE_TRY
-                                                    {
-                                                        msg->messageCallback();
-                                                    }
-                                                    JUCE_CATCH_EXCEPTION
-                                                }
-                                            });
+        jassert (wakeupFd >= 0);
+
+        LinuxEventLoop::registerFdCallback (wakeupFd, [this] (int) { dispatchMessages(); });
     }
 
     ~InternalMessageQueue()
     {
-        LinuxEventLoop::unregisterFdCallback (getReadHandle());
+        LinuxEventLoop::unregisterFdCallback (wakeupFd);
+        close (wakeupFd);
+
+        appendToBatch (pending.exchange (nullptr));
 
-        close (getReadHandle());
-        close (getWriteHandle());
+        while (batchStart != nullptr)
+        {
+            std::unique_ptr<Node> node (batchStart);
+            batchStart = node->next;
+        }
 
         clearSingletonInstance();
     }
@@ -60,16 +54,23 @@ public:
     //==============================================================================
     void postMessage (MessageManager::MessageBase* const msg) noexcept
     {
-        ScopedLock sl (lock);
-        queue.add (msg);
+        auto* node = new Node { msg, nullptr };
+        auto* previous = pending.load (std::memory_order_relaxed);
 
-        if (bytesInSocket < maxBytesInSocketQueue)
+        // Once the node has been pushed, the message thread may take it and delete it at
+        // any moment, so the old head is kept in a local rather than read back from the node
+        do
         {
-            bytesInSocket++;
+            node->next = previous;
+        }
+        while (! pending.compare_exchange_weak (previous, node, std::memory_order_release, std::memory_order_relaxed));
 
-            ScopedUnlock ul (lock);
-            unsigned char x = 0xff;
-            auto numBytes = write (getWriteHandle(), &x, 1);
+        // Only the message that makes the queue non-empty needs to wake the message thread - any
+        // others will be picked up in the same batch
+        if (previous == nullptr)
+        {
+            uint64_t one = 1;
+            auto numBytes = write (wakeupFd, &one, sizeof (one));
             ignoreUnused (numBytes);
         }
     }
@@ -78,31 +79,86 @@ public:
     JUCE_DECLARE_SINGLETON (InternalMessageQueue, false)
 
 private:
-    CriticalSection lock;
-    ReferenceCountedArray <MessageManager::MessageBase> queue;
+    struct Node
+    {
+        MessageManager::MessageBase::Ptr message;
+        Node* next;
+    };
 
-    int msgpipe[2];
-    int bytesInSocket = 0;
-    static constexpr int maxBytesInSocketQueue = 128;
+    // A lock-free stack that the posting threads push onto, and which the message
+    // thread takes in one go and reverses to get the messages in the order they were posted
+    std::atomic<Node*> pending { nullptr };
+    const int wakeupFd;
 
-    int getWriteHandle() const noexcept  { return msgpipe[0]; }
-    int getReadHandle() const noexcept   { return msgpipe[1]; }
+    // These are only used by the message thread
+    Node* batchStart = nullptr;
+    Node* batchEnd = nullptr;
+    bool wakeupSignalled = false;
 
-    MessageManager::MessageBase::Ptr popNextMessage (int fd) noexcept
+    void dispatchMessages()
     {
-        const ScopedLock sl (lock);
+        // The eventfd must be reset before taking the queue, so that anything posted
+        // after that point will trigger another wake-up
+        uint64_t count;
+        auto numBytes = read (wakeupFd, &count, sizeof (count));
+        ignoreUnused (numBytes);
+        wakeupSignalled = false;
 
-        if (bytesInSocket > 0)
+        appendToBatch (pending.exchange (nullptr, std::memory_order_acquire));
+
+        while (batchStart != nullptr)
         {
-            --bytesInSocket;
+            std::unique_ptr<Node> node (batchStart);
+            batchStart = node->next;
 
-            ScopedUnlock ul (lock);
-            unsigned char x;
-            auto numBytes = read (fd, &x, 1);
-            ignoreUnused (numBytes);
+            if (batchStart == nullptr)
+                batchEnd = nullptr;
+            else
+                signalRestOfBatch();
+
+            JUCE_TRY
+            {
+                node->message->messageCallback();
+            }
+            JUCE_CATCH_EXCEPTION
+        }
+    }
+
+    void appendToBatch (Node* newestFirst) noexcept
+    {
+        Node* oldestFirst = nullptr;
+        auto* last = newestFirst;
+
+        while (newestFirst != nullptr)
+        {
+            auto* next = newestFirst->next;
+            newestFirst->next = oldestFirst;
+            oldestFirst = newestFirst;
+            newestFirst = next;
         }
 
-        return queue.removeAndReturn (0);
+        if (oldestFirst == nullptr)
+            return;
+
+        if (batchEnd != nullptr)
+            batchEnd->next = oldestFirst;
+        else
+            batchStart = oldestFirst;
+
+        batchEnd = last;
+    }
+
+    // If a callback runs a modal loop, the messages left in the current batch must still
+    // be able to wake it up, so while a batch is being dispatched, the eventfd is kept set
+    void signalRestOfBatch() noexcept
+    {
+        if (! wakeupSignalled)
+        {
+            wakeupSignalled = true;
+            uint64_t one = 1;
+            auto numBytes = write (wakeupFd, &one, sizeof (one));
+            ignoreUnused (numBytes);
+        }
     }
 };
 
@@ -113,10 +169,17 @@ struct InternalRunLoop
 {
 public:
     InternalRunLoop()
+        : epollFd (epoll_create1 (EPOLL_CLOEXEC))
     {
+        jassert (epollFd >= 0);
         fdReadCallbacks.reserve (16);
     }
 
+    ~InternalRunLoop()
+    {
+        close (epollFd);
+    }
+
     void registerFdCallback (int fd, std::function<void (int)>&& cb, short eventMask)
     {
         const ScopedLock sl (lock);
@@ -130,8 +193,29 @@ public:
             return;
         }
 
+        // the poll() event flags have the same values as the epoll ones
+        auto mask = (uint32_t) (uint16) eventMask;
+
+        auto existing = std::find_if (fdEventMasks.begin(), fdEventMasks.end(),
+                                      [fd] (const std::pair<int, uint32_t>& f) { return f.first == fd; });
+
+        epoll_event event {};
+        event.data.fd = fd;
+
+        if (existing != fdEventMasks.end())
+        {
+            existing->second |= mask;
+            event.events = existing->second;
+            epoll_ctl (epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+        else
+        {
+            fdEventMasks.push_back ({ fd, mask });
+            event.events = mask;
+            epoll_ctl (epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+
         fdReadCallbacks.push_back ({ fd, std::move (cb) });
-        pfds.push_back ({ fd, eventMask, 0 });
     }
 
     void unregisterFdCallback (int fd)
@@ -152,30 +236,31 @@ public:
         }
 
         {
-            auto removePredicate = [=] (const pollfd& pfd)  { return pfd.fd == fd; };
+            auto removePredicate = [=] (const std::pair<int, uint32_t>& f)  { return f.first == fd; };
 
-            pfds.erase (std::remove_if (std::begin (pfds), std::end (pfds), removePredicate),
-                        std::end (pfds));
+            fdEventMasks.erase (std::remove_if (std::begin (fdEventMasks), std::end (fdEventMasks), removePredicate),
+                                std::end (fdEventMasks));
         }
+
+        epoll_event event {};
+        epoll_ctl (epollFd, EPOLL_CTL_DEL, fd, &event);
     }
 
     bool dispatchPendingEvents()
     {
         const ScopedLock sl (lock);
 
-        if (poll (&pfds.front(), static_cast<nfds_t> (pfds.size()), 0) == 0)
+        epoll_event events[maxEventsPerWait];
+        auto numEvents = epoll_wait (epollFd, events, maxEventsPerWait, 0);
+
+        if (numEvents <= 0)
             return false;
 
         bool eventWasSent = false;
 
-        for (auto& pfd : pfds)
+        for (int i = 0; i < numEvents; ++i)
         {
-            if (pfd.revents == 0)
-                continue;
-
-            pfd.revents = 0;
-
-            auto fd = pfd.fd;
+            auto fd = events[i].data.fd;
 
             for (auto& fdAndCallback : fdReadCallbacks)
             {
@@ -193,8 +278,8 @@ public:
 
                         deferredReadCallbackModifications.clear();
 
-                        // elements may have been removed from the fdReadCallbacks/pfds array so we really need
-                        // to call poll again
+                        // elements may have been removed from the fdReadCallbacks array so we really need
+                        // to wait for events again
                         return true;
                     }
 
@@ -208,7 +293,10 @@ public:
 
     void sleepUntilNextEvent (int timeoutMs)
     {
-        poll (&pfds.front(), static_cast<nfds_t> (pfds.size()), timeoutMs);
+        // the fds are level-triggered, so any events that this returns will
+        // still be there for dispatchPendingEvents() to pick up
+        epoll_event event;
+        epoll_wait (epollFd, &event, 1, timeoutMs);
     }
 
     std::vector<std::pair<int, std::function<void (int)>>> getFdReadCallbacks()
@@ -221,10 +309,13 @@ public:
     JUCE_DECLARE_SINGLETON (InternalRunLoop, false)
 
 private:
+    static constexpr int maxEventsPerWait = 16;
+
     CriticalSection lock;
+    const int epollFd;
 
     std::vector<std::pair<int, std::function<void (int)>>> fdReadCallbacks;
-    std::vector<pollfd> pfds;
+    std::vector<std::pair<int, uint32_t>> fdEventMasks;
 
     bool shouldDeferModifyingReadCallbacks = false;
     std::vector<std::function<void()>> deferredReadCallbackModifications;
@@ -323,6 +414,123 @@ void LinuxEventLoop::unregisterFdCallback (int fd)
         runLoop->unregisterFdCallback (fd);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_MODAL_LOOPS_PERMITTED
+
+class LinuxMessageQueueTests  : public UnitTest
+{
+public:
+    LinuxMessageQueueTests()
+        : UnitTest ("Linux message queue", UnitTestCategories::threads)
+    {}
+
+    struct ProducerThread  : public Thread
+    {
+        ProducerThread (WaitableEvent& startEventToUse, std::function<void()> postMessagesToUse)
+            : Thread ("Message producer"), startEvent (startEventToUse), postMessages (std::move (postMessagesToUse))
+        {}
+
+        void run() override
+        {
+            startEvent.wait();
+            postMessages();
+        }
+
+        WaitableEvent& startEvent;
+        std::function<void()> postMessages;
+    };
+
+    // Posts messages from several threads at once while the message thread is dispatching them,
+    // and returns the time taken for all of them to arrive
+    static double postFromThreads (int numThreads, int numMessagesPerThread, Array<Array<int>>& received)
+    {
+        received.clearQuick();
+        received.resize (numThreads);
+
+        int numReceived = 0;
+        WaitableEvent startEvent (true);
+        OwnedArray<ProducerThread> producers;
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            producers.add (new ProducerThread (startEvent, [i, numMessagesPerThread, &received, &numReceived]
+            {
+                for (int j = 0; j < numMessagesPerThread; ++j)
+                    MessageManager::callAsync ([i, j, &received, &numReceived]
+                                               {
+                                                   received.getReference (i).add (j);
+                                                   ++numReceived;
+                                               });
+            }));
+
+            producers.getLast()->startThread();
+        }
+
+        auto start = Time::getHighResolutionTicks();
+        startEvent.signal();
+
+        auto* messageManager = MessageManager::getInstance();
+        auto timeout = Time::getMillisecondCounter() + 60000;
+
+        while (numReceived < numThreads * numMessagesPerThread && Time::getMillisecondCounter() < timeout)
+            messageManager->runDispatchLoopUntil (1);
+
+        auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+        for (auto* producer : producers)
+            producer->stopThread (10000);
+
+        // give any messages that were posted more than once a chance to show up
+        messageManager->runDispatchLoopUntil (20);
+
+        return seconds;
+    }
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser;
+
+        beginTest ("Messages from many threads arrive once each, in the order each thread posted them");
+        {
+            const int numThreads = 4, numMessagesPerThread = 20000;
+            Array<Array<int>> received;
+            postFromThreads (numThreads, numMessagesPerThread, received);
+
+            for (auto& messages : received)
+            {
+                expectEquals (messages.size(), numMessagesPerThread);
+
+                bool inOrder = true;
+
+                for (int i = 0; i < messages.size(); ++i)
+                    inOrder = inOrder && messages.getUnchecked (i) == i;
+
+                expect (inOrder);
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            const int numMessagesPerThread = 100000;
+
+            for (auto numThreads : { 1, 4 })
+            {
+                Array<Array<int>> received;
+                auto seconds = postFromThreads (numThreads, numMessagesPerThread, received);
+
+                logMessage (String (numThreads) + (numThreads == 1 ? " posting thread, " : " posting threads, ")
+                              + String (numThreads * numMessagesPerThread) + " messages: "
+                              + String (numThreads * numMessagesPerThread / (seconds * 1.0e6), 2) + " million posts/s");
+            }
+        }
+    }
+};
+
+static LinuxMessageQueueTests linuxMessageQueueTests;
+
+#endif
+
 } // namespace juce
 
 JUCE_API std::vector<std::pair<int, std::function<void (int)>>> getFdReadCallbacks()
@@ -49,17 +49,11 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -95,18 +89,30 @@ public:
 
         const LockType::ScopedLockType sl (lock);
 
+        // Every timer that's due within the same tick gets called from this one message,
+        // rather than each of them waking the thread and posting a message of its own
+        auto now = Time::getMillisecondCounterHiRes();
+        auto batchEnd = now + coalescingWindowMs;
+        bool anyCalled = false;
+
         while (! timers.empty())
         {
             auto& first = timers.front();
 
-            if (first.countdownMs > 0)
+            if (first.dueTime > batchEnd)
                 break;
 
             auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
+            auto lateness = Time::getMillisecondCounterHiRes() - first.dueTime;
+
+            first.dueTime = now + timer->timerPeriodMs;
+            first.order = nextOrder++;
+            siftDown (0);
             notify();
 
+            statistics.add (lateness);
+            anyCalled = true;
+
             const LockType::ScopedUnlockType ul (lock);
 
             JUCE_TRY
@@ -120,6 +126,9 @@ public:
                 break;
         }
 
+        if (anyCalled)
+            ++statistics.numBatches;
+
         callbackArrived.signal();
     }
 
@@ -156,17 +165,70 @@ public:
             instance->resetTimerCounter (tim);
     }
 
+    static DispatchStatistics getStatistics() noexcept
+    {
+        const LockType::ScopedLockType sl (lock);
+        return statistics.get();
+    }
+
+    static void resetStatistics() noexcept
+    {
+        const LockType::ScopedLockType sl (lock);
+        statistics = {};
+    }
+
     static TimerThread* instance;
     static LockType lock;
 
 private:
+    // Timers that fall due within this long of each other are called together
+    static constexpr double coalescingWindowMs = 0.5;
+
     struct TimerCountdown
     {
         Timer* timer;
-        int countdownMs;
+        double dueTime;
+        uint64 order;
+
+        bool operator< (const TimerCountdown& other) const noexcept
+        {
+            return dueTime < other.dueTime || (dueTime == other.dueTime && order < other.order);
+        }
     };
 
+    struct StatisticsAccumulator
+    {
+        uint64 numCallbacks = 0, numBatches = 0;
+        double totalLateness = 0, totalLatenessSquared = 0, maxLateness = 0;
+
+        void add (double lateness) noexcept
+        {
+            ++numCallbacks;
+            totalLateness += lateness;
+            totalLatenessSquared += lateness * lateness;
+            maxLateness = jmax (maxLateness, lateness);
+        }
+
+        DispatchStatistics get() const noexcept
+        {
+            DispatchStatistics result { numCallbacks, numBatches, 0.0, maxLateness, 0.0 };
+
+            if (numCallbacks > 0)
+            {
+                result.meanLatenessMs = totalLateness / (double) numCallbacks;
+                result.jitterMs = std::sqrt (jmax (0.0, totalLatenessSquared / (double) numCallbacks
+                                                          - result.meanLatenessMs * result.meanLatenessMs));
+            }
+
+            return result;
+        }
+    };
+
+    // A binary min-heap ordered by due time, so that adding, removing or resetting
+    // a timer is O(log n), and nothing needs to be touched as time passes
     std::vector<TimerCountdown> timers;
+    uint64 nextOrder = 0;
+    static StatisticsAccumulator statistics;
 
     WaitableEvent callbackArrived;
 
@@ -191,9 +253,9 @@ private:
 
         auto pos = timers.size();
 
-        timers.push_back ({ t, t->timerPeriodMs });
+        timers.push_back ({ t, Time::getMillisecondCounterHiRes() + t->timerPeriodMs, nextOrder++ });
         t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
+        siftUp (pos);
         notify();
     }
 
@@ -205,13 +267,19 @@ private:
         jassert (pos <= lastIndex);
         jassert (timers[pos].timer == t);
 
-        for (auto i = pos; i < lastIndex; ++i)
+        if (pos != lastIndex)
         {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
+            timers[pos] = timers[lastIndex];
+            timers[pos].timer->positionInQueue = pos;
+            timers.pop_back();
+            updatePosition (pos);
+        }
+        else
+        {
+            timers.pop_back();
         }
 
-        timers.pop_back();
+        t->positionInQueue = (size_t) -1;
     }
 
     void resetTimerCounter (Timer* t) noexcept
@@ -221,83 +289,75 @@ private:
         jassert (pos < timers.size());
         jassert (timers[pos].timer == t);
 
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
-
-        if (newCountdown != lastCountdown)
-        {
-            timers[pos].countdownMs = newCountdown;
-
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
+        timers[pos].dueTime = Time::getMillisecondCounterHiRes() + t->timerPeriodMs;
+        timers[pos].order = nextOrder++;
+        updatePosition (pos);
+        notify();
+    }
 
-            notify();
-        }
+    void updatePosition (size_t pos) noexcept
+    {
+        if (pos > 0 && timers[pos] < timers[(pos - 1) / 2])
+            siftUp (pos);
+        else
+            siftDown (pos);
     }
 
-    void shuffleTimerBackInQueue (size_t pos)
+    void siftUp (size_t pos) noexcept
     {
-        auto numTimers = timers.size();
+        auto t = timers[pos];
 
-        if (pos < numTimers - 1)
+        while (pos > 0)
         {
-            auto t = timers[pos];
+            auto parent = (pos - 1) / 2;
 
-            for (;;)
-            {
-                auto next = pos + 1;
-
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
-                    break;
-
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
-
-                ++pos;
-            }
+            if (! (t < timers[parent]))
+                break;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            timers[pos] = timers[parent];
+            timers[pos].timer->positionInQueue = pos;
+            pos = parent;
         }
+
+        timers[pos] = t;
+        t.timer->positionInQueue = pos;
     }
 
-    void shuffleTimerForwardInQueue (size_t pos)
+    void siftDown (size_t pos) noexcept
     {
-        if (pos > 0)
-        {
-            auto t = timers[pos];
+        auto numTimers = timers.size();
+        auto t = timers[pos];
 
-            while (pos > 0)
-            {
-                auto& prev = timers[(size_t) pos - 1];
+        for (;;)
+        {
+            auto child = 2 * pos + 1;
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
+            if (child >= numTimers)
+                break;
 
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+            if (child + 1 < numTimers && timers[child + 1] < timers[child])
+                ++child;
 
-                --pos;
-            }
+            if (! (timers[child] < t))
+                break;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            timers[pos] = timers[child];
+            timers[pos].timer->positionInQueue = pos;
+            pos = child;
         }
+
+        timers[pos] = t;
+        t.timer->positionInQueue = pos;
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
         if (timers.empty())
             return 1000;
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
-
-        return timers.front().countdownMs;
+        return (int) std::ceil (timers.front().dueTime - Time::getMillisecondCounterHiRes() - coalescingWindowMs);
     }
 
     void handleAsyncUpdate() override
@@ -310,6 +370,7 @@ private:
 
 Timer::TimerThread* Timer::TimerThread::instance = nullptr;
 Timer::TimerThread::LockType Timer::TimerThread::lock;
+Timer::TimerThread::StatisticsAccumulator Timer::TimerThread::statistics;
 
 //==============================================================================
 Timer::Timer() noexcept {}
@@ -356,6 +417,16 @@ void Timer::stopTimer() noexcept
     }
 }
 
+Timer::DispatchStatistics JUCE_CALLTYPE Timer::getDispatchStatistics()
+{
+    return TimerThread::getStatistics();
+}
+
+void JUCE_CALLTYPE Timer::resetDispatchStatistics()
+{
+    TimerThread::resetStatistics();
+}
+
 void JUCE_CALLTYPE Timer::callPendingTimersSynchronously()
 {
     if (TimerThread::instance != nullptr)
@@ -386,4 +457,223 @@ void JUCE_CALLTYPE Timer::callAfterDelay (int milliseconds, std::function<void()
     new LambdaInvoker (milliseconds, f);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TimerTests  : public UnitTest
+{
+public:
+    TimerTests()
+        : UnitTest ("Timer", UnitTestCategories::time)
+    {}
+
+    // A one-shot timer that records its index when it fires
+    struct RecordingTimer  : public Timer
+    {
+        RecordingTimer (Array<int>& logToUse, int indexToUse)  : log (logToUse), index (indexToUse) {}
+
+        void timerCallback() override
+        {
+            stopTimer();
+            log.add (index);
+
+            if (onCallback != nullptr)
+                onCallback();
+        }
+
+        Array<int>& log;
+        int index;
+        std::function<void()> onCallback;
+    };
+
+    // There's no message loop running in the tests, so the timers are called directly
+    static void callTimersUntil (std::function<bool()> isDone, int timeoutMs = 5000)
+    {
+        auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        while (! isDone() && Time::getMillisecondCounter() < endTime)
+        {
+            Thread::sleep (1);
+            Timer::callPendingTimersSynchronously();
+        }
+    }
+
+    static Array<int> getIndexesSortedBy (const Array<int>& intervals)
+    {
+        Array<int> indexes;
+
+        for (int i = 0; i < intervals.size(); ++i)
+            if (intervals[i] > 0)
+                indexes.add (i);
+
+        std::sort (indexes.begin(), indexes.end(), [&] (int a, int b) { return intervals[a] < intervals[b]; });
+        return indexes;
+    }
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser;
+        auto r = getRandom();
+
+        // All the intervals used in a test are different multiples of this, which leaves
+        // plenty of room for the time taken to start the timers
+        const int intervalStepMs = 4;
+
+        beginTest ("Timers with mixed intervals fire in order");
+        {
+            Array<int> log, intervals;
+            OwnedArray<RecordingTimer> timers;
+
+            for (int i = 0; i < 30; ++i)
+            {
+                intervals.add ((i + 1) * intervalStepMs);
+                timers.add (new RecordingTimer (log, i));
+            }
+
+            for (int i = intervals.size(); --i > 0;)
+                intervals.swap (i, r.nextInt (i + 1));
+
+            for (int i = 0; i < timers.size(); ++i)
+                timers[i]->startTimer (intervals[i]);
+
+            callTimersUntil ([&] { return log.size() == timers.size(); });
+
+            expect (log == getIndexesSortedBy (intervals));
+        }
+
+        beginTest ("Timers can be stopped, started and restarted while they're queued");
+        {
+            for (int trial = 0; trial < 10; ++trial)
+            {
+                Array<int> log, intervals, unusedIntervals;
+                OwnedArray<RecordingTimer> timers;
+
+                for (int i = 0; i < 50; ++i)
+                    unusedIntervals.add ((i + 1) * intervalStepMs);
+
+                auto takeInterval = [&]
+                {
+                    auto interval = unusedIntervals[r.nextInt (unusedIntervals.size())];
+                    unusedIntervals.removeFirstMatchingValue (interval);
+                    return interval;
+                };
+
+                for (int i = 0; i < 25; ++i)
+                {
+                    timers.add (new RecordingTimer (log, i));
+                    intervals.add (takeInterval());
+                    timers[i]->startTimer (intervals[i]);
+                }
+
+                // Stopping and restarting timers at random moves them around inside the
+                // queue, and takes them out of the middle of it
+                for (int i = 0; i < 40; ++i)
+                {
+                    auto index = r.nextInt (timers.size());
+                    auto& timer = *timers[index];
+
+                    if (timer.isTimerRunning() && r.nextBool())
+                    {
+                        timer.stopTimer();
+                        unusedIntervals.add (intervals[index]);
+                        intervals.set (index, 0);
+                    }
+                    else if (unusedIntervals.size() > 0)
+                    {
+                        if (intervals[index] > 0)
+                            unusedIntervals.add (intervals[index]);
+
+                        intervals.set (index, takeInterval());
+                        timer.startTimer (intervals[index]);
+                        expectEquals (timer.getTimerInterval(), intervals[index]);
+                    }
+                }
+
+                auto expectedOrder = getIndexesSortedBy (intervals);
+                callTimersUntil ([&] { return log.size() == expectedOrder.size(); });
+
+                Thread::sleep (intervalStepMs);
+                Timer::callPendingTimersSynchronously();
+
+                expect (log == expectedOrder);
+            }
+        }
+
+        beginTest ("A restarted timer uses its new interval");
+        {
+            Array<int> log;
+            RecordingTimer shorter (log, 0), reference (log, 1), longer (log, 2);
+
+            shorter.startTimer (200);
+            reference.startTimer (100);
+            longer.startTimer (10);
+
+            shorter.startTimer (10);
+            longer.startTimer (200);
+
+            callTimersUntil ([&] { return log.size() == 3; });
+            expect (log == Array<int> (0, 1, 2));
+        }
+
+        beginTest ("Timers can be stopped and started by other timers' callbacks");
+        {
+            Array<int> log;
+            RecordingTimer first (log, 0), stopped (log, 1), started (log, 2);
+
+            first.onCallback = [&]
+            {
+                stopped.stopTimer();
+                started.startTimer (intervalStepMs);
+            };
+
+            first.startTimer (intervalStepMs);
+            stopped.startTimer (intervalStepMs * 2);
+
+            // Both of the first two are due by the time the timers are called
+            Thread::sleep (intervalStepMs * 4);
+            callTimersUntil ([&] { return log.size() == 2; });
+
+            expect (log == Array<int> (0, 2));
+        }
+
+        beginTest ("Dispatch statistics");
+        {
+            Timer::resetDispatchStatistics();
+            auto stats = Timer::getDispatchStatistics();
+            expectEquals ((int) stats.numCallbacks, 0);
+            expectEquals ((int) stats.numBatches, 0);
+            expectEquals (stats.maxLatenessMs, 0.0);
+
+            Array<int> log;
+            OwnedArray<RecordingTimer> timers;
+
+            for (int i = 0; i < 5; ++i)
+                timers.add (new RecordingTimer (log, i))->startTimer (10);
+
+            // All five are due together, so they should be called from one batch
+            Thread::sleep (30);
+            Timer::callPendingTimersSynchronously();
+            expectEquals (log.size(), 5);
+
+            stats = Timer::getDispatchStatistics();
+            expectEquals ((int) stats.numCallbacks, 5);
+            expectEquals ((int) stats.numBatches, 1);
+            expect (stats.meanLatenessMs >= 10.0);
+            expect (stats.maxLatenessMs >= stats.meanLatenessMs);
+            expect (stats.jitterMs >= 0.0 && stats.jitterMs <= stats.maxLatenessMs);
+
+            Timer::resetDispatchStatistics();
+            stats = Timer::getDispatchStatistics();
+            expectEquals ((int) stats.numCallbacks, 0);
+            expectEquals ((int) stats.numBatches, 0);
+            expectEquals (stats.meanLatenessMs, 0.0);
+        }
+    }
+};
+
+static TimerTests timerTests;
+
+#endif
+
 } // namespace juce
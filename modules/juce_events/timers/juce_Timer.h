@@ -119,6 +119,32 @@ public:
     /** Invokes a lambda after a given number of milliseconds. */
     static void JUCE_CALLTYPE callAfterDelay (int milliseconds, std::function<void()> functionToCall);
 
+    //==============================================================================
+    /** Describes how promptly timer callbacks have been delivered.
+        @see getDispatchStatistics
+    */
+    struct DispatchStatistics
+    {
+        uint64 numCallbacks;        /**< The number of timerCallback() calls that have been made. */
+        uint64 numBatches;          /**< The number of message-thread callbacks that were used to make them. */
+        double meanLatenessMs;      /**< The average time between a callback falling due and it being made. */
+        double maxLatenessMs;       /**< The longest time between a callback falling due and it being made. */
+        double jitterMs;            /**< The standard deviation of the lateness. */
+    };
+
+    /** Returns statistics about all the timer callbacks made since the app started,
+        or since resetDispatchStatistics() was last called.
+
+        Timers that fall due at the same moment are called together from a single message,
+        so numBatches will usually be much lower than numCallbacks when lots of timers
+        are running. A large jitter or lateness means that the message thread is too busy
+        to service the timers on time.
+    */
+    static DispatchStatistics JUCE_CALLTYPE getDispatchStatistics();
+
+    /** Resets the values returned by getDispatchStatistics(). */
+    static void JUCE_CALLTYPE resetDispatchStatistics();
+
     //==============================================================================
     /** For internal use only: invokes any timers that need callbacks.
         Don't call this unless you really know what you're doing!
@@ -41,4 +41,336 @@ LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer (const Image&
 
 LowLevelGraphicsSoftwareRenderer::~LowLevelGraphicsSoftwareRenderer() {}
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+#if ! JUCE_ARM
+/*  A plain C++ model of the NEON intrinsics used by the pixel span kernels. This lets the
+    NEON code be compiled and checked on machines that can't run it; on ARM the real
+    kernels are tested directly instead, since some compilers implement these as macros.
+*/
+namespace NEONPixelSpanModel
+{
+    struct uint8x8_t    { uint8 v[8]; };
+    struct uint16x8_t   { uint16 v[8]; };
+    struct uint8x8x4_t  { uint8x8_t val[4]; };
+
+    static uint8x8x4_t vld4_u8 (const uint8* p) noexcept
+    {
+        uint8x8x4_t r;
+
+        for (int i = 0; i < 8; ++i)
+            for (int c = 0; c < 4; ++c)
+                r.val[c].v[i] = p[i * 4 + c];
+
+        return r;
+    }
+
+    static void vst4_u8 (uint8* p, uint8x8x4_t d) noexcept
+    {
+        for (int i = 0; i < 8; ++i)
+            for (int c = 0; c < 4; ++c)
+                p[i * 4 + c] = d.val[c].v[i];
+    }
+
+    template <typename Op>
+    static uint16x8_t eachLane (Op op) noexcept
+    {
+        uint16x8_t r;
+
+        for (int i = 0; i < 8; ++i)
+            r.v[i] = (uint16) op (i);
+
+        return r;
+    }
+
+    static uint16x8_t vmovl_u8 (uint8x8_t a) noexcept                   { return eachLane ([&] (int i) { return a.v[i]; }); }
+    static uint16x8_t vdupq_n_u16 (uint16 a) noexcept                   { return eachLane ([&] (int)   { return a; }); }
+    static uint16x8_t vaddq_u16 (uint16x8_t a, uint16x8_t b) noexcept   { return eachLane ([&] (int i) { return a.v[i] + b.v[i]; }); }
+    static uint16x8_t vsubq_u16 (uint16x8_t a, uint16x8_t b) noexcept   { return eachLane ([&] (int i) { return a.v[i] - b.v[i]; }); }
+    static uint16x8_t vmulq_u16 (uint16x8_t a, uint16x8_t b) noexcept   { return eachLane ([&] (int i) { return a.v[i] * b.v[i]; }); }
+    static uint16x8_t vshrq_n_u16 (uint16x8_t a, int n) noexcept        { return eachLane ([&] (int i) { return a.v[i] >> n; }); }
+
+    static uint8x8_t vqmovn_u16 (uint16x8_t a) noexcept
+    {
+        uint8x8_t r;
+
+        for (int i = 0; i < 8; ++i)
+            r.v[i] = (uint8) jmin ((int) a.v[i], 255);
+
+        return r;
+    }
+
+    struct Vectorised
+    {
+        #include "../native/juce_RenderingHelpers_NEON.h"
+    };
+}
+#endif
+
+class SoftwareRendererPixelSpanTests  : public UnitTest
+{
+public:
+    SoftwareRendererPixelSpanTests()
+        : UnitTest ("Software renderer pixel spans", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        auto randomPixel = [&r]
+        {
+            return PixelARGB ((uint8) r.nextInt (256), (uint8) r.nextInt (256),
+                              (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+        };
+
+        // This mixes in some pixels that aren't validly premultiplied, to make sure
+        // that they saturate in the same way as the scalar code.
+        auto makeLine = [&] (int size)
+        {
+            std::vector<PixelARGB> line ((size_t) size);
+
+            for (auto& p : line)
+            {
+                switch (r.nextInt (4))
+                {
+                    case 0:   p = randomPixel(); break;
+                    case 1:   p = PixelARGB (0, 0, 0, 0); break;
+                    case 2:   p = Colour ((uint32) r.nextInt() | 0xff000000).getPixelARGB(); break;
+                    default:  p = Colour ((uint32) r.nextInt()).getPixelARGB(); break;
+                }
+            }
+
+            return line;
+        };
+
+        auto expectSameLine = [this] (const std::vector<PixelARGB>& a, const std::vector<PixelARGB>& b)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                if (a[i].getNativeARGB() != b[i].getNativeARGB())
+                    return expect (false, "Pixel " + String (i) + " differs");
+
+            expect (true);
+        };
+
+        constexpr int stride = (int) sizeof (PixelARGB);
+
+        beginTest ("Solid colour");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                auto width = 1 + r.nextInt (70);
+                auto offset = r.nextInt (3);
+                auto colour = i % 2 == 0 ? randomPixel() : makeLine (1)[0];
+                auto expected = makeLine (width + offset);
+                auto actual = expected;
+
+                for (int x = offset; x < width + offset; ++x)
+                    expected[(size_t) x].blend (colour);
+
+                RenderingHelpers::PixelSpans::blendLine (actual.data() + offset, stride, colour, width);
+                expectSameLine (expected, actual);
+            }
+        }
+
+        beginTest ("Source pixels");
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                auto width = 1 + r.nextInt (70);
+                auto offset = r.nextInt (3);
+                auto src = makeLine (width + 3);
+                auto expected = makeLine (width + offset);
+                auto actual = expected;
+
+                for (int x = 0; x < width; ++x)
+                    expected[(size_t) (x + offset)].blend (src[(size_t) x + 1]);
+
+                RenderingHelpers::PixelSpans::blendLine (actual.data() + offset, stride, src.data() + 1, stride, width);
+                expectSameLine (expected, actual);
+            }
+        }
+
+        beginTest ("Source pixels with extra alpha");
+        {
+            for (int i = 0; i < 400; ++i)
+            {
+                auto width = 1 + r.nextInt (70);
+                auto offset = r.nextInt (3);
+                auto extraAlpha = (uint32) r.nextInt (257);
+                auto src = makeLine (width);
+                auto expected = makeLine (width + offset);
+                auto actual = expected;
+
+                for (int x = 0; x < width; ++x)
+                    expected[(size_t) (x + offset)].blend (src[(size_t) x], extraAlpha);
+
+                RenderingHelpers::PixelSpans::blendLine (actual.data() + offset, stride, src.data(), stride, width, extraAlpha);
+                expectSameLine (expected, actual);
+            }
+        }
+
+        beginTest ("Tiled image fill");
+        {
+            Image tile (Image::ARGB, 7, 5, false);
+
+            for (int y = 0; y < tile.getHeight(); ++y)
+                for (int x = 0; x < tile.getWidth(); ++x)
+                    tile.setPixelAt (x, y, Colour ((uint8) (x * 30), (uint8) (y * 40), (uint8) (x + y), (uint8) 255));
+
+            Image dest (Image::ARGB, 61, 23, true);
+
+            {
+                Graphics g (dest);
+                g.setTiledImageFill (tile, 3, -2, 1.0f);
+                g.fillRect (dest.getBounds());
+            }
+
+            bool allMatch = true;
+
+            for (int y = 0; y < dest.getHeight(); ++y)
+                for (int x = 0; x < dest.getWidth(); ++x)
+                    allMatch = allMatch && dest.getPixelAt (x, y) == tile.getPixelAt (negativeAwareModulo (x - 3, 7),
+                                                                                         negativeAwareModulo (y + 2, 5));
+
+            expect (allMatch);
+        }
+
+        // Checks the vector kernels on their own, without the scalar code that finishes
+        // off the end of each line in blendLine().
+        auto checkKernels = [&] (auto kernels, const String& testName)
+        {
+            using Kernels = decltype (kernels);
+
+            beginTest (testName);
+
+            auto expectBlended = [&] (const std::vector<PixelARGB>& before, const std::vector<PixelARGB>& actual,
+                                      int width, int numDone, std::function<void (PixelARGB&, int)> blendScalar)
+            {
+                expect (numDone <= width && numDone > width - 8, "Processed " + String (numDone) + " of " + String (width));
+
+                auto expected = before;
+
+                for (int x = 0; x < numDone; ++x)
+                    blendScalar (expected[(size_t) x], x);
+
+                expectSameLine (expected, actual);
+            };
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto width = 1 + r.nextInt (70);
+                auto colour = i % 2 == 0 ? randomPixel() : makeLine (1)[0];
+                auto before = makeLine (width);
+                auto actual = before;
+
+                auto numDone = Kernels::blendColour (actual.data(), colour, width);
+                expectBlended (before, actual, width, numDone, [&] (PixelARGB& p, int) { p.blend (colour); });
+            }
+
+            for (int i = 0; i < 400; ++i)
+            {
+                auto width = 1 + r.nextInt (70);
+                auto extraAlpha = (uint32) r.nextInt (257);
+                auto src = makeLine (width);
+                auto before = makeLine (width);
+                auto actual = before;
+
+                auto numDone = i % 2 == 0 ? Kernels::blendPixels (actual.data(), src.data(), width)
+                                          : Kernels::blendPixels (actual.data(), src.data(), width, extraAlpha);
+
+                expectBlended (before, actual, width, numDone, [&] (PixelARGB& p, int x)
+                {
+                    if (i % 2 == 0)
+                        p.blend (src[(size_t) x]);
+                    else
+                        p.blend (src[(size_t) x], extraAlpha);
+                });
+            }
+        };
+
+       #if JUCE_USE_SIMD_PIXEL_BLENDING
+        checkKernels (RenderingHelpers::PixelSpans::Vectorised(), "Vectorised kernels");
+       #endif
+
+       #if ! JUCE_ARM
+        checkKernels (NEONPixelSpanModel::Vectorised(), "NEON kernels, using a model of the intrinsics");
+       #endif
+
+        beginTest ("Benchmark");
+        {
+            constexpr int size = 1024;
+            constexpr int numRepeats = 20;
+
+            auto src = makeLine (size);
+            auto dest = makeLine (size);
+            auto colour = Colour (0x80336699).getPixelARGB();
+
+            auto timeLines = [&] (std::function<void()> blend)
+            {
+                auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < size * numRepeats; ++i)
+                    blend();
+
+                auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+                return (double) size * size * numRepeats / (seconds * 1.0e6);
+            };
+
+            auto logLines = [&] (const String& spanType, std::function<void()> scalar, std::function<void()> vectorised)
+            {
+                auto scalarRate = timeLines (scalar);
+                auto vectorisedRate = timeLines (vectorised);
+
+                logMessage (spanType + ": scalar " + String (roundToInt (scalarRate)) + " Mpix/s, blendLine "
+                              + String (roundToInt (vectorisedRate)) + " Mpix/s (" + String (vectorisedRate / scalarRate, 2) + "x)");
+            };
+
+            using namespace RenderingHelpers::PixelSpans;
+
+            logLines ("Colour spans",
+                      [&] { blendLine<PixelARGB> (dest.data(), stride, colour, size); },
+                      [&] { blendLine (dest.data(), stride, colour, size); });
+
+            logLines ("Image spans",
+                      [&] { blendLine<PixelARGB, PixelARGB> (dest.data(), stride, src.data(), stride, size); },
+                      [&] { blendLine (dest.data(), stride, src.data(), stride, size); });
+
+            logLines ("Image spans with opacity",
+                      [&] { blendLine<PixelARGB, PixelARGB> (dest.data(), stride, src.data(), stride, size, 0x80); },
+                      [&] { blendLine (dest.data(), stride, src.data(), stride, size, 0x80); });
+
+            Image target (Image::ARGB, size, size, true);
+            Image source (Image::ARGB, size, size, false);
+            source.clear (source.getBounds(), Colours::green.withAlpha (0.7f));
+
+            auto timeFills = [&] (const String& fillType, std::function<void (Graphics&)> draw)
+            {
+                Graphics g (target);
+                auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numRepeats; ++i)
+                    draw (g);
+
+                auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+                logMessage (fillType + ": " + String (roundToInt ((double) size * size * numRepeats / (seconds * 1.0e6))) + " Mpix/s");
+            };
+
+            auto centre = target.getBounds().getCentre().toFloat();
+
+            timeFills ("Translucent fillRect", [&] (Graphics& g) { g.setColour (Colours::blue.withAlpha (0.5f)); g.fillAll(); });
+            timeFills ("Linear gradient",      [&] (Graphics& g) { g.setGradientFill ({ Colours::red.withAlpha (0.3f), {}, Colours::blue.withAlpha (0.8f), { 0.0f, (float) size }, false }); g.fillAll(); });
+            timeFills ("Radial gradient",      [&] (Graphics& g) { g.setGradientFill ({ Colours::red.withAlpha (0.3f), centre, Colours::blue.withAlpha (0.8f), {}, true }); g.fillAll(); });
+            timeFills ("drawImageAt",          [&] (Graphics& g) { g.setOpacity (1.0f); g.drawImageAt (source, 0, 0); });
+            timeFills ("drawImageAt, opacity", [&] (Graphics& g) { g.setOpacity (0.5f); g.drawImageAt (source, 0, 0); });
+            timeFills ("Tiled image fill",     [&] (Graphics& g) { g.setTiledImageFill (source, 3, 5, 0.6f); g.fillAll(); });
+        }
+    }
+};
+
+static SoftwareRendererPixelSpanTests softwareRendererPixelSpanTests;
+
+#endif
+
 } // namespace juce
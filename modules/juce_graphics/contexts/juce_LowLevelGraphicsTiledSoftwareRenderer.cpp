@@ -0,0 +1,694 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, ThreadPool& pool)
+    : target (image), threadPool (pool), serialContext (image)
+{
+    createTiles ({}, image.getBounds());
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, Point<int> origin,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              ThreadPool& pool)
+    : target (image), threadPool (pool), serialContext (image, origin, initialClip)
+{
+    createTiles (origin, initialClip);
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    flush();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::createTiles (Point<int> origin, const RectangleList<int>& initialClip)
+{
+    // The glyph cache is shared by all the tiles, so make sure it's been created before
+    // any of them try to use it
+    RenderingHelpers::SoftwareRendererSavedState::GlyphCacheType::getInstance();
+
+    // A few more tiles than threads helps to balance the load, as parts of the image
+    // will usually be much busier than others
+    enum { minRowsPerTile = 16 };
+
+    auto area = initialClip.getBounds().getIntersection (target.getBounds());
+    auto numTiles = jlimit (1, 2 * (threadPool.getNumThreads() + 1), area.getHeight() / minRowsPerTile);
+
+    for (int i = 0; i < numTiles; ++i)
+    {
+        auto top    = area.getY() + (area.getHeight() * i) / numTiles;
+        auto bottom = area.getY() + (area.getHeight() * (i + 1)) / numTiles;
+
+        RectangleList<int> tileClip (initialClip);
+        tileClip.clipTo (Rectangle<int> (area.getX(), top, area.getWidth(), bottom - top));
+
+        tiles.add (new SoftwareContext (target, origin, tileClip));
+    }
+}
+
+int LowLevelGraphicsTiledSoftwareRenderer::getNumTiles() const noexcept
+{
+    return tiles.size();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    renderOperations();
+
+    // Once the operations that drew the target onto itself have finished, the rest of the
+    // frame can be recorded again, unless the current fill is still reading from the target
+    renderImmediately = serialContext.isFillUsing (target);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderOperations()
+{
+    if (operations.empty())
+        return;
+
+    // This is shared with the pool's jobs, as some of them may not start until
+    // after all the tiles have been rendered and this method has returned
+    struct RenderState
+    {
+        std::atomic<int> nextTile { 0 }, numTilesFinished { 0 };
+        int numTiles = 0;
+        WaitableEvent finished;
+    };
+
+    auto state = std::make_shared<RenderState>();
+    state->numTiles = tiles.size();
+
+    auto renderTiles = [this, state]
+    {
+        for (;;)
+        {
+            auto index = state->nextTile++;
+
+            if (index >= state->numTiles)
+                return;
+
+            auto& tile = *tiles.getUnchecked (index);
+
+            for (auto& op : operations)
+                op (tile);
+
+            if (++state->numTilesFinished == state->numTiles)
+                state->finished.signal();
+        }
+    };
+
+    isRendering = true;
+
+    for (int i = jmin (threadPool.getNumThreads(), tiles.size() - 1); --i >= 0;)
+        threadPool.addJob (renderTiles);
+
+    renderTiles();
+    state->finished.wait();
+
+    isRendering = false;
+
+    releaseImagesInUse();
+    operations.clear();
+}
+
+Range<int> LowLevelGraphicsTiledSoftwareRenderer::SoftwareContext::getClipColumns() const
+{
+    return stack->clip != nullptr ? stack->clip->getClipBounds().getHorizontalRange() : Range<int>();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::SoftwareContext::setPathColumns (Range<int> columns)
+{
+    stack->pathColumns = columns;
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::SoftwareContext::isFillUsing (const Image& image) const
+{
+    auto& fill = stack->fillType;
+    return fill.isTiledImage() && fill.image.getPixelData() != nullptr
+             && fill.image.getPixelData() == image.getPixelData();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addOperation (Operation&& operation)
+{
+    // Anything beyond the right-hand edge of the area that a path is rasterised against
+    // gets clamped to just inside it. A tile's clip can be narrower than the whole clip
+    // region, so the tiles are given the serial context's columns as they were before
+    // this operation, to make sure the last column comes out the same.
+    Operation op = [columns = serialContext.getClipColumns(), operation = std::move (operation)] (LowLevelGraphicsContext& c)
+    {
+        static_cast<SoftwareContext&> (c).setPathColumns (columns);
+        operation (c);
+    };
+
+    if (renderImmediately)
+    {
+        for (auto* tile : tiles)
+            op (*tile);
+    }
+    else
+    {
+        operations.push_back (std::move (op));
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addDrawingOperation (Operation&& op)
+{
+    if (numTransparencyLayers > 0)
+        op (serialContext);
+    else
+        addOperation (std::move (op));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addImageInUse (const Image& image)
+{
+    if (auto* data = image.getPixelData())
+    {
+        if (data == target.getPixelData())
+        {
+            // If the target image is being drawn onto itself, each operation has to finish
+            // rendering every tile before the next one starts, in the same order as the
+            // serial renderer would have drawn its scanlines
+            renderOperations();
+            renderImmediately = true;
+        }
+        else if (! imagesInUse.contains (data))
+        {
+            imagesInUse.add (data);
+            data->listeners.add (this);
+        }
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::releaseImagesInUse()
+{
+    for (auto* data : imagesInUse)
+        data->listeners.remove (this);
+
+    imagesInUse.clear();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::imageDataChanged (ImagePixelData*)
+{
+    // An image that's needed by the operations recorded so far is about to be modified,
+    // so they need to be rendered first
+    if (! isRendering)
+        renderOperations();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::imageDataBeingDeleted (ImagePixelData* data)
+{
+    imagesInUse.removeFirstMatchingValue (data);
+}
+
+//==============================================================================
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const
+{
+    return false;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    serialContext.setOrigin (o);
+    addOperation ([o] (LowLevelGraphicsContext& c) { c.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    serialContext.addTransform (t);
+    addOperation ([t] (LowLevelGraphicsContext& c) { c.addTransform (t); });
+}
+
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()
+{
+    return serialContext.getPhysicalPixelScaleFactor();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    addOperation ([r] (LowLevelGraphicsContext& c) { c.clipToRectangle (r); });
+    return serialContext.clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    addOperation ([r] (LowLevelGraphicsContext& c) { c.clipToRectangleList (r); });
+    return serialContext.clipToRectangleList (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    addOperation ([r] (LowLevelGraphicsContext& c) { c.excludeClipRectangle (r); });
+    serialContext.excludeClipRectangle (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    addOperation ([path, t] (LowLevelGraphicsContext& c) { c.clipToPath (path, t); });
+    serialContext.clipToPath (path, t);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& image, const AffineTransform& t)
+{
+    addImageInUse (image);
+    addOperation ([image, t] (LowLevelGraphicsContext& c) { c.clipToImageAlpha (image, t); });
+    serialContext.clipToImageAlpha (image, t);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)
+{
+    return serialContext.clipRegionIntersects (r);
+}
+
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const
+{
+    return serialContext.getClipBounds();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const
+{
+    return serialContext.isClipEmpty();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    serialContext.saveState();
+    addOperation ([] (LowLevelGraphicsContext& c) { c.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    serialContext.restoreState();
+
+    if (serialContext.isFillUsing (target))
+        addImageInUse (target);
+
+    addOperation ([] (LowLevelGraphicsContext& c) { c.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    // A layer's image is positioned at the top of the clip region, so if the tiles each
+    // created their own layer, the rounding of anything drawn with a fractional position
+    // could be different. Instead, the layer is rendered by the serial context, and the
+    // tiles just need to keep track of the state.
+    if (numTransparencyLayers++ == 0)
+        renderOperations();
+
+    serialContext.beginTransparencyLayer (opacity);
+    addOperation ([] (LowLevelGraphicsContext& c) { c.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    jassert (numTransparencyLayers > 0);
+
+    serialContext.endTransparencyLayer();
+
+    if (serialContext.isFillUsing (target))
+        addImageInUse (target);
+
+    addOperation ([] (LowLevelGraphicsContext& c) { c.restoreState(); });
+    --numTransparencyLayers;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fillType)
+{
+    if (fillType.isTiledImage())
+        addImageInUse (fillType.image);
+
+    serialContext.setFill (fillType);
+    addOperation ([fillType] (LowLevelGraphicsContext& c) { c.setFill (fillType); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float newOpacity)
+{
+    serialContext.setOpacity (newOpacity);
+    addOperation ([newOpacity] (LowLevelGraphicsContext& c) { c.setOpacity (newOpacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    serialContext.setInterpolationQuality (quality);
+    addOperation ([quality] (LowLevelGraphicsContext& c) { c.setInterpolationQuality (quality); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replace)
+{
+    addDrawingOperation ([r, replace] (LowLevelGraphicsContext& c) { c.fillRect (r, replace); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    addDrawingOperation ([r] (LowLevelGraphicsContext& c) { c.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    addDrawingOperation ([list] (LowLevelGraphicsContext& c) { c.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    addDrawingOperation ([path, t] (LowLevelGraphicsContext& c) { c.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& image, const AffineTransform& t)
+{
+    addImageInUse (image);
+    addDrawingOperation ([image, t] (LowLevelGraphicsContext& c) { c.drawImage (image, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    addDrawingOperation ([line] (LowLevelGraphicsContext& c) { c.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& newFont)
+{
+    // Find the typeface now, as the tiles will all share this font object
+    newFont.getTypeface();
+
+    serialContext.setFont (newFont);
+    addOperation ([newFont] (LowLevelGraphicsContext& c) { c.setFont (newFont); });
+}
+
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()
+{
+    return serialContext.getFont();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    addDrawingOperation ([glyphNumber, t] (LowLevelGraphicsContext& c) { c.drawGlyph (glyphNumber, t); });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TiledSoftwareRendererTests  : public UnitTest
+{
+public:
+    TiledSoftwareRendererTests()
+        : UnitTest ("LowLevelGraphicsTiledSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+
+        beginTest ("Renders the same pixels as the serial renderer");
+        {
+            Image serial (Image::ARGB, 317, 251, true), tiled (Image::ARGB, 317, 251, true);
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial);
+                drawTestScene (context, serial);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (tiled, pool);
+                expect (context.getNumTiles() > 1);
+                drawTestScene (context, tiled);
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+        }
+
+        beginTest ("Renders the same pixels into a clipped region");
+        {
+            Image serial (Image::RGB, 400, 300, true), tiled (Image::RGB, 400, 300, true);
+
+            RectangleList<int> clip;
+            clip.add ({ 10, 5, 250, 120 });
+            clip.add ({ 100, 150, 280, 140 });
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial, { -7, 3 }, clip);
+                context.addTransform (AffineTransform::scale (1.5f));
+                drawTestScene (context, serial);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (tiled, { -7, 3 }, clip, pool);
+                context.addTransform (AffineTransform::scale (1.5f));
+                drawTestScene (context, tiled);
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+        }
+
+        beginTest ("Paths crossing the edge of a non-rectangular clip match the serial renderer");
+        {
+            // Each tile only sees part of this clip, so most of them have a narrower clip
+            // than the whole region
+            RectangleList<int> clip;
+            clip.add ({ 0, 0, 300, 40 });
+            clip.add ({ 0, 40, 120, 200 });
+            clip.add ({ 0, 240, 250, 60 });
+
+            Image serial (Image::ARGB, 300, 300, true), tiled (Image::ARGB, 300, 300, true);
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (serial, {}, clip);
+                drawPathsCrossingTheClip (context);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (tiled, {}, clip, pool);
+                expect (context.getNumTiles() > 2);
+                drawPathsCrossingTheClip (context);
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+        }
+
+        beginTest ("Images modified while recording are drawn as they were");
+        {
+            Image serial (Image::ARGB, 200, 200, true), tiled (Image::ARGB, 200, 200, true);
+
+            for (auto* target : { &serial, &tiled })
+            {
+                std::unique_ptr<LowLevelGraphicsContext> context;
+
+                if (target == &serial)
+                    context = std::make_unique<LowLevelGraphicsSoftwareRenderer> (*target);
+                else
+                    context = std::make_unique<LowLevelGraphicsTiledSoftwareRenderer> (*target, pool);
+
+                Graphics g (*context);
+                Image source (Image::ARGB, 40, 40, true);
+
+                source.clear (source.getBounds(), Colours::red);
+                g.drawImageAt (source, 10, 10);
+
+                source.clear (source.getBounds(), Colours::blue);
+                g.drawImageAt (source, 10, 100);
+
+                Graphics (source).fillAll (Colours::green);
+                g.drawImageTransformed (source, AffineTransform::rotation (0.3f).translated (100.0f, 50.0f));
+            }
+
+            expect (imagesAreIdentical (serial, tiled));
+            expect (tiled.getPixelAt (20, 20) == Colours::red);
+            expect (tiled.getPixelAt (20, 110) == Colours::blue);
+        }
+
+        beginTest ("Drawing the target onto itself only renders immediately until the frame is flushed");
+        {
+            Image image (Image::ARGB, 100, 100, true);
+            image.clear (image.getBounds(), Colours::red);
+
+            LowLevelGraphicsTiledSoftwareRenderer context (image, pool);
+            Graphics g (context);
+
+            g.drawImageAt (image, 50, 0);
+            g.setColour (Colours::blue);
+            g.fillRect (0, 0, 10, 10);
+            expect (image.getPixelAt (5, 5) == Colours::blue);
+
+            context.flush();
+
+            g.setColour (Colours::green);
+            g.fillRect (0, 0, 10, 10);
+            expect (image.getPixelAt (5, 5) == Colours::blue);
+
+            context.flush();
+            expect (image.getPixelAt (5, 5) == Colours::green);
+
+            // a fill that reads from the target keeps it rendering immediately
+            g.setTiledImageFill (image, 20, 20, 1.0f);
+            context.flush();
+            g.fillRect (20, 20, 10, 10);
+            expect (image.getPixelAt (25, 25) == Colours::green);
+        }
+
+        beginTest ("Benchmark");
+        {
+            constexpr int numFrames = 20;
+            ThreadPool benchmarkPool (jmax (1, SystemStats::getNumCpus() - 1));
+
+            Image image (Image::ARGB, 1280, 800, true);
+
+            const auto timeFrames = [&] (bool useTiles)
+            {
+                const auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numFrames; ++i)
+                {
+                    std::unique_ptr<LowLevelGraphicsContext> context;
+
+                    if (useTiles)
+                        context = std::make_unique<LowLevelGraphicsTiledSoftwareRenderer> (image, benchmarkPool);
+                    else
+                        context = std::make_unique<LowLevelGraphicsSoftwareRenderer> (image);
+
+                    context->addTransform (AffineTransform::scale (4.0f, 3.2f));
+                    drawTestScene (*context, image);
+                }
+
+                return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0 / numFrames;
+            };
+
+            const auto serialTime = timeFrames (false);
+            const auto tiledTime = timeFrames (true);
+
+            logMessage ("1280x800 frame: serial " + String (serialTime, 2) + " ms, tiled "
+                          + String (tiledTime, 2) + " ms with " + String (benchmarkPool.getNumThreads() + 1)
+                          + " threads (" + String (serialTime / tiledTime, 2) + "x)");
+        }
+    }
+
+private:
+    static void drawTestScene (LowLevelGraphicsContext& context, Image& target)
+    {
+        Graphics g (context);
+
+        g.setGradientFill (ColourGradient (Colours::darkblue, 0.0f, 0.0f, Colours::orange, 300.0f, 250.0f, false));
+        g.fillAll();
+
+        Image source (Image::ARGB, 64, 48, true);
+
+        for (int y = 0; y < source.getHeight(); ++y)
+            for (int x = 0; x < source.getWidth(); ++x)
+                source.setPixelAt (x, y, Colour ((uint8) (x * 4), (uint8) (y * 5), (uint8) (x ^ y), (uint8) (128 + x + y)));
+
+        Path star;
+        star.addStar ({ 120.0f, 90.0f }, 7, 20.0f, 70.0f, 0.2f);
+
+        g.setColour (Colours::white.withAlpha (0.7f));
+        g.fillPath (star, AffineTransform::rotation (0.4f, 120.0f, 90.0f));
+        g.setColour (Colours::black);
+        g.strokePath (star, PathStrokeType (2.5f));
+
+        g.drawLine (3.3f, 200.0f, 310.0f, 17.5f, 3.0f);
+        g.fillRect (Rectangle<float> (10.3f, 180.7f, 80.2f, 40.9f));
+
+        {
+            Graphics::ScopedSaveState ss (g);
+            g.reduceClipRegion (star);
+            g.excludeClipRegion ({ 100, 70, 30, 30 });
+            g.setImageResamplingQuality (Graphics::highResamplingQuality);
+            g.drawImageTransformed (source, AffineTransform::rotation (0.3f).scaled (2.1f).translated (60.0f, 20.0f));
+        }
+
+        g.beginTransparencyLayer (0.6f);
+        g.setColour (Colours::limegreen);
+        g.fillEllipse (150.0f, 100.0f, 140.0f, 90.0f);
+        g.setTiledImageFill (source, 5, 7, 0.8f);
+        g.fillRoundedRectangle (170.0f, 30.0f, 120.0f, 60.0f, 12.0f);
+        g.endTransparencyLayer();
+
+        {
+            Graphics::ScopedSaveState ss (g);
+            g.reduceClipRegion (source, AffineTransform::translation (230.0f, 180.0f));
+            g.fillAll (Colours::magenta);
+        }
+
+        g.setColour (Colours::yellow);
+        g.setFont (18.0f);
+        g.drawText ("Tiled rendering", 10, 10, 200, 30, Justification::left);
+
+        GlyphArrangement glyphs;
+        glyphs.addLineOfText (g.getCurrentFont(), "Rotated", 0.0f, 0.0f);
+        glyphs.draw (g, AffineTransform::rotation (-0.5f).translated (40.0f, 240.0f));
+
+        g.addTransform (AffineTransform::rotation (0.2f, 150.0f, 120.0f));
+        g.drawText ("Transformed", 100, 120, 200, 30, Justification::centred);
+
+        // drawing the target onto itself needs the operations to be rendered in order
+        g.setOpacity (0.5f);
+        g.drawImage (target, { 20.0f, 150.0f, 100.0f, 60.0f }, RectanglePlacement::stretchToFit);
+    }
+
+    static void drawPathsCrossingTheClip (LowLevelGraphicsContext& context)
+    {
+        Graphics g (context);
+
+        g.setColour (Colours::white);
+        g.fillPath (createTriangle (-20.0f, 10.0f, 400.0f, 150.0f, -20.0f, 290.0f));
+
+        g.setColour (Colours::red.withAlpha (0.8f));
+        g.strokePath (createTriangle (50.0f, 20.0f, 350.0f, 260.0f, 80.0f, 280.0f), PathStrokeType (7.0f));
+
+        {
+            Graphics::ScopedSaveState ss (g);
+            g.reduceClipRegion (createTriangle (30.0f, -10.0f, 500.0f, 100.0f, 30.0f, 310.0f));
+            g.addTransform (AffineTransform::rotation (0.25f, 150.0f, 150.0f));
+            g.excludeClipRegion ({ 60, 60, 40, 160 });
+            g.setColour (Colours::blue.withAlpha (0.6f));
+            g.fillRect (Rectangle<float> (-50.0f, 5.5f, 500.0f, 290.0f));
+        }
+
+        Image source (Image::RGB, 50, 50, true);
+        source.clear (source.getBounds(), Colours::green);
+        g.drawImageTransformed (source, AffineTransform::rotation (0.4f).scaled (6.0f).translated (60.0f, -40.0f));
+    }
+
+    static Path createTriangle (float x1, float y1, float x2, float y2, float x3, float y3)
+    {
+        Path p;
+        p.addTriangle (x1, y1, x2, y2, x3, y3);
+        return p;
+    }
+
+    static bool imagesAreIdentical (const Image& a, const Image& b)
+    {
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                if (a.getPixelAt (x, y) != b.getPixelAt (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static TiledSoftwareRendererTests tiledSoftwareRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer which uses several threads to rasterise each frame.
+
+    This renders exactly the same pixels as a LowLevelGraphicsSoftwareRenderer, but
+    rather than drawing each shape as it's requested, it records the drawing operations,
+    and when flush() is called (or the context is deleted), the target area is split into
+    horizontal strips which are rendered in parallel by a ThreadPool and the calling thread.
+
+    The strips span the whole width of the target area, so each one rasterises complete
+    scanlines in exactly the same way that the serial renderer does, and paths are clamped
+    to the left and right edges of the whole clip region rather than those of the strip,
+    which is what keeps the results identical. Transparency layers are the exception:
+    anything drawn inside a layer is rendered on the calling thread.
+
+    Any images that are drawn, used as fills or used as clip masks are only read when the
+    operations are flushed. If one of them gets modified before that, the context notices
+    and flushes the operations that were recorded before the change.
+
+    To use it for a component's painting, override LookAndFeel::createGraphicsContext()
+    to return one, e.g.
+    @code
+    std::unique_ptr<LowLevelGraphicsContext> createGraphicsContext (const Image& imageToRenderOn,
+                                                                    Point<int> origin,
+                                                                    const RectangleList<int>& initialClip) override
+    {
+        return std::make_unique<LowLevelGraphicsTiledSoftwareRenderer> (imageToRenderOn, origin,
+                                                                         initialClip, renderingThreadPool);
+    }
+    @endcode
+
+    @see LowLevelGraphicsSoftwareRenderer
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public LowLevelGraphicsContext,
+                                                           private ImagePixelData::Listener
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image.
+
+        The thread pool must not be deleted while this context exists.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, ThreadPool& threadPoolToUse);
+
+    /** Creates a context to render into a clipped subsection of an image.
+
+        The thread pool must not be deleted while this context exists.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool& threadPoolToUse);
+
+    /** Destructor. This renders any operations that haven't been flushed yet. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Renders all the operations that have been recorded so far, blocking until
+        they've finished.
+
+        Call this at the end of a frame. If the target image was drawn onto itself,
+        the context stops rendering each operation as soon as it's added, and goes back
+        to recording them.
+    */
+    void flush();
+
+    /** Returns the number of strips that the target area has been split into. */
+    int getNumTiles() const noexcept;
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    using Operation = std::function<void (LowLevelGraphicsContext&)>;
+
+    // A software renderer that can tell the tiles which columns the whole clip region
+    // covers, so that they can rasterise paths against the same edges
+    class SoftwareContext  : public LowLevelGraphicsSoftwareRenderer
+    {
+    public:
+        using LowLevelGraphicsSoftwareRenderer::LowLevelGraphicsSoftwareRenderer;
+
+        Range<int> getClipColumns() const;
+        void setPathColumns (Range<int>);
+        bool isFillUsing (const Image&) const;
+    };
+
+    Image target;
+    ThreadPool& threadPool;
+    SoftwareContext serialContext; // answers queries about the state, and renders transparency layers
+    OwnedArray<SoftwareContext> tiles;
+    std::vector<Operation> operations;
+    Array<ImagePixelData*> imagesInUse;
+    std::atomic<bool> isRendering { false };
+    bool renderImmediately = false;
+    int numTransparencyLayers = 0;
+
+    void createTiles (Point<int> origin, const RectangleList<int>& initialClip);
+    void renderOperations();
+    void addOperation (Operation&&);
+    void addDrawingOperation (Operation&&);
+    void addImageInUse (const Image&);
+    void releaseImagesInUse();
+    void imageDataChanged (ImagePixelData*) override;
+    void imageDataBeingDeleted (ImagePixelData*) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
@@ -98,6 +98,31 @@
  #define USE_COREGRAPHICS_RENDERING 1
 #endif
 
+/** Config: JUCE_USE_SIMD_PIXEL_BLENDING
+
+    Enables SSE2/AVX2 or NEON versions of the loops that the software renderer uses to
+    blend runs of ARGB pixels. These produce exactly the same results as the plain C++
+    versions, so you'd only want to turn this off when comparing the two.
+*/
+#ifndef JUCE_USE_SIMD_PIXEL_BLENDING
+ #define JUCE_USE_SIMD_PIXEL_BLENDING 1
+#endif
+
+#if JUCE_USE_SIMD_PIXEL_BLENDING
+ #if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+  #include <emmintrin.h>
+
+  #if defined (__AVX2__)
+   #include <immintrin.h>
+  #endif
+ #elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON)) && ! JUCE_BIG_ENDIAN
+  #include <arm_neon.h>
+ #else
+  #undef JUCE_USE_SIMD_PIXEL_BLENDING
+  #define JUCE_USE_SIMD_PIXEL_BLENDING 0
+ #endif
+#endif
+
 //==============================================================================
 namespace juce
 {
@@ -142,6 +167,7 @@ namespace juce
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
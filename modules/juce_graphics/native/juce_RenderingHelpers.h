@@ -199,6 +199,17 @@ public:
         return g;
     }
 
+    /** Creates an edge table for a glyph that isn't going to be cached.
+        This holds the same lock that's used while generating cached glyphs, as
+        typefaces aren't necessarily safe to use from several threads at once.
+    */
+    EdgeTable* createUncachedGlyphEdgeTable (const Font& font, int glyphNumber,
+                                             const AffineTransform& transform, float fontHeight)
+    {
+        const ScopedLock sl (lock);
+        return font.getTypeface()->getEdgeTableForGlyph (glyphNumber, transform, fontHeight);
+    }
+
 private:
     ReferenceCountedArray<CachedGlyphType> glyphs;
     Atomic<int> accessCounter, hits, misses;
@@ -555,6 +566,259 @@ namespace GradientPixelIterators
     };
 }
 
+//==============================================================================
+/** Contains the inner loops used by the EdgeTableFillers for blending whole runs
+    of pixels at a time.
+
+    When both the source and destination are tightly-packed PixelARGB data, these
+    use SSE2/AVX2 or NEON to process several pixels per iteration. The results are
+    always bit-for-bit identical to calling PixelARGB::blend() on each pixel in turn,
+    so the vectorised and plain versions can be mixed freely.
+*/
+namespace PixelSpans
+{
+   #if JUCE_USE_SIMD_PIXEL_BLENDING
+    /** Each of these functions blends as many whole vectors of pixels as will fit into
+        the given width, and returns the number of pixels that it has processed.
+    */
+    struct Vectorised
+    {
+       #if JUCE_INTEL
+        // All the arithmetic is done on 16-bit lanes, which hold each channel of two pixels.
+        static forcedinline __m128i getInverseAlpha (__m128i s) noexcept
+        {
+            constexpr int a = PixelARGB::indexA;
+            return _mm_sub_epi16 (_mm_set1_epi16 (256),
+                                  _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (s, _MM_SHUFFLE (a, a, a, a)), _MM_SHUFFLE (a, a, a, a)));
+        }
+
+        static forcedinline __m128i blendChannels (__m128i d, __m128i s, __m128i inverseAlpha) noexcept
+        {
+            return _mm_add_epi16 (s, _mm_srli_epi16 (_mm_mullo_epi16 (d, inverseAlpha), 8));
+        }
+
+        static forcedinline __m128i blendPacked (__m128i d, __m128i sLo, __m128i sHi) noexcept
+        {
+            auto zero = _mm_setzero_si128();
+            return _mm_packus_epi16 (blendChannels (_mm_unpacklo_epi8 (d, zero), sLo, getInverseAlpha (sLo)),
+                                     blendChannels (_mm_unpackhi_epi8 (d, zero), sHi, getInverseAlpha (sHi)));
+        }
+
+        #if defined (__AVX2__)
+         static forcedinline __m256i getInverseAlpha (__m256i s) noexcept
+         {
+             constexpr int a = PixelARGB::indexA;
+             return _mm256_sub_epi16 (_mm256_set1_epi16 (256),
+                                      _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (s, _MM_SHUFFLE (a, a, a, a)), _MM_SHUFFLE (a, a, a, a)));
+         }
+
+         static forcedinline __m256i blendChannels (__m256i d, __m256i s, __m256i inverseAlpha) noexcept
+         {
+             return _mm256_add_epi16 (s, _mm256_srli_epi16 (_mm256_mullo_epi16 (d, inverseAlpha), 8));
+         }
+
+         static forcedinline __m256i blendPacked (__m256i d, __m256i sLo, __m256i sHi) noexcept
+         {
+             auto zero = _mm256_setzero_si256();
+             return _mm256_packus_epi16 (blendChannels (_mm256_unpacklo_epi8 (d, zero), sLo, getInverseAlpha (sLo)),
+                                         blendChannels (_mm256_unpackhi_epi8 (d, zero), sHi, getInverseAlpha (sHi)));
+         }
+        #endif
+
+        static int blendColour (PixelARGB* dest, PixelARGB colour, int width) noexcept
+        {
+            int i = 0;
+
+           #if defined (__AVX2__)
+            {
+                auto zero = _mm256_setzero_si256();
+                auto s = _mm256_unpacklo_epi8 (_mm256_set1_epi32 ((int) colour.getNativeARGB()), zero);
+                auto inverseAlpha = _mm256_set1_epi16 ((short) (256 - colour.getAlpha()));
+
+                for (; i + 8 <= width; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*> (dest + i);
+                    auto d = _mm256_loadu_si256 (p);
+                    _mm256_storeu_si256 (p, _mm256_packus_epi16 (blendChannels (_mm256_unpacklo_epi8 (d, zero), s, inverseAlpha),
+                                                                 blendChannels (_mm256_unpackhi_epi8 (d, zero), s, inverseAlpha)));
+                }
+            }
+           #endif
+
+            auto zero = _mm_setzero_si128();
+            auto s = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) colour.getNativeARGB()), zero);
+            auto inverseAlpha = _mm_set1_epi16 ((short) (256 - colour.getAlpha()));
+
+            for (; i + 4 <= width; i += 4)
+            {
+                auto* p = reinterpret_cast<__m128i*> (dest + i);
+                auto d = _mm_loadu_si128 (p);
+                _mm_storeu_si128 (p, _mm_packus_epi16 (blendChannels (_mm_unpacklo_epi8 (d, zero), s, inverseAlpha),
+                                                       blendChannels (_mm_unpackhi_epi8 (d, zero), s, inverseAlpha)));
+            }
+
+            return i;
+        }
+
+        static int blendPixels (PixelARGB* dest, const PixelARGB* src, int width) noexcept
+        {
+            int i = 0;
+
+           #if defined (__AVX2__)
+            {
+                auto zero = _mm256_setzero_si256();
+
+                for (; i + 8 <= width; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*> (dest + i);
+                    auto s = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i));
+                    _mm256_storeu_si256 (p, blendPacked (_mm256_loadu_si256 (p), _mm256_unpacklo_epi8 (s, zero), _mm256_unpackhi_epi8 (s, zero)));
+                }
+            }
+           #endif
+
+            auto zero = _mm_setzero_si128();
+
+            for (; i + 4 <= width; i += 4)
+            {
+                auto* p = reinterpret_cast<__m128i*> (dest + i);
+                auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+                _mm_storeu_si128 (p, blendPacked (_mm_loadu_si128 (p), _mm_unpacklo_epi8 (s, zero), _mm_unpackhi_epi8 (s, zero)));
+            }
+
+            return i;
+        }
+
+        static int blendPixels (PixelARGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept
+        {
+            int i = 0;
+
+           #if defined (__AVX2__)
+            {
+                auto zero = _mm256_setzero_si256();
+                auto extra = _mm256_set1_epi16 ((short) extraAlpha);
+
+                for (; i + 8 <= width; i += 8)
+                {
+                    auto* p = reinterpret_cast<__m256i*> (dest + i);
+                    auto s = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i));
+                    auto sLo = _mm256_srli_epi16 (_mm256_mullo_epi16 (_mm256_unpacklo_epi8 (s, zero), extra), 8);
+                    auto sHi = _mm256_srli_epi16 (_mm256_mullo_epi16 (_mm256_unpackhi_epi8 (s, zero), extra), 8);
+                    _mm256_storeu_si256 (p, blendPacked (_mm256_loadu_si256 (p), sLo, sHi));
+                }
+            }
+           #endif
+
+            auto zero = _mm_setzero_si128();
+            auto extra = _mm_set1_epi16 ((short) extraAlpha);
+
+            for (; i + 4 <= width; i += 4)
+            {
+                auto* p = reinterpret_cast<__m128i*> (dest + i);
+                auto s = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+                auto sLo = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (s, zero), extra), 8);
+                auto sHi = _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (s, zero), extra), 8);
+                _mm_storeu_si128 (p, blendPacked (_mm_loadu_si128 (p), sLo, sHi));
+            }
+
+            return i;
+        }
+       #else
+        #include "juce_RenderingHelpers_NEON.h"
+       #endif
+    };
+   #endif
+
+    //==============================================================================
+    /** Blends a colour onto a run of pixels. */
+    template <class DestPixelType>
+    void blendLine (DestPixelType* dest, int destStride, PixelARGB colour, int width) noexcept
+    {
+        do { dest->blend (colour); dest = addBytesToPointer (dest, destStride); } while (--width > 0);
+    }
+
+    /** Blends a run of source pixels onto a run of destination pixels. */
+    template <class DestPixelType, class SrcPixelType>
+    void blendLine (DestPixelType* dest, int destStride, const SrcPixelType* src, int srcStride, int width) noexcept
+    {
+        do
+        {
+            dest->blend (*src);
+            dest = addBytesToPointer (dest, destStride);
+            src  = addBytesToPointer (src, srcStride);
+        } while (--width > 0);
+    }
+
+    /** Blends a run of source pixels onto a run of destination pixels, scaling the
+        opacity of the source by extraAlpha, which must be in the range 0 to 256.
+    */
+    template <class DestPixelType, class SrcPixelType>
+    void blendLine (DestPixelType* dest, int destStride, const SrcPixelType* src, int srcStride, int width, uint32 extraAlpha) noexcept
+    {
+        do
+        {
+            dest->blend (*src, extraAlpha);
+            dest = addBytesToPointer (dest, destStride);
+            src  = addBytesToPointer (src, srcStride);
+        } while (--width > 0);
+    }
+
+    inline void blendLine (PixelARGB* dest, int destStride, PixelARGB colour, int width) noexcept
+    {
+       #if JUCE_USE_SIMD_PIXEL_BLENDING
+        if (destStride == (int) sizeof (PixelARGB))
+        {
+            auto numDone = Vectorised::blendColour (dest, colour, width);
+            dest += numDone;
+            width -= numDone;
+
+            if (width <= 0)
+                return;
+        }
+       #endif
+
+        blendLine<PixelARGB> (dest, destStride, colour, width);
+    }
+
+    inline void blendLine (PixelARGB* dest, int destStride, const PixelARGB* src, int srcStride, int width) noexcept
+    {
+       #if JUCE_USE_SIMD_PIXEL_BLENDING
+        if (destStride == (int) sizeof (PixelARGB) && srcStride == (int) sizeof (PixelARGB))
+        {
+            auto numDone = Vectorised::blendPixels (dest, src, width);
+            dest += numDone;
+            src += numDone;
+            width -= numDone;
+
+            if (width <= 0)
+                return;
+        }
+       #endif
+
+        blendLine<PixelARGB, PixelARGB> (dest, destStride, src, srcStride, width);
+    }
+
+    inline void blendLine (PixelARGB* dest, int destStride, const PixelARGB* src, int srcStride, int width, uint32 extraAlpha) noexcept
+    {
+        jassert (extraAlpha <= 256);
+
+       #if JUCE_USE_SIMD_PIXEL_BLENDING
+        if (destStride == (int) sizeof (PixelARGB) && srcStride == (int) sizeof (PixelARGB))
+        {
+            auto numDone = Vectorised::blendPixels (dest, src, width, extraAlpha);
+            dest += numDone;
+            src += numDone;
+            width -= numDone;
+
+            if (width <= 0)
+                return;
+        }
+       #endif
+
+        blendLine<PixelARGB, PixelARGB> (dest, destStride, src, srcStride, width, extraAlpha);
+    }
+}
+
 #define JUCE_PERFORM_PIXEL_OP_LOOP(op) \
 { \
     const int destStride = destData.pixelStride;  \
@@ -667,7 +931,7 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            PixelSpans::blendLine (dest, destData.pixelStride, colour, width);
         }
 
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
@@ -724,18 +988,12 @@ namespace EdgeTableFillers
 
         void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept
         {
-            auto* dest = getPixel (x);
-
-            if (alphaLevel < 0xff)
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
-            else
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            blendLine (getPixel (x), x, width, alphaLevel);
         }
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
-            auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            blendLine (getPixel (x), x, width, 0xff);
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -765,6 +1023,39 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        template <class DestPixelType>
+        void blendLine (DestPixelType* dest, int x, int width, int alphaLevel) const noexcept
+        {
+            if (alphaLevel < 0xff)
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+        }
+
+        // For ARGB destinations, the gradient is rendered in chunks so that they can be blended as spans
+        void blendLine (PixelARGB* dest, int x, int width, int alphaLevel) const noexcept
+        {
+            constexpr int chunkSize = 64;
+            PixelARGB chunk[chunkSize];
+
+            do
+            {
+                auto num = jmin (width, chunkSize);
+
+                for (int i = 0; i < num; ++i)
+                    chunk[i] = GradientType::getPixel (x++);
+
+                if (alphaLevel < 0xff)
+                    PixelSpans::blendLine (dest, destData.pixelStride, chunk, (int) sizeof (PixelARGB), num, (uint32) alphaLevel);
+                else
+                    PixelSpans::blendLine (dest, destData.pixelStride, chunk, (int) sizeof (PixelARGB), num);
+
+                dest = addBytesToPointer (dest, num * destData.pixelStride);
+                width -= num;
+            }
+            while (width > 0);
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -810,49 +1101,12 @@ namespace EdgeTableFillers
 
         void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept
         {
-            auto* dest = getDestPixel (x);
-            alphaLevel = (alphaLevel * extraAlpha) >> 8;
-            x -= xOffset;
-
-            if (repeatPattern)
-            {
-                if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width), (uint32) alphaLevel))
-                else
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width)))
-            }
-            else
-            {
-                jassert (x >= 0 && x + width <= srcData.width);
-
-                if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
-                else
-                    copyRow (dest, getSrcPixel (x), width);
-            }
+            blendLine (getDestPixel (x), x - xOffset, width, (alphaLevel * extraAlpha) >> 8);
         }
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
-            auto* dest = getDestPixel (x);
-            x -= xOffset;
-
-            if (repeatPattern)
-            {
-                if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width), (uint32) extraAlpha))
-                else
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++ % srcData.width)))
-            }
-            else
-            {
-                jassert (x >= 0 && x + width <= srcData.width);
-
-                if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
-                else
-                    copyRow (dest, getSrcPixel (x), width);
-            }
+            blendLine (getDestPixel (x), x - xOffset, width, extraAlpha);
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -902,6 +1156,39 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        void blendLine (DestPixelType* dest, int x, int width, int alphaLevel) const noexcept
+        {
+            if (repeatPattern)
+            {
+                // Split the line into runs that don't wrap around the edge of the source image
+                do
+                {
+                    auto srcX = x % srcData.width;
+                    auto num = jmin (width, srcData.width - srcX);
+
+                    blendRow (dest, getSrcPixel (srcX), num, alphaLevel);
+
+                    dest = addBytesToPointer (dest, num * destData.pixelStride);
+                    x += num;
+                    width -= num;
+                }
+                while (width > 0);
+            }
+            else
+            {
+                jassert (x >= 0 && x + width <= srcData.width);
+                blendRow (dest, getSrcPixel (x), width, alphaLevel);
+            }
+        }
+
+        forcedinline void blendRow (DestPixelType* dest, SrcPixelType const* src, int width, int alphaLevel) const noexcept
+        {
+            if (alphaLevel < 0xfe)
+                PixelSpans::blendLine (dest, destData.pixelStride, src, srcData.pixelStride, width, (uint32) alphaLevel);
+            else
+                copyRow (dest, src, width);
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -915,12 +1202,7 @@ namespace EdgeTableFillers
             }
             else
             {
-                do
-                {
-                    dest->blend (*src);
-                    dest = addBytesToPointer (dest, destStride);
-                    src  = addBytesToPointer (src, srcStride);
-                } while (--width > 0);
+                PixelSpans::blendLine (dest, destStride, src, srcStride, width);
             }
         }
 
@@ -985,9 +1267,9 @@ namespace EdgeTableFillers
             alphaLevel >>= 8;
 
             if (alphaLevel < 0xfe)
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++, (uint32) alphaLevel))
+                PixelSpans::blendLine (dest, destData.pixelStride, span, (int) sizeof (SrcPixelType), width, (uint32) alphaLevel);
             else
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*span++))
+                PixelSpans::blendLine (dest, destData.pixelStride, span, (int) sizeof (SrcPixelType), width);
         }
 
         forcedinline void handleEdgeTableLineFull (int x, int width) noexcept
@@ -1603,7 +1885,7 @@ struct ClipRegions
         virtual Ptr clipToRectangle (Rectangle<int>) = 0;
         virtual Ptr clipToRectangleList (const RectangleList<int>&) = 0;
         virtual Ptr excludeClipRectangle (Rectangle<int>) = 0;
-        virtual Ptr clipToPath (const Path&, const AffineTransform&) = 0;
+        virtual Ptr clipToPath (Rectangle<int> pathArea, const Path&, const AffineTransform&) = 0;
         virtual Ptr clipToEdgeTable (const EdgeTable&) = 0;
         virtual Ptr clipToImageAlpha (const Image&, const AffineTransform&, Graphics::ResamplingQuality) = 0;
         virtual void translate (Point<int> delta) = 0;
@@ -1660,9 +1942,9 @@ struct ClipRegions
             return edgeTable.isEmpty() ? Ptr() : Ptr (*this);
         }
 
-        Ptr clipToPath (const Path& p, const AffineTransform& transform) override
+        Ptr clipToPath (Rectangle<int> pathArea, const Path& p, const AffineTransform& transform) override
         {
-            EdgeTable et (edgeTable.getMaximumBounds(), p, transform);
+            EdgeTable et (pathArea, p, transform);
             edgeTable.clipToEdgeTable (et);
             return edgeTable.isEmpty() ? Ptr() : Ptr (*this);
         }
@@ -1836,7 +2118,7 @@ struct ClipRegions
             return clip.isEmpty() ? Ptr() : Ptr (*this);
         }
 
-        Ptr clipToPath (const Path& p, const AffineTransform& transform) override  { return toEdgeTable()->clipToPath (p, transform); }
+        Ptr clipToPath (Rectangle<int> pathArea, const Path& p, const AffineTransform& transform) override  { return toEdgeTable()->clipToPath (pathArea, p, transform); }
         Ptr clipToEdgeTable (const EdgeTable& et) override                         { return toEdgeTable()->clipToEdgeTable (et); }
 
         Ptr clipToImageAlpha (const Image& image, const AffineTransform& transform, Graphics::ResamplingQuality quality) override
@@ -2060,7 +2342,7 @@ public:
     }
 
     SavedStateBase (const SavedStateBase& other)
-        : clip (other.clip), transform (other.transform), fillType (other.fillType),
+        : clip (other.clip), pathColumns (other.pathColumns), transform (other.transform), fillType (other.fillType),
           interpolationQuality (other.interpolationQuality),
           transparencyLayerAlpha (other.transparencyLayerAlpha)
     {
@@ -2160,9 +2442,9 @@ public:
                 Path p;
                 p.addRectangle (r.toFloat());
                 p.applyTransform (transform.complexTransform);
-                p.addRectangle (clip->getClipBounds().toFloat());
+                p.addRectangle (getPathArea().toFloat());
                 p.setUsingNonZeroWinding (false);
-                clip = clip->clipToPath (p, {});
+                clip = clip->clipToPath (getPathArea(), p, {});
             }
         }
 
@@ -2174,7 +2456,7 @@ public:
         if (clip != nullptr)
         {
             cloneClipIfMultiplyReferenced();
-            clip = clip->clipToPath (p, transform.getTransformWith (t));
+            clip = clip->clipToPath (getPathArea(), p, transform.getTransformWith (t));
         }
     }
 
@@ -2328,7 +2610,7 @@ public:
             auto clipRect = clip->getClipBounds();
 
             if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
-                fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+                fillShape (*new EdgeTableRegionType (getPathArea(), path, trans), false);
         }
     }
 
@@ -2418,7 +2700,7 @@ public:
                 Path p;
                 p.addRectangle (sourceImage.getBounds());
 
-                if (auto c = clip->clone()->clipToPath (p, t))
+                if (auto c = clip->clone()->clipToPath (getPathArea(), p, t))
                     c->renderImageTransformed (getThis(), sourceImage, alpha,
                                                t, interpolationQuality, false);
             }
@@ -2469,7 +2751,22 @@ public:
             clip = clip->clone();
     }
 
+    // Paths are rasterised against the clip's bounds, and anything beyond the right-hand
+    // edge is clamped to just inside it, which can affect the last column. When a clip
+    // region has been split into horizontal strips, each strip can set the columns of
+    // the whole region here so that its paths are clamped in the same way.
+    Rectangle<int> getPathArea() const
+    {
+        auto area = clip->getClipBounds();
+
+        if (pathColumns.isEmpty())
+            return area;
+
+        return { pathColumns.getStart(), area.getY(), pathColumns.getLength(), area.getHeight() };
+    }
+
     typename BaseRegionType::Ptr clip;
+    Range<int> pathColumns;
     RenderingHelpers::TranslationOrTransform transform;
     FillType fillType;
     Graphics::ResamplingQuality interpolationQuality;
@@ -2567,7 +2864,7 @@ public:
                 auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
                                                                      .followedBy (trans));
 
-                std::unique_ptr<EdgeTable> et (font.getTypeface()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
+                std::unique_ptr<EdgeTable> et (GlyphCacheType::getInstance().createUncachedGlyphEdgeTable (font, glyphNumber, t, fontHeight));
 
                 if (et != nullptr)
                     fillShape (*new EdgeTableRegionType (*et), false);
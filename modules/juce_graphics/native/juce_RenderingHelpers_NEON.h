@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file contains the NEON versions of the RenderingHelpers::PixelSpans::Vectorised
+    kernels.
+
+    It gets included inside the body of the Vectorised struct when building for ARM. The
+    software renderer's unit tests also include it inside a struct which declares a plain
+    C++ model of the handful of NEON intrinsics that it uses, so that this code gets
+    compiled and checked against PixelARGB::blend() on every platform. Don't include it
+    anywhere else!
+*/
+
+// NEON de-interleaves 8 pixels into one register per channel, so there's no shuffling needed.
+static forcedinline uint8x8_t blendChannels (uint8x8_t d, uint16x8_t s, uint16x8_t inverseAlpha) noexcept
+{
+    return vqmovn_u16 (vaddq_u16 (s, vshrq_n_u16 (vmulq_u16 (vmovl_u8 (d), inverseAlpha), 8)));
+}
+
+static forcedinline void blendPacked (uint8x8x4_t& d, const uint16x8_t (&s)[4]) noexcept
+{
+    auto inverseAlpha = vsubq_u16 (vdupq_n_u16 (256), s[PixelARGB::indexA]);
+
+    d.val[0] = blendChannels (d.val[0], s[0], inverseAlpha);
+    d.val[1] = blendChannels (d.val[1], s[1], inverseAlpha);
+    d.val[2] = blendChannels (d.val[2], s[2], inverseAlpha);
+    d.val[3] = blendChannels (d.val[3], s[3], inverseAlpha);
+}
+
+static int blendColour (PixelARGB* dest, PixelARGB colour, int width) noexcept
+{
+    auto* c = reinterpret_cast<const uint8*> (&colour);
+    const uint16x8_t s[] = { vdupq_n_u16 (c[0]), vdupq_n_u16 (c[1]), vdupq_n_u16 (c[2]), vdupq_n_u16 (c[3]) };
+    int i = 0;
+
+    for (; i + 8 <= width; i += 8)
+    {
+        auto* p = reinterpret_cast<uint8*> (dest + i);
+        auto d = vld4_u8 (p);
+        blendPacked (d, s);
+        vst4_u8 (p, d);
+    }
+
+    return i;
+}
+
+static int blendPixels (PixelARGB* dest, const PixelARGB* src, int width) noexcept
+{
+    int i = 0;
+
+    for (; i + 8 <= width; i += 8)
+    {
+        auto* p = reinterpret_cast<uint8*> (dest + i);
+        auto sp = vld4_u8 (reinterpret_cast<const uint8*> (src + i));
+        const uint16x8_t s[] = { vmovl_u8 (sp.val[0]), vmovl_u8 (sp.val[1]), vmovl_u8 (sp.val[2]), vmovl_u8 (sp.val[3]) };
+        auto d = vld4_u8 (p);
+        blendPacked (d, s);
+        vst4_u8 (p, d);
+    }
+
+    return i;
+}
+
+static int blendPixels (PixelARGB* dest, const PixelARGB* src, int width, uint32 extraAlpha) noexcept
+{
+    auto extra = vdupq_n_u16 ((uint16) extraAlpha);
+    int i = 0;
+
+    for (; i + 8 <= width; i += 8)
+    {
+        auto* p = reinterpret_cast<uint8*> (dest + i);
+        auto sp = vld4_u8 (reinterpret_cast<const uint8*> (src + i));
+        const uint16x8_t s[] = { vshrq_n_u16 (vmulq_u16 (vmovl_u8 (sp.val[0]), extra), 8),
+                                 vshrq_n_u16 (vmulq_u16 (vmovl_u8 (sp.val[1]), extra), 8),
+                                 vshrq_n_u16 (vmulq_u16 (vmovl_u8 (sp.val[2]), extra), 8),
+                                 vshrq_n_u16 (vmulq_u16 (vmovl_u8 (sp.val[3]), extra), 8) };
+        auto d = vld4_u8 (p);
+        blendPacked (d, s);
+        vst4_u8 (p, d);
+    }
+
+    return i;
+}
@@ -34,11 +34,18 @@
 
 #include "juce_osc.h"
 
+//==============================================================================
+#if JUCE_LINUX
+ #include <sys/socket.h>
+#endif
+
+//==============================================================================
 #include "osc/juce_OSCTypes.cpp"
 #include "osc/juce_OSCTimeTag.cpp"
 #include "osc/juce_OSCArgument.cpp"
 #include "osc/juce_OSCAddress.cpp"
 #include "osc/juce_OSCMessage.cpp"
+#include "osc/juce_OSCMessageView.cpp"
 #include "osc/juce_OSCBundle.cpp"
 #include "osc/juce_OSCReceiver.cpp"
 #include "osc/juce_OSCSender.cpp"
@@ -60,6 +60,7 @@
 #include "osc/juce_OSCArgument.h"
 #include "osc/juce_OSCAddress.h"
 #include "osc/juce_OSCMessage.h"
+#include "osc/juce_OSCMessageView.h"
 #include "osc/juce_OSCBundle.h"
 #include "osc/juce_OSCReceiver.h"
 #include "osc/juce_OSCSender.h"
@@ -0,0 +1,399 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace
+{
+    //==============================================================================
+    /** Allocation-free helpers for checking and stepping through the contents of
+        an OSC message in place, following the same rules as the OSCInputStream used
+        by OSCReceiver.
+    */
+    struct OSCMessageViewHelpers
+    {
+        static size_t getPaddedSize (size_t numBytes) noexcept
+        {
+            return (numBytes + 3) & ~(size_t) 3;
+        }
+
+        static uint32 readUint32 (const char* data) noexcept
+        {
+            return ByteOrder::bigEndianInt (data);
+        }
+
+        static bool hasZeroPadding (const char* data, size_t numBytes) noexcept
+        {
+            for (auto i = numBytes; i < getPaddedSize (numBytes); ++i)
+                if (data[i] != 0)
+                    return false;
+
+            return true;
+        }
+
+        /** Returns the number of bytes taken up by the padded string at data, or 0 if
+            the string is malformed or runs past the end.
+        */
+        static size_t checkString (const char* data, const char* end) noexcept
+        {
+            if (end - data < 4)
+                return 0;
+
+            auto* terminator = static_cast<const char*> (std::memchr (data, 0, (size_t) (end - data)));
+
+            if (terminator == nullptr)
+                return 0;
+
+            auto numBytes = (size_t) (terminator - data) + 1;
+
+            if (getPaddedSize (numBytes) > (size_t) (end - data) || ! hasZeroPadding (data, numBytes))
+                return 0;
+
+            return getPaddedSize (numBytes);
+        }
+
+        static bool isValidAddressPatternChar (char c) noexcept
+        {
+            return c > ' ' && c <= '~' && c != '#';
+        }
+
+        /** Returns the number of bytes taken up by the argument at data, or 0 if the
+            argument is malformed or runs past the end.
+        */
+        static size_t checkArgument (OSCType type, const char* data, const char* end) noexcept
+        {
+            auto numBytesLeft = (size_t) (end - data);
+
+            switch (type)
+            {
+                case OSCTypes::int32:
+                case OSCTypes::float32:
+                case OSCTypes::colour:
+                    return numBytesLeft >= 4 ? 4 : 0;
+
+                case OSCTypes::string:
+                    return checkString (data, end);
+
+                case OSCTypes::blob:
+                {
+                    if (numBytesLeft < 4)
+                        return 0;
+
+                    auto blobSize = (size_t) readUint32 (data);
+
+                    if (blobSize > numBytesLeft - 4 || getPaddedSize (blobSize) > numBytesLeft - 4
+                         || ! hasZeroPadding (data + 4, blobSize))
+                        return 0;
+
+                    return 4 + getPaddedSize (blobSize);
+                }
+
+                default:
+                    return 0;
+            }
+        }
+
+        /** Returns the size of an argument that has already been checked. */
+        static size_t getArgumentSize (OSCType type, const char* data) noexcept
+        {
+            switch (type)
+            {
+                case OSCTypes::string:  return getPaddedSize (std::strlen (data) + 1);
+                case OSCTypes::blob:    return 4 + getPaddedSize ((size_t) readUint32 (data));
+                default:                return 4;
+            }
+        }
+    };
+
+} // namespace
+
+//==============================================================================
+int32 OSCArgumentView::getInt32() const noexcept
+{
+    if (isInt32())
+        return (int32) OSCMessageViewHelpers::readUint32 (data);
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return 0;
+}
+
+float OSCArgumentView::getFloat32() const noexcept
+{
+    if (isFloat32())
+    {
+        auto bits = OSCMessageViewHelpers::readUint32 (data);
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return 0.0f;
+}
+
+const char* OSCArgumentView::getString() const noexcept
+{
+    if (isString())
+        return data;
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return "";
+}
+
+const void* OSCArgumentView::getBlobData() const noexcept
+{
+    if (isBlob())
+        return data + 4;
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return nullptr;
+}
+
+size_t OSCArgumentView::getBlobSize() const noexcept
+{
+    if (isBlob())
+        return (size_t) OSCMessageViewHelpers::readUint32 (data);
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return 0;
+}
+
+OSCColour OSCArgumentView::getColour() const noexcept
+{
+    if (isColour())
+        return OSCColour::fromInt32 (OSCMessageViewHelpers::readUint32 (data));
+
+    jassertfalse; // you must check the type of an argument before attempting to get its value!
+    return { 0, 0, 0, 0 };
+}
+
+OSCArgument OSCArgumentView::toArgument() const
+{
+    switch (type)
+    {
+        case OSCTypes::int32:       return OSCArgument (getInt32());
+        case OSCTypes::float32:     return OSCArgument (getFloat32());
+        case OSCTypes::string:      return OSCArgument (String::fromUTF8 (getString()));
+        case OSCTypes::blob:        return OSCArgument (MemoryBlock (getBlobData(), getBlobSize()));
+        case OSCTypes::colour:      return OSCArgument (getColour());
+
+        default:
+            // views are only ever created for supported types, so this should never happen.
+            jassertfalse;
+            throw OSCInternalError ("OSC message view: internal error while copying argument");
+    }
+}
+
+//==============================================================================
+OSCMessageView::OSCMessageView (const void* messageData, size_t messageDataSize) noexcept
+{
+    using Helpers = OSCMessageViewHelpers;
+
+    auto* data = static_cast<const char*> (messageData);
+    auto* end = data + messageDataSize;
+
+    auto addressSize = Helpers::checkString (data, end);
+
+    if (addressSize == 0 || data[0] != '/')
+        return;
+
+    for (auto* c = data; *c != 0; ++c)
+        if (! Helpers::isValidAddressPatternChar (*c))
+            return;
+
+    auto* tags = data + addressSize;
+    auto tagsSize = Helpers::checkString (tags, end);
+
+    if (tagsSize == 0 || tags[0] != ',')
+        return;
+
+    auto* args = tags + tagsSize;
+    auto* argEnd = args;
+    int numArgs = 0;
+
+    for (auto* t = tags + 1; *t != 0; ++t, ++numArgs)
+    {
+        if (! OSCTypes::isSupportedType (*t))
+            return;
+
+        auto argSize = Helpers::checkArgument (*t, argEnd, end);
+
+        if (argSize == 0)
+            return;
+
+        argEnd += argSize;
+    }
+
+    if (argEnd != end)
+        return;
+
+    addressPattern = data;
+    typeTags = tags + 1;
+    argumentData = args;
+    numArguments = numArgs;
+}
+
+OSCArgumentView OSCMessageView::operator[] (int i) const noexcept
+{
+    jassert (isPositiveAndBelow (i, numArguments));
+
+    auto it = begin();
+
+    while (--i >= 0)
+        ++it;
+
+    return *it;
+}
+
+OSCMessage OSCMessageView::toMessage() const
+{
+    jassert (isValid());
+
+    OSCMessage message (OSCAddressPattern (String::fromUTF8 (addressPattern)));
+
+    for (auto arg : *this)
+        message.addArgument (arg.toArgument());
+
+    return message;
+}
+
+OSCMessageView::Iterator& OSCMessageView::Iterator::operator++() noexcept
+{
+    data += OSCMessageViewHelpers::getArgumentSize (*typeTag, data);
+    ++typeTag;
+    return *this;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OSCMessageViewTests  : public UnitTest
+{
+public:
+    OSCMessageViewTests()
+        : UnitTest ("OSCMessageView class", UnitTestCategories::osc)
+    {}
+
+    void runTest()
+    {
+        beginTest ("Reading arguments in place");
+        {
+            const char buffer[] = {
+                '/', 't', 'e', 's', 't', '/', 'v', '\0',
+                ',', 'i', 'f', 's', 'b', 'r', '\0', '\0',
+                char (0xff), char (0xff), char (0xff), char (0xd6),   // -42
+                0x40, 0x60, 0x00, 0x00,                             // 3.5f
+                'h', 'e', 'l', 'l', 'o', '\0', '\0', '\0',
+                0x00, 0x00, 0x00, 0x05, 1, 2, 3, 4, 5, 0, 0, 0,
+                10, 20, 30, 40 };
+
+            OSCMessageView view (buffer, sizeof (buffer));
+
+            expect (view.isValid());
+            expectEquals (String (view.getAddressPattern()), String ("/test/v"));
+            expectEquals (view.size(), 5);
+
+            expectEquals (view[0].getInt32(), -42);
+            expectEquals (view[1].getFloat32(), 3.5f);
+            expectEquals (String (view[2].getString()), String ("hello"));
+            expectEquals ((int) view[3].getBlobSize(), 5);
+            expect (view[3].getBlobData() == buffer + 36);
+            expectEquals ((int) view[4].getColour().toInt32(), (int) (OSCColour { 10, 20, 30, 40 }).toInt32());
+
+            // the view must point into the buffer rather than into a copy of it:
+            expect (view.getAddressPattern() == buffer);
+            expect (view[2].getString() == buffer + 24);
+
+            const char expectedTypes[] = { 'i', 'f', 's', 'b', 'r' };
+            int numIterated = 0;
+
+            for (auto arg : view)
+                expectEquals (arg.getType(), expectedTypes[numIterated++]);
+
+            expectEquals (numIterated, 5);
+
+            auto message = view.toMessage();
+            expectEquals (message.getAddressPattern().toString(), String ("/test/v"));
+            expectEquals (message.size(), 5);
+            expectEquals (message[2].getString(), String ("hello"));
+            expect (message[3].getBlob() == MemoryBlock (buffer + 36, 5));
+        }
+
+        beginTest ("Messages without arguments");
+        {
+            const char buffer[] = { '/', 'e', 'm', 'p', 't', 'y', '\0', '\0',
+                                    ',', '\0', '\0', '\0' };
+
+            OSCMessageView view (buffer, sizeof (buffer));
+
+            expect (view.isValid());
+            expect (view.isEmpty());
+            expect (view.begin() == view.end());
+        }
+
+        beginTest ("Rejecting malformed messages");
+        {
+            const char buffer[] = { '/', 'a', '\0', '\0', ',', 'i', 's', '\0',
+                                    0, 0, 0, 1, 't', 'e', 'x', 't', '\0', '\0', '\0', '\0' };
+
+            expect (OSCMessageView (buffer, sizeof (buffer)).isValid());
+
+            for (size_t size = 0; size < sizeof (buffer); ++size)
+                expect (! OSCMessageView (buffer, size).isValid());
+
+            auto expectInvalidWithByte = [&] (size_t index, char value)
+            {
+                char modified[sizeof (buffer)];
+                std::memcpy (modified, buffer, sizeof (buffer));
+                modified[index] = value;
+                expect (! OSCMessageView (modified, sizeof (modified)).isValid());
+            };
+
+            expectInvalidWithByte (0, 'a');     // no leading slash
+            expectInvalidWithByte (1, '#');     // character not allowed in address patterns
+            expectInvalidWithByte (3, 'x');     // bad padding
+            expectInvalidWithByte (4, 'i');     // no type tag string
+            expectInvalidWithByte (6, 'q');     // unsupported type
+            expectInvalidWithByte (19, 'x');    // bad string padding
+
+            char withExtraBytes[sizeof (buffer) + 4] = {};
+            std::memcpy (withExtraBytes, buffer, sizeof (buffer));
+            expect (! OSCMessageView (withExtraBytes, sizeof (withExtraBytes)).isValid());
+
+            const char blobTooLong[] = { '/', 'b', '\0', '\0', ',', 'b', '\0', '\0',
+                                         0, 0, 0, 8, 1, 2, 3, 4 };
+            expect (! OSCMessageView (blobTooLong, sizeof (blobTooLong)).isValid());
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
+#endif
+
+} // namespace juce
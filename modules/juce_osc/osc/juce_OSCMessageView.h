@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A non-owning view of a single argument inside an OSC packet.
+
+    OSCArgumentView objects are handed out by an OSCMessageView. They point directly
+    into the packet data and never copy or allocate anything, so they are only valid
+    for as long as the packet buffer they refer to.
+
+    @see OSCMessageView, OSCArgument
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCArgumentView
+{
+public:
+    /** Returns the type of the argument as an OSCType. */
+    OSCType getType() const noexcept        { return type; }
+
+    /** Returns whether the type of the argument is int32. */
+    bool isInt32() const noexcept           { return type == OSCTypes::int32; }
+
+    /** Returns whether the type of the argument is float. */
+    bool isFloat32() const noexcept         { return type == OSCTypes::float32; }
+
+    /** Returns whether the type of the argument is string. */
+    bool isString() const noexcept          { return type == OSCTypes::string; }
+
+    /** Returns whether the type of the argument is blob. */
+    bool isBlob() const noexcept            { return type == OSCTypes::blob; }
+
+    /** Returns whether the type of the argument is colour. */
+    bool isColour() const noexcept          { return type == OSCTypes::colour; }
+
+    /** Returns the value of the argument as an int32.
+        If the type of the argument is not int32, this will return 0.
+    */
+    int32 getInt32() const noexcept;
+
+    /** Returns the value of the argument as a float32.
+        If the type of the argument is not float32, this will return 0.
+    */
+    float getFloat32() const noexcept;
+
+    /** Returns a pointer to the null-terminated UTF-8 string inside the packet.
+        If the type of the argument is not string, this will return an empty string.
+    */
+    const char* getString() const noexcept;
+
+    /** Returns a pointer to the first byte of the blob's data inside the packet.
+        If the type of the argument is not blob, this will return nullptr.
+    */
+    const void* getBlobData() const noexcept;
+
+    /** Returns the number of bytes in the blob.
+        If the type of the argument is not blob, this will return 0.
+    */
+    size_t getBlobSize() const noexcept;
+
+    /** Returns the value of the argument as an OSCColour.
+        If the type of the argument is not a colour, this will return a transparent black.
+    */
+    OSCColour getColour() const noexcept;
+
+    /** Creates an OSCArgument holding a copy of this argument's value. */
+    OSCArgument toArgument() const;
+
+private:
+    //==============================================================================
+    OSCArgumentView (OSCType t, const char* d) noexcept  : type (t), data (d) {}
+
+    OSCType type;
+    const char* data;
+
+    friend class OSCMessageView;
+};
+
+//==============================================================================
+/**
+    A non-owning view of an OSC message inside a packet buffer.
+
+    Unlike OSCMessage, an OSCMessageView doesn't copy the address pattern or the
+    arguments out of the packet, and creating one never allocates any memory. The
+    packet is checked when the view is created, and the arguments are decoded on
+    demand when you access them.
+
+    Because the view points into the buffer it was created from, it must not be
+    used after that buffer has been released or reused. The views handed to an
+    OSCReceiver::MessageViewListener are only valid for the duration of the callback:
+    use toMessage() if you need to keep hold of the message.
+
+    @see OSCReceiver::MessageViewListener, OSCMessage
+
+    @tags{OSC}
+*/
+class JUCE_API  OSCMessageView
+{
+public:
+    //==============================================================================
+    /** Creates a view of the OSC message stored in a block of data.
+
+        The data must contain exactly one OSC message, as defined by the
+        OpenSoundControl 1.0 specification. If it doesn't, isValid() will return false.
+    */
+    OSCMessageView (const void* messageData, size_t messageDataSize) noexcept;
+
+    /** Returns true if the data that this view was created from is a well-formed
+        OSC message. None of the other methods may be used if this returns false.
+    */
+    bool isValid() const noexcept                   { return addressPattern != nullptr; }
+
+    /** Returns the address pattern of the message as a null-terminated string
+        pointing into the packet.
+    */
+    const char* getAddressPattern() const noexcept  { return addressPattern; }
+
+    /** Returns the number of arguments in the message. */
+    int size() const noexcept                       { return numArguments; }
+
+    /** Returns true if the message contains no arguments. */
+    bool isEmpty() const noexcept                   { return numArguments == 0; }
+
+    /** Returns the argument at index i.
+
+        The arguments of an OSC message don't have a fixed size, so this has to step
+        over all of the preceding ones. If you need all of them, it's quicker to
+        iterate over the message with begin() and end().
+
+        This method does not check the range and results in undefined behaviour
+        in case i < 0 or i >= size().
+    */
+    OSCArgumentView operator[] (int i) const noexcept;
+
+    /** Creates an OSCMessage holding copies of the address pattern and arguments. */
+    OSCMessage toMessage() const;
+
+    //==============================================================================
+    /** Iterates over the arguments of an OSCMessageView. */
+    class JUCE_API  Iterator
+    {
+    public:
+        OSCArgumentView operator*() const noexcept          { return { *typeTag, data }; }
+
+        Iterator& operator++() noexcept;
+
+        bool operator== (const Iterator& other) const noexcept  { return typeTag == other.typeTag; }
+        bool operator!= (const Iterator& other) const noexcept  { return typeTag != other.typeTag; }
+
+    private:
+        Iterator (const char* t, const char* d) noexcept  : typeTag (t), data (d) {}
+
+        const char* typeTag;
+        const char* data;
+
+        friend class OSCMessageView;
+    };
+
+    /** Returns an iterator pointing to the first argument. */
+    Iterator begin() const noexcept                 { return { typeTags, argumentData }; }
+
+    /** Returns an iterator pointing after the last argument. */
+    Iterator end() const noexcept                   { return { typeTags + numArguments, nullptr }; }
+
+private:
+    //==============================================================================
+    const char* addressPattern = nullptr;
+    const char* typeTags = nullptr;
+    const char* argumentData = nullptr;
+    int numArguments = 0;
+};
+
+} // namespace juce
@@ -311,6 +311,381 @@ namespace
 
 } // namespace
 
+//==============================================================================
+/** Matches one part of an OSC address pattern against one part of an OSC
+    address, without allocating any memory.
+
+    This follows the same rules as OSCAddressPattern::matches(), but works on
+    character ranges inside a packet rather than on String objects.
+*/
+struct OSCSegmentMatcher
+{
+    static bool containsWildcards (const char* pattern, const char* patternEnd) noexcept
+    {
+        for (auto* p = pattern; p != patternEnd; ++p)
+            if (*p == '*' || *p == '?' || *p == '[' || *p == ']' || *p == '{' || *p == '}')
+                return true;
+
+        return false;
+    }
+
+    static bool match (const char* pattern, const char* patternEnd,
+                       const char* target, const char* targetEnd) noexcept
+    {
+        while (pattern != patternEnd)
+        {
+            switch (*pattern)
+            {
+                case '?':
+                    if (target == targetEnd)
+                        return false;
+
+                    ++target;
+                    break;
+
+                case '*':   return matchAnyOrNoChars (pattern + 1, patternEnd, target, targetEnd);
+                case '[':   return matchCharSet (pattern + 1, patternEnd, target, targetEnd);
+                case '{':   return matchStringSet (pattern + 1, patternEnd, target, targetEnd);
+
+                default:
+                    if (target == targetEnd || *target != *pattern)
+                        return false;
+
+                    ++target;
+                    break;
+            }
+
+            ++pattern;
+        }
+
+        return target == targetEnd;
+    }
+
+private:
+    //==============================================================================
+    static bool matchAnyOrNoChars (const char* pattern, const char* patternEnd,
+                                   const char* target, const char* targetEnd) noexcept
+    {
+        for (;; ++target)
+        {
+            if (target == targetEnd)
+                return pattern == patternEnd;
+
+            if (match (pattern, patternEnd, target, targetEnd))
+                return true;
+        }
+    }
+
+    static bool matchCharSet (const char* pattern, const char* patternEnd,
+                              const char* target, const char* targetEnd) noexcept
+    {
+        auto c = target != targetEnd ? *target : 0;
+        bool isNegated = false, isEmpty = true, containsTarget = false;
+        char last = 0;
+
+        for (; pattern != patternEnd; ++pattern)
+        {
+            switch (*pattern)
+            {
+                case ']':
+                    if (isEmpty)
+                        return match (pattern + 1, patternEnd, target, targetEnd);
+
+                    if (target == targetEnd || containsTarget == isNegated)
+                        return false;
+
+                    return match (pattern + 1, patternEnd, target + 1, targetEnd);
+
+                case '-':
+                {
+                    if (target == targetEnd)
+                        return false;
+
+                    auto rangeEnd = pattern + 1 != patternEnd ? pattern[1] : 0;
+
+                    if (rangeEnd == ']')
+                    {
+                        // special case: '-' has no special meaning at the end.
+                        containsTarget = containsTarget || c == '-';
+                        last = '-';
+                        break;
+                    }
+
+                    if (rangeEnd == ',' || rangeEnd == '{' || rangeEnd == '}' || isEmpty)
+                        return false;
+
+                    containsTarget = containsTarget || (c > last && c <= rangeEnd);
+                    break;
+                }
+
+                case '!':
+                    if (isEmpty && ! isNegated)
+                    {
+                        isNegated = true;
+                        break;
+                    }
+                    // else = special case: fall through to default and treat '!' as a non-special character.
+                    JUCE_FALLTHROUGH
+
+                default:
+                    containsTarget = containsTarget || (target != targetEnd && c == *pattern);
+                    isEmpty = false;
+                    last = *pattern;
+                    break;
+            }
+        }
+
+        return false;
+    }
+
+    static bool matchStringSet (const char* pattern, const char* patternEnd,
+                                const char* target, const char* targetEnd) noexcept
+    {
+        auto* setEnd = std::find (pattern, patternEnd, '}');
+
+        if (setEnd == patternEnd)
+            return false;
+
+        for (auto* element = pattern;; )
+        {
+            auto* elementEnd = std::find (element, setEnd, ',');
+            auto length = elementEnd - element;
+
+            if (targetEnd - target >= length
+                 && std::equal (element, elementEnd, target)
+                 && match (setEnd + 1, patternEnd, target + length, targetEnd))
+                return true;
+
+            if (elementEnd == setEnd)
+                return false;
+
+            element = elementEnd + 1;
+        }
+    }
+};
+
+//==============================================================================
+/** A tree of OSC addresses, with one level for each part of an address.
+
+    This is built from a list of listeners and the addresses they were added
+    with, and is then used to find the listeners matching an incoming OSC
+    address pattern. The nodes are stored in flat arrays, with the children
+    of each node stored next to each other and sorted, so a part of a pattern
+    without wildcards can be looked up with a binary search. Finding the
+    matching listeners never allocates any memory.
+*/
+template <typename ListenerType>
+class OSCAddressTree
+{
+public:
+    void build (const Array<std::pair<OSCAddress, ListenerType*>>& entries)
+    {
+        BuildNode root;
+
+        for (auto& entry : entries)
+        {
+            auto* node = &root;
+
+            for (auto& symbol : StringArray::fromTokens (entry.first.toString(), "/", {}))
+                if (symbol.isNotEmpty())
+                    node = &node->getChild (symbol);
+
+            node->listeners.add (entry.second);
+        }
+
+        nodes.clearQuick();
+        symbols.clearQuick();
+        listeners.clearQuick();
+
+        // lay out the nodes breadth-first, so that the children of each node are contiguous
+        Array<const BuildNode*> queue { &root };
+
+        for (int i = 0; i < queue.size(); ++i)
+        {
+            auto& source = *queue.getUnchecked (i);
+            Node node;
+
+            node.symbolStart = symbols.size();
+            node.symbolLength = (int) source.symbol.getNumBytesAsUTF8();
+            symbols.addArray (source.symbol.toRawUTF8(), node.symbolLength);
+
+            node.firstListener = listeners.size();
+            node.numListeners = source.listeners.size();
+            listeners.addArray (source.listeners);
+
+            node.firstChild = queue.size();
+            node.numChildren = source.children.size();
+
+            for (auto* child : source.children)
+                queue.add (child);
+
+            nodes.add (node);
+        }
+    }
+
+    /** Stops a listener from being found, without changing the structure of the tree. */
+    void removeListener (ListenerType* listenerToRemove) noexcept
+    {
+        for (auto& l : listeners)
+            if (l == listenerToRemove)
+                l = nullptr;
+    }
+
+    /** Calls the callback for every listener whose address matches the given
+        null-terminated OSC address pattern.
+    */
+    template <typename Callback>
+    void forEachMatch (const char* pattern, Callback&& callback) const
+    {
+        if (! nodes.isEmpty())
+            visit (nodes.getReference (0), pattern, callback);
+    }
+
+private:
+    //==============================================================================
+    struct Node
+    {
+        int symbolStart = 0, symbolLength = 0;
+        int firstChild = 0, numChildren = 0;
+        int firstListener = 0, numListeners = 0;
+    };
+
+    struct BuildNode
+    {
+        BuildNode& getChild (const String& childSymbol)
+        {
+            auto* position = std::lower_bound (children.begin(), children.end(), childSymbol,
+                                               [] (const BuildNode* n, const String& s)
+                                               {
+                                                   return isBefore (n->symbol.toRawUTF8(), n->symbol.getNumBytesAsUTF8(),
+                                                                    s.toRawUTF8(), s.getNumBytesAsUTF8());
+                                               });
+
+            if (position != children.end() && (*position)->symbol == childSymbol)
+                return **position;
+
+            auto* child = children.insert ((int) (position - children.begin()), new BuildNode());
+            child->symbol = childSymbol;
+            return *child;
+        }
+
+        String symbol;
+        OwnedArray<BuildNode> children;
+        Array<ListenerType*> listeners;
+    };
+
+    //==============================================================================
+    static bool isBefore (const char* a, size_t aLength, const char* b, size_t bLength) noexcept
+    {
+        auto result = std::memcmp (a, b, jmin (aLength, bLength));
+        return result != 0 ? result < 0 : aLength < bLength;
+    }
+
+    const char* getSymbol (const Node& node) const noexcept
+    {
+        return symbols.begin() + node.symbolStart;
+    }
+
+    template <typename Callback>
+    void visit (const Node& node, const char* pattern, Callback& callback) const
+    {
+        while (*pattern == '/')
+            ++pattern;
+
+        if (*pattern == 0)
+        {
+            for (int i = node.firstListener; i < node.firstListener + node.numListeners; ++i)
+                if (auto* listener = listeners.getUnchecked (i))
+                    callback (*listener);
+
+            return;
+        }
+
+        auto* segmentEnd = pattern;
+
+        while (*segmentEnd != 0 && *segmentEnd != '/')
+            ++segmentEnd;
+
+        auto* firstChild = nodes.begin() + node.firstChild;
+        auto* lastChild = firstChild + node.numChildren;
+
+        if (OSCSegmentMatcher::containsWildcards (pattern, segmentEnd))
+        {
+            for (auto* child = firstChild; child != lastChild; ++child)
+                if (OSCSegmentMatcher::match (pattern, segmentEnd, getSymbol (*child), getSymbol (*child) + child->symbolLength))
+                    visit (*child, segmentEnd, callback);
+
+            return;
+        }
+
+        auto segmentLength = (size_t) (segmentEnd - pattern);
+
+        auto* child = std::lower_bound (firstChild, lastChild, pattern,
+                                        [this, segmentLength] (const Node& n, const char* segment)
+                                        {
+                                            return isBefore (getSymbol (n), (size_t) n.symbolLength, segment, segmentLength);
+                                        });
+
+        if (child != lastChild
+             && (size_t) child->symbolLength == segmentLength
+             && std::memcmp (getSymbol (*child), pattern, segmentLength) == 0)
+            visit (*child, segmentEnd, callback);
+    }
+
+    //==============================================================================
+    Array<Node> nodes;
+    Array<char> symbols;
+    Array<ListenerType*> listeners;
+};
+
+//==============================================================================
+/** Checks an OSC packet in place and calls the callback with a view of each
+    message it contains, including the ones inside bundles.
+
+    @returns false if the packet is malformed, in which case the callback may
+             already have been called for some of the messages in it.
+*/
+template <typename Callback>
+static bool forEachMessageInPacket (const char* data, size_t dataSize, Callback&& callback)
+{
+    if (dataSize < 4)
+        return false;
+
+    if (data[0] == '/')
+    {
+        OSCMessageView message (data, dataSize);
+
+        if (! message.isValid())
+            return false;
+
+        callback (message);
+        return true;
+    }
+
+    if (dataSize < 16 || std::memcmp (data, "#bundle", 8) != 0)
+        return false;
+
+    auto* end = data + dataSize;
+
+    for (auto* element = data + 16; element != end;)
+    {
+        if (end - element < 4)
+            return false;
+
+        auto elementSize = (int32) ByteOrder::bigEndianInt (element);
+
+        if (elementSize < 4 || elementSize > end - element - 4)
+            return false;
+
+        if (! forEachMessageInPacket (element + 4, (size_t) elementSize, callback))
+            return false;
+
+        element += 4 + elementSize;
+    }
+
+    return true;
+}
+
 
 //==============================================================================
 struct OSCReceiver::Pimpl   : private Thread,
@@ -323,6 +698,7 @@ struct OSCReceiver::Pimpl   : private Thread,
     ~Pimpl() override
     {
         disconnect();
+        delete messageViewListenerSet.load();
     }
 
     //==============================================================================
@@ -408,6 +784,45 @@ struct OSCReceiver::Pimpl   : private Thread,
         removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
     }
 
+    void addListener (MessageViewListener* listenerToAdd)
+    {
+        {
+            const ScopedLock sl (messageViewLock);
+            messageViewListeners.addIfNotAlreadyThere (listenerToAdd);
+            updateMessageViewListenerSet (nullptr);
+        }
+
+        retireOldMessageViewListenerSets();
+    }
+
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+    {
+        {
+            const ScopedLock sl (messageViewLock);
+            addListenerWithAddress (listenerToAdd, addressToMatch, messageViewListenersWithAddress);
+            updateMessageViewListenerSet (nullptr);
+        }
+
+        retireOldMessageViewListenerSets();
+    }
+
+    void removeListener (MessageViewListener* listenerToRemove)
+    {
+        {
+            const ScopedLock sl (messageViewLock);
+            messageViewListeners.removeFirstMatchingValue (listenerToRemove);
+
+            messageViewListenersWithAddress.removeIf ([listenerToRemove] (const std::pair<OSCAddress, MessageViewListener*>& entry)
+                                                      {
+                                                          return entry.second == listenerToRemove;
+                                                      });
+
+            updateMessageViewListenerSet (listenerToRemove);
+        }
+
+        retireOldMessageViewListenerSets();
+    }
+
     //==============================================================================
     struct CallbackMessage   : public Message
     {
@@ -420,6 +835,23 @@ struct OSCReceiver::Pimpl   : private Thread,
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
     {
+        if (hasMessageViewListeners)
+        {
+            if (! callMessageViewListeners (data, dataSize))
+            {
+                if (formatErrorHandler != nullptr)
+                    formatErrorHandler (data, (int) dataSize);
+
+                return;
+            }
+
+            // if nobody needs the content as OSCMessage and OSCBundle objects,
+            // there's no point in parsing it again
+            if (listeners.isEmpty() && realtimeListeners.isEmpty()
+                 && listenersWithAddress.isEmpty() && realtimeListenersWithAddress.isEmpty())
+                return;
+        }
+
         OSCInputStream inStream (data, dataSize);
 
         try
@@ -455,8 +887,30 @@ private:
     //==============================================================================
     void run() override
     {
-        int bufferSize = 65535;
-        HeapBlock<char> oscBuffer (bufferSize);
+       #if JUCE_LINUX
+        // recvmmsg lets us collect several datagrams with a single system call
+        constexpr int maxPacketsPerRead = 16;
+       #else
+        constexpr int maxPacketsPerRead = 1;
+       #endif
+
+        const int bufferSize = 65535;
+        HeapBlock<char> oscBuffer (bufferSize * maxPacketsPerRead);
+
+       #if JUCE_LINUX
+        mmsghdr headers[maxPacketsPerRead];
+        iovec vectors[maxPacketsPerRead];
+
+        for (int i = 0; i < maxPacketsPerRead; ++i)
+        {
+            vectors[i].iov_base = oscBuffer + i * bufferSize;
+            vectors[i].iov_len = (size_t) bufferSize;
+
+            zerostruct (headers[i]);
+            headers[i].msg_hdr.msg_iov = vectors + i;
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+       #endif
 
         while (! threadShouldExit())
         {
@@ -469,10 +923,29 @@ private:
             if (ready == 0)
                 continue;
 
-            auto bytesRead = (size_t) socket->read (oscBuffer.getData(), bufferSize, false);
+           #if JUCE_LINUX
+            auto numPackets = ::recvmmsg (socket->getRawSocketHandle(), headers,
+                                          (unsigned int) maxPacketsPerRead, MSG_DONTWAIT, nullptr);
+
+            if (numPackets > 0)
+            {
+                for (int i = 0; i < numPackets; ++i)
+                    if (headers[i].msg_len >= 4)
+                        handleBuffer (static_cast<const char*> (vectors[i].iov_base), headers[i].msg_len);
+
+                continue;
+            }
+
+            if (numPackets < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                continue;
+
+            // if recvmmsg isn't available, fall back to reading one datagram at a time
+           #endif
+
+            auto bytesRead = socket->read (oscBuffer.getData(), bufferSize, false);
 
             if (bytesRead >= 4)
-                handleBuffer (oscBuffer.getData(), bytesRead);
+                handleBuffer (oscBuffer.getData(), (size_t) bytesRead);
         }
     }
 
@@ -555,6 +1028,93 @@ private:
         }
     }
 
+    //==============================================================================
+    bool callMessageViewListeners (const char* data, size_t dataSize)
+    {
+        // a bundle is checked in full before any of its messages are delivered, so
+        // that a malformed bundle is rejected as a whole, like in handleBuffer
+        if (data[0] == '#' && ! forEachMessageInPacket (data, dataSize, [] (const OSCMessageView&) {}))
+            return false;
+
+        // The set is marked as in use before checking that it's still the current one, so
+        // that a thread which has just swapped it out will wait for this to finish with it
+        auto* set = messageViewListenerSet.load();
+
+        for (;;)
+        {
+            messageViewListenerSetInUse = set;
+            auto* current = messageViewListenerSet.load();
+
+            if (current == set)
+                break;
+
+            set = current;
+        }
+
+        auto isValid = forEachMessageInPacket (data, dataSize, [set] (const OSCMessageView& message)
+        {
+            if (set == nullptr)
+                return;
+
+            for (auto* listener : set->listeners)
+                if (listener != nullptr)
+                    listener->oscMessageReceived (message);
+
+            set->addressTree.forEachMatch (message.getAddressPattern(),
+                                           [&] (MessageViewListener& l) { l.oscMessageReceived (message); });
+        });
+
+        messageViewListenerSetInUse = nullptr;
+        return isValid;
+    }
+
+    void updateMessageViewListenerSet (MessageViewListener* removedListener)
+    {
+        std::unique_ptr<MessageViewListenerSet> newSet (new MessageViewListenerSet());
+        newSet->listeners = messageViewListeners;
+        newSet->addressTree.build (messageViewListenersWithAddress);
+
+        auto* oldSet = messageViewListenerSet.exchange (newSet.release());
+        hasMessageViewListeners = ! (messageViewListeners.isEmpty() && messageViewListenersWithAddress.isEmpty());
+
+        if (oldSet != nullptr)
+            retiredMessageViewListenerSets.add (oldSet);
+
+        // If this was called from inside a callback, the rest of the packet is still being
+        // delivered with the set that's in use, so a removed listener has to be taken out of it
+        if (removedListener != nullptr && getCurrentThreadId() == getThreadId())
+            if (auto* setInUse = messageViewListenerSetInUse.load())
+                setInUse->removeListener (removedListener);
+    }
+
+    void retireOldMessageViewListenerSets()
+    {
+        // the set in use may be further up the network thread's own call stack
+        if (getCurrentThreadId() == getThreadId())
+            return;
+
+        // Wait until the network thread isn't delivering a packet with an out-of-date set,
+        // so that a removed listener won't be called again. The lock isn't held here, as
+        // one of its callbacks might be trying to add or remove a listener.
+        for (;;)
+        {
+            auto* setInUse = messageViewListenerSetInUse.load();
+
+            if (setInUse == nullptr || setInUse == messageViewListenerSet.load())
+                break;
+
+            Thread::yield();
+        }
+
+        // A set that's been swapped out can't be picked up again, so any that aren't in use
+        // can be deleted. The others are left for the next change, or the destructor.
+        const ScopedLock sl (messageViewLock);
+
+        for (int i = retiredMessageViewListenerSets.size(); --i >= 0;)
+            if (retiredMessageViewListenerSets.getUnchecked (i) != messageViewListenerSetInUse.load())
+                retiredMessageViewListenerSets.remove (i);
+    }
+
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
@@ -579,6 +1139,31 @@ private:
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
     Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
 
+    // Everything the network thread needs to deliver message views. A new set is built
+    // by whichever thread adds or removes a listener, and swapped in for the old one, so
+    // the network thread only ever reads it, without allocating or taking a lock.
+    struct MessageViewListenerSet
+    {
+        void removeListener (MessageViewListener* listenerToRemove) noexcept
+        {
+            for (auto& l : listeners)
+                if (l == listenerToRemove)
+                    l = nullptr;
+
+            addressTree.removeListener (listenerToRemove);
+        }
+
+        Array<MessageViewListener*> listeners;
+        OSCAddressTree<MessageViewListener> addressTree;
+    };
+
+    Array<MessageViewListener*> messageViewListeners;
+    Array<std::pair<OSCAddress, MessageViewListener*>> messageViewListenersWithAddress;
+    CriticalSection messageViewLock; // only taken by the threads that add and remove listeners
+    std::atomic<MessageViewListenerSet*> messageViewListenerSet { nullptr }, messageViewListenerSetInUse { nullptr };
+    OwnedArray<MessageViewListenerSet> retiredMessageViewListenerSets;
+    std::atomic<bool> hasMessageViewListeners { false };
+
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
 
@@ -654,6 +1239,21 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+{
+    pimpl->addListener (listenerToAdd, addressToMatch);
+}
+
+void OSCReceiver::removeListener (MessageViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1189,6 +1789,201 @@ public:
 
 static OSCInputStreamTests OSCInputStreamUnitTests;
 
+//==============================================================================
+class OSCMessageViewDispatchTests  : public UnitTest
+{
+public:
+    OSCMessageViewDispatchTests()
+        : UnitTest ("OSCReceiver message view dispatch", UnitTestCategories::osc)
+    {}
+
+    void runTest()
+    {
+        const char* patterns[] = { "fader1", "fader?", "fader*", "*", "*1", "f*r*", "fader[0-9]", "fader[!2]",
+                                   "fader[1-]", "fader[-1]", "fader[]", "fader[!]1", "fader[a,9]", "{fader,knob}1",
+                                   "{fad,fader}1", "{}fader1", "fader{1,2", "fader[12", "knob", "?????2", "fader1?" };
+
+        const char* addresses[] = { "fader1", "fader2", "fader-", "fader", "knob1", "faderx", "f", "fader12" };
+
+        beginTest ("Matching parts of address patterns");
+        {
+            for (auto* pattern : patterns)
+            {
+                for (auto* address : addresses)
+                {
+                    auto expected = OSCAddressPattern ("/" + String (pattern)).matches (OSCAddress ("/" + String (address)));
+                    auto actual = OSCSegmentMatcher::match (pattern, pattern + std::strlen (pattern),
+                                                            address, address + std::strlen (address));
+
+                    expect (actual == expected, String (pattern) + " vs " + String (address));
+                }
+            }
+        }
+
+        beginTest ("Finding listeners in the address tree");
+        {
+            OwnedArray<TestListener> testListeners;
+            Array<std::pair<OSCAddress, TestListener*>> entries;
+
+            for (auto* first : { "/mixer", "/lights", "/lights/dimmer" })
+            {
+                for (auto* address : addresses)
+                {
+                    auto* listener = testListeners.add (new TestListener { first + String ("/") + address });
+                    entries.add ({ OSCAddress (listener->address), listener });
+                }
+            }
+
+            entries.add ({ OSCAddress ("/"), testListeners.add (new TestListener { "/" }) });
+
+            OSCAddressTree<TestListener> tree;
+            tree.build (entries);
+
+            auto checkMatches = [&] (const String& pattern)
+            {
+                Array<TestListener*> found;
+                tree.forEachMatch (pattern.toRawUTF8(), [&] (TestListener& l) { found.add (&l); });
+
+                for (auto& entry : entries)
+                    expect (found.contains (entry.second) == OSCAddressPattern (pattern).matches (entry.first),
+                            pattern + " vs " + entry.first.toString());
+
+                return found.size();
+            };
+
+            for (auto* first : { "/mixer", "/lights", "/lights/dimmer", "/*", "/{mixer,lights}", "/[l]ights", "/nothing" })
+                for (auto* pattern : patterns)
+                    checkMatches (first + String ("/") + pattern);
+
+            expectEquals (checkMatches ("/lights/dimmer/fader1"), 1);
+            expectEquals (checkMatches ("/lights/*/fader1"), 1);
+            expectEquals (checkMatches ("/*/fader1"), 2);
+            expectEquals (checkMatches ("/"), 1);
+            expectEquals (checkMatches ("/lights/fader"), 1);
+
+            tree.removeListener (testListeners[0]);
+            expectEquals (countMatches (tree, "/mixer/fader1"), 0);
+        }
+
+        beginTest ("Receiving message views");
+        {
+            ScopedJuceInitialiser_GUI libraryInitialiser;
+
+            DatagramSocket socket;
+            expect (socket.bindToPort (0));
+
+            OSCReceiver receiver;
+            expect (receiver.connectToSocket (socket));
+
+            CountingListener all, faders, knob;
+            receiver.addListener (&all);
+            receiver.addListener (&faders, "/test/fader1");
+            receiver.addListener (&faders, "/test/fader2");
+            receiver.addListener (&knob, "/test/knob");
+
+            int numFormatErrors = 0;
+            receiver.registerFormatErrorHandler ([&numFormatErrors] (const char*, int) { ++numFormatErrors; });
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", socket.getBoundPort()));
+
+            OSCBundle bundle;
+            bundle.addElement (OSCMessage ("/test/fader1", 1.0f));
+            bundle.addElement (OSCMessage ("/test/knob", 2.0f));
+
+            expect (sender.send (OSCMessage ("/test/fader?", 0.5f)));
+            expect (sender.send (bundle));
+            expect (sender.send (OSCMessage ("/test/other", String ("text"))));
+
+            // "/test/fader?" matches both of the addresses that faders was added with
+            expect (all.waitForMessages (4));
+            expect (faders.waitForMessages (3));
+            expect (knob.waitForMessages (1));
+
+            expectEquals (all.lastAddress, String ("/test/other"));
+            expectEquals (knob.lastValue, 2.0f);
+            expectEquals (numFormatErrors, 0);
+
+            receiver.removeListener (&faders);
+            expect (sender.send (OSCMessage ("/test/fader1", 3.0f)));
+
+            expect (all.waitForMessages (5));
+            expectEquals (faders.getNumMessages(), 3);
+
+            // a listener that removes itself isn't called for the rest of the bundle
+            SelfRemovingListener selfRemoving (receiver);
+            receiver.addListener (&selfRemoving, "/test/knob");
+            receiver.addListener (&faders, "/test/knob");
+
+            bundle.addElement (OSCMessage ("/test/knob", 4.0f));
+            expect (sender.send (bundle));
+
+            expect (all.waitForMessages (8));
+            expect (faders.waitForMessages (5));
+            expectEquals (selfRemoving.getNumMessages(), 1);
+
+            receiver.disconnect();
+        }
+    }
+
+private:
+    struct TestListener
+    {
+        String address;
+    };
+
+    static int countMatches (const OSCAddressTree<TestListener>& tree, const char* pattern)
+    {
+        int numFound = 0;
+        tree.forEachMatch (pattern, [&numFound] (TestListener&) { ++numFound; });
+        return numFound;
+    }
+
+    struct CountingListener  : public OSCReceiver::MessageViewListener
+    {
+        void oscMessageReceived (const OSCMessageView& message) override
+        {
+            lastAddress = message.getAddressPattern();
+
+            if (! message.isEmpty() && message[0].isFloat32())
+                lastValue = message[0].getFloat32();
+
+            ++numMessages;
+            messageArrived.signal();
+        }
+
+        bool waitForMessages (int numExpected)
+        {
+            for (int i = 0; i < 50 && numMessages < numExpected; ++i)
+                messageArrived.wait (100);
+
+            return numMessages == numExpected;
+        }
+
+        int getNumMessages() const noexcept     { return numMessages; }
+
+        String lastAddress;
+        float lastValue = 0;
+        std::atomic<int> numMessages { 0 };
+        WaitableEvent messageArrived;
+    };
+
+    struct SelfRemovingListener  : public CountingListener
+    {
+        explicit SelfRemovingListener (OSCReceiver& r)  : receiver (r) {}
+
+        void oscMessageReceived (const OSCMessageView& message) override
+        {
+            receiver.removeListener (this);
+            CountingListener::oscMessageReceived (message);
+        }
+
+        OSCReceiver& receiver;
+    };
+};
+
+static OSCMessageViewDispatchTests OSCMessageViewDispatchUnitTests;
+
 #endif
 
 } // namespace juce
@@ -157,6 +157,40 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any parsing
+        into OSCMessage objects.
+
+        The listener is called directly on the network thread that receives OSC
+        data, like a RealtimeCallback listener, but instead of an OSCMessage it is
+        given an OSCMessageView pointing into the receive buffer. Nothing is copied
+        and no memory is allocated to deliver a message, which makes this the
+        cheapest way of handling high message rates.
+
+        The view is only valid for the duration of the callback. Messages inside
+        OSC bundles are delivered one by one, in the order they appear in the bundle.
+
+        Listeners that are added with an OSC address are found with a lookup tree,
+        so the cost of dispatching a message doesn't grow with the number of
+        listeners. The tree is rebuilt by addListener() and removeListener() on the
+        thread that calls them, so the network thread never has to wait for it.
+
+        @see OSCReceiver::addListener, OSCMessageView
+    */
+    class JUCE_API  MessageViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~MessageViewListener() = default;
+
+        /** Called when the OSCReceiver receives an OSC message.
+
+            If the listener was added with an OSC address, this is only called for
+            messages whose address pattern matches that address.
+        */
+        virtual void oscMessageReceived (const OSCMessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -183,6 +217,23 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that is given a view of every OSC message that arrives,
+        including the messages inside bundles.
+        This listener will be called in real-time directly on the network thread
+        that receives OSC data.
+    */
+    void addListener (MessageViewListener* listenerToAdd);
+
+    /** Adds a listener that is given a view of the OSC messages matching the
+        address used to register the listener here.
+        This listener will be called in real-time directly on the network thread
+        that receives OSC data.
+
+        A listener may be added with more than one address, in which case it is
+        called once for each address that a message matches.
+    */
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -195,6 +246,11 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener, along with all the addresses
+        it was registered with.
+    */
+    void removeListener (MessageViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.